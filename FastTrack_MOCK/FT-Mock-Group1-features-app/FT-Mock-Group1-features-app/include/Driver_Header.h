@@ -16,6 +16,7 @@
 #include "../src/driver/adc_driver/include/ADC_Driver.h"
 #include "../src/driver/can_driver/include/FlexCAN.h"
 #include "../src/driver/clock_driver/include/CLOCK.h"
+#include "../src/driver/crc_driver/include/CRC_Driver.h"
 #include "../src/driver/gpio_driver/include/GPIO_Driver.h"
 #include "../src/driver/NVIC/include/NVIC.h"
 #include "../src/driver/port_driver/include/PORT_Driver.h"
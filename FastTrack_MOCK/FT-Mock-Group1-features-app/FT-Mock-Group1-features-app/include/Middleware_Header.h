@@ -10,10 +10,23 @@
 
 #include "Driver_Header.h"
 #include "../src/middleware/can_middleware/include/MIDDLE_FlexCAN.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanTxQueue.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanFilter.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanLatency.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanHealth.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanSched.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanE2E.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanCom.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanTp.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanIdMap.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanGateway.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanSniffer.h"
+#include "../src/middleware/can_middleware/include/MIDDLE_CanStats.h"
 #include "../src/middleware/lpit_middleware/src/Mid_Lpit.h"
 #include "../src/middleware/adc_middleware/include/MIDDLE_ADC.h"
 #include "../src/middleware/uart_middleware/include/MIDDLE_UART.h"
 #include "../src/middleware/gpio_middleware/include/gpio_middleware.h"
+#include "../src/middleware/queue/include/MIDDLE_Snapshot.h"
 
 
 #endif /* MIDDLEWARE_HEADER_H_ */
@@ -0,0 +1,151 @@
+/*
+ * SimBus.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Virtual CAN bus shared by the simulated nodes of sim_can.
+ * The bus lives in the sim_can executable, every node is a shared object with its own copy
+ * of the application, the middleware and FlexCAN_Host.c, attached to the bus as a controller.
+ */
+
+#ifndef SIM_BUS_H_
+#define SIM_BUS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define SIM_BUS_MAX_CONTROLLERS         8U
+#define SIM_BUS_MAX_DATA_LEN            64U
+#define SIM_BUS_RECOVERY_BITS           (128U * 11U)  /*!< Recessive bits needed to leave bus-off */
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Frame on the virtual bus.
+ */
+typedef struct
+{
+    uint32_t                     Id;             /*!< Standard (11-bit) or extended (29-bit) ID */
+    bool                         IsExtended;     /*!< IDE */
+    bool                         IsRemote;       /*!< RTR */
+    bool                         IsFd;           /*!< EDL */
+    bool                         BitRateSwitch;  /*!< BRS */
+    uint8_t                      DataLen;        /*!< Payload length in bytes */
+    uint8_t                      Data[SIM_BUS_MAX_DATA_LEN];
+    uint32_t                     RequestTime;    /*!< Bus time the sender queued the frame */
+} SimBus_FrameType;
+
+/**
+ * @brief Outcome of a transmission, as seen by the transmitter.
+ */
+typedef enum
+{
+    SIM_BUS_TX_OK           = 0U,   /*!< Frame acknowledged */
+    SIM_BUS_TX_ACK_ERROR,           /*!< Nobody acknowledged the frame */
+    SIM_BUS_TX_BIT_ERROR            /*!< Injected error, error frame on the bus */
+} SimBus_TxResult_e;
+
+/**
+ * @brief Controller side of the bus, every function is called from the bus thread.
+ *
+ * The controller runs them as its interrupts, under its own interrupt lock.
+ */
+typedef struct
+{
+    /* Highest priority frame pending in the controller, false when there is none */
+    bool (*GetTx)(void *Controller, SimBus_FrameType *Frame);
+    /* Outcome of the frame returned by the last GetTx */
+    void (*TxDone)(void *Controller, SimBus_TxResult_e Result, uint32_t Time);
+    /* Frame sent by another controller, IsValid false for a frame destroyed by an error frame */
+    void (*Rx)(void *Controller, const SimBus_FrameType *Frame, bool IsValid, uint32_t Time);
+    /* Called at every bus decision, for the bus-off recovery */
+    void (*Tick)(void *Controller, uint32_t Time);
+    /* True when the controller takes part in the bus (acknowledges frames) */
+    bool (*IsOnline)(void *Controller);
+} SimBus_ControllerOps;
+
+/**
+ * @brief Simulation parameters, set by the sim_can command line.
+ */
+typedef struct
+{
+    uint32_t                     BitRate;        /*!< Nominal bit rate, bit times are the bus time unit */
+    uint32_t                     AdcPeriodUs;    /*!< Period of the simulated ADC conversions */
+    uint32_t                     LpitClockHz;    /*!< LPIT functional clock, converts timer values to time */
+    uint32_t                     ErrorPpm;       /*!< Injected frame errors per million frames */
+} SimBus_ConfigType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Attaches a controller to the bus.
+ *
+ * @param[in]  Ops         Controller functions.
+ * @param[in]  Controller  Passed back to the controller functions.
+ * @param[in]  Name        Node name used by the report.
+ *
+ * @return int  Controller index, -1 when the bus is full.
+ */
+int SimBus_Attach(const SimBus_ControllerOps *Ops, void *Controller, const char *Name);
+
+/**
+ * @brief  Arbitration value of a frame, the lowest value wins the bus.
+ *
+ * Base ID, RTR/SRR, IDE, extended ID and RTR packed in bus order, so a standard data frame
+ * beats a remote frame and an extended frame with the same base ID.
+ */
+uint32_t SimBus_ArbitrationKey(const SimBus_FrameType *Frame);
+
+/**
+ * @brief  Current bus time in nominal bit times, follows the wall clock.
+ */
+uint32_t SimBus_Now(void);
+
+/**
+ * @brief  Tells the bus thread a controller has a new frame to send.
+ */
+void SimBus_Wakeup(void);
+
+/**
+ * @brief  Gets the simulation parameters.
+ */
+const SimBus_ConfigType * SimBus_GetConfig(void);
+
+/**
+ * @brief  Calls Func(Arg) every PeriodUs microseconds from the timer thread.
+ *
+ * @return bool  false when no timer is left.
+ */
+bool SimTimer_Start(uint32_t PeriodUs, void (*Func)(void *Arg), void *Arg);
+
+/**
+ * @brief  Stops the timers started with Func and Arg.
+ */
+void SimTimer_Stop(void (*Func)(void *Arg), void *Arg);
+
+/**
+ * @brief  Starts the bus and timer threads, called by sim_can before loading the nodes.
+ */
+void SimBus_Start(const SimBus_ConfigType *Config, bool IsVerbose);
+
+/**
+ * @brief  Stops the bus thread, the statistics stay readable.
+ */
+void SimBus_Stop(void);
+
+/**
+ * @brief  Prints bus load, frames per second and per ID latency since SimBus_Start.
+ */
+void SimBus_Report(FILE *Out);
+
+#endif /* SIM_BUS_H_ */
@@ -0,0 +1,43 @@
+/*
+ * SimCore.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Host replacement of s32_core_cm4.h, force-included in every node source.
+ * The guard keeps the Cortex-M4 header out, interrupts become the node interrupt lock.
+ */
+
+#ifndef SIM_CORE_H_
+#define SIM_CORE_H_
+
+#define CORE_CM4_H
+
+#include <stdint.h>
+
+void SimCore_IrqLock(void);
+void SimCore_IrqUnlock(void);
+/* Lets the node main thread sleep a little when it polls an empty driver, there is one CPU */
+void SimCore_Poll(void);
+
+#define DISABLE_INTERRUPTS()    SimCore_IrqLock()
+#define ENABLE_INTERRUPTS()     SimCore_IrqUnlock()
+#define STANDBY()
+#define NOP()
+
+#define REV_BYTES_32(a, b)      ((b) = __builtin_bswap32((uint32_t)(a)))
+#define REV_BYTES_16(a, b)      ((b) = (((uint32_t)(a) & 0xFF00FF00U) >> 8U) | (((uint32_t)(a) & 0x00FF00FFU) << 8U))
+
+#define START_FUNCTION_DECLARATION_RAMSECTION
+#define END_FUNCTION_DECLARATION_RAMSECTION     ;
+#define START_FUNCTION_DEFINITION_RAMSECTION
+#define END_FUNCTION_DEFINITION_RAMSECTION
+#define DISABLE_CHECK_RAMSECTION_FUNCTION_CALL
+#define ENABLE_CHECK_RAMSECTION_FUNCTION_CALL
+
+#define GET_CORE_ID()           0U
+#define ALIGNED(x)              __attribute__((aligned(x)))
+#define PLACE_IN_SECTION(x)     __attribute__((section(x)))
+#define CORE_LITTLE_ENDIAN
+
+#endif /* SIM_CORE_H_ */
@@ -0,0 +1,62 @@
+#!/bin/sh
+#
+# Builds sim_can with the host compiler and runs it, arguments go to sim_can:
+#   sim/run_sim.sh -t 10 -b 500000 -e 1000
+#   sim/run_sim.sh -n tpbench -t 120        ISO-TP throughput benchmark
+#   sim/run_sim.sh -n gwbench               gateway routing cost per frame
+#   sim/run_sim.sh -n e2ebench              E2E protection cost per PDU
+#   sim/run_sim.sh -n rxbench -t 60         CPU load and Rx latency of the interrupt, poll and adaptive Rx modes
+#   sim/run_sim.sh -n filtertest            acceptance filter planner against all standard IDs
+#   sim/run_sim.sh -n irqbench              mailbox interrupt dispatch cost, linear scan against ctz
+#   sim/run_sim.sh -n forwarder,speed,temp,sniffer   listen-only bus monitor next to the nodes
+#   sim/run_sim.sh -n forwarder,speed,temp,monitor   listen-only bus statistics next to the nodes
+#
+# Each node is a shared object with its own copy of the application, the CAN/ADC/LPIT middleware
+# and the host FlexCAN driver. The S32DS project does not compile sim/.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT="$ROOT/sim/build"
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:-"-std=gnu99 -O2 -g -Wall"}
+
+INC="-I$ROOT/include -I$ROOT/sim/include -I$ROOT/src -I$ROOT/src/driver -I$ROOT/src/middleware/lpit_middleware/src"
+for dir in $(find "$ROOT/src" -type d -name include); do
+    INC="$INC -I$dir"
+done
+
+NODE_SRC="$ROOT/src/middleware/can_middleware/src/*.c
+          $ROOT/src/middleware/adc_middleware/src/MIDDLE_ADC.c
+          $ROOT/src/middleware/lpit_middleware/src/Mid_Lpit.c
+          $ROOT/src/middleware/gpio_middleware/src/gpio_middleware.c
+          $ROOT/src/middleware/queue/src/MIDDLE_Snapshot.c
+          $ROOT/sim/src/FlexCAN_Host.c
+          $ROOT/sim/src/SimPlatform.c"
+
+mkdir -p "$OUT"
+
+# name entry application
+build_node() {
+    $CC $CFLAGS -shared -fPIC -Wl,-Bsymbolic -o "$OUT/node_$1.so" \
+        -include "$ROOT/sim/include/SimCore.h" -DCPU_S32K144HFT0VLLT \
+        -DSIM_NODE_NAME="\"$1\"" -DSIM_NODE_ENTRY="$2" $INC \
+        "$3" $NODE_SRC -lpthread
+}
+
+build_node forwarder App_Forwarder_Run "$ROOT/src/app/node_forwarder/src/node_forwarder.c"
+build_node speed App_NodeSpeed_Run "$ROOT/src/app/node_speed/src/node_speed.c"
+build_node temp App_NodeTemp_Run "$ROOT/src/app/node_temperature/src/node_temp.c"
+build_node sniffer App_Forwarder_Sniffer_Run "$ROOT/src/app/node_forwarder/src/node_forwarder.c"
+build_node monitor App_Forwarder_Monitor_Run "$ROOT/src/app/node_forwarder/src/node_forwarder.c"
+build_node tpbench SimTpBench_Run "$ROOT/sim/src/SimTpBench.c"
+build_node gwbench SimGwBench_Run "$ROOT/sim/src/SimGwBench.c"
+build_node e2ebench SimE2EBench_Run "$ROOT/sim/src/SimE2EBench.c"
+build_node rxbench SimRxBench_Run "$ROOT/sim/src/SimRxBench.c"
+build_node filtertest SimFilterTest_Run "$ROOT/sim/src/SimFilterTest.c"
+build_node irqbench SimIrqBench_Run "$ROOT/sim/src/SimIrqBench.c"
+
+$CC $CFLAGS -o "$OUT/sim_can" -I"$ROOT/sim/include" \
+    "$ROOT/sim/src/SimMain.c" "$ROOT/sim/src/SimBus.c" -rdynamic -ldl -lpthread
+
+exec "$OUT/sim_can" "$@"
@@ -0,0 +1,1967 @@
+/*
+ * FlexCAN_Host.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Host port of the FlexCAN driver for sim_can, same API as FlexCAN.c.
+ * The message buffer RAM keeps the hardware layout and encoding, the CAN protocol engine is a
+ * controller of the virtual bus. Bus events run under the node interrupt lock, like the ISRs.
+ */
+
+#include "FlexCAN.h"
+#include "SimBus.h"
+#include "s32_core_cm4.h"
+#include <stddef.h>
+#include <stdio.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define ERROR_INT                               (0x300002U)    /*!< Masks for ErrorOvr, ErrorFast, Error */
+#define BUS_OFF_INT                             (0xB0004U)     /*!< Masks for busOff, Tx/Rx Warning */
+#define ESR1_ERROR_BITS                         (FLEXCAN_ESR1_STFERR_MASK | FLEXCAN_ESR1_FRMERR_MASK | FLEXCAN_ESR1_CRCERR_MASK \
+                                                 | FLEXCAN_ESR1_ACKERR_MASK | FLEXCAN_ESR1_BIT0ERR_MASK | FLEXCAN_ESR1_BIT1ERR_MASK)
+#define NUMBER_OF_MB                            (32U)
+#define NUMBER_OF_CALLBACK                      (FLEXCAN_ORED_CALLBACK_ID + 1U)
+#define MB_HEADER_WORDS                         (2U)
+#define MB_RAM_WORDS                            (128U)
+#define FLEXCAN_MB_RAM_WORDS                    { 128U, 64U, 64U } /*!< Message buffer RAM of FlexCAN0/1/2, in words */
+#define FD_DLC_COUNT                            (16U)
+#define RXIMR_COUNT                             (32U)
+#define DMA_CITER_MAX                           (0x7FFFU)
+#define RXIMR_MATCH_ALL_BITS                    (0xFFFFFFFFU)
+#define RXFIFO_MAX_ELEMENTS                     (128U)
+#define RXFIFO_MAX_ID_FILTERS                   (RXFIFO_MAX_ELEMENTS)
+#define MB_ID_BITS_MASK                         (FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK)
+#define NO_TX_MB                                (-1)
+#define ERROR_PASSIVE_LIMIT                     (128U)
+#define ERROR_WARNING_LIMIT                     (96U)
+#define BUS_OFF_LIMIT                           (256U)
+#define REC_PASSIVE_RESTART                     (120U)         /*!< REC after a good frame while error passive (119-127) */
+#define TEC_ERROR_STEP                          (8U)
+#define FLTCONF_PASSIVE                         (1U)
+#define FLTCONF_BUS_OFF                         (2U)
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+typedef struct
+{
+    FlexCAN_CallbackType Func;
+    void * Context;
+} FlexCAN_CallbackEntryType;
+
+typedef struct
+{
+    uint32_t WireTime;
+    uint32_t IsrTime;
+    bool IsPending;     /*!< Event not consumed by a frame read yet */
+} FlexCAN_MbEventTimeType;
+
+typedef struct
+{
+    const FlexCAN_RxFifoConfigType * Config;
+    uint32_t Produced;
+    uint32_t Consumed;
+    uint32_t OverflowCount;
+    uint32_t BatchTime;
+    uint32_t NoOfElements;
+    uint32_t Element[RXFIFO_MAX_ELEMENTS];      /*!< ID filter table, filter element layout */
+    uint32_t ElementMask[RXFIFO_MAX_ELEMENTS];  /*!< RXIMR for the first 32 elements, RXFGMASK after */
+} FlexCAN_RxFifoStateType;
+
+/**
+ * One controller: the registers the driver uses, the MB RAM and the protocol state.
+ */
+typedef struct
+{
+    FlexCAN_Instance_e          Ins;
+    int                         BusIndex;       /*!< Index on the virtual bus, -1 until the first init */
+    uint32_t                    RAMn[MB_RAM_WORDS];
+    uint32_t                    RXIMR[RXIMR_COUNT];
+    uint32_t                    IFLAG1;
+    uint32_t                    IMASK1;
+    uint32_t                    Esr1;
+    FlexCAN_InterruptType       IntControl;
+    uint32_t                    Tec;            /*!< Goes past 255 on the way to bus-off */
+    uint32_t                    Rec;
+    bool                        IsBusOff;
+    bool                        IsRecoveryHeld; /*!< CTRL1[BOFFREC] */
+    bool                        IsListenOnly;   /*!< CTRL1[LOM]: no Tx, no ACK, error counters frozen */
+    uint32_t                    RecoveryStart;
+    uint8_t                     MbWords;
+    uint8_t                     FirstMb;        /*!< First MB after the Rx FIFO area */
+    uint8_t                     LastMb;         /*!< MCR[MAXMB] */
+    int                         TxMb;           /*!< MB of the frame handed to the bus */
+    uint32_t                    RequestTime[NUMBER_OF_MB];
+    FlexCAN_MbEventTimeType     MbEventTime[NUMBER_OF_MB];
+    FlexCAN_CallbackEntryType   Callback[NUMBER_OF_CALLBACK];
+    FlexCAN_ObserverType        Observer;
+    FlexCAN_RxPollConfigType    RxMode;
+    uint32_t                    PollGroup;      /*!< Mailboxes of RxMode.MbMask that had their interrupt enabled */
+    bool                        IsPolling;      /*!< Interrupts of PollGroup masked, FlexCAN_RxPoll serves it */
+    uint8_t                     QuietCount;
+    FlexCAN_RxPollStatsType     PollStats;
+    FlexCAN_RxFifoStateType     RxFifo;
+    char                        Name[32];
+} FlexCAN_HostType;
+
+static FlexCAN_HostType FlexCAN_Host[FLEXCAN_INSTANCE_COUNT];
+
+FlexCAN_State_e FlexCAN_CurrentState[FLEXCAN_INSTANCE_COUNT] = { FLEXCAN_STATE_UNINIT };
+
+static const uint8_t FlexCAN_MbRamWords[FLEXCAN_INSTANCE_COUNT] = FLEXCAN_MB_RAM_WORDS;
+
+static const uint8_t FlexCAN_DlcToLength[FD_DLC_COUNT] = { 0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+
+/* ----------------------------------------------------------------------------
+   -- Private function prototypes
+   ---------------------------------------------------------------------------- */
+static bool FlexCAN_HostGetTx(void *Controller, SimBus_FrameType *Frame);
+static void FlexCAN_HostTxDone(void *Controller, SimBus_TxResult_e Result, uint32_t Time);
+static void FlexCAN_HostRx(void *Controller, const SimBus_FrameType *Frame, bool IsValid, uint32_t Time);
+static void FlexCAN_HostTick(void *Controller, uint32_t Time);
+static bool FlexCAN_HostIsOnline(void *Controller);
+static void FlexCAN_HostRxFifoInit(FlexCAN_HostType *Host, const FlexCAN_RxFifoConfigType * RxFifoConfig);
+static bool FlexCAN_HostCheckMbLayout(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config);
+static bool FlexCAN_HostIsDmaFree(FlexCAN_Instance_e FlexCAN_Ins);
+static bool FlexCAN_HostCheckRxFifoConfig(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_RxFifoConfigType * RxFifoConfig);
+static bool FlexCAN_HostRxFifoStore(FlexCAN_HostType *Host, const SimBus_FrameType *Frame, uint32_t Time);
+static void FlexCAN_HostRxMbStore(FlexCAN_HostType *Host, const SimBus_FrameType *Frame, uint32_t Time);
+static void FlexCAN_HostRemoteRequest(FlexCAN_HostType *Host, const SimBus_FrameType *Frame);
+static void FlexCAN_HostMbToBus(FlexCAN_HostType *Host, uint8_t MbIndex, SimBus_FrameType *Frame);
+static void FlexCAN_HostBusToWords(const SimBus_FrameType *Frame, uint32_t Time, uint32_t * Words, uint8_t NoOfPayloadWords);
+static void FlexCAN_HostFaultConfinement(FlexCAN_HostType *Host, uint32_t Time);
+static void FlexCAN_HostDispatch(FlexCAN_HostType *Host);
+static void FlexCAN_HostMbService(FlexCAN_HostType *Host, uint8_t MbIndex, uint32_t Now);
+static void FlexCAN_HostMbSetInterrupt(FlexCAN_HostType *Host, uint8_t MbIndex, bool IsEnableMbInt);
+static uint32_t FlexCAN_HostReadEsr1(FlexCAN_HostType *Host);
+static void FlexCAN_SetModuleState(FlexCAN_Instance_e Ins, FlexCAN_State_e Transition);
+static void FlexCAN_MbToFrame(const volatile FlexCAN_MbStructureType * Mbx, FlexCAN_FrameType * Frame);
+static uint32_t FlexCAN_ExtendTimeStamp(uint32_t Now, uint32_t TimeStamp);
+static uint32_t FlexCAN_ConsumeIsrTime(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, uint32_t Now);
+static FlexCAN_MbStructureType * FlexCAN_GetMb(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex);
+static uint8_t FlexCAN_LengthToDlc(uint8_t DataLen);
+
+static const SimBus_ControllerOps FlexCAN_HostOps =
+{
+    .GetTx = FlexCAN_HostGetTx,
+    .TxDone = FlexCAN_HostTxDone,
+    .Rx = FlexCAN_HostRx,
+    .Tick = FlexCAN_HostTick,
+    .IsOnline = FlexCAN_HostIsOnline
+};
+
+/* ----------------------------------------------------------------------------
+   -- Public functions
+   ---------------------------------------------------------------------------- */
+FlexCAN_Driver_ReturnCode_e FlexCAN_Init(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_ConfigType *FlexCAN_Config)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+    const FlexCAN_FdConfigType * FdConfig = NULL;
+    const FlexCAN_MbLayoutType * Layout = NULL;
+    uint8_t MbCount = 0U;
+    uint8_t Index = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || FlexCAN_Config == NULL || FlexCAN_CurrentState[FlexCAN_Ins] != FLEXCAN_STATE_UNINIT
+       || FlexCAN_HostCheckMbLayout(FlexCAN_Ins, FlexCAN_Config) == false
+       || FlexCAN_HostCheckRxFifoConfig(FlexCAN_Ins, FlexCAN_Config->RxFifoConfig) == false
+       || (FlexCAN_Config->FdConfig != NULL && FlexCAN_Config->FdConfig->Enable == true
+           && (FlexCAN_Ins != FlexCAN0_INS || FlexCAN_Config->FdConfig->PayloadSize > FlexCAN_PAYLOAD_64_BYTES
+               || (FlexCAN_Config->RxFifoConfig != NULL && FlexCAN_Config->RxFifoConfig->Mode != FlexCAN_RXFIFO_DISABLE))))
+    {
+        /* Invalid parameters, driver already in init state or CAN FD configuration not supported */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        DISABLE_INTERRUPTS();
+
+        Host->Ins = FlexCAN_Ins;
+        Host->IntControl = FlexCAN_Config->IntControl;
+        Host->IFLAG1 = 0U;
+        Host->IMASK1 = 0U;
+        Host->RxMode.Mode = FlexCAN_RX_MODE_IRQ;
+        Host->PollGroup = 0U;
+        Host->IsPolling = false;
+        Host->Esr1 = 0U;
+        Host->Tec = 0U;
+        Host->Rec = 0U;
+        Host->IsBusOff = false;
+        Host->IsRecoveryHeld = false;
+        Host->IsListenOnly = (FlexCAN_Config->RunMode == FlexCAN_MODE_LISTEN_ONLY);
+        Host->TxMb = NO_TX_MB;
+
+        /* Payload size of the MB RAM */
+        FdConfig = FlexCAN_Config->FdConfig;
+        Host->MbWords = (FdConfig != NULL && FdConfig->Enable == true)
+                        ? (uint8_t)(MB_HEADER_WORDS + (2U << FdConfig->PayloadSize)) : (MB_HEADER_WORDS + 2U);
+
+        /* Clear MSG Buffers, exact match until FlexCAN_SetRxFilters widens the masks */
+        for(Index = 0U; Index < MB_RAM_WORDS; Index++)
+        {
+            Host->RAMn[Index] = 0U;
+        }
+
+        for(Index = 0U; Index < RXIMR_COUNT; Index++)
+        {
+            Host->RXIMR[Index] = RXIMR_MATCH_ALL_BITS;
+        }
+
+        for(Index = 0U; Index < NUMBER_OF_MB; Index++)
+        {
+            Host->MbEventTime[Index].IsPending = false;
+        }
+
+        MbCount = FlexCAN_GetMbCount(FlexCAN_Ins);
+        Host->LastMb = (FlexCAN_Config->MaxNoMB < MbCount) ? FlexCAN_Config->MaxNoMB : (MbCount - 1U);
+        Host->LastMb = (Host->LastMb >= NUMBER_OF_MB) ? (NUMBER_OF_MB - 1U) : Host->LastMb;
+
+        FlexCAN_HostRxFifoInit(Host, FlexCAN_Config->RxFifoConfig);
+
+        /* Mailboxes, masks and callbacks of the const layout */
+        for(Index = 0U; Index < FlexCAN_Config->NoOfMbLayout; Index++)
+        {
+            Layout = &FlexCAN_Config->MbLayout[Index];
+            FlexCAN_GetMb(FlexCAN_Ins, Layout->MbIndex)->Header[1] = Layout->Id;
+            FlexCAN_GetMb(FlexCAN_Ins, Layout->MbIndex)->Header[0] = Layout->Cs;
+            Host->RXIMR[Layout->MbIndex] = Layout->RxMask;
+            Host->Callback[Layout->MbIndex].Func = Layout->Callback;
+            Host->Callback[Layout->MbIndex].Context = Layout->Context;
+            Host->IMASK1 |= (Layout->Callback != NULL) ? (1UL << Layout->MbIndex) : 0U;
+        }
+
+        ENABLE_INTERRUPTS();
+
+        if(Host->BusIndex <= 0 && Host->Name[0] == '\0')
+        {
+            /* Attach once, a DeInit/Init cycle keeps the bus slot */
+            snprintf(Host->Name, sizeof(Host->Name), (FlexCAN_Ins == FlexCAN0_INS) ? "%s" : "%s/CAN%u",
+                     SIM_NODE_NAME, (unsigned)FlexCAN_Ins);
+            Host->BusIndex = SimBus_Attach(&FlexCAN_HostOps, Host, Host->Name);
+        }
+
+        if(FlexCAN_Config->BitRate != SimBus_GetConfig()->BitRate)
+        {
+            fprintf(stderr, "%s: bit rate %u differs from the bus, frames use the bus bit rate\n",
+                    Host->Name, FlexCAN_Config->BitRate);
+        }
+
+        /* Switch to READY state */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_READY);
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_DeInit(FlexCAN_Instance_e FlexCAN_Ins)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || FlexCAN_CurrentState[FlexCAN_Ins] != FLEXCAN_STATE_READY)
+    {
+        /* Invalid parameter or driver is not in ready  state */
+    }
+    else
+    {
+        /* Switch to UNINIT state, the controller leaves the bus */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_UNINIT);
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_CallbackRegister(FlexCAN_Instance_e Ins, FlexCAN_CallbackType CallbackFunc,
+                      uint8_t CallbackID, void * Context)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    if(Ins > FlexCAN2_INS || CallbackID >= NUMBER_OF_CALLBACK)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+        FlexCAN_Host[Ins].Callback[CallbackID].Func = CallbackFunc;
+        FlexCAN_Host[Ins].Callback[CallbackID].Context = Context;
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetObserver(FlexCAN_Instance_e Ins, FlexCAN_ObserverType Observer)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    if(Ins > FlexCAN2_INS)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+        FlexCAN_Host[Ins].Observer = Observer;
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetRxMode(FlexCAN_Instance_e Ins, const FlexCAN_RxPollConfigType * Config)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+
+    if(Ins > FlexCAN2_INS || Config == NULL || Config->Mode > FlexCAN_RX_MODE_ADAPTIVE
+       || Config->Budget == 0U || Config->QuietPasses == 0U)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[Ins];
+
+        DISABLE_INTERRUPTS();
+
+        if((Config->MbMask & ((1UL << Host->FirstMb) - 1U)) != 0U)
+        {
+            /* Group overlaps the Rx FIFO */
+        }
+        else
+        {
+            if(Host->IsPolling == true)
+            {
+                Host->IMASK1 |= Host->PollGroup;
+            }
+
+            Host->RxMode = *Config;
+            Host->PollGroup = Host->IMASK1 & Config->MbMask;
+            Host->IsPolling = (Config->Mode == FlexCAN_RX_MODE_POLL);
+            Host->QuietCount = 0U;
+            Host->PollStats = (FlexCAN_RxPollStatsType){ 0U };
+
+            if(Host->IsPolling == true)
+            {
+                Host->IMASK1 &= ~Host->PollGroup;
+            }
+
+            /* Flags left by the previous mode interrupt now */
+            FlexCAN_HostDispatch(Host);
+
+            RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+        }
+
+        ENABLE_INTERRUPTS();
+    }
+
+    return RetVal;
+}
+
+uint8_t FlexCAN_RxPoll(FlexCAN_Instance_e Ins)
+{
+    uint8_t Served = 0U;
+
+    FlexCAN_HostType * Host = NULL;
+    uint32_t RaisedFlags = 0U;
+    uint32_t Now = 0U;
+    uint8_t MbIndex = 0U;
+
+    if(Ins > FlexCAN2_INS || FlexCAN_Host[Ins].IsPolling == false)
+    {
+        /* Invalid parameter or the interrupts serve the group */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[Ins];
+
+        DISABLE_INTERRUPTS();
+        RaisedFlags = Host->IFLAG1 & Host->PollGroup;
+        ENABLE_INTERRUPTS();
+
+        if(RaisedFlags != 0U)
+        {
+            Now = SimBus_Now();
+        }
+
+        while(RaisedFlags != 0U && Served < Host->RxMode.Budget)
+        {
+            MbIndex = (uint8_t)__builtin_ctz(RaisedFlags);
+            RaisedFlags &= (RaisedFlags - 1U);
+
+            DISABLE_INTERRUPTS();
+            FlexCAN_HostMbService(Host, MbIndex, Now);
+            ENABLE_INTERRUPTS();
+
+            Served++;
+        }
+
+        Host->PollStats.PollPasses++;
+        Host->PollStats.PollFrames += Served;
+
+        if(Host->RxMode.Mode == FlexCAN_RX_MODE_ADAPTIVE)
+        {
+            Host->QuietCount = (Served <= Host->RxMode.QuietFrames) ? (Host->QuietCount + 1U) : 0U;
+
+            if(Host->QuietCount >= Host->RxMode.QuietPasses)
+            {
+                /* A flag raised since the IFLAG1 read interrupts as soon as its mask is set */
+                DISABLE_INTERRUPTS();
+                Host->IsPolling = false;
+                Host->IMASK1 |= Host->PollGroup;
+                FlexCAN_HostDispatch(Host);
+                ENABLE_INTERRUPTS();
+            }
+        }
+    }
+
+    return Served;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetRxPollStats(FlexCAN_Instance_e Ins, FlexCAN_RxPollStatsType * Stats)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    if(Ins > FlexCAN2_INS || Stats == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+        *Stats = FlexCAN_Host[Ins].PollStats;
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_MbInit(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                    FlexCAN_MbHeaderType * FLexCAN_MbConfig)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint32_t ControlStatus = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || FLexCAN_MbConfig == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+
+        /* Same fields as the hardware driver */
+        ControlStatus = FLEXCAN_RAMn_DATA_WORD_0_EDL(FLexCAN_MbConfig->EDL) | FLEXCAN_RAMn_DATA_WORD_0_BRS(FLexCAN_MbConfig->BRS)
+                      | FLEXCAN_RAMn_DATA_WORD_0_ESI(FLexCAN_MbConfig->ESI) | FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK
+                      | FLEXCAN_RAMn_DATA_WORD_0_IDE(FLexCAN_MbConfig->IdType) | FLEXCAN_RAMn_DATA_WORD_0_RTR(FLexCAN_MbConfig->IsRemote)
+                      | FLEXCAN_RAMn_DATA_WORD_0_DLC(FLexCAN_MbConfig->DataLen)
+                      | FLEXCAN_RAMn_DATA_WORD_0_CODE((FLexCAN_MbConfig->MbType == FlexCAN_MB_TX) ? Tx_CODE_INACTIVE : Rx_CODE_EMPTY);
+
+        Mbx->Header[1] = FLEXCAN_MB_ID(FLexCAN_MbConfig->MbID, FLexCAN_MbConfig->IdType);
+        Mbx->Header[0] = ControlStatus;
+
+        FlexCAN_HostMbSetInterrupt(&FlexCAN_Host[FlexCAN_Ins], (uint8_t)MbIndex, FLexCAN_MbConfig->IsEnableMbInt);
+
+        if(FlexCAN_Host[FlexCAN_Ins].TxMb == (int)MbIndex)
+        {
+            FlexCAN_Host[FlexCAN_Ins].TxMb = NO_TX_MB;
+        }
+
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_MbDeInit(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins))
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        DISABLE_INTERRUPTS();
+
+        FlexCAN_HostMbSetInterrupt(Host, (uint8_t)MbIndex, false);
+
+        /* Out of the matching and the arbitration, a frame already on the bus no longer owns the MB */
+        FlexCAN_GetMb(FlexCAN_Ins, MbIndex)->Header[0] = FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_INACTIVE);
+        Host->IFLAG1 &= ~(1UL << MbIndex);
+        Host->TxMb = (Host->TxMb == (int)MbIndex) ? NO_TX_MB : Host->TxMb;
+
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_Transmit(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      uint8_t * MsgData)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint8_t DataLen = 0U;
+    uint8_t Index = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || MsgData == NULL)
+    {
+        /* Invalid parameters*/
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        DISABLE_INTERRUPTS();
+
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+        DataLen = (((Mbx->Header[0]) & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
+        DataLen = (DataLen > FLEXCAN_FRAME_MAX_DATA_LEN) ? FLEXCAN_FRAME_MAX_DATA_LEN : DataLen;
+
+        /* Clear Int Flag, the frame on the bus, if any, no longer owns the MB */
+        Host->IFLAG1 &= ~(1UL << MbIndex);
+        Host->TxMb = (Host->TxMb == (int)MbIndex) ? NO_TX_MB : Host->TxMb;
+
+        Mbx->Payload[0] = 0U;
+        Mbx->Payload[1] = 0U;
+
+        for(Index = 0U; Index < DataLen; Index++)
+        {
+            Mbx->Payload[Index / 4U] |= (uint32_t)MsgData[Index] << (8U * (3U - (Index % 4U)));
+        }
+
+        /* Start transmitting */
+        Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK;
+        Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_DATA);
+        Host->RequestTime[MbIndex] = SimBus_Now();
+
+        ENABLE_INTERRUPTS();
+
+        SimBus_Wakeup();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_TransmitFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      const FlexCAN_FrameType * Frame)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint32_t Word = 0U;
+    uint32_t ControlStatus = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || Frame == NULL || Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        DISABLE_INTERRUPTS();
+
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+
+        Host->IFLAG1 &= ~(1UL << MbIndex);
+        Host->TxMb = (Host->TxMb == (int)MbIndex) ? NO_TX_MB : Host->TxMb;
+
+        /* Message data to RAM, bus byte order is big endian in the MB words */
+        REV_BYTES_32(Frame->Data.Word[0], Word);
+        Mbx->Payload[0] = Word;
+        REV_BYTES_32(Frame->Data.Word[1], Word);
+        Mbx->Payload[1] = Word;
+
+        /* Keep the FD bits of the MB configuration, SRR must always be 1 */
+        ControlStatus = (Mbx->Header[0] & (FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK | FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK
+                                           | FLEXCAN_RAMn_DATA_WORD_0_ESI_MASK))
+                      | FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK
+                      | FLEXCAN_RAMn_DATA_WORD_0_DLC(Frame->DataLen)
+                      | FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_DATA);
+
+        if(Frame->IdType == FlexCAN_EXTENDED)
+        {
+            Mbx->Header[1] = FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Frame->Id);
+            ControlStatus |= FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK;
+        }
+        else
+        {
+            Mbx->Header[1] = FLEXCAN_RAMn_DATA_WORD_1_ID(Frame->Id);
+        }
+
+        Mbx->Header[0] = ControlStatus;
+        Host->RequestTime[MbIndex] = SimBus_Now();
+
+        ENABLE_INTERRUPTS();
+
+        SimBus_Wakeup();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_ReadFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      FlexCAN_FrameType * Frame)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    uint32_t Now = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || Frame == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+
+        FlexCAN_MbToFrame(FlexCAN_GetMb(FlexCAN_Ins, MbIndex), Frame);
+
+        Now = FlexCAN_GetTime(FlexCAN_Ins);
+        Frame->TimeStamp = FlexCAN_ExtendTimeStamp(Now, Frame->TimeStamp);
+        Frame->IsrTimeStamp = FlexCAN_ConsumeIsrTime(FlexCAN_Ins, MbIndex, Now);
+
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_TransmitFdFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      const FlexCAN_FdFrameType * Frame)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+    uint32_t * MbWords = NULL;
+    uint8_t Dlc = 0U;
+    uint8_t WordIndex = 0U;
+    uint8_t NoOfWords = 0U;
+    uint32_t Word = 0U;
+    uint32_t ControlStatus = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || Frame == NULL || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins)
+       || Frame->DataLen > (uint8_t)((FlexCAN_Host[FlexCAN_Ins].MbWords - MB_HEADER_WORDS) * 4U)
+       || (Frame->IsFd == false && Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN))
+    {
+        /* Invalid parameters or payload does not fit the message buffer */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        DISABLE_INTERRUPTS();
+
+        MbWords = (uint32_t *)FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+        Dlc = FlexCAN_LengthToDlc(Frame->DataLen);
+        NoOfWords = (FlexCAN_DlcToLength[Dlc] + 3U) / 4U;
+
+        /* Padding up to the DLC length never writes past the payload area of the MB */
+        if(NoOfWords > (uint8_t)(FlexCAN_Host[FlexCAN_Ins].MbWords - MB_HEADER_WORDS))
+        {
+            NoOfWords = (uint8_t)(FlexCAN_Host[FlexCAN_Ins].MbWords - MB_HEADER_WORDS);
+        }
+
+        Host->IFLAG1 &= ~(1UL << MbIndex);
+        Host->TxMb = (Host->TxMb == (int)MbIndex) ? NO_TX_MB : Host->TxMb;
+
+        for(WordIndex = 0U; WordIndex < NoOfWords; WordIndex++)
+        {
+            REV_BYTES_32(Frame->Data.Word[WordIndex], Word);
+            MbWords[MB_HEADER_WORDS + WordIndex] = Word;
+        }
+
+        ControlStatus = FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK
+                      | FLEXCAN_RAMn_DATA_WORD_0_DLC(Dlc)
+                      | FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_DATA);
+
+        if(Frame->IsFd == true)
+        {
+            ControlStatus |= FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK;
+
+            if(Frame->BitRateSwitch == true)
+            {
+                ControlStatus |= FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK;
+            }
+        }
+
+        if(Frame->IdType == FlexCAN_EXTENDED)
+        {
+            MbWords[1] = FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Frame->Id);
+            ControlStatus |= FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK;
+        }
+        else
+        {
+            MbWords[1] = FLEXCAN_RAMn_DATA_WORD_1_ID(Frame->Id);
+        }
+
+        MbWords[0] = ControlStatus;
+        Host->RequestTime[MbIndex] = SimBus_Now();
+
+        ENABLE_INTERRUPTS();
+
+        SimBus_Wakeup();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_ReadFdFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      FlexCAN_FdFrameType * Frame)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    const uint32_t * MbWords = NULL;
+    uint32_t ControlStatus = 0U;
+    uint32_t Identifier = 0U;
+    uint32_t Word = 0U;
+    uint32_t Now = 0U;
+    uint8_t WordIndex = 0U;
+    uint8_t NoOfWords = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || Frame == NULL || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins))
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+
+        MbWords = (const uint32_t *)FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+        ControlStatus = MbWords[0];
+        Identifier = MbWords[1];
+
+        Frame->IsFd = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK) != 0U);
+        Frame->BitRateSwitch = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK) != 0U);
+        Frame->ErrorPassive = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_ESI_MASK) != 0U);
+        Frame->TimeStamp = (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_SHIFT;
+        Frame->DataLen = FlexCAN_DlcToLength[(ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT];
+
+        if(Frame->IsFd == false && Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
+        {
+            Frame->DataLen = FLEXCAN_FRAME_MAX_DATA_LEN;
+        }
+
+        /* A DLC above the configured payload size only carries what fits the MB */
+        if(Frame->DataLen > (uint8_t)((FlexCAN_Host[FlexCAN_Ins].MbWords - MB_HEADER_WORDS) * 4U))
+        {
+            Frame->DataLen = (uint8_t)((FlexCAN_Host[FlexCAN_Ins].MbWords - MB_HEADER_WORDS) * 4U);
+        }
+
+        if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U)
+        {
+            Frame->IdType = FlexCAN_EXTENDED;
+            Frame->Id = (Identifier & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT;
+        }
+        else
+        {
+            Frame->IdType = FlexCAN_STANDARD;
+            Frame->Id = (Identifier & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT;
+        }
+
+        NoOfWords = (Frame->DataLen + 3U) / 4U;
+
+        for(WordIndex = 0U; WordIndex < NoOfWords; WordIndex++)
+        {
+            REV_BYTES_32(MbWords[MB_HEADER_WORDS + WordIndex], Word);
+            Frame->Data.Word[WordIndex] = Word;
+        }
+
+        Now = FlexCAN_GetTime(FlexCAN_Ins);
+        Frame->TimeStamp = FlexCAN_ExtendTimeStamp(Now, Frame->TimeStamp);
+        Frame->IsrTimeStamp = FlexCAN_ConsumeIsrTime(FlexCAN_Ins, MbIndex, Now);
+
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+uint32_t FlexCAN_GetTime(FlexCAN_Instance_e FlexCAN_Ins)
+{
+    uint32_t Now = 0U;
+
+    /* All controllers share the bus time, already 32 bits wide */
+    if(FlexCAN_Ins <= FlexCAN2_INS)
+    {
+        Now = SimBus_Now();
+    }
+
+    return Now;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetMbEventTime(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      uint32_t * WireTime, uint32_t * IsrTime)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || WireTime == NULL || IsrTime == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+        *WireTime = FlexCAN_Host[FlexCAN_Ins].MbEventTime[MbIndex].WireTime;
+        *IsrTime = FlexCAN_Host[FlexCAN_Ins].MbEventTime[MbIndex].IsrTime;
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+bool FlexCAN_CalcBitTiming(uint32_t ClkFreq, uint32_t BitRate, uint16_t SamplePoint, uint8_t Sjw, uint32_t * Cbt)
+{
+    bool IsFound = false;
+
+    /* The virtual bus has no time quanta, any valid request is met */
+    if(BitRate != 0U && Cbt != NULL && SamplePoint < 1000U && ClkFreq >= BitRate)
+    {
+        *Cbt = 0U;
+        IsFound = true;
+    }
+
+    return IsFound;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetRxFilters(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e FirstMb,
+                      const FlexCAN_RxFilterType * Filters, uint8_t NoOfFilters, bool IsEnableMbInt)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint8_t Index = 0U;
+    uint8_t MbIndex = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || Filters == NULL || NoOfFilters == 0U
+       || ((uint32_t)FirstMb + NoOfFilters) > FlexCAN_GetMbCount(FlexCAN_Ins)
+       || FirstMb < FlexCAN_Host[FlexCAN_Ins].FirstMb)
+    {
+        /* Invalid parameters, not enough message buffers or overlap with the Rx FIFO area */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        DISABLE_INTERRUPTS();
+
+        for(Index = 0U; Index < NoOfFilters; Index++)
+        {
+            MbIndex = (uint8_t)FirstMb + Index;
+            Mbx = FlexCAN_GetMb(FlexCAN_Ins, (FlexCAN_MbIndex_e)MbIndex);
+
+            if(Filters[Index].IdType == FlexCAN_EXTENDED)
+            {
+                Mbx->Header[1] = FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Filters[Index].Id);
+                Host->RXIMR[MbIndex] = FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Filters[Index].Mask);
+                Mbx->Header[0] = FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_EMPTY) | FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK
+                               | FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK;
+            }
+            else
+            {
+                Mbx->Header[1] = FLEXCAN_RAMn_DATA_WORD_1_ID(Filters[Index].Id);
+                Host->RXIMR[MbIndex] = FLEXCAN_RAMn_DATA_WORD_1_ID(Filters[Index].Mask);
+                Mbx->Header[0] = FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_EMPTY);
+            }
+
+            FlexCAN_HostMbSetInterrupt(Host, MbIndex, IsEnableMbInt);
+        }
+
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+bool FlexCAN_IsTxMbIdle(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex)
+{
+    bool IsIdle = false;
+
+    uint32_t Code = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins))
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+        Code = (FlexCAN_GetMb(FlexCAN_Ins, MbIndex)->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK)
+                                >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+        ENABLE_INTERRUPTS();
+
+        IsIdle = (Code == Tx_CODE_INACTIVE || Code == Tx_CODE_ABORT);
+    }
+
+    return IsIdle;
+}
+
+FlexCAN_TxAbort_e FlexCAN_AbortTx(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex)
+{
+    FlexCAN_TxAbort_e Result = FLEXCAN_TX_ABORT_IDLE;
+
+    FlexCAN_HostType * Host = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint32_t Code = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins))
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        DISABLE_INTERRUPTS();
+
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+        Code = (Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+
+        if(Code == Tx_CODE_DATA)
+        {
+            /* The bus runs under this lock, so the acknowledge is not waited for: a frame on the bus
+             * is taken as sent and no longer owns the MB, any other one is aborted */
+            Result = (Host->TxMb == (int)MbIndex) ? FLEXCAN_TX_ABORT_LATE : FLEXCAN_TX_ABORT_DONE;
+            Host->TxMb = (Host->TxMb == (int)MbIndex) ? NO_TX_MB : Host->TxMb;
+            Host->IFLAG1 &= ~(1UL << MbIndex);
+
+            Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK;
+            Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE((Result == FLEXCAN_TX_ABORT_DONE) ? Tx_CODE_ABORT : Tx_CODE_INACTIVE);
+        }
+
+        ENABLE_INTERRUPTS();
+    }
+
+    return Result;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetAnswerData(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      const uint8_t * Data, uint8_t DataLen)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint32_t ControlStatus = 0U;
+    uint32_t Code = 0U;
+    uint8_t Index = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || Data == NULL || DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        DISABLE_INTERRUPTS();
+
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+        ControlStatus = Mbx->Header[0];
+        Code = (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+
+        if(Code == Rx_CODE_RANSWER || Code == Tx_CODE_TANSWER || Code == Tx_CODE_INACTIVE)
+        {
+            /* An answer on the bus was copied out, the MB no longer owns it. A pending one is dropped */
+            Host->TxMb = (Host->TxMb == (int)MbIndex) ? NO_TX_MB : Host->TxMb;
+            Host->IFLAG1 &= ~(1UL << MbIndex);
+
+            Mbx->Payload[0] = 0U;
+            Mbx->Payload[1] = 0U;
+
+            for(Index = 0U; Index < DataLen; Index++)
+            {
+                Mbx->Payload[Index / 4U] |= (uint32_t)Data[Index] << (8U * (3U - (Index % 4U)));
+            }
+
+            Mbx->Header[0] = (ControlStatus & ~(FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK | FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK
+                                                | FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK))
+                           | FLEXCAN_RAMn_DATA_WORD_0_DLC(DataLen) | FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_RANSWER);
+
+            RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+        }
+
+        ENABLE_INTERRUPTS();
+    }
+
+    return RetVal;
+}
+
+uint8_t FlexCAN_GetMbCount(FlexCAN_Instance_e FlexCAN_Ins)
+{
+    uint8_t Count = 0U;
+
+    if(FlexCAN_Ins <= FlexCAN2_INS)
+    {
+        Count = (uint8_t)(FlexCAN_MbRamWords[FlexCAN_Ins] / ((FlexCAN_Host[FlexCAN_Ins].MbWords != 0U) ? FlexCAN_Host[FlexCAN_Ins].MbWords
+                                                                                     : (MB_HEADER_WORDS + 2U)));
+    }
+
+    return Count;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetMaxMb(FlexCAN_Instance_e FlexCAN_Ins, uint8_t MaxMb)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_HostType * Host = NULL;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || FlexCAN_CurrentState[FlexCAN_Ins] != FLEXCAN_STATE_READY
+       || MaxMb >= FlexCAN_GetMbCount(FlexCAN_Ins) || ((uint32_t)MaxMb + 1U) < FlexCAN_Host[FlexCAN_Ins].FirstMb)
+    {
+        /* Invalid parameters, driver not ready or Rx FIFO area not covered */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[FlexCAN_Ins];
+
+        /* The freeze mode window is not modelled, the bus runs under this lock */
+        DISABLE_INTERRUPTS();
+        Host->LastMb = MaxMb;
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_ReadMailboxData(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                             uint8_t * MsgData)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint8_t DataLen = 0U;
+    uint8_t Index = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || MsgData == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+        DataLen = (((Mbx->Header[0]) & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
+        DataLen = (DataLen > FLEXCAN_FRAME_MAX_DATA_LEN) ? FLEXCAN_FRAME_MAX_DATA_LEN : DataLen;
+
+        for(Index = 0U; Index < DataLen; Index++)
+        {
+            MsgData[Index] = (uint8_t)(Mbx->Payload[Index / 4U] >> (8U * (3U - (Index % 4U))));
+        }
+
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_RxFifoRead(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbStructureType * Record)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_RxFifoStateType * FifoState = NULL;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || Record == NULL || FlexCAN_Host[FlexCAN_Ins].RxFifo.Config == NULL)
+    {
+        /* Invalid parameters or Rx FIFO not configured */
+    }
+    else
+    {
+        FifoState = &FlexCAN_Host[FlexCAN_Ins].RxFifo;
+
+        DISABLE_INTERRUPTS();
+
+        if(FifoState->Produced != FifoState->Consumed)
+        {
+            *Record = FifoState->Config->RingBuffer[FifoState->Consumed % FifoState->Config->RingLength];
+            FifoState->Consumed++;
+
+            RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+        }
+        else
+        {
+            /* Ring is empty, the caller polls */
+            SimCore_Poll();
+        }
+
+        ENABLE_INTERRUPTS();
+    }
+
+    return RetVal;
+}
+
+uint32_t FlexCAN_RxFifoGetOverflowCount(FlexCAN_Instance_e FlexCAN_Ins)
+{
+    uint32_t Count = 0U;
+
+    if(FlexCAN_Ins <= FlexCAN2_INS)
+    {
+        Count = FlexCAN_Host[FlexCAN_Ins].RxFifo.OverflowCount;
+    }
+
+    return Count;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_RxFifoReadFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_FrameType * Frame)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_MbStructureType Record;
+    uint32_t BatchTime = 0U;
+
+    if(Frame == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        RetVal = FlexCAN_RxFifoRead(FlexCAN_Ins, &Record);
+
+        if(RetVal == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+        {
+            FlexCAN_MbToFrame(&Record, Frame);
+            Frame->TimeStamp = FlexCAN_ExtendTimeStamp(FlexCAN_GetTime(FlexCAN_Ins), Frame->TimeStamp);
+
+            /* Every stored frame closes a batch, the batch time is the handling time */
+            BatchTime = FlexCAN_Host[FlexCAN_Ins].RxFifo.BatchTime;
+            Frame->IsrTimeStamp = ((int32_t)(BatchTime - Frame->TimeStamp) >= 0) ? BatchTime : Frame->TimeStamp;
+        }
+        else
+        {
+            /* Ring is empty */
+        }
+    }
+
+    return RetVal;
+}
+
+FlexCAN_State_e FlexCAN_GetModuleState(FlexCAN_Instance_e Ins)
+{
+    return FlexCAN_CurrentState[Ins];
+}
+
+uint8_t FlexCAN_GetStatusFlag(FlexCAN_Instance_e Ins, FlexCAN_StatusFlag_e FlagType)
+{
+    uint8_t FlagValue = 0U;
+    uint32_t Esr1 = 0U;
+
+    DISABLE_INTERRUPTS();
+    Esr1 = FlexCAN_HostReadEsr1(&FlexCAN_Host[Ins]);
+    SimCore_Poll();
+    ENABLE_INTERRUPTS();
+
+    if(FlagType == FlexCAN_STATUS_FLAG_FLTCONF)
+    {
+        FlagValue = (Esr1 >> FlagType) & 0x3U;
+    }
+    else
+    {
+        FlagValue = (Esr1 >> FlagType) & SET;
+    }
+
+    return FlagValue;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetErrorState(FlexCAN_Instance_e Ins, FlexCAN_ErrorStateType * State)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+    FlexCAN_HostType * Host = NULL;
+
+    if(Ins > FlexCAN2_INS || State == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[Ins];
+
+        DISABLE_INTERRUPTS();
+
+        /* ECR holds 8 bits, TEC keeps counting past 255 only inside the bus-off decision */
+        State->Tec = (uint8_t)((Host->Tec > 0xFFU) ? 0xFFU : Host->Tec);
+        State->Rec = (uint8_t)((Host->Rec > 0xFFU) ? 0xFFU : Host->Rec);
+        State->Esr1 = FlexCAN_HostReadEsr1(Host);
+        SimCore_Poll();
+
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetBusOffRecovery(FlexCAN_Instance_e Ins, bool IsAutomatic)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+    FlexCAN_HostType * Host = NULL;
+
+    if(Ins > FlexCAN2_INS)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        Host = &FlexCAN_Host[Ins];
+
+        DISABLE_INTERRUPTS();
+
+        /* Releasing the hold while bus-off starts the 128 x 11 recessive bits count */
+        if(IsAutomatic == true && Host->IsRecoveryHeld == true && Host->IsBusOff == true)
+        {
+            Host->RecoveryStart = SimBus_Now();
+        }
+
+        Host->IsRecoveryHeld = !IsAutomatic;
+
+        ENABLE_INTERRUPTS();
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions: virtual bus controller, called from the bus thread
+   ---------------------------------------------------------------------------- */
+static bool FlexCAN_HostGetTx(void *Controller, SimBus_FrameType *Frame)
+{
+    FlexCAN_HostType * Host = (FlexCAN_HostType *)Controller;
+    SimBus_FrameType Candidate;
+    uint32_t BestKey = UINT32_MAX;
+    uint32_t Key = 0U;
+    uint32_t Code = 0U;
+    uint8_t MbIndex = 0U;
+
+    DISABLE_INTERRUPTS();
+
+    Host->TxMb = NO_TX_MB;
+
+    if(FlexCAN_CurrentState[Host->Ins] != FLEXCAN_STATE_UNINIT && Host->IsBusOff == false && Host->IsListenOnly == false)
+    {
+        /* CTRL1[LBUF] = 0: the lowest ID goes first, then the lowest MB */
+        for(MbIndex = Host->FirstMb; MbIndex <= Host->LastMb; MbIndex++)
+        {
+            Code = (FlexCAN_GetMb(Host->Ins, (FlexCAN_MbIndex_e)MbIndex)->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK)
+                   >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+
+            if(Code == Tx_CODE_DATA || Code == Tx_CODE_TANSWER)
+            {
+                FlexCAN_HostMbToBus(Host, MbIndex, &Candidate);
+                Key = SimBus_ArbitrationKey(&Candidate);
+
+                if(Host->TxMb == NO_TX_MB || Key < BestKey)
+                {
+                    BestKey = Key;
+                    Host->TxMb = MbIndex;
+                    *Frame = Candidate;
+                }
+            }
+        }
+    }
+
+    ENABLE_INTERRUPTS();
+
+    return (Host->TxMb != NO_TX_MB);
+}
+
+static void FlexCAN_HostTxDone(void *Controller, SimBus_TxResult_e Result, uint32_t Time)
+{
+    FlexCAN_HostType * Host = (FlexCAN_HostType *)Controller;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint32_t Code = 0U;
+
+    DISABLE_INTERRUPTS();
+
+    if(Result == SIM_BUS_TX_OK)
+    {
+        Host->Tec = (Host->Tec > 0U) ? (Host->Tec - 1U) : 0U;
+
+        if(Host->TxMb != NO_TX_MB)
+        {
+            /* Tx complete: the MB goes back to INACTIVE, a remote answer waits for the next request */
+            Mbx = FlexCAN_GetMb(Host->Ins, (FlexCAN_MbIndex_e)Host->TxMb);
+            Code = (Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+            Mbx->Header[0] &= ~(FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK | FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK);
+            Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE((Code == Tx_CODE_TANSWER) ? Rx_CODE_RANSWER : Tx_CODE_INACTIVE)
+                            | FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP(Time);
+            Host->IFLAG1 |= (1UL << Host->TxMb);
+        }
+    }
+    else
+    {
+        /* The frame stays pending and is retried. An error passive transmitter that only misses
+         * the ACK does not count it. */
+        Host->Esr1 |= FLEXCAN_ESR1_ERRINT_MASK
+                    | ((Result == SIM_BUS_TX_ACK_ERROR) ? FLEXCAN_ESR1_ACKERR_MASK : FLEXCAN_ESR1_BIT1ERR_MASK);
+
+        if(Result != SIM_BUS_TX_ACK_ERROR || Host->Tec < ERROR_PASSIVE_LIMIT)
+        {
+            Host->Tec += TEC_ERROR_STEP;
+        }
+    }
+
+    Host->TxMb = NO_TX_MB;
+
+    FlexCAN_HostFaultConfinement(Host, Time);
+    FlexCAN_HostDispatch(Host);
+
+    ENABLE_INTERRUPTS();
+}
+
+static void FlexCAN_HostRx(void *Controller, const SimBus_FrameType *Frame, bool IsValid, uint32_t Time)
+{
+    FlexCAN_HostType * Host = (FlexCAN_HostType *)Controller;
+
+    DISABLE_INTERRUPTS();
+
+    if(FlexCAN_CurrentState[Host->Ins] == FLEXCAN_STATE_UNINIT || Host->IsBusOff == true)
+    {
+        /* Not on the bus */
+    }
+    else if(IsValid == false)
+    {
+        /* Destroyed frame, every receiver sees the error */
+        Host->Esr1 |= FLEXCAN_ESR1_ERRINT_MASK | FLEXCAN_ESR1_CRCERR_MASK;
+        Host->Rec += (Host->IsListenOnly == false) ? 1U : 0U;
+
+        FlexCAN_HostFaultConfinement(Host, Time);
+        FlexCAN_HostDispatch(Host);
+    }
+    else
+    {
+        if(Host->IsListenOnly == false)
+        {
+            Host->Rec = (Host->Rec >= ERROR_PASSIVE_LIMIT) ? REC_PASSIVE_RESTART : ((Host->Rec > 0U) ? (Host->Rec - 1U) : 0U);
+        }
+
+        if(Frame->IsRemote == true)
+        {
+            /* CTRL2[RRS] = 0: remote requests are answered, not stored, unless the Rx FIFO takes them */
+            if(FlexCAN_HostRxFifoStore(Host, Frame, Time) == false)
+            {
+                FlexCAN_HostRemoteRequest(Host, Frame);
+            }
+        }
+        else if(FlexCAN_HostRxFifoStore(Host, Frame, Time) == false)
+        {
+            /* CTRL2[MRP] = 0: the Rx FIFO is matched first, then the mailboxes */
+            FlexCAN_HostRxMbStore(Host, Frame, Time);
+        }
+
+        FlexCAN_HostFaultConfinement(Host, Time);
+        FlexCAN_HostDispatch(Host);
+    }
+
+    ENABLE_INTERRUPTS();
+}
+
+static void FlexCAN_HostTick(void *Controller, uint32_t Time)
+{
+    FlexCAN_HostType * Host = (FlexCAN_HostType *)Controller;
+
+    DISABLE_INTERRUPTS();
+
+    if(Host->IsBusOff == true && Host->IsRecoveryHeld == false
+       && (Time - Host->RecoveryStart) >= SIM_BUS_RECOVERY_BITS)
+    {
+        /* 128 x 11 recessive bits seen, back to error active */
+        Host->IsBusOff = false;
+        Host->Tec = 0U;
+        Host->Rec = 0U;
+        Host->Esr1 |= FLEXCAN_ESR1_BOFFDONEINT_MASK;
+
+        FlexCAN_HostFaultConfinement(Host, Time);
+        FlexCAN_HostDispatch(Host);
+        SimBus_Wakeup();
+    }
+
+    ENABLE_INTERRUPTS();
+}
+
+static bool FlexCAN_HostIsOnline(void *Controller)
+{
+    FlexCAN_HostType * Host = (FlexCAN_HostType *)Controller;
+
+    return (FlexCAN_CurrentState[Host->Ins] != FLEXCAN_STATE_UNINIT && Host->IsBusOff == false && Host->IsListenOnly == false);
+}
+
+/* Same checks as the hardware driver */
+static bool FlexCAN_HostCheckMbLayout(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config)
+{
+    const FlexCAN_RxFifoConfigType * RxFifoConfig = FlexCAN_Config->RxFifoConfig;
+    const FlexCAN_FdConfigType * FdConfig = FlexCAN_Config->FdConfig;
+    uint8_t MbWords = MB_HEADER_WORDS + 2U;
+    uint8_t FirstMb = 0U;
+    uint8_t Index = 0U;
+    bool IsValid = (FlexCAN_Config->MbLayout != NULL || FlexCAN_Config->NoOfMbLayout == 0U);
+
+    if(RxFifoConfig != NULL && RxFifoConfig->Mode != FlexCAN_RXFIFO_DISABLE)
+    {
+        FirstMb = FLEXCAN_RXFIFO_FIRST_FREE_MB(RxFifoConfig->NoOfIdFilters);
+    }
+
+    if(FdConfig != NULL && FdConfig->Enable == true)
+    {
+        MbWords = (uint8_t)(MB_HEADER_WORDS + (2U << FdConfig->PayloadSize));
+    }
+
+    for(Index = 0U; Index < FlexCAN_Config->NoOfMbLayout && IsValid == true; Index++)
+    {
+        IsValid = (FlexCAN_Config->MbLayout[Index].MbIndex >= FirstMb
+                   && FlexCAN_Config->MbLayout[Index].MbIndex <= FlexCAN_Config->MaxNoMB
+                   && FlexCAN_Config->MbLayout[Index].MbIndex < (FlexCAN_MbRamWords[FlexCAN_Ins] / MbWords));
+    }
+
+    return IsValid;
+}
+
+/* The driver has one eDMA channel for the FIFO, owned by an instance until its de-init */
+static bool FlexCAN_HostIsDmaFree(FlexCAN_Instance_e FlexCAN_Ins)
+{
+    bool IsFree = true;
+    uint8_t Ins = 0U;
+
+    for(Ins = 0U; Ins < FLEXCAN_INSTANCE_COUNT; Ins++)
+    {
+        if(Ins != (uint8_t)FlexCAN_Ins && FlexCAN_CurrentState[Ins] != FLEXCAN_STATE_UNINIT
+           && FlexCAN_Host[Ins].RxFifo.Config != NULL && FlexCAN_Host[Ins].RxFifo.Config->UseDma == true)
+        {
+            IsFree = false;
+        }
+    }
+
+    return IsFree;
+}
+
+/* Same checks as the hardware driver, the host ring is filled by the CPU either way */
+static bool FlexCAN_HostCheckRxFifoConfig(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_RxFifoConfigType * RxFifoConfig)
+{
+    bool IsValid = true;
+
+    if(RxFifoConfig != NULL && RxFifoConfig->Mode != FlexCAN_RXFIFO_DISABLE)
+    {
+        IsValid = (RxFifoConfig->RingBuffer != NULL && RxFifoConfig->RingLength >= 2U
+                   && RxFifoConfig->NoOfIdFilters <= RXFIFO_MAX_ID_FILTERS
+                   && FLEXCAN_RXFIFO_FIRST_FREE_MB(RxFifoConfig->NoOfIdFilters) <= (FlexCAN_MbRamWords[FlexCAN_Ins] / (MB_HEADER_WORDS + 2U))
+                   && (RxFifoConfig->RingLength % 2U) == 0U
+                   && (RxFifoConfig->UseDma == false
+                       || (RxFifoConfig->DmaChannel == FLEXCAN_RXFIFO_DMA_CHANNEL && RxFifoConfig->RingLength <= DMA_CITER_MAX
+                           && FlexCAN_HostIsDmaFree(FlexCAN_Ins) == true)));
+    }
+
+    return IsValid;
+}
+
+static void FlexCAN_HostRxFifoInit(FlexCAN_HostType *Host, const FlexCAN_RxFifoConfigType * RxFifoConfig)
+{
+    FlexCAN_RxFifoStateType * FifoState = &Host->RxFifo;
+    const FlexCAN_RxFifoIdFilterType * Filter = NULL;
+    uint32_t Index = 0U;
+
+    FifoState->Produced = 0U;
+    FifoState->Consumed = 0U;
+    FifoState->OverflowCount = 0U;
+
+    if(RxFifoConfig == NULL || RxFifoConfig->Mode == FlexCAN_RXFIFO_DISABLE
+       || RxFifoConfig->RingBuffer == NULL || RxFifoConfig->RingLength < 2U)
+    {
+        /* MB0-MB7 stay regular mailboxes */
+        FifoState->Config = NULL;
+        Host->FirstMb = 0U;
+    }
+    else
+    {
+        /* Filter table in element layout, like FlexCAN_RxFifoSetFilterTable */
+        FifoState->NoOfElements = (FLEXCAN_RXFIFO_RFFN(RxFifoConfig->NoOfIdFilters) + 1U) * 8U;
+
+        for(Index = 0U; Index < FifoState->NoOfElements; Index++)
+        {
+            if(RxFifoConfig->NoOfIdFilters == 0U || RxFifoConfig->IdFilterTable == NULL)
+            {
+                FifoState->Element[Index] = 0U;
+                FifoState->ElementMask[Index] = RxFifoConfig->GlobalMask;
+            }
+            else
+            {
+                Filter = &RxFifoConfig->IdFilterTable[(Index < RxFifoConfig->NoOfIdFilters) ? Index : (RxFifoConfig->NoOfIdFilters - 1U)];
+
+                FifoState->Element[Index] = ((Filter->IdType == FlexCAN_EXTENDED)
+                                             ? (FLEXCAN_RXFIFO_ID_FILTER_IDE_MASK
+                                                | ((Filter->Id << FLEXCAN_RXFIFO_ID_FILTER_EXT_SHIFT) & FLEXCAN_RXFIFO_ID_FILTER_EXT_MASK))
+                                             : ((Filter->Id << FLEXCAN_RXFIFO_ID_FILTER_STD_SHIFT) & FLEXCAN_RXFIFO_ID_FILTER_STD_MASK))
+                                          | ((Filter->IsRemote == true) ? FLEXCAN_RXFIFO_ID_FILTER_RTR_MASK : 0U);
+
+                FifoState->ElementMask[Index] = (Filter->Mask == 0U) ? RxFifoConfig->GlobalMask
+                                              : ((Filter->IdType == FlexCAN_EXTENDED) ? FLEXCAN_RXFIFO_EXT_MASK(Filter->Mask)
+                                                                                    : FLEXCAN_RXFIFO_STD_MASK(Filter->Mask));
+            }
+
+            /* Only the first 32 elements have an individual mask */
+            FifoState->ElementMask[Index] = (Index < RXIMR_COUNT) ? FifoState->ElementMask[Index] : RxFifoConfig->GlobalMask;
+        }
+
+        FifoState->Config = RxFifoConfig;
+        Host->FirstMb = (uint8_t)FLEXCAN_RXFIFO_FIRST_FREE_MB(RxFifoConfig->NoOfIdFilters);
+    }
+}
+
+static bool FlexCAN_HostRxFifoStore(FlexCAN_HostType *Host, const SimBus_FrameType *Frame, uint32_t Time)
+{
+    FlexCAN_RxFifoStateType * FifoState = &Host->RxFifo;
+    const FlexCAN_RxFifoConfigType * FifoConfig = FifoState->Config;
+    FlexCAN_MbStructureType Dropped;
+    FlexCAN_MbStructureType * Record = &Dropped;
+    uint32_t Key = 0U;
+    uint32_t Index = 0U;
+    bool IsAccepted = false;
+
+    if(FifoConfig != NULL)
+    {
+        Key = (Frame->IsRemote ? FLEXCAN_RXFIFO_ID_FILTER_RTR_MASK : 0U)
+            | (Frame->IsExtended ? (FLEXCAN_RXFIFO_ID_FILTER_IDE_MASK
+                                    | ((Frame->Id << FLEXCAN_RXFIFO_ID_FILTER_EXT_SHIFT) & FLEXCAN_RXFIFO_ID_FILTER_EXT_MASK))
+                                 : ((Frame->Id << FLEXCAN_RXFIFO_ID_FILTER_STD_SHIFT) & FLEXCAN_RXFIFO_ID_FILTER_STD_MASK));
+
+        for(Index = 0U; Index < FifoState->NoOfElements && IsAccepted == false; Index++)
+        {
+            IsAccepted = (((Key ^ FifoState->Element[Index]) & FifoState->ElementMask[Index]) == 0U);
+        }
+    }
+
+    if(IsAccepted == true)
+    {
+        if((FifoState->Produced - FifoState->Consumed) < FifoConfig->RingLength)
+        {
+            Record = &FifoConfig->RingBuffer[FifoState->Produced % FifoConfig->RingLength];
+            FifoState->Produced++;
+        }
+        else
+        {
+            /* Ring full, the frame is dropped */
+            FifoState->OverflowCount++;
+        }
+
+        FlexCAN_HostBusToWords(Frame, Time, (uint32_t *)Record, 2U);
+
+        if(Host->Observer != NULL)
+        {
+            Host->Observer(Host->Ins, FLEXCAN_EVENT_RX, Record, Time);
+        }
+
+        /* Every frame closes a batch, with or without eDMA */
+        FifoState->BatchTime = Time;
+
+        if(FifoConfig->BatchCallback != NULL)
+        {
+            FifoConfig->BatchCallback(Host->Ins, MB5, FifoConfig->BatchContext);
+        }
+    }
+
+    return IsAccepted;
+}
+
+static void FlexCAN_HostRxMbStore(FlexCAN_HostType *Host, const SimBus_FrameType *Frame, uint32_t Time)
+{
+    uint32_t * MbWords = NULL;
+    uint32_t IdWord = Frame->IsExtended ? FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Frame->Id) : FLEXCAN_RAMn_DATA_WORD_1_ID(Frame->Id);
+    uint32_t Code = 0U;
+    int Target = NO_TX_MB;
+    int LastMatch = NO_TX_MB;
+    uint8_t MbIndex = 0U;
+
+    /* MCR[IRMQ] = 1: first free matching MB, else the last match is overrun */
+    for(MbIndex = Host->FirstMb; MbIndex <= Host->LastMb && Target == NO_TX_MB; MbIndex++)
+    {
+        MbWords = (uint32_t *)FlexCAN_GetMb(Host->Ins, (FlexCAN_MbIndex_e)MbIndex);
+        Code = (MbWords[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+
+        if((Code == Rx_CODE_EMPTY || Code == Rx_CODE_FULL || Code == Rx_CODE_OVERRUN)
+           && ((MbWords[0] & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U) == Frame->IsExtended
+           && ((IdWord ^ MbWords[1]) & Host->RXIMR[MbIndex] & MB_ID_BITS_MASK) == 0U)
+        {
+            LastMatch = MbIndex;
+
+            /* A full MB whose flag was cleared has been serviced */
+            if(Code == Rx_CODE_EMPTY || (Host->IFLAG1 & (1UL << MbIndex)) == 0U)
+            {
+                Target = MbIndex;
+            }
+        }
+    }
+
+    Code = Rx_CODE_FULL;
+    if(Target == NO_TX_MB && LastMatch != NO_TX_MB)
+    {
+        Target = LastMatch;
+        Code = Rx_CODE_OVERRUN;
+    }
+
+    if(Target != NO_TX_MB)
+    {
+        MbWords = (uint32_t *)FlexCAN_GetMb(Host->Ins, (FlexCAN_MbIndex_e)Target);
+        FlexCAN_HostBusToWords(Frame, Time, MbWords, (uint8_t)(Host->MbWords - MB_HEADER_WORDS));
+        MbWords[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE(Code);
+        Host->IFLAG1 |= (1UL << Target);
+    }
+}
+
+static void FlexCAN_HostRemoteRequest(FlexCAN_HostType *Host, const SimBus_FrameType *Frame)
+{
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint32_t IdWord = Frame->IsExtended ? FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Frame->Id) : FLEXCAN_RAMn_DATA_WORD_1_ID(Frame->Id);
+    uint8_t MbIndex = 0U;
+    bool IsAnswered = false;
+
+    /* A RANSWER MB with the same ID sends its data frame */
+    for(MbIndex = Host->FirstMb; MbIndex <= Host->LastMb && IsAnswered == false; MbIndex++)
+    {
+        Mbx = FlexCAN_GetMb(Host->Ins, (FlexCAN_MbIndex_e)MbIndex);
+
+        if(((Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT) == Rx_CODE_RANSWER
+           && ((Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U) == Frame->IsExtended
+           && ((IdWord ^ Mbx->Header[1]) & MB_ID_BITS_MASK) == 0U)
+        {
+            Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK;
+            Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_TANSWER);
+            Host->RequestTime[MbIndex] = SimBus_Now();
+            IsAnswered = true;
+        }
+    }
+
+    if(IsAnswered == true)
+    {
+        SimBus_Wakeup();
+    }
+}
+
+static void FlexCAN_HostMbToBus(FlexCAN_HostType *Host, uint8_t MbIndex, SimBus_FrameType *Frame)
+{
+    const uint32_t * MbWords = (const uint32_t *)FlexCAN_GetMb(Host->Ins, (FlexCAN_MbIndex_e)MbIndex);
+    uint32_t ControlStatus = MbWords[0];
+    uint32_t Code = (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+    uint8_t Index = 0U;
+
+    Frame->IsExtended = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U);
+    Frame->Id = Frame->IsExtended ? (MbWords[1] & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK)
+                                  : ((MbWords[1] & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT);
+    Frame->IsRemote = (Code != Tx_CODE_TANSWER && (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK) != 0U);
+    Frame->IsFd = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK) != 0U);
+    Frame->BitRateSwitch = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK) != 0U);
+    Frame->DataLen = FlexCAN_DlcToLength[(ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT];
+    Frame->DataLen = (Frame->IsFd == false && Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN) ? FLEXCAN_FRAME_MAX_DATA_LEN : Frame->DataLen;
+    Frame->RequestTime = Host->RequestTime[MbIndex];
+
+    for(Index = 0U; Index < Frame->DataLen; Index++)
+    {
+        Frame->Data[Index] = (uint8_t)(MbWords[MB_HEADER_WORDS + (Index / 4U)] >> (8U * (3U - (Index % 4U))));
+    }
+}
+
+static void FlexCAN_HostBusToWords(const SimBus_FrameType *Frame, uint32_t Time, uint32_t * Words, uint8_t NoOfPayloadWords)
+{
+    uint8_t Dlc = FlexCAN_LengthToDlc(Frame->DataLen);
+    uint8_t Index = 0U;
+
+    Words[0] = FLEXCAN_RAMn_DATA_WORD_0_DLC(Dlc) | FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP(Time)
+             | (Frame->IsExtended ? (FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK | FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK) : 0U)
+             | (Frame->IsRemote ? FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK : 0U)
+             | (Frame->IsFd ? FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK : 0U)
+             | (Frame->BitRateSwitch ? FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK : 0U);
+    Words[1] = Frame->IsExtended ? FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Frame->Id) : FLEXCAN_RAMn_DATA_WORD_1_ID(Frame->Id);
+
+    for(Index = 0U; Index < NoOfPayloadWords; Index++)
+    {
+        Words[MB_HEADER_WORDS + Index] = 0U;
+    }
+
+    /* Bytes that do not fit the MB payload are lost, like on the hardware */
+    for(Index = 0U; Index < Frame->DataLen && Index < (NoOfPayloadWords * 4U); Index++)
+    {
+        Words[MB_HEADER_WORDS + (Index / 4U)] |= (uint32_t)Frame->Data[Index] << (8U * (3U - (Index % 4U)));
+    }
+}
+
+static void FlexCAN_HostFaultConfinement(FlexCAN_HostType *Host, uint32_t Time)
+{
+    uint32_t Status = 0U;
+
+    if(Host->IsBusOff == false && Host->Tec >= BUS_OFF_LIMIT)
+    {
+        /* Bus-off: the recovery count starts now unless CTRL1[BOFFREC] holds it */
+        Host->IsBusOff = true;
+        Host->Rec = 0U;
+        Host->RecoveryStart = Time;
+        Host->Esr1 |= FLEXCAN_ESR1_BOFFINT_MASK;
+        SimBus_Wakeup();
+    }
+
+    /* Warning status bits, their interrupt flags are set on the rising edge */
+    Status = ((Host->IsBusOff == false && Host->Tec >= ERROR_WARNING_LIMIT) ? FLEXCAN_ESR1_TXWRN_MASK : 0U)
+           | ((Host->IsBusOff == false && Host->Rec >= ERROR_WARNING_LIMIT) ? FLEXCAN_ESR1_RXWRN_MASK : 0U);
+
+    if((Status & ~Host->Esr1 & FLEXCAN_ESR1_TXWRN_MASK) != 0U)
+    {
+        Host->Esr1 |= FLEXCAN_ESR1_TWRNINT_MASK;
+    }
+
+    if((Status & ~Host->Esr1 & FLEXCAN_ESR1_RXWRN_MASK) != 0U)
+    {
+        Host->Esr1 |= FLEXCAN_ESR1_RWRNINT_MASK;
+    }
+
+    Host->Esr1 = (Host->Esr1 & ~(FLEXCAN_ESR1_TXWRN_MASK | FLEXCAN_ESR1_RXWRN_MASK | FLEXCAN_ESR1_FLTCONF_MASK)) | Status
+               | FLEXCAN_ESR1_FLTCONF(Host->IsBusOff ? FLTCONF_BUS_OFF
+                                      : ((Host->Tec >= ERROR_PASSIVE_LIMIT || Host->Rec >= ERROR_PASSIVE_LIMIT
+                                          || Host->IsListenOnly == true) ? FLTCONF_PASSIVE : 0U));
+}
+
+static void FlexCAN_HostDispatch(FlexCAN_HostType *Host)
+{
+    FlexCAN_Instance_e Ins = Host->Ins;
+    uint32_t RaisedFlags = 0U;
+    uint32_t Now = 0U;
+    uint8_t MbIndex = 0U;
+
+    /* Error interrupt, CTRL1[ERRMSK] */
+    if((Host->Esr1 & FLEXCAN_ESR1_ERRINT_MASK) != 0U && Host->IntControl.IntError == FlexCAN_INT_ERROR_ENABLE)
+    {
+        if(Host->Observer != NULL)
+        {
+            Host->Observer(Ins, FLEXCAN_EVENT_ERROR, NULL, SimBus_Now());
+        }
+
+        if(Host->Callback[FLEXCAN_ERROR_CALLBACK_ID].Func != NULL)
+        {
+            Host->Callback[FLEXCAN_ERROR_CALLBACK_ID].Func(Ins, FLEXCAN_ERROR_CALLBACK_ID, Host->Callback[FLEXCAN_ERROR_CALLBACK_ID].Context);
+        }
+
+        Host->Esr1 &= ~ERROR_INT;
+    }
+
+    /* Bus-off, bus-off done and warning interrupts share the ORed vector */
+    if(((Host->Esr1 & (FLEXCAN_ESR1_BOFFINT_MASK | FLEXCAN_ESR1_BOFFDONEINT_MASK)) != 0U
+        && Host->IntControl.IntBusOff == FlexCAN_INT_BUSOFF_ENABLE)
+       || ((Host->Esr1 & FLEXCAN_ESR1_TWRNINT_MASK) != 0U && Host->IntControl.IntTxWarning == FlexCAN_INT_TxWARNING_ENABLE)
+       || ((Host->Esr1 & FLEXCAN_ESR1_RWRNINT_MASK) != 0U && Host->IntControl.IntRxWarning == FlexCAN_INT_RxWARNING_ENABLE))
+    {
+        if(Host->Callback[FLEXCAN_ORED_CALLBACK_ID].Func != NULL)
+        {
+            Host->Callback[FLEXCAN_ORED_CALLBACK_ID].Func(Ins, FLEXCAN_ORED_CALLBACK_ID, Host->Callback[FLEXCAN_ORED_CALLBACK_ID].Context);
+        }
+
+        Host->Esr1 &= ~BUS_OFF_INT;
+    }
+
+    /* MB interrupts, MB0-MB7 belong to the Rx FIFO when it is enabled */
+    RaisedFlags = Host->IFLAG1 & Host->IMASK1 & ~((1UL << Host->FirstMb) - 1U);
+
+    if(RaisedFlags != 0U)
+    {
+        Now = SimBus_Now();
+        Host->PollStats.IrqEntries++;
+
+        if(Host->RxMode.Mode == FlexCAN_RX_MODE_ADAPTIVE && (RaisedFlags & Host->PollGroup) != 0U)
+        {
+            Host->IMASK1 &= ~Host->PollGroup;
+            Host->IsPolling = true;
+            Host->QuietCount = 0U;
+            Host->PollStats.Switches++;
+        }
+    }
+
+    while(RaisedFlags != 0U)
+    {
+        MbIndex = (uint8_t)__builtin_ctz(RaisedFlags);
+        RaisedFlags &= (RaisedFlags - 1U);
+
+        FlexCAN_HostMbService(Host, MbIndex, Now);
+        Host->PollStats.IrqFrames++;
+    }
+}
+
+static void FlexCAN_HostMbService(FlexCAN_HostType *Host, uint8_t MbIndex, uint32_t Now)
+{
+    FlexCAN_Instance_e Ins = Host->Ins;
+    const FlexCAN_MbStructureType * Mbx = FlexCAN_GetMb(Ins, (FlexCAN_MbIndex_e)MbIndex);
+    FlexCAN_MbEventTimeType * EventTime = &Host->MbEventTime[MbIndex];
+    FlexCAN_Event_e Event = FLEXCAN_EVENT_RX;
+
+    EventTime->WireTime = FlexCAN_ExtendTimeStamp(Now, Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK);
+    EventTime->IsrTime = Now;
+    EventTime->IsPending = true;
+
+    if(Host->Observer != NULL)
+    {
+        Event = ((Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_INACTIVE)) != 0U) ? FLEXCAN_EVENT_TX : FLEXCAN_EVENT_RX;
+        Host->Observer(Ins, Event, Mbx, EventTime->WireTime);
+    }
+
+    if(Host->Callback[MbIndex].Func != NULL)
+    {
+        Host->Callback[MbIndex].Func(Ins, MbIndex, Host->Callback[MbIndex].Context);
+    }
+
+    Host->IFLAG1 &= ~(1UL << MbIndex);
+}
+
+static void FlexCAN_HostMbSetInterrupt(FlexCAN_HostType *Host, uint8_t MbIndex, bool IsEnableMbInt)
+{
+    if(IsEnableMbInt == false)
+    {
+        Host->IMASK1 &= ~(1UL << MbIndex);
+    }
+    else if(Host->IsPolling == false || (Host->PollGroup & (1UL << MbIndex)) == 0U)
+    {
+        Host->IMASK1 |= (1UL << MbIndex);
+    }
+    else
+    {
+        /* Mailbox of a polled group, its interrupt comes back with the group's */
+    }
+}
+
+static uint32_t FlexCAN_HostReadEsr1(FlexCAN_HostType *Host)
+{
+    uint32_t Esr1 = Host->Esr1;
+
+    /* The error bits are cleared by the read */
+    Host->Esr1 &= ~ESR1_ERROR_BITS;
+
+    return Esr1;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions shared with FlexCAN.c
+   ---------------------------------------------------------------------------- */
+static void FlexCAN_SetModuleState(FlexCAN_Instance_e Ins, FlexCAN_State_e Transition)
+{
+    FlexCAN_CurrentState[Ins] = Transition;
+}
+
+static void FlexCAN_MbToFrame(const volatile FlexCAN_MbStructureType * Mbx, FlexCAN_FrameType * Frame)
+{
+    uint32_t ControlStatus = Mbx->Header[0];
+    uint32_t Identifier = Mbx->Header[1];
+    uint32_t Word = 0U;
+
+    if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U)
+    {
+        Frame->IdType = FlexCAN_EXTENDED;
+        Frame->Id = (Identifier & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT;
+    }
+    else
+    {
+        Frame->IdType = FlexCAN_STANDARD;
+        Frame->Id = (Identifier & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT;
+    }
+
+    Frame->DataLen = (uint8_t)((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
+    Frame->TimeStamp = (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_SHIFT;
+
+    if(Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
+    {
+        Frame->DataLen = FLEXCAN_FRAME_MAX_DATA_LEN;
+    }
+
+    REV_BYTES_32(Mbx->Payload[0], Word);
+    Frame->Data.Word[0] = Word;
+    REV_BYTES_32(Mbx->Payload[1], Word);
+    Frame->Data.Word[1] = Word;
+}
+
+static uint32_t FlexCAN_ExtendTimeStamp(uint32_t Now, uint32_t TimeStamp)
+{
+    /* The stamp is in the past: go back from now by the 16-bit distance */
+    return Now - (uint16_t)((uint16_t)Now - (uint16_t)TimeStamp);
+}
+
+static uint32_t FlexCAN_ConsumeIsrTime(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, uint32_t Now)
+{
+    FlexCAN_MbEventTimeType * EventTime = &FlexCAN_Host[FlexCAN_Ins].MbEventTime[MbIndex];
+    uint32_t IsrTime = Now;
+
+    /* Polled reads have no interrupt time, the read itself handles the frame */
+    if(EventTime->IsPending == true)
+    {
+        IsrTime = EventTime->IsrTime;
+        EventTime->IsPending = false;
+    }
+
+    return IsrTime;
+}
+
+static FlexCAN_MbStructureType * FlexCAN_GetMb(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex)
+{
+    FlexCAN_HostType * Host = &FlexCAN_Host[FlexCAN_Ins];
+    uint8_t MbWords = (Host->MbWords != 0U) ? Host->MbWords : (MB_HEADER_WORDS + 2U);
+
+    return (FlexCAN_MbStructureType *)&Host->RAMn[((uint32_t)MbIndex * MbWords) % MB_RAM_WORDS];
+}
+
+static uint8_t FlexCAN_LengthToDlc(uint8_t DataLen)
+{
+    uint8_t Dlc = 0U;
+
+    while(Dlc < (FD_DLC_COUNT - 1U) && FlexCAN_DlcToLength[Dlc] < DataLen)
+    {
+        Dlc++;
+    }
+
+    return Dlc;
+}
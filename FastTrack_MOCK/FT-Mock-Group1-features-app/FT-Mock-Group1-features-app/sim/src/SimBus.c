@@ -0,0 +1,665 @@
+/*
+ * SimBus.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Virtual CAN bus: arbitration, bit-exact frame length with stuffing, acknowledge and error
+ * injection, paced against the wall clock. Also runs the periodic timers of the simulated
+ * peripherals and keeps the statistics printed by sim_can.
+ */
+
+#include "SimBus.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define SIM_BUS_CRC15_POLY              0x4599U
+#define SIM_BUS_MAX_FRAME_BITS          (64U + (SIM_BUS_MAX_DATA_LEN * 8U) + 32U)
+#define SIM_BUS_STUFF_LIMIT             5U     /*!< Same-level bits before a stuff bit */
+#define SIM_BUS_TRAILER_BITS            10U    /*!< CRC delimiter, ACK slot, ACK delimiter, EOF */
+#define SIM_BUS_IFS_BITS                3U     /*!< Intermission */
+#define SIM_BUS_ERROR_FRAME_BITS        14U    /*!< Error flag and error delimiter */
+#define SIM_BUS_FD_STUFF_COUNT_BITS     4U     /*!< Stuff count and its parity */
+#define SIM_BUS_IDLE_WAIT_NS            1000000L
+#define SIM_BUS_MAX_IDS                 64U
+#define SIM_TIMER_COUNT                 16U
+#define SIM_NS_PER_S                    1000000000ULL
+#define SIM_NS_PER_US                   1000ULL
+#define SIM_PPM                         1000000U
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+typedef struct
+{
+    const SimBus_ControllerOps * Ops;
+    void                       * Controller;
+    const char                 * Name;
+    uint32_t                     TxFrames;       /*!< Frames sent and acknowledged */
+    uint32_t                     TxErrors;       /*!< Frames lost to an error or a missing ACK */
+} SimBus_NodeType;
+
+typedef struct
+{
+    uint32_t                     Id;
+    bool                         IsExtended;
+    uint32_t                     Sender;         /*!< Node index of the last sender */
+    uint32_t                     Frames;
+    uint64_t                     LatencySum;     /*!< Request to end of frame, bit times */
+    uint32_t                     LatencyMin;
+    uint32_t                     LatencyMax;
+} SimBus_IdStatsType;
+
+typedef struct
+{
+    bool                         IsActive;
+    uint64_t                     PeriodNs;
+    uint64_t                     NextNs;
+    void                      (* Func)(void *Arg);
+    void                       * Arg;
+} SimTimer_Type;
+
+/*==================================================================================================
+*                                       VARIABLES
+==================================================================================================*/
+
+static SimBus_ConfigType SimBus_Config;
+static struct timespec SimBus_StartTime;
+
+static pthread_mutex_t SimBus_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t SimBus_Event;
+static bool SimBus_IsPending = false;
+static volatile bool SimBus_IsRunning = false;
+static pthread_t SimBus_Thread;
+static bool SimBus_IsVerbose = false;
+static uint32_t SimBus_Seed = 1U;
+
+static SimBus_NodeType SimBus_Nodes[SIM_BUS_MAX_CONTROLLERS];
+static volatile uint32_t SimBus_NoOfNodes = 0U;
+
+/* Statistics, written by the bus thread only */
+static SimBus_IdStatsType SimBus_IdStats[SIM_BUS_MAX_IDS];
+static uint32_t SimBus_NoOfIds = 0U;
+static uint64_t SimBus_BusyBits = 0U;
+static uint32_t SimBus_Frames = 0U;
+static uint32_t SimBus_ErrorFrames = 0U;
+static uint32_t SimBus_AckErrors = 0U;
+
+static pthread_mutex_t SimTimer_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t SimTimer_Event;
+static SimTimer_Type SimTimer_List[SIM_TIMER_COUNT];
+static pthread_t SimTimer_Thread;
+
+static const uint8_t SimBus_DlcToLength[16U] = { 0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static uint64_t SimBus_ElapsedNs(void);
+static void SimBus_AbsTime(uint64_t ElapsedNs, struct timespec *Time);
+static uint64_t SimBus_BitsToNs(uint32_t Bits);
+static uint32_t SimBus_FrameBits(const SimBus_FrameType *Frame);
+static uint8_t SimBus_LengthToDlc(uint8_t DataLen);
+static void SimBus_PushBits(uint8_t *Bits, uint32_t *NoOfBits, uint32_t Value, uint8_t Width);
+static void SimBus_Trace(uint32_t Node, const SimBus_FrameType *Frame, uint32_t Time, SimBus_TxResult_e Result);
+static void SimBus_UpdateStats(uint32_t Node, const SimBus_FrameType *Frame, uint32_t EndTime);
+static void * SimBus_Main(void *Arg);
+static void * SimTimer_Main(void *Arg);
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+void SimBus_Start(const SimBus_ConfigType *Config, bool IsVerbose)
+{
+    pthread_condattr_t Attr;
+
+    SimBus_Config = *Config;
+    SimBus_IsVerbose = IsVerbose;
+
+    /* Conditions wait on the monotonic clock, like the pacing sleeps */
+    pthread_condattr_init(&Attr);
+    pthread_condattr_setclock(&Attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&SimBus_Event, &Attr);
+    pthread_cond_init(&SimTimer_Event, &Attr);
+    pthread_condattr_destroy(&Attr);
+
+    clock_gettime(CLOCK_MONOTONIC, &SimBus_StartTime);
+
+    SimBus_IsRunning = true;
+    pthread_create(&SimBus_Thread, NULL, SimBus_Main, NULL);
+    pthread_create(&SimTimer_Thread, NULL, SimTimer_Main, NULL);
+}
+
+void SimBus_Stop(void)
+{
+    SimBus_IsRunning = false;
+
+    pthread_mutex_lock(&SimBus_Lock);
+    pthread_cond_signal(&SimBus_Event);
+    pthread_mutex_unlock(&SimBus_Lock);
+
+    /* The node threads never return, the timers stop with the process */
+    pthread_join(SimBus_Thread, NULL);
+}
+
+int SimBus_Attach(const SimBus_ControllerOps *Ops, void *Controller, const char *Name)
+{
+    int Index = -1;
+
+    pthread_mutex_lock(&SimBus_Lock);
+
+    if(Ops != NULL && SimBus_NoOfNodes < SIM_BUS_MAX_CONTROLLERS)
+    {
+        Index = (int)SimBus_NoOfNodes;
+        SimBus_Nodes[Index].Ops = Ops;
+        SimBus_Nodes[Index].Controller = Controller;
+        SimBus_Nodes[Index].Name = Name;
+
+        /* Published last, the bus thread reads the count without the lock */
+        __atomic_store_n(&SimBus_NoOfNodes, SimBus_NoOfNodes + 1U, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        /* Invalid parameters or bus full */
+    }
+
+    pthread_mutex_unlock(&SimBus_Lock);
+
+    return Index;
+}
+
+uint32_t SimBus_ArbitrationKey(const SimBus_FrameType *Frame)
+{
+    uint32_t Key = 0U;
+
+    if(Frame->IsExtended == true)
+    {
+        /* Base ID, SRR (recessive), IDE (recessive), ID extension, RTR */
+        Key = ((Frame->Id >> 18U) << 21U) | (1UL << 20U) | (1UL << 19U) | ((Frame->Id & 0x3FFFFU) << 1U)
+            | (Frame->IsRemote ? 1U : 0U);
+    }
+    else
+    {
+        /* Base ID, RTR, IDE (dominant), nothing left to compare */
+        Key = ((Frame->Id & 0x7FFU) << 21U) | (Frame->IsRemote ? (1UL << 20U) : 0U);
+    }
+
+    return Key;
+}
+
+uint32_t SimBus_Now(void)
+{
+    return (uint32_t)((SimBus_ElapsedNs() * SimBus_Config.BitRate) / SIM_NS_PER_S);
+}
+
+void SimBus_Wakeup(void)
+{
+    pthread_mutex_lock(&SimBus_Lock);
+    SimBus_IsPending = true;
+    pthread_cond_signal(&SimBus_Event);
+    pthread_mutex_unlock(&SimBus_Lock);
+}
+
+const SimBus_ConfigType * SimBus_GetConfig(void)
+{
+    return &SimBus_Config;
+}
+
+bool SimTimer_Start(uint32_t PeriodUs, void (*Func)(void *Arg), void *Arg)
+{
+    bool IsStarted = false;
+    uint32_t Index = 0U;
+
+    pthread_mutex_lock(&SimTimer_Lock);
+
+    for(Index = 0U; Index < SIM_TIMER_COUNT && IsStarted == false; Index++)
+    {
+        if(SimTimer_List[Index].IsActive == false && PeriodUs != 0U && Func != NULL)
+        {
+            SimTimer_List[Index].PeriodNs = (uint64_t)PeriodUs * SIM_NS_PER_US;
+            SimTimer_List[Index].NextNs = SimBus_ElapsedNs() + SimTimer_List[Index].PeriodNs;
+            SimTimer_List[Index].Func = Func;
+            SimTimer_List[Index].Arg = Arg;
+            SimTimer_List[Index].IsActive = true;
+            IsStarted = true;
+        }
+    }
+
+    pthread_cond_signal(&SimTimer_Event);
+    pthread_mutex_unlock(&SimTimer_Lock);
+
+    return IsStarted;
+}
+
+void SimTimer_Stop(void (*Func)(void *Arg), void *Arg)
+{
+    uint32_t Index = 0U;
+
+    pthread_mutex_lock(&SimTimer_Lock);
+
+    for(Index = 0U; Index < SIM_TIMER_COUNT; Index++)
+    {
+        if(SimTimer_List[Index].Func == Func && SimTimer_List[Index].Arg == Arg)
+        {
+            SimTimer_List[Index].IsActive = false;
+        }
+    }
+
+    pthread_mutex_unlock(&SimTimer_Lock);
+}
+
+void SimBus_Report(FILE *Out)
+{
+    uint64_t ElapsedNs = SimBus_ElapsedNs();
+    uint64_t ElapsedBits = (ElapsedNs * SimBus_Config.BitRate) / SIM_NS_PER_S;
+    double Seconds = (double)ElapsedNs / (double)SIM_NS_PER_S;
+    double UsPerBit = 1000000.0 / (double)SimBus_Config.BitRate;
+    const SimBus_IdStatsType * Stats = NULL;
+    uint32_t Index = 0U;
+
+    fprintf(Out, "\nsim_can: %.2f s at %u bit/s, %u controllers\n", Seconds, SimBus_Config.BitRate, SimBus_NoOfNodes);
+    fprintf(Out, "bus load %.2f %%, %.1f frames/s, %u error frames, %u ACK errors\n\n",
+            (ElapsedBits != 0U) ? (100.0 * (double)SimBus_BusyBits / (double)ElapsedBits) : 0.0,
+            (double)SimBus_Frames / Seconds, SimBus_ErrorFrames, SimBus_AckErrors);
+
+    fprintf(Out, "%-12s %10s %10s\n", "node", "tx frames", "tx errors");
+    for(Index = 0U; Index < SimBus_NoOfNodes; Index++)
+    {
+        fprintf(Out, "%-12s %10u %10u\n", SimBus_Nodes[Index].Name, SimBus_Nodes[Index].TxFrames, SimBus_Nodes[Index].TxErrors);
+    }
+
+    fprintf(Out, "\n%-10s %-12s %8s %9s   %s\n", "id", "sender", "frames", "frames/s", "request to Rx latency min/avg/max (us)");
+    for(Index = 0U; Index < SimBus_NoOfIds; Index++)
+    {
+        Stats = &SimBus_IdStats[Index];
+        fprintf(Out, "%s0x%-7X %-12s %8u %9.1f   %.0f / %.0f / %.0f\n", Stats->IsExtended ? "x" : " ",
+                Stats->Id, SimBus_Nodes[Stats->Sender].Name, Stats->Frames,
+                (double)Stats->Frames / Seconds, Stats->LatencyMin * UsPerBit,
+                ((double)Stats->LatencySum / (double)Stats->Frames) * UsPerBit, Stats->LatencyMax * UsPerBit);
+    }
+}
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+static uint64_t SimBus_ElapsedNs(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((uint64_t)(Now.tv_sec - SimBus_StartTime.tv_sec) * SIM_NS_PER_S) + (uint64_t)Now.tv_nsec
+           - (uint64_t)SimBus_StartTime.tv_nsec;
+}
+
+static void SimBus_AbsTime(uint64_t ElapsedNs, struct timespec *Time)
+{
+    uint64_t Ns = (uint64_t)SimBus_StartTime.tv_nsec + ElapsedNs;
+
+    Time->tv_sec = SimBus_StartTime.tv_sec + (time_t)(Ns / SIM_NS_PER_S);
+    Time->tv_nsec = (long)(Ns % SIM_NS_PER_S);
+}
+
+static uint64_t SimBus_BitsToNs(uint32_t Bits)
+{
+    /* Rounded up, the bus must not run ahead of the time the nodes read */
+    return (((uint64_t)Bits * SIM_NS_PER_S) + SimBus_Config.BitRate - 1U) / SimBus_Config.BitRate;
+}
+
+static uint8_t SimBus_LengthToDlc(uint8_t DataLen)
+{
+    uint8_t Dlc = 0U;
+
+    while(Dlc < 15U && SimBus_DlcToLength[Dlc] < DataLen)
+    {
+        Dlc++;
+    }
+
+    return Dlc;
+}
+
+static void SimBus_PushBits(uint8_t *Bits, uint32_t *NoOfBits, uint32_t Value, uint8_t Width)
+{
+    while(Width > 0U)
+    {
+        Width--;
+        Bits[(*NoOfBits)++] = (uint8_t)((Value >> Width) & 1U);
+    }
+}
+
+static uint32_t SimBus_FrameBits(const SimBus_FrameType *Frame)
+{
+    uint8_t Bits[SIM_BUS_MAX_FRAME_BITS];
+    uint32_t NoOfBits = 0U;
+    uint32_t Index = 0U;
+    uint32_t Crc = 0U;
+    uint32_t Run = 0U;
+    uint8_t Level = 2U;
+    uint32_t Stuff = 0U;
+    uint32_t CrcLen = 0U;
+    uint8_t Dlc = SimBus_LengthToDlc(Frame->DataLen);
+    uint8_t DataLen = Frame->IsRemote ? 0U : SimBus_DlcToLength[Dlc];
+
+    /* Arbitration and control fields, SOF first */
+    SimBus_PushBits(Bits, &NoOfBits, 0U, 1U);
+    SimBus_PushBits(Bits, &NoOfBits, Frame->IsExtended ? (Frame->Id >> 18U) : Frame->Id, 11U);
+
+    if(Frame->IsExtended == true)
+    {
+        SimBus_PushBits(Bits, &NoOfBits, 3U, 2U);                 /* SRR, IDE */
+        SimBus_PushBits(Bits, &NoOfBits, Frame->Id, 18U);
+        SimBus_PushBits(Bits, &NoOfBits, Frame->IsRemote ? 1U : 0U, 1U);
+        SimBus_PushBits(Bits, &NoOfBits, Frame->IsFd ? 2U : 0U, 2U);  /* r1/FDF, r0/res */
+    }
+    else
+    {
+        SimBus_PushBits(Bits, &NoOfBits, Frame->IsRemote ? 1U : 0U, 1U);
+        SimBus_PushBits(Bits, &NoOfBits, Frame->IsFd ? 1U : 0U, 2U);  /* IDE, r0/FDF */
+
+        if(Frame->IsFd == true)
+        {
+            SimBus_PushBits(Bits, &NoOfBits, 0U, 1U);             /* res */
+        }
+    }
+
+    if(Frame->IsFd == true)
+    {
+        SimBus_PushBits(Bits, &NoOfBits, Frame->BitRateSwitch ? 2U : 0U, 2U);  /* BRS, ESI */
+    }
+
+    SimBus_PushBits(Bits, &NoOfBits, Dlc, 4U);
+
+    for(Index = 0U; Index < DataLen; Index++)
+    {
+        SimBus_PushBits(Bits, &NoOfBits, (Index < Frame->DataLen) ? Frame->Data[Index] : 0U, 8U);
+    }
+
+    if(Frame->IsFd == false)
+    {
+        /* CRC15 over SOF to the end of the data field, it is stuffed like the rest */
+        for(Index = 0U; Index < NoOfBits; Index++)
+        {
+            Crc = ((Crc << 1U) ^ ((((Crc >> 14U) & 1U) != Bits[Index]) ? SIM_BUS_CRC15_POLY : 0U)) & 0x7FFFU;
+        }
+
+        SimBus_PushBits(Bits, &NoOfBits, Crc, 15U);
+    }
+
+    /* Dynamic stuffing: a complement bit after 5 equal bits, it starts the next run */
+    for(Index = 0U; Index < NoOfBits; Index++)
+    {
+        Run = (Bits[Index] == Level) ? (Run + 1U) : 1U;
+        Level = Bits[Index];
+
+        if(Run == SIM_BUS_STUFF_LIMIT)
+        {
+            Stuff++;
+            Level ^= 1U;
+            Run = 1U;
+        }
+    }
+
+    if(Frame->IsFd == true)
+    {
+        /* Stuff count and CRC17/21 use fixed stuff bits, one every 4 bits. BRS is not modelled,
+         * the data phase is counted at the nominal bit rate. */
+        CrcLen = (DataLen > 16U) ? 21U : 17U;
+        Stuff += (SIM_BUS_FD_STUFF_COUNT_BITS + CrcLen) / 4U + 1U;
+        NoOfBits += SIM_BUS_FD_STUFF_COUNT_BITS + CrcLen;
+    }
+
+    return NoOfBits + Stuff + SIM_BUS_TRAILER_BITS;
+}
+
+static void SimBus_Trace(uint32_t Node, const SimBus_FrameType *Frame, uint32_t Time, SimBus_TxResult_e Result)
+{
+    static const char * const ResultText[] = { "", " ACK error", " error frame" };
+    uint32_t Index = 0U;
+
+    printf("%10.1f us  %-10s %s%03X [%u]", (double)Time * 1000000.0 / (double)SimBus_Config.BitRate,
+           SimBus_Nodes[Node].Name, Frame->IsExtended ? "x" : " ", Frame->Id, Frame->DataLen);
+
+    for(Index = 0U; Index < Frame->DataLen && Frame->IsRemote == false; Index++)
+    {
+        printf(" %02X", Frame->Data[Index]);
+    }
+
+    printf("%s%s\n", Frame->IsRemote ? " remote" : "", ResultText[Result]);
+}
+
+static void SimBus_UpdateStats(uint32_t Node, const SimBus_FrameType *Frame, uint32_t EndTime)
+{
+    SimBus_IdStatsType * Stats = NULL;
+    uint32_t Latency = EndTime - Frame->RequestTime;
+    uint32_t Index = 0U;
+
+    for(Index = 0U; Index < SimBus_NoOfIds && Stats == NULL; Index++)
+    {
+        if(SimBus_IdStats[Index].Id == Frame->Id && SimBus_IdStats[Index].IsExtended == Frame->IsExtended)
+        {
+            Stats = &SimBus_IdStats[Index];
+        }
+    }
+
+    if(Stats == NULL && SimBus_NoOfIds < SIM_BUS_MAX_IDS)
+    {
+        Stats = &SimBus_IdStats[SimBus_NoOfIds++];
+        Stats->Id = Frame->Id;
+        Stats->IsExtended = Frame->IsExtended;
+        Stats->LatencyMin = UINT32_MAX;
+    }
+
+    if(Stats != NULL)
+    {
+        Stats->Sender = Node;
+        Stats->Frames++;
+        Stats->LatencySum += Latency;
+        Stats->LatencyMin = (Latency < Stats->LatencyMin) ? Latency : Stats->LatencyMin;
+        Stats->LatencyMax = (Latency > Stats->LatencyMax) ? Latency : Stats->LatencyMax;
+    }
+}
+
+static void * SimBus_Main(void *Arg)
+{
+    SimBus_FrameType Candidates[SIM_BUS_MAX_CONTROLLERS];
+    SimBus_FrameType * Frame = NULL;
+    SimBus_NodeType * Node = NULL;
+    SimBus_TxResult_e Result = SIM_BUS_TX_OK;
+    struct timespec Deadline;
+    uint32_t NoOfNodes = 0U;
+    uint32_t Index = 0U;
+    uint32_t Winner = 0U;
+    uint32_t BestKey = 0U;
+    uint32_t Key = 0U;
+    uint32_t Now = 0U;
+    uint32_t FrameStart = 0U;
+    uint32_t FrameEnd = 0U;
+    uint32_t BusFree = 0U;
+    bool IsAcked = false;
+
+    while(SimBus_IsRunning == true)
+    {
+        NoOfNodes = __atomic_load_n(&SimBus_NoOfNodes, __ATOMIC_ACQUIRE);
+        Now = SimBus_Now();
+
+        /* Requests made from here on are seen by the next scan */
+        pthread_mutex_lock(&SimBus_Lock);
+        SimBus_IsPending = false;
+        pthread_mutex_unlock(&SimBus_Lock);
+
+        /* Bus-off recovery runs on bus time, then arbitration among the pending frames */
+        Winner = SIM_BUS_MAX_CONTROLLERS;
+        BestKey = UINT32_MAX;
+
+        for(Index = 0U; Index < NoOfNodes; Index++)
+        {
+            Node = &SimBus_Nodes[Index];
+            Node->Ops->Tick(Node->Controller, Now);
+
+            if(Node->Ops->GetTx(Node->Controller, &Candidates[Index]) == true)
+            {
+                Key = SimBus_ArbitrationKey(&Candidates[Index]);
+
+                if(Winner == SIM_BUS_MAX_CONTROLLERS || Key < BestKey)
+                {
+                    Winner = Index;
+                    BestKey = Key;
+                }
+            }
+        }
+
+        if(Winner == SIM_BUS_MAX_CONTROLLERS)
+        {
+            /* Bus idle until a controller requests or the recovery tick is due */
+            SimBus_AbsTime(SimBus_ElapsedNs() + SIM_BUS_IDLE_WAIT_NS, &Deadline);
+
+            pthread_mutex_lock(&SimBus_Lock);
+            while(SimBus_IsPending == false && SimBus_IsRunning == true
+                  && pthread_cond_timedwait(&SimBus_Event, &SimBus_Lock, &Deadline) == 0)
+            {
+                /* Spurious wakeup */
+            }
+            pthread_mutex_unlock(&SimBus_Lock);
+        }
+        else
+        {
+            Frame = &Candidates[Winner];
+            FrameStart = ((int32_t)(BusFree - Now) > 0) ? BusFree : Now;
+            FrameEnd = FrameStart + SimBus_FrameBits(Frame);
+
+            /* Someone else on the bus acknowledges */
+            IsAcked = false;
+            for(Index = 0U; Index < NoOfNodes; Index++)
+            {
+                if(Index != Winner && SimBus_Nodes[Index].Ops->IsOnline(SimBus_Nodes[Index].Controller) == true)
+                {
+                    IsAcked = true;
+                }
+            }
+
+            if(SimBus_Config.ErrorPpm != 0U && (uint32_t)(rand_r(&SimBus_Seed) % SIM_PPM) < SimBus_Config.ErrorPpm)
+            {
+                /* Error detected half way through the frame, then the error frame */
+                Result = SIM_BUS_TX_BIT_ERROR;
+                FrameEnd = FrameStart + ((FrameEnd - FrameStart) / 2U) + SIM_BUS_ERROR_FRAME_BITS;
+                SimBus_ErrorFrames++;
+            }
+            else if(IsAcked == false)
+            {
+                /* The transmitter sends an error flag after the ACK slot */
+                Result = SIM_BUS_TX_ACK_ERROR;
+                FrameEnd += SIM_BUS_ERROR_FRAME_BITS;
+                SimBus_AckErrors++;
+            }
+            else
+            {
+                Result = SIM_BUS_TX_OK;
+            }
+
+            /* The frame occupies the bus in real time */
+            SimBus_AbsTime(SimBus_BitsToNs(FrameEnd), &Deadline);
+            while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Deadline, NULL) != 0)
+            {
+                /* Interrupted by a signal */
+            }
+
+            if(SimBus_IsVerbose == true)
+            {
+                SimBus_Trace(Winner, Frame, FrameEnd, Result);
+            }
+
+            /* Receivers first, the transmitter's callback may queue the next frame */
+            for(Index = 0U; Index < NoOfNodes; Index++)
+            {
+                if(Index != Winner && Result != SIM_BUS_TX_ACK_ERROR)
+                {
+                    SimBus_Nodes[Index].Ops->Rx(SimBus_Nodes[Index].Controller, Frame, Result == SIM_BUS_TX_OK, FrameEnd);
+                }
+            }
+
+            SimBus_Nodes[Winner].Ops->TxDone(SimBus_Nodes[Winner].Controller, Result, FrameEnd);
+
+            if(Result == SIM_BUS_TX_OK)
+            {
+                SimBus_Nodes[Winner].TxFrames++;
+                SimBus_Frames++;
+                SimBus_UpdateStats(Winner, Frame, FrameEnd);
+            }
+            else
+            {
+                SimBus_Nodes[Winner].TxErrors++;
+            }
+
+            BusFree = FrameEnd + SIM_BUS_IFS_BITS;
+            SimBus_BusyBits += (uint64_t)(BusFree - FrameStart);
+        }
+    }
+
+    return Arg;
+}
+
+static void * SimTimer_Main(void *Arg)
+{
+    SimTimer_Type * Timer = NULL;
+    SimTimer_Type * Next = NULL;
+    struct timespec Deadline;
+    uint64_t Now = 0U;
+    uint32_t Index = 0U;
+    void (*Func)(void *Arg) = NULL;
+    void * FuncArg = NULL;
+
+    pthread_mutex_lock(&SimTimer_Lock);
+
+    while(SimBus_IsRunning == true)
+    {
+        Next = NULL;
+
+        for(Index = 0U; Index < SIM_TIMER_COUNT; Index++)
+        {
+            Timer = &SimTimer_List[Index];
+
+            if(Timer->IsActive == true && (Next == NULL || Timer->NextNs < Next->NextNs))
+            {
+                Next = Timer;
+            }
+        }
+
+        Now = SimBus_ElapsedNs();
+
+        if(Next == NULL || Next->NextNs > Now)
+        {
+            /* Sleep until the earliest expiry or a timer change */
+            SimBus_AbsTime((Next != NULL) ? Next->NextNs : (Now + SIM_NS_PER_S), &Deadline);
+            pthread_cond_timedwait(&SimTimer_Event, &SimTimer_Lock, &Deadline);
+        }
+        else
+        {
+            /* Periodic, a late expiry does not fire a burst to catch up */
+            Next->NextNs += Next->PeriodNs;
+            Next->NextNs = (Next->NextNs < Now) ? (Now + Next->PeriodNs) : Next->NextNs;
+            Func = Next->Func;
+            FuncArg = Next->Arg;
+
+            /* The expiry runs as the node interrupt, it may start or stop timers */
+            pthread_mutex_unlock(&SimTimer_Lock);
+            Func(FuncArg);
+            pthread_mutex_lock(&SimTimer_Lock);
+        }
+    }
+
+    pthread_mutex_unlock(&SimTimer_Lock);
+
+    return Arg;
+}
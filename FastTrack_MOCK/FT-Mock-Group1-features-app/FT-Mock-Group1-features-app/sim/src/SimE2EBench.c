@@ -0,0 +1,198 @@
+/*
+ * SimE2EBench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * E2E protection cost benchmark node: checks that both CRC engines agree and that the check
+ * sees corrupted, repeated and lost PDUs, then times MID_CAN_E2EProtect and MID_CAN_E2ECheck per
+ * PDU with each engine. Host CPU timings: the CRC unit path runs the bit by bit model of
+ * SimPlatform.c, so only the table row says something about the S32K144. Run it alone:
+ *   sim/run_sim.sh -n e2ebench
+ */
+
+#include "Middleware_Header.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define E2EBENCH_ROUNDS             (8000U)
+#define E2EBENCH_STREAM_LENGTH      (256U)      /*!< Multiple of 16, the counters run on across rounds */
+#define E2EBENCH_FRAMES             (E2EBENCH_ROUNDS * E2EBENCH_STREAM_LENGTH)
+#define E2EBENCH_CHECKED_FRAMES     (4096U)
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static const MID_CAN_E2EConfigType E2EBench_Config = {
+    .DataId = 0x0123U,
+    .DataLen = FLEXCAN_FRAME_MAX_DATA_LEN,
+    .CrcByte = 0U,
+    .CounterByte = 1U,
+    .MaxDeltaCounter = 1U
+};
+
+static const char * const E2EBench_EngineName[] = { "CRC unit", "table" };
+static uint8_t E2EBench_Stream[E2EBENCH_STREAM_LENGTH][FLEXCAN_FRAME_MAX_DATA_LEN];
+static volatile uint32_t E2EBench_Sink;
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static uint64_t E2EBench_Now(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((uint64_t)Now.tv_sec * 1000000000ULL) + (uint64_t)Now.tv_nsec;
+}
+
+static void E2EBench_Fail(const char *Reason)
+{
+    printf("e2ebench: %s\n", Reason);
+    fflush(stdout);
+    _exit(1);
+}
+
+static void E2EBench_Fill(uint8_t *Data, uint32_t Seed)
+{
+    uint8_t Index = 0U;
+
+    for(Index = 0U; Index < FLEXCAN_FRAME_MAX_DATA_LEN; Index++)
+    {
+        Seed = (Seed * 1103515245U) + 12345U;
+        Data[Index] = (uint8_t)(Seed >> 16U);
+    }
+}
+
+/* PDUs protected with one engine are accepted by the other one, faults are reported */
+static void E2EBench_Verify(void)
+{
+    MID_CAN_E2EStateType Sender;
+    MID_CAN_E2EStateType Receiver;
+    uint8_t Data[FLEXCAN_FRAME_MAX_DATA_LEN];
+    uint8_t Copy[FLEXCAN_FRAME_MAX_DATA_LEN];
+    uint32_t Frame = 0U;
+
+    MID_CAN_E2EResetState(&Sender);
+    MID_CAN_E2EResetState(&Receiver);
+
+    for(Frame = 0U; Frame < E2EBENCH_CHECKED_FRAMES; Frame++)
+    {
+        E2EBench_Fill(Data, Frame);
+        MID_CAN_E2EInit(((Frame & 1U) == 0U) ? MID_CAN_E2E_CRC_UNIT : MID_CAN_E2E_CRC_TABLE);
+        MID_CAN_E2EProtect(&E2EBench_Config, &Sender, Data, sizeof(Data));
+        MID_CAN_E2EInit(((Frame & 1U) == 0U) ? MID_CAN_E2E_CRC_TABLE : MID_CAN_E2E_CRC_UNIT);
+
+        /* Every single bit flip is caught by the CRC */
+        memcpy(Copy, Data, sizeof(Data));
+        Copy[(Frame / 8U) % FLEXCAN_FRAME_MAX_DATA_LEN] ^= (uint8_t)(1U << (Frame % 8U));
+
+        if(MID_CAN_E2ECheck(&E2EBench_Config, &Receiver, Copy, sizeof(Copy)) != MID_CAN_E2E_ERROR)
+        {
+            E2EBench_Fail("bit flip not detected");
+        }
+
+        if(MID_CAN_E2ECheck(&E2EBench_Config, &Receiver, Data, sizeof(Data)) != MID_CAN_E2E_OK)
+        {
+            E2EBench_Fail("engines disagree");
+        }
+
+        if(MID_CAN_E2ECheck(&E2EBench_Config, &Receiver, Data, sizeof(Data)) != MID_CAN_E2E_REPEATED)
+        {
+            E2EBench_Fail("repeated PDU not detected");
+        }
+    }
+
+    /* Two PDUs lost with MaxDeltaCounter 1 */
+    MID_CAN_E2EProtect(&E2EBench_Config, &Sender, Data, sizeof(Data));
+    MID_CAN_E2EProtect(&E2EBench_Config, &Sender, Data, sizeof(Data));
+    MID_CAN_E2EProtect(&E2EBench_Config, &Sender, Data, sizeof(Data));
+
+    if(MID_CAN_E2ECheck(&E2EBench_Config, &Receiver, Data, sizeof(Data)) != MID_CAN_E2E_WRONG_SEQUENCE)
+    {
+        E2EBench_Fail("lost PDUs not detected");
+    }
+}
+
+/* Nanoseconds per PDU, a stream protected in one go then checked in one go */
+static void E2EBench_Time(MID_CAN_E2ECrcEngine_e Engine, double *ProtectNs, double *CheckNs)
+{
+    MID_CAN_E2EStateType Sender;
+    MID_CAN_E2EStateType Receiver;
+    uint32_t Rejected = 0U;
+    uint32_t Round = 0U;
+    uint32_t Frame = 0U;
+    uint64_t Start = 0U;
+    uint64_t ProtectTime = 0U;
+    uint64_t CheckTime = 0U;
+
+    MID_CAN_E2EInit(Engine);
+    MID_CAN_E2EResetState(&Sender);
+    MID_CAN_E2EResetState(&Receiver);
+
+    for(Frame = 0U; Frame < E2EBENCH_STREAM_LENGTH; Frame++)
+    {
+        E2EBench_Fill(E2EBench_Stream[Frame], Frame);
+    }
+
+    for(Round = 0U; Round < E2EBENCH_ROUNDS; Round++)
+    {
+        Start = E2EBench_Now();
+
+        for(Frame = 0U; Frame < E2EBENCH_STREAM_LENGTH; Frame++)
+        {
+            MID_CAN_E2EProtect(&E2EBench_Config, &Sender, E2EBench_Stream[Frame], FLEXCAN_FRAME_MAX_DATA_LEN);
+        }
+
+        ProtectTime += E2EBench_Now() - Start;
+        Start = E2EBench_Now();
+
+        for(Frame = 0U; Frame < E2EBENCH_STREAM_LENGTH; Frame++)
+        {
+            Rejected += (MID_CAN_E2ECheck(&E2EBench_Config, &Receiver, E2EBench_Stream[Frame], FLEXCAN_FRAME_MAX_DATA_LEN)
+                         != MID_CAN_E2E_OK) ? 1U : 0U;
+        }
+
+        CheckTime += E2EBench_Now() - Start;
+    }
+
+    if(Rejected != 0U)
+    {
+        E2EBench_Fail("PDU rejected while timing");
+    }
+
+    E2EBench_Sink = Rejected;
+    *ProtectNs = (double)ProtectTime / E2EBENCH_FRAMES;
+    *CheckNs = (double)CheckTime / E2EBENCH_FRAMES;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void SimE2EBench_Run(void)
+{
+    double ProtectNs = 0.0;
+    double CheckNs = 0.0;
+    uint32_t Index = 0U;
+
+    E2EBench_Verify();
+
+    printf("E2E protection cost, ns per %u-byte PDU on the host, CRC and check verified on %u PDUs\n",
+           (unsigned int)FLEXCAN_FRAME_MAX_DATA_LEN, (unsigned int)E2EBENCH_CHECKED_FRAMES);
+    printf("%-10s %10s %10s\n", "engine", "protect", "check");
+
+    for(Index = 0U; Index < (sizeof(E2EBench_EngineName) / sizeof(E2EBench_EngineName[0])); Index++)
+    {
+        E2EBench_Time((MID_CAN_E2ECrcEngine_e)Index, &ProtectNs, &CheckNs);
+        printf("%-10s %10.1f %10.1f\n", E2EBench_EngineName[Index], ProtectNs, CheckNs);
+        fflush(stdout);
+    }
+
+    _exit(0);
+}
@@ -0,0 +1,211 @@
+/*
+ * SimFilterTest.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Acceptance filter planner test node: plans ID + mask filters for fixed and pseudo-random range
+ * sets with MID_CAN_FilterPlan, then sends all 2048 standard IDs through each plan. Every requested
+ * ID must be accepted, and the over-acceptance must match the planner contract, which is none.
+ * Sets that do not fit the table must be reported so. Run it alone:
+ *   sim/run_sim.sh -n filtertest
+ */
+
+#include "Middleware_Header.h"
+#include "MIDDLE_CanFilter.h"
+#include <stdio.h>
+#include <unistd.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define FILTERTEST_MAX_RANGES       (4U)
+#define FILTERTEST_MAX_ENTRIES      (32U)       /*!< Rx FIFO ID filter elements of the largest table */
+#define FILTERTEST_RANDOM_SETS      (64U)
+#define FILTERTEST_STD_ID_COUNT     (MID_CAN_FILTER_STD_ID_MAX + 1U)
+#define FILTERTEST_OVER_ACCEPTED    (0U)        /*!< MID_CAN_FilterPlan never accepts an ID outside the ranges */
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+typedef struct
+{
+    const char *                 Name;
+    MID_CAN_FilterRangeType      Ranges[FILTERTEST_MAX_RANGES];
+    uint8_t                      NoOfRanges;
+    uint8_t                      MaxEntries;
+    bool                         IsFit;         /*!< Expected result of the planner */
+} FilterTest_SetType;
+
+static const FilterTest_SetType FilterTest_Sets[] = {
+    { "single ID",        { { 0x123U, 0x123U, FlexCAN_STANDARD } }, 1U, FILTERTEST_MAX_ENTRIES, true },
+    { "aligned block",    { { 0x100U, 0x1FFU, FlexCAN_STANDARD } }, 1U, FILTERTEST_MAX_ENTRIES, true },
+    { "unaligned range",  { { 0x0F5U, 0x30AU, FlexCAN_STANDARD } }, 1U, FILTERTEST_MAX_ENTRIES, true },
+    { "all IDs",          { { 0x000U, 0x7FFU, FlexCAN_STANDARD } }, 1U, FILTERTEST_MAX_ENTRIES, true },
+    { "one bit apart",    { { 0x100U, 0x100U, FlexCAN_STANDARD }, { 0x300U, 0x300U, FlexCAN_STANDARD } },
+                          2U, FILTERTEST_MAX_ENTRIES, true },
+    { "overlapping",      { { 0x200U, 0x2FFU, FlexCAN_STANDARD }, { 0x280U, 0x3FFU, FlexCAN_STANDARD } },
+                          2U, FILTERTEST_MAX_ENTRIES, true },
+    { "diagnostic IDs",   { { 0x7DFU, 0x7DFU, FlexCAN_STANDARD }, { 0x7E0U, 0x7E7U, FlexCAN_STANDARD },
+                            { 0x7E8U, 0x7EFU, FlexCAN_STANDARD } }, 3U, FILTERTEST_MAX_ENTRIES, true },
+    { "mixed ID types",   { { 0x010U, 0x01FU, FlexCAN_STANDARD }, { 0x010U, 0x7FFU, FlexCAN_EXTENDED },
+                            { 0x7F0U, 0x7F3U, FlexCAN_STANDARD } }, 3U, FILTERTEST_MAX_ENTRIES, true },
+    { "table too small",  { { 0x001U, 0x7FEU, FlexCAN_STANDARD } }, 1U, 2U, false }
+};
+
+static FlexCAN_RxFilterType FilterTest_Plan[FILTERTEST_MAX_ENTRIES];
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void FilterTest_Fail(const char *Name, const char *Reason)
+{
+    printf("filtertest: %s: %s\n", Name, Reason);
+    fflush(stdout);
+    _exit(1);
+}
+
+static bool FilterTest_IsRequested(const FilterTest_SetType *Set, uint32_t Id)
+{
+    bool IsRequested = false;
+    uint8_t Index = 0U;
+
+    for(Index = 0U; Index < Set->NoOfRanges && IsRequested == false; Index++)
+    {
+        IsRequested = (Set->Ranges[Index].IdType == FlexCAN_STANDARD
+                       && Id >= Set->Ranges[Index].FirstId && Id <= Set->Ranges[Index].LastId);
+    }
+
+    return IsRequested;
+}
+
+/* Same acceptance rule as the mailbox RXIMR and the Rx FIFO element masks */
+static bool FilterTest_IsAccepted(uint8_t NoOfEntries, uint32_t Id)
+{
+    bool IsAccepted = false;
+    uint8_t Index = 0U;
+
+    for(Index = 0U; Index < NoOfEntries && IsAccepted == false; Index++)
+    {
+        IsAccepted = (FilterTest_Plan[Index].IdType == FlexCAN_STANDARD
+                      && ((Id ^ FilterTest_Plan[Index].Id) & FilterTest_Plan[Index].Mask) == 0U);
+    }
+
+    return IsAccepted;
+}
+
+static void FilterTest_Check(const FilterTest_SetType *Set, bool IsPrinted)
+{
+    uint8_t NoOfEntries = 0U;
+    uint32_t Requested = 0U;
+    uint32_t Accepted = 0U;
+    uint32_t OverAccepted = 0U;
+    uint32_t Id = 0U;
+    bool IsFit = false;
+    bool IsRequested = false;
+    bool IsAccepted = false;
+
+    IsFit = MID_CAN_FilterPlan(Set->Ranges, Set->NoOfRanges, FilterTest_Plan, Set->MaxEntries, &NoOfEntries);
+
+    if(IsFit != Set->IsFit)
+    {
+        FilterTest_Fail(Set->Name, IsFit ? "planned although the table is too small" : "does not fit the table");
+    }
+
+    if(NoOfEntries > Set->MaxEntries)
+    {
+        FilterTest_Fail(Set->Name, "more filters than table entries");
+    }
+
+    if(IsFit == true)
+    {
+        for(Id = 0U; Id < FILTERTEST_STD_ID_COUNT; Id++)
+        {
+            IsRequested = FilterTest_IsRequested(Set, Id);
+            IsAccepted = FilterTest_IsAccepted(NoOfEntries, Id);
+
+            if(IsRequested == true && IsAccepted == false)
+            {
+                printf("filtertest: %s: ID 0x%03X rejected\n", Set->Name, (unsigned int)Id);
+                FilterTest_Fail(Set->Name, "requested ID rejected");
+            }
+
+            Requested += IsRequested ? 1U : 0U;
+            Accepted += IsAccepted ? 1U : 0U;
+            OverAccepted += (IsAccepted == true && IsRequested == false) ? 1U : 0U;
+        }
+
+        if(OverAccepted != FILTERTEST_OVER_ACCEPTED)
+        {
+            FilterTest_Fail(Set->Name, "IDs accepted outside the ranges");
+        }
+    }
+
+    if(IsPrinted == true)
+    {
+        printf("%-18s %6u %7u %9u %8u %5u  %s\n", Set->Name, (unsigned int)Set->NoOfRanges, (unsigned int)NoOfEntries,
+               (unsigned int)Requested, (unsigned int)Accepted, (unsigned int)OverAccepted, IsFit ? "fit" : "no fit");
+    }
+}
+
+/* Up to 4 standard ranges, unaligned bounds, often overlapping */
+static void FilterTest_Random(FilterTest_SetType *Set, uint32_t *Seed)
+{
+    uint32_t First = 0U;
+    uint32_t Length = 0U;
+    uint8_t Index = 0U;
+
+    *Seed = (*Seed * 1103515245U) + 12345U;
+    Set->NoOfRanges = (uint8_t)(1U + ((*Seed >> 16U) % FILTERTEST_MAX_RANGES));
+
+    for(Index = 0U; Index < Set->NoOfRanges; Index++)
+    {
+        *Seed = (*Seed * 1103515245U) + 12345U;
+        First = (*Seed >> 8U) & MID_CAN_FILTER_STD_ID_MAX;
+        *Seed = (*Seed * 1103515245U) + 12345U;
+        Length = ((*Seed >> 8U) & 0xFFU) >> ((*Seed >> 20U) & 0x7U);
+
+        Set->Ranges[Index].FirstId = First;
+        Set->Ranges[Index].LastId = ((First + Length) > MID_CAN_FILTER_STD_ID_MAX) ? MID_CAN_FILTER_STD_ID_MAX : (First + Length);
+        Set->Ranges[Index].IdType = FlexCAN_STANDARD;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void SimFilterTest_Run(void)
+{
+    FilterTest_SetType Set;
+    uint8_t NoOfEntries = 0U;
+    uint32_t Seed = 0x5EEDU;
+    uint32_t Index = 0U;
+    uint32_t NoFit = 0U;
+
+    printf("Acceptance filter planner, all %u standard IDs through each plan\n", (unsigned int)FILTERTEST_STD_ID_COUNT);
+    printf("%-18s %6s %7s %9s %8s %5s\n", "set", "ranges", "filters", "requested", "accepted", "over");
+
+    for(Index = 0U; Index < (sizeof(FilterTest_Sets) / sizeof(FilterTest_Sets[0])); Index++)
+    {
+        FilterTest_Check(&FilterTest_Sets[Index], true);
+    }
+
+    /* Random sets that need more filters than the table holds must be refused, not widened */
+    Set.Name = "random";
+    Set.MaxEntries = FILTERTEST_MAX_ENTRIES;
+
+    for(Index = 0U; Index < FILTERTEST_RANDOM_SETS; Index++)
+    {
+        FilterTest_Random(&Set, &Seed);
+        Set.IsFit = MID_CAN_FilterPlan(Set.Ranges, Set.NoOfRanges, FilterTest_Plan, Set.MaxEntries, &NoOfEntries);
+        NoFit += (Set.IsFit == false) ? 1U : 0U;
+
+        FilterTest_Check(&Set, false);
+    }
+
+    printf("filtertest: %u sets passed, %u random sets refused as too large\n",
+           (unsigned int)(Index + (sizeof(FilterTest_Sets) / sizeof(FilterTest_Sets[0]))), (unsigned int)NoFit);
+    fflush(stdout);
+
+    _exit(0);
+}
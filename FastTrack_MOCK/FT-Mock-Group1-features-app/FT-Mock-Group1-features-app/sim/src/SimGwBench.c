@@ -0,0 +1,178 @@
+/*
+ * SimGwBench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Routing cost benchmark node: times the route lookup of the gateway against a linear search of
+ * the same table, and a whole MID_CAN_GwRxIndication, for growing routing tables. Host CPU
+ * timings, they show how the cost scales, not the cycles of the S32K144. Run it alone:
+ *   sim/run_sim.sh -n gwbench
+ */
+
+#include "Middleware_Header.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define GWBENCH_FRAMES              (2000000U)
+#define GWBENCH_STREAM_LENGTH       (256U)
+#define GWBENCH_MISS_EVERY          (8U)        /*!< One frame in 8 has no route */
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static const uint8_t GwBench_Sizes[] = { 2U, 8U, 16U, 32U, MID_CAN_GW_MAX_ROUTES };
+
+static MID_CAN_GwRouteType GwBench_Routes[MID_CAN_GW_MAX_ROUTES];
+static MID_CAN_GwSignalType GwBench_Signals[MID_CAN_GW_MAX_ROUTES];
+static FlexCAN_FrameType GwBench_Stream[GWBENCH_STREAM_LENGTH];
+static volatile uint32_t GwBench_Sink;
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static uint64_t GwBench_Now(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((uint64_t)Now.tv_sec * 1000000000ULL) + (uint64_t)Now.tv_nsec;
+}
+
+/* Table of a gateway without lookup structure, the cost the perfect hash removes */
+static uint8_t GwBench_LinearFind(uint8_t NoOfRoutes, const FlexCAN_FrameType *Frame)
+{
+    uint8_t Index = 0U;
+
+    while(Index < NoOfRoutes && (GwBench_Routes[Index].Id != Frame->Id || GwBench_Routes[Index].IdType != Frame->IdType
+                                 || GwBench_Routes[Index].SrcIns != MODULE_0_INS))
+    {
+        Index++;
+    }
+
+    return (Index < NoOfRoutes) ? Index : MID_CAN_IDMAP_NONE;
+}
+
+/* Half standard, half extended IDs spread over the ID range, one signal per route */
+static void GwBench_Build(uint8_t NoOfRoutes)
+{
+    uint32_t Index = 0U;
+    uint32_t Route = 0U;
+
+    for(Index = 0U; Index < NoOfRoutes; Index++)
+    {
+        GwBench_Signals[Index].Slot = (uint8_t)Index;
+        GwBench_Signals[Index].StartBit = 0U;
+        GwBench_Signals[Index].Length = 16U;
+        GwBench_Signals[Index].UpdateBit = MID_CAN_GW_NO_UPDATE_BIT;
+
+        GwBench_Routes[Index].IdType = ((Index & 1U) == 0U) ? FlexCAN_STANDARD : FlexCAN_EXTENDED;
+        GwBench_Routes[Index].Id = ((Index & 1U) == 0U) ? (0x100U + (Index * 0x13U)) : (0x18FF0000U + (Index * 0x101U));
+        GwBench_Routes[Index].SrcIns = MODULE_0_INS;
+        GwBench_Routes[Index].Actions = MID_CAN_GW_SIGNAL;
+        GwBench_Routes[Index].Signals = &GwBench_Signals[Index];
+        GwBench_Routes[Index].NoOfSignals = 1U;
+        GwBench_Routes[Index].Tag = (uint8_t)Index;
+    }
+
+    /* Frames of random routes, the same stream for both lookups */
+    for(Index = 0U; Index < GWBENCH_STREAM_LENGTH; Index++)
+    {
+        Route = ((Index * 2654435761U) >> 8U) % NoOfRoutes;
+        GwBench_Stream[Index].Id = GwBench_Routes[Route].Id;
+        GwBench_Stream[Index].IdType = GwBench_Routes[Route].IdType;
+        GwBench_Stream[Index].DataLen = 8U;
+        GwBench_Stream[Index].Data.Word[0] = Index;
+        GwBench_Stream[Index].Data.Word[1] = 0U;
+
+        if((Index % GWBENCH_MISS_EVERY) == 0U)
+        {
+            GwBench_Stream[Index].Id = 0x7FFU;
+            GwBench_Stream[Index].IdType = FlexCAN_STANDARD;
+        }
+    }
+}
+
+/* Nanoseconds per frame of one lookup method, 0 linear, 1 gateway lookup, 2 whole indication */
+static double GwBench_Time(uint8_t NoOfRoutes, uint8_t Method)
+{
+    const FlexCAN_FrameType *Frame = NULL;
+    uint32_t Sum = 0U;
+    uint32_t Index = 0U;
+    uint64_t Start = GwBench_Now();
+
+    for(Index = 0U; Index < GWBENCH_FRAMES; Index++)
+    {
+        Frame = &GwBench_Stream[Index % GWBENCH_STREAM_LENGTH];
+
+        if(Method == 0U)
+        {
+            Sum += GwBench_LinearFind(NoOfRoutes, Frame);
+        }
+        else if(Method == 1U)
+        {
+            Sum += MID_CAN_GwFind(MODULE_0_INS, Frame->Id, Frame->IdType);
+        }
+        else
+        {
+            Sum += MID_CAN_GwRxIndication(MODULE_0_INS, Frame);
+        }
+    }
+
+    GwBench_Sink = Sum;
+
+    return (double)(GwBench_Now() - Start) / GWBENCH_FRAMES;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void SimGwBench_Run(void)
+{
+    MID_CAN_GwConfigType Config = { .Routes = GwBench_Routes };
+    uint32_t Index = 0U;
+    uint8_t Size = 0U;
+    bool IsChecked = true;
+
+    printf("Gateway routing cost, ns per frame on the host, 1 frame in %u without route\n",
+           (unsigned int)GWBENCH_MISS_EVERY);
+    printf("%6s %12s %12s %14s\n", "routes", "linear find", "hash find", "RxIndication");
+
+    for(Size = 0U; Size < sizeof(GwBench_Sizes); Size++)
+    {
+        GwBench_Build(GwBench_Sizes[Size]);
+        Config.NoOfRoutes = GwBench_Sizes[Size];
+
+        if(MID_CAN_GwInit(&Config) == false)
+        {
+            printf("gwbench: routing table of %u routes rejected\n", (unsigned int)GwBench_Sizes[Size]);
+            fflush(stdout);
+            _exit(1);
+        }
+
+        /* Both lookups give the same route for every frame */
+        for(Index = 0U; Index < GWBENCH_STREAM_LENGTH && IsChecked == true; Index++)
+        {
+            IsChecked = (GwBench_LinearFind(GwBench_Sizes[Size], &GwBench_Stream[Index])
+                         == MID_CAN_GwFind(MODULE_0_INS, GwBench_Stream[Index].Id, GwBench_Stream[Index].IdType));
+        }
+
+        if(IsChecked == false)
+        {
+            printf("gwbench: lookups disagree\n");
+            fflush(stdout);
+            _exit(1);
+        }
+
+        printf("%6u %12.1f %12.1f %14.1f\n", (unsigned int)GwBench_Sizes[Size], GwBench_Time(GwBench_Sizes[Size], 0U),
+               GwBench_Time(GwBench_Sizes[Size], 1U), GwBench_Time(GwBench_Sizes[Size], 2U));
+        fflush(stdout);
+    }
+
+    _exit(0);
+}
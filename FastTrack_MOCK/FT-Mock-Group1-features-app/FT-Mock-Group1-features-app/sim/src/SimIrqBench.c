@@ -0,0 +1,204 @@
+/*
+ * SimIrqBench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Mailbox interrupt dispatch benchmark node: compares two standalone reimplementations of the
+ * mailbox dispatch, not FlexCAN_MB_IRQHandler itself. The count-trailing-zeros loop mirrors the
+ * current handler, all raised flags of a vector served in one entry; the linear scan mirrors the
+ * former one, one mailbox per entry. Both run for 1, 4 and 16 pending mailboxes from MB8 on, on a
+ * RAM copy of IFLAG1/IMASK1 with empty callbacks. Host CPU timings: the exception entry and exit
+ * the old dispatch pays per extra mailbox on the Cortex-M4 are not included, the entries column
+ * counts them. Run it alone:
+ *   sim/run_sim.sh -n irqbench
+ */
+
+#include "Middleware_Header.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define IRQBENCH_BURSTS             (2000000U)
+#define IRQBENCH_FIRST_MB           (8U)
+#define IRQBENCH_MB_COUNT           (32U)
+#define IRQBENCH_MB_0_15_MASK       (0x0000FFFFU)
+#define IRQBENCH_MB_16_31_MASK      (0xFFFF0000U)
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+typedef struct
+{
+    volatile uint32_t            IFLAG1;
+    volatile uint32_t            IMASK1;
+} IrqBench_RegsType;
+
+static const uint8_t IrqBench_Pending[] = { 1U, 4U, 16U };
+
+static IrqBench_RegsType IrqBench_Regs;
+static void (*IrqBench_Callback[IRQBENCH_MB_COUNT])(uint8_t MbIndex);
+static volatile uint32_t IrqBench_Served;
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static uint64_t IrqBench_Now(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((uint64_t)Now.tv_sec * 1000000000ULL) + (uint64_t)Now.tv_nsec;
+}
+
+static void IrqBench_Serve(uint8_t MbIndex)
+{
+    IrqBench_Served += (uint32_t)MbIndex + 1U;
+}
+
+/* Write-1-to-clear of the hardware register */
+static void IrqBench_ClearFlags(uint32_t Flags)
+{
+    IrqBench_Regs.IFLAG1 &= ~Flags;
+}
+
+/* Copy of the dispatch before the rework: scan from MB0, serve the first raised mailbox, return */
+static void IrqBench_ScanDispatch(void)
+{
+    uint8_t RaisedFlag = 0U;
+    uint8_t MbIndex = 0U;
+
+    while((RaisedFlag & 1U) == 0U && (MbIndex < IRQBENCH_MB_COUNT))
+    {
+        RaisedFlag = (uint8_t)(((IrqBench_Regs.IFLAG1 & IrqBench_Regs.IMASK1) >> MbIndex) & 1U);
+        MbIndex++;
+    }
+
+    MbIndex--;
+
+    if(RaisedFlag == 1U)
+    {
+        if(IrqBench_Callback[MbIndex] != NULL)
+        {
+            IrqBench_Callback[MbIndex](MbIndex);
+        }
+
+        IrqBench_ClearFlags(1UL << MbIndex);
+    }
+}
+
+/* Copy of the FlexCAN_MB_IRQHandler loop: every raised flag of the vector in one entry */
+static void IrqBench_CtzDispatch(uint32_t VectorMask)
+{
+    uint32_t RaisedFlags = IrqBench_Regs.IFLAG1 & IrqBench_Regs.IMASK1 & VectorMask;
+    uint8_t MbIndex = 0U;
+
+    while(RaisedFlags != 0U)
+    {
+        MbIndex = (uint8_t)__builtin_ctz(RaisedFlags);
+        RaisedFlags &= (RaisedFlags - 1U);
+
+        if(IrqBench_Callback[MbIndex] != NULL)
+        {
+            IrqBench_Callback[MbIndex](MbIndex);
+        }
+
+        IrqBench_ClearFlags(1UL << MbIndex);
+    }
+}
+
+/* ns per burst of Pending raised mailboxes, Entries gets the handler entries of one burst */
+static double IrqBench_Time(uint8_t Pending, bool IsCtz, uint32_t *Entries)
+{
+    uint32_t Flags = ((Pending >= IRQBENCH_MB_COUNT) ? 0xFFFFFFFFU : ((1UL << Pending) - 1U)) << IRQBENCH_FIRST_MB;
+    uint32_t Burst = 0U;
+    uint32_t Count = 0U;
+    uint64_t Start = 0U;
+
+    IrqBench_Regs.IMASK1 = 0xFFFFFFFFU;
+    Start = IrqBench_Now();
+
+    for(Burst = 0U; Burst < IRQBENCH_BURSTS; Burst++)
+    {
+        IrqBench_Regs.IFLAG1 = Flags;
+        Count = 0U;
+
+        /* The NVIC enters again as long as a flag of the vector is raised */
+        while((IrqBench_Regs.IFLAG1 & IrqBench_Regs.IMASK1) != 0U)
+        {
+            if(IsCtz == true)
+            {
+                if((IrqBench_Regs.IFLAG1 & IRQBENCH_MB_0_15_MASK) != 0U)
+                {
+                    IrqBench_CtzDispatch(IRQBENCH_MB_0_15_MASK);
+                    Count++;
+                }
+
+                if((IrqBench_Regs.IFLAG1 & IRQBENCH_MB_16_31_MASK) != 0U)
+                {
+                    IrqBench_CtzDispatch(IRQBENCH_MB_16_31_MASK);
+                    Count++;
+                }
+            }
+            else
+            {
+                IrqBench_ScanDispatch();
+                Count++;
+            }
+        }
+    }
+
+    *Entries = Count;
+
+    return (double)(IrqBench_Now() - Start) / IRQBENCH_BURSTS;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void SimIrqBench_Run(void)
+{
+    double ScanNs = 0.0;
+    double CtzNs = 0.0;
+    uint32_t ScanEntries = 0U;
+    uint32_t CtzEntries = 0U;
+    uint32_t Expected = 0U;
+    uint32_t Index = 0U;
+
+    for(Index = 0U; Index < IRQBENCH_MB_COUNT; Index++)
+    {
+        IrqBench_Callback[Index] = IrqBench_Serve;
+    }
+
+    printf("Mailbox interrupt dispatch cost, ns per burst on the host, pending mailboxes from MB%u on\n",
+           (unsigned int)IRQBENCH_FIRST_MB);
+    printf("%7s %10s %8s %10s %8s\n", "pending", "scan", "entries", "ctz", "entries");
+
+    for(Index = 0U; Index < sizeof(IrqBench_Pending); Index++)
+    {
+        IrqBench_Served = 0U;
+        ScanNs = IrqBench_Time(IrqBench_Pending[Index], false, &ScanEntries);
+        Expected = IrqBench_Served;
+
+        IrqBench_Served = 0U;
+        CtzNs = IrqBench_Time(IrqBench_Pending[Index], true, &CtzEntries);
+
+        /* Both dispatches serve every mailbox of every burst once */
+        if(IrqBench_Served != Expected || ScanEntries != IrqBench_Pending[Index])
+        {
+            printf("irqbench: dispatches disagree\n");
+            fflush(stdout);
+            _exit(1);
+        }
+
+        printf("%7u %10.1f %8u %10.1f %8u\n", (unsigned int)IrqBench_Pending[Index], ScanNs, (unsigned int)ScanEntries,
+               CtzNs, (unsigned int)CtzEntries);
+        fflush(stdout);
+    }
+
+    _exit(0);
+}
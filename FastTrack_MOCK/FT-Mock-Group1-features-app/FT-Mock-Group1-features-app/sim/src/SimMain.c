@@ -0,0 +1,169 @@
+/*
+ * SimMain.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * sim_can: runs the forwarder, speed and temperature nodes on one virtual CAN bus.
+ * Every node is loaded from its own shared object, so the driver and middleware globals
+ * stay per node, and runs its App_*_Run loop on its own thread.
+ *
+ * usage: sim_can [-t seconds] [-b bitrate] [-a adc_period_us] [-e error_ppm] [-n node,...] [-L libdir] [-v]
+ *   -n  nodes to load instead of the three application nodes, e.g. -n tpbench loads node_tpbench.so
+ */
+
+#include "SimBus.h"
+#include <dlfcn.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define SIM_DEFAULT_SECONDS         (10U)
+#define SIM_DEFAULT_BITRATE         (500000U)
+#define SIM_DEFAULT_ADC_PERIOD_US   (10000U)
+#define SIM_DEFAULT_LPIT_CLOCK_HZ   (48000000U)  /*!< SOSCDIV2 as set up by the nodes */
+#define SIM_NODE_COUNT              (3U)
+#define SIM_MAX_NODES               (8U)
+
+typedef void (*SimNode_RunType)(void);
+
+static const char * const SimMain_NodeLib[SIM_NODE_COUNT] =
+{
+    "forwarder",
+    "speed",
+    "temp"
+};
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void * SimMain_NodeThread(void *Arg)
+{
+    SimNode_RunType Run = (SimNode_RunType)Arg;
+
+    Run();
+
+    return NULL;
+}
+
+/* Comma separated node names, at most SIM_MAX_NODES */
+static uint32_t SimMain_ParseNodes(char *List, const char **Node)
+{
+    uint32_t NoOfNodes = 0U;
+    char * Name = strtok(List, ",");
+
+    while(Name != NULL && NoOfNodes < SIM_MAX_NODES)
+    {
+        Node[NoOfNodes++] = Name;
+        Name = strtok(NULL, ",");
+    }
+
+    return NoOfNodes;
+}
+
+static void SimMain_Usage(const char *Prog)
+{
+    fprintf(stderr, "usage: %s [-t seconds] [-b bitrate] [-a adc_period_us] [-e error_ppm] [-n node,...] [-L libdir] [-v]\n", Prog);
+    exit(2);
+}
+
+/* ----------------------------------------------------------------------------
+   -- Main
+   ---------------------------------------------------------------------------- */
+int main(int argc, char **argv)
+{
+    SimBus_ConfigType Config =
+    {
+        .BitRate = SIM_DEFAULT_BITRATE,
+        .AdcPeriodUs = SIM_DEFAULT_ADC_PERIOD_US,
+        .LpitClockHz = SIM_DEFAULT_LPIT_CLOCK_HZ,
+        .ErrorPpm = 0U
+    };
+    unsigned int Seconds = SIM_DEFAULT_SECONDS;
+    bool IsVerbose = false;
+    char LibDir[PATH_MAX] = ".";
+    char LibPath[PATH_MAX];
+    const char * Node[SIM_MAX_NODES];
+    uint32_t NoOfNodes = SIM_NODE_COUNT;
+    ssize_t Len = 0;
+    void * Handle = NULL;
+    SimNode_RunType Run = NULL;
+    pthread_t Thread;
+    uint32_t Index = 0U;
+    int Opt = 0;
+
+    /* Node libraries default to the directory of the executable */
+    Len = readlink("/proc/self/exe", LibDir, sizeof(LibDir) - 1U);
+    if(Len > 0)
+    {
+        LibDir[Len] = '\0';
+        *strrchr(LibDir, '/') = '\0';
+    }
+    else
+    {
+        strcpy(LibDir, ".");
+    }
+
+    for(Index = 0U; Index < SIM_NODE_COUNT; Index++)
+    {
+        Node[Index] = SimMain_NodeLib[Index];
+    }
+
+    while((Opt = getopt(argc, argv, "t:b:a:e:n:L:v")) != -1)
+    {
+        switch(Opt)
+        {
+            case 't': Seconds = (unsigned int)strtoul(optarg, NULL, 0); break;
+            case 'b': Config.BitRate = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'a': Config.AdcPeriodUs = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'e': Config.ErrorPpm = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'n': NoOfNodes = SimMain_ParseNodes(optarg, Node); break;
+            case 'L': snprintf(LibDir, sizeof(LibDir), "%s", optarg); break;
+            case 'v': IsVerbose = true; break;
+            default: SimMain_Usage(argv[0]); break;
+        }
+    }
+
+    if(Config.BitRate == 0U || Config.AdcPeriodUs == 0U || NoOfNodes == 0U)
+    {
+        SimMain_Usage(argv[0]);
+    }
+
+    SimBus_Start(&Config, IsVerbose);
+
+    for(Index = 0U; Index < NoOfNodes; Index++)
+    {
+        snprintf(LibPath, sizeof(LibPath), "%s/node_%s.so", LibDir, Node[Index]);
+
+        Handle = dlopen(LibPath, RTLD_NOW | RTLD_LOCAL);
+        Run = (Handle != NULL) ? (SimNode_RunType)dlsym(Handle, "SimNode_Run") : NULL;
+
+        if(Run == NULL)
+        {
+            fprintf(stderr, "sim_can: %s\n", dlerror());
+            return 1;
+        }
+
+        if(pthread_create(&Thread, NULL, SimMain_NodeThread, (void *)Run) != 0)
+        {
+            fprintf(stderr, "sim_can: cannot start %s\n", Node[Index]);
+            return 1;
+        }
+
+        pthread_detach(Thread);
+    }
+
+    sleep(Seconds);
+
+    SimBus_Stop();
+    SimBus_Report(stdout);
+    fflush(stdout);
+
+    /* The node loops never return */
+    _exit(0);
+}
@@ -0,0 +1,347 @@
+/*
+ * SimPlatform.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Host replacement of the S32K144 drivers used by a node, linked into every node shared object.
+ * The node interrupt lock stands for the CPU interrupt mask: the bus, ADC and LPIT events of the
+ * node run under it, so they never interleave with a DISABLE_INTERRUPTS() section of the node.
+ */
+
+#include "SimBus.h"
+#include "s32_core_cm4.h"
+#include "CLOCK.h"
+#include "CRC_Driver.h"
+#include "PORT_Driver.h"
+#include "GPIO_Driver.h"
+#include "NVIC.h"
+#include "ADC_Driver.h"
+#include "Drv_Lpit.h"
+#include "MIDDLE_UART.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define SIM_POLL_SLEEP_US       (100U)
+#define SIM_ADC_MAX_SAMPLE      (4095U)
+#define SIM_ADC_STEP            (64)
+#define SIM_US_PER_SECOND       (1000000ULL)
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static pthread_mutex_t SimCore_Irq;
+static pthread_once_t SimCore_IrqOnce = PTHREAD_ONCE_INIT;
+static __thread uint32_t SimCore_IrqDepth = 0U;
+static __thread bool SimCore_IsPollPending = false;
+static pthread_t SimCore_MainThread;
+
+static IRQCallBack SimAdc_Callback = NULL;
+static uint16_t SimAdc_Sample = (SIM_ADC_MAX_SAMPLE / 2U);
+static unsigned int SimAdc_Seed = 1U;
+static bool SimAdc_IsRunning = false;
+
+static Lpit0_Callback_t SimLpit_Callback = NULL;
+static uint8_t SimLpit_Channel[DRV_LPIT_MAX_CHANNEL + 1U];
+
+static DRV_CallBack_LPUART SimUart_Callback[MID_UART_callBackReceiver + 1U];
+
+static CRC_ConfigType SimCrc_Config = { .Width = CRC_WIDTH_16BIT, .Poly = 0x1021U };
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void SimCore_IrqInit(void)
+{
+    pthread_mutexattr_t Attr;
+
+    /* ISR callbacks may call driver functions that disable interrupts again */
+    pthread_mutexattr_init(&Attr);
+    pthread_mutexattr_settype(&Attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&SimCore_Irq, &Attr);
+    pthread_mutexattr_destroy(&Attr);
+}
+
+static void SimAdc_Convert(void *Arg)
+{
+    int Sample = (int)SimAdc_Sample + (rand_r(&SimAdc_Seed) % (2 * SIM_ADC_STEP + 1)) - SIM_ADC_STEP;
+
+    /* Random walk over the full range, the ADC conversion complete interrupt */
+    Sample = (Sample < 0) ? 0 : ((Sample > (int)SIM_ADC_MAX_SAMPLE) ? (int)SIM_ADC_MAX_SAMPLE : Sample);
+    SimAdc_Sample = (uint16_t)Sample;
+
+    DISABLE_INTERRUPTS();
+
+    if(SimAdc_Callback != NULL)
+    {
+        SimAdc_Callback(SimAdc_Sample);
+    }
+
+    ENABLE_INTERRUPTS();
+}
+
+static void SimLpit_Expire(void *Arg)
+{
+    uint8_t Channel = *(uint8_t *)Arg;
+
+    DISABLE_INTERRUPTS();
+
+    if(SimLpit_Callback != NULL)
+    {
+        SimLpit_Callback(Channel);
+    }
+
+    ENABLE_INTERRUPTS();
+}
+
+/* ----------------------------------------------------------------------------
+   -- Public functions: node core
+   ---------------------------------------------------------------------------- */
+void SimCore_IrqLock(void)
+{
+    pthread_once(&SimCore_IrqOnce, SimCore_IrqInit);
+    pthread_mutex_lock(&SimCore_Irq);
+    SimCore_IrqDepth++;
+}
+
+void SimCore_IrqUnlock(void)
+{
+    SimCore_IrqDepth--;
+    pthread_mutex_unlock(&SimCore_Irq);
+
+    if(SimCore_IrqDepth == 0U && SimCore_IsPollPending == true)
+    {
+        SimCore_IsPollPending = false;
+        usleep(SIM_POLL_SLEEP_US);
+    }
+}
+
+void SimCore_Poll(void)
+{
+    /* Only the node main loop is throttled, never a bus or timer event */
+    if(pthread_equal(pthread_self(), SimCore_MainThread))
+    {
+        if(SimCore_IrqDepth == 0U)
+        {
+            usleep(SIM_POLL_SLEEP_US);
+        }
+        else
+        {
+            SimCore_IsPollPending = true;
+        }
+    }
+}
+
+/**
+ * @brief  Entry point of the node, called by sim_can on the node thread.
+ */
+void SimNode_Run(void)
+{
+    extern void SIM_NODE_ENTRY(void);
+
+    SimCore_MainThread = pthread_self();
+    SimAdc_Seed = (unsigned int)(uintptr_t)&SimAdc_Seed;
+
+    SIM_NODE_ENTRY();
+}
+
+/* ----------------------------------------------------------------------------
+   -- Public functions: drivers without behaviour on the host
+   ---------------------------------------------------------------------------- */
+void PCC_PeriClockControl(uint8_t PCCIndex, Clock_PeriClockSrc_e ClkSrc, Clock_ClkDiv_e DivVal, uint8_t EnOrDis)
+{
+}
+
+SCG_SysFreqType_e SCG_GetSysFreq(void)
+{
+    return SCG_SYS_FREQ_NORMALRUN;
+}
+
+void PORT_Driver_InitPin(PORT_PinConfig_type *pinConfig)
+{
+}
+
+void GPIO_Driver_ModeConfig(const GPIO_PinConfig_type *pinConfig)
+{
+}
+
+void GPIO_Driver_SetOutput(uint8_t pinCode)
+{
+}
+
+void GPIO_Driver_ClearOutput(uint8_t pinCode)
+{
+}
+
+void GPIO_Driver_ToggleOutput(uint8_t pinCode)
+{
+}
+
+void NVIC_EnableIRQn(IRQn_Type IRQn)
+{
+}
+
+void NVIC_DisableIRQn(IRQn_Type IRQn)
+{
+}
+
+/* ----------------------------------------------------------------------------
+   -- Public functions: ADC, conversions from the timer thread
+   ---------------------------------------------------------------------------- */
+ADC_Driver_ReturnCode_t DRV_ADC_Init(ADC_Type * AdcHwUnitId, ADC_Channel_type Channel, IRQCallBack CallBackFunction)
+{
+    SimAdc_Callback = CallBackFunction;
+
+    return ADC_DRIVER_RETURN_CODE_SUCCESSED;
+}
+
+ADC_Driver_ReturnCode_t DRV_ADC_EnableIRQ(ADC_Type * AdcHwUnitId, ADC_Channel_type Channel)
+{
+    ADC_Driver_ReturnCode_t RetVal = ADC_DRIVER_RETURN_CODE_SUCCESSED;
+
+    if(SimAdc_IsRunning == false)
+    {
+        SimAdc_IsRunning = SimTimer_Start(SimBus_GetConfig()->AdcPeriodUs, SimAdc_Convert, NULL);
+        RetVal = (SimAdc_IsRunning == true) ? ADC_DRIVER_RETURN_CODE_SUCCESSED : ADC_DRIVER_RETURN_CODE_ERROR;
+    }
+
+    return RetVal;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Public functions: LPIT, timer values in LPIT clock ticks
+   ---------------------------------------------------------------------------- */
+LpitStatusType DRV_LPIT_Init(LpitInsType Lpit_ins, const LpitConfigType * UserConfig)
+{
+    LpitStatusType RetVal = FAIL;
+
+    if(UserConfig != DRV_LPIT_NULL_PTR)
+    {
+        SimLpit_Callback = UserConfig->callback;
+        RetVal = SUCCESS;
+    }
+
+    return RetVal;
+}
+
+LpitStatusType DRV_LPIT_StartTimer(LpitInsType Lpit_ins, LpitChannelType channel, int64_t timer_value)
+{
+    LpitStatusType RetVal = FAIL;
+    uint64_t PeriodUs = 0U;
+
+    if(channel <= LPIT_CHANNEL_3 && timer_value > 0)
+    {
+        SimLpit_Channel[channel] = (uint8_t)channel;
+        SimTimer_Stop(SimLpit_Expire, &SimLpit_Channel[channel]);
+
+        PeriodUs = ((uint64_t)timer_value * SIM_US_PER_SECOND) / SimBus_GetConfig()->LpitClockHz;
+        PeriodUs = (PeriodUs == 0U) ? 1U : PeriodUs;
+
+        if(SimTimer_Start((uint32_t)PeriodUs, SimLpit_Expire, &SimLpit_Channel[channel]) == true)
+        {
+            RetVal = SUCCESS;
+        }
+    }
+
+    return RetVal;
+}
+
+LpitStatusType DRV_LPIT_StopTimer(LpitInsType Lpit_ins, LpitChannelType channel)
+{
+    LpitStatusType RetVal = FAIL;
+
+    if(channel <= LPIT_CHANNEL_3)
+    {
+        SimTimer_Stop(SimLpit_Expire, &SimLpit_Channel[channel]);
+        RetVal = SUCCESS;
+    }
+
+    return RetVal;
+}
+
+LpitStatusType DRV_LPIT_Deinit(LpitInsType Lpit_ins)
+{
+    uint8_t Channel = 0U;
+
+    for(Channel = 0U; Channel <= DRV_LPIT_MAX_CHANNEL; Channel++)
+    {
+        SimTimer_Stop(SimLpit_Expire, &SimLpit_Channel[Channel]);
+    }
+
+    SimLpit_Callback = NULL;
+
+    return SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Public functions: CRC, bit by bit like the shift register of the unit
+   ---------------------------------------------------------------------------- */
+void CRC_Init(const CRC_ConfigType *Config)
+{
+    if(Config != NULL)
+    {
+        SimCrc_Config = *Config;
+    }
+}
+
+uint32_t CRC_Calc(uint32_t Seed, const uint8_t *Data, uint32_t Length)
+{
+    uint32_t Width = (SimCrc_Config.Width == CRC_WIDTH_16BIT) ? 16U : 32U;
+    uint32_t TopBit = 1UL << (Width - 1U);
+    uint32_t Mask = (Width == 16U) ? 0xFFFFU : 0xFFFFFFFFU;
+    uint32_t Crc = Seed & Mask;
+    uint32_t Index = 0U;
+    uint8_t Bit = 0U;
+
+    for(Index = 0U; Index < Length; Index++)
+    {
+        Crc ^= (uint32_t)Data[Index] << (Width - 8U);
+
+        for(Bit = 0U; Bit < 8U; Bit++)
+        {
+            Crc = ((Crc & TopBit) != 0U) ? ((Crc << 1U) ^ SimCrc_Config.Poly) : (Crc << 1U);
+        }
+
+        Crc &= Mask;
+    }
+
+    return Crc;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Public functions: UART, no console on the host
+   ---------------------------------------------------------------------------- */
+void MID_UART_Init(void)
+{
+}
+
+void MID_UART_SetBaudRate(Drv_Uart_BaudrateValueType baudRate)
+{
+}
+
+void MID_UART_InstallCallBack(MID_UART_CallBackFunctionType callBackType, DRV_CallBack_LPUART cbFunction)
+{
+    if(callBackType <= MID_UART_callBackReceiver)
+    {
+        SimUart_Callback[callBackType] = cbFunction;
+    }
+}
+
+void MID_UART_ReceiveDataInterrupt(const MID_UART_InstanceType instance, const uint8_t *rxBuff, const uint16_t rxSize)
+{
+}
+
+bool MID_UART_SendDataInterrupt(const MID_UART_InstanceType instance, uint8_t *data, uint16_t length)
+{
+    /* The transfer completes at once */
+    if(SimUart_Callback[MID_UART_callBackTransmitter] != NULL)
+    {
+        SimUart_Callback[MID_UART_callBackTransmitter]();
+    }
+
+    return true;
+}
@@ -0,0 +1,213 @@
+/*
+ * SimRxBench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * Receive mode benchmark node: FlexCAN0 sends bursts of 8-byte frames to eight Rx mailboxes of
+ * FlexCAN1 of the same node, at growing frame rates, with the mailboxes served by interrupt, by
+ * polling and by the adaptive mode. It counts the interrupt entries and poll passes, turns them
+ * into a Cortex-M4 CPU load with the cycle costs below, and measures the Rx latency of the
+ * callback. The mailboxes come from MID_CAN_MbAlloc. The cycle costs are estimates, the counts are
+ * exact. Run it alone:
+ *   sim/run_sim.sh -n rxbench -t 60
+ */
+
+#include "SimBus.h"
+#include "Middleware_Header.h"
+#include <stdio.h>
+#include <unistd.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define RXBENCH_SENDER              (MODULE_0_INS)
+#define RXBENCH_RECEIVER            (MODULE_1_INS)
+#define RXBENCH_NO_OF_MBS           (8U)
+#define RXBENCH_ID                  (0x100U)
+#define RXBENCH_POINT_MS            (2000U)     /*!< Length of one measure */
+#define RXBENCH_SEND_PERIOD_MS      (1U)        /*!< The frames due are queued together, a burst */
+#define RXBENCH_POLL_PERIOD_US      (500U)      /*!< Main loop poll period */
+#define RXBENCH_LOOP_US             (50U)
+#define RXBENCH_DRAIN_MS            (20U)
+
+#define RXBENCH_CPU_HZ              (80000000U)
+#define RXBENCH_CYCLES_IRQ          (60U)       /*!< Exception entry and exit, IFLAG1, IMASK1 and TIMER reads */
+#define RXBENCH_CYCLES_POLL         (20U)       /*!< FlexCAN_RxPoll call and IFLAG1 read, idle calls included */
+#define RXBENCH_CYCLES_FRAME        (150U)      /*!< Event time, callback frame read and flag clear, any mode */
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static const uint16_t RxBench_Rates[] = { 100U, 500U, 1000U, 2000U, 3000U, 3500U };
+
+static const char * const RxBench_ModeNames[] = { "irq", "poll", "adaptive" };
+
+static FlexCAN_MbIndex_e RxBench_TxMb[RXBENCH_NO_OF_MBS];
+
+/* Written by the receive callback, interrupt or poll */
+static volatile uint32_t RxBench_Received;
+static volatile uint32_t RxBench_LatencySum;
+static volatile uint32_t RxBench_LatencyMax;
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void RxBench_RxHandler(FlexCAN_Instance_e Ins, uint8_t CallbackID, void *Context)
+{
+    FlexCAN_FrameType Frame;
+    uint32_t Latency = 0U;
+
+    if(MID_CAN_ReceiveFrame((MID_CAN_ModuleIns_e)Ins, (FlexCAN_MbIndex_e)CallbackID, &Frame) == true)
+    {
+        /* Bus end of frame to the interrupt or poll pass that served it */
+        Latency = Frame.IsrTimeStamp - Frame.TimeStamp;
+        RxBench_Received++;
+        RxBench_LatencySum += Latency;
+        RxBench_LatencyMax = (Latency > RxBench_LatencyMax) ? Latency : RxBench_LatencyMax;
+    }
+}
+
+static bool RxBench_Send(uint32_t Sequence)
+{
+    FlexCAN_FrameType Frame = { .IdType = FlexCAN_STANDARD, .DataLen = 8U };
+    uint8_t Index = 0U;
+    bool IsSent = false;
+
+    for(Index = 0U; Index < RXBENCH_NO_OF_MBS && IsSent == false; Index++)
+    {
+        if(FlexCAN_IsTxMbIdle((FlexCAN_Instance_e)RXBENCH_SENDER, RxBench_TxMb[Index]) == true)
+        {
+            Frame.Id = RXBENCH_ID + (Sequence & 0x7FU);
+            Frame.Data.Word[0] = Sequence;
+            Frame.Data.Word[1] = ~Sequence;
+            MID_CAN_TransmitFrame(RXBENCH_SENDER, RxBench_TxMb[Index], &Frame);
+            IsSent = true;
+        }
+    }
+
+    return IsSent;
+}
+
+/* One measure: frames sent at Rate for RXBENCH_POINT_MS, the receiver polled when Mode asks for it */
+static void RxBench_Point(FlexCAN_RxMode_e Mode, uint16_t Rate)
+{
+    uint32_t BitRate = SimBus_GetConfig()->BitRate;
+    uint32_t BitsPerMs = BitRate / 1000U;
+    FlexCAN_RxPollStatsType Stats;
+    uint32_t Start = SimBus_Now();
+    uint32_t LastPoll = Start;
+    uint32_t Elapsed = 0U;
+    uint32_t Sent = 0U;
+    uint32_t Due = 0U;
+    uint32_t Calls = 0U;
+    uint64_t Cycles = 0U;
+    uint32_t Received = 0U;
+
+    RxBench_Received = 0U;
+    RxBench_LatencySum = 0U;
+    RxBench_LatencyMax = 0U;
+
+    (void)FlexCAN_GetRxPollStats((FlexCAN_Instance_e)RXBENCH_RECEIVER, &Stats);
+
+    while(Elapsed < (RXBENCH_POINT_MS + RXBENCH_DRAIN_MS) * BitsPerMs)
+    {
+        Elapsed = SimBus_Now() - Start;
+
+        if(Elapsed < RXBENCH_POINT_MS * BitsPerMs)
+        {
+            /* Frames of the send periods that started */
+            Due = (uint32_t)((((uint64_t)(Elapsed / (RXBENCH_SEND_PERIOD_MS * BitsPerMs)) + 1U) * RXBENCH_SEND_PERIOD_MS * Rate) / 1000U);
+
+            while(Sent < Due && RxBench_Send(Sent) == true)
+            {
+                Sent++;
+            }
+        }
+
+        if(Mode != FlexCAN_RX_MODE_IRQ && (SimBus_Now() - LastPoll) >= (RXBENCH_POLL_PERIOD_US * (BitRate / 1000U)) / 1000U)
+        {
+            LastPoll = SimBus_Now();
+            (void)MID_CAN_RxPoll(RXBENCH_RECEIVER);
+            Calls++;
+        }
+
+        usleep(RXBENCH_LOOP_US);
+    }
+
+    (void)FlexCAN_GetRxPollStats((FlexCAN_Instance_e)RXBENCH_RECEIVER, &Stats);
+    Received = RxBench_Received;
+
+    Cycles = ((uint64_t)Stats.IrqEntries * RXBENCH_CYCLES_IRQ) + ((uint64_t)Calls * RXBENCH_CYCLES_POLL)
+           + ((uint64_t)Received * RXBENCH_CYCLES_FRAME);
+
+    printf("%-9s %6u %7lu %5lu %8lu %7.2f %8lu %8lu %7.3f %6.0f %6lu\n", RxBench_ModeNames[Mode], (unsigned int)Rate,
+           (unsigned long)Received, (unsigned long)(Sent - Received),
+           (unsigned long)((Stats.IrqEntries * 1000U) / RXBENCH_POINT_MS),
+           (Stats.IrqEntries != 0U) ? ((double)Stats.IrqFrames / Stats.IrqEntries) : 0.0,
+           (unsigned long)Stats.PollFrames, (unsigned long)Stats.Switches,
+           (100.0 * (double)Cycles) / ((double)RXBENCH_CPU_HZ * RXBENCH_POINT_MS / 1000.0),
+           (Received != 0U) ? ((1000000.0 * RxBench_LatencySum) / ((double)Received * BitRate)) : 0.0,
+           (unsigned long)((1000000ULL * RxBench_LatencyMax) / BitRate));
+    fflush(stdout);
+}
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void SimRxBench_Run(void)
+{
+    MID_CAN_MbRequestType TxRequest = { .MbType = FlexCAN_MB_TX, .Id = RXBENCH_ID, .IdType = FlexCAN_STANDARD,
+                                        .DataLen = 8U, .HandlerFunc = NULL };
+    MID_CAN_MbRequestType RxRequest = { .MbType = FlexCAN_MB_RX, .Id = RXBENCH_ID, .IdType = FlexCAN_STANDARD,
+                                        .Mask = 0x700U, .HandlerFunc = RxBench_RxHandler };
+    FlexCAN_RxPollConfigType Config = { .MbMask = 0U, .Budget = RXBENCH_NO_OF_MBS, .QuietFrames = 0U, .QuietPasses = 2U };
+    FlexCAN_MbIndex_e RxMb = MB0;
+    uint8_t Index = 0U;
+    uint8_t Mode = 0U;
+
+    MID_CAN_Init(RXBENCH_SENDER);
+    MID_CAN_Init(RXBENCH_RECEIVER);
+
+    for(Index = 0U; Index < RXBENCH_NO_OF_MBS; Index++)
+    {
+        /* Same filter in every Rx mailbox: a frame goes to the first empty one, an 8-deep queue */
+        if(MID_CAN_MbAlloc(RXBENCH_SENDER, &TxRequest, &RxBench_TxMb[Index]) == false
+           || MID_CAN_MbAlloc(RXBENCH_RECEIVER, &RxRequest, &RxMb) == false)
+        {
+            printf("rxbench: mailbox allocation failed\n");
+            fflush(stdout);
+            _exit(1);
+        }
+
+        Config.MbMask |= (1UL << RxMb);
+    }
+
+    printf("Rx modes, 8 Rx MBs up to MAXMB %u, frames queued every %u ms, poll every %u us, %u s per point\n",
+           (unsigned int)MID_CAN_GetMaxMb(RXBENCH_RECEIVER), (unsigned int)RXBENCH_SEND_PERIOD_MS,
+           (unsigned int)RXBENCH_POLL_PERIOD_US, (unsigned int)(RXBENCH_POINT_MS / 1000U));
+    printf("CPU load at %u MHz with %u cycles per interrupt, %u per poll call and %u per frame\n",
+           (unsigned int)(RXBENCH_CPU_HZ / 1000000U), (unsigned int)RXBENCH_CYCLES_IRQ,
+           (unsigned int)RXBENCH_CYCLES_POLL, (unsigned int)RXBENCH_CYCLES_FRAME);
+    printf("%-9s %6s %7s %5s %8s %7s %8s %8s %7s %6s %6s\n", "mode", "fr/s", "frames", "lost", "irq/s",
+           "fr/irq", "polled", "switches", "cpu %", "lat us", "max us");
+
+    for(Mode = FlexCAN_RX_MODE_IRQ; Mode <= FlexCAN_RX_MODE_ADAPTIVE; Mode++)
+    {
+        Config.Mode = (FlexCAN_RxMode_e)Mode;
+
+        for(Index = 0U; Index < sizeof(RxBench_Rates) / sizeof(RxBench_Rates[0]); Index++)
+        {
+            if(MID_CAN_SetRxMode(RXBENCH_RECEIVER, &Config) == false)
+            {
+                printf("rxbench: receive mode rejected\n");
+                fflush(stdout);
+                _exit(1);
+            }
+
+            RxBench_Point(Config.Mode, RxBench_Rates[Index]);
+        }
+    }
+
+    _exit(0);
+}
@@ -0,0 +1,193 @@
+/*
+ * SimTpBench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ *
+ * ISO-TP throughput benchmark node: FlexCAN0 sends to FlexCAN1 of the same node over the virtual
+ * bus, for every block size and STmin of the sweep, and prints the payload rate. Run it alone:
+ *   sim/run_sim.sh -n tpbench -t 120
+ */
+
+#include "SimBus.h"
+#include "Middleware_Header.h"
+#include <stdio.h>
+#include <unistd.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define TPBENCH_LENGTH              (MID_CAN_TP_MAX_LENGTH)
+#define TPBENCH_TRANSFERS           (3U)
+#define TPBENCH_TIMEOUT_MS          (1000U)
+#define TPBENCH_SENDER              (MODULE_0_INS)
+#define TPBENCH_RECEIVER            (MODULE_1_INS)
+#define TPBENCH_ID_REQUEST          (0x7E0U)
+#define TPBENCH_ID_RESPONSE         (0x7E8U)
+
+typedef enum
+{
+    TPBENCH_BUSY = 0U,
+    TPBENCH_DONE,
+    TPBENCH_FAILED
+} TpBench_Status_e;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static const uint8_t TpBench_BlockSize[] = { 0U, 1U, 4U, 8U, 16U };
+static const uint8_t TpBench_STmin[] = { 0U, MID_CAN_TP_STMIN_US(500U), 1U, 2U };
+
+static uint8_t TpBench_TxData[TPBENCH_LENGTH];
+static uint8_t TpBench_RxData[TPBENCH_LENGTH];
+static volatile TpBench_Status_e TpBench_Status = TPBENCH_BUSY;
+
+static void TpBench_RxIndication(MID_CAN_ModuleIns_e Ins, uint8_t Channel, const uint8_t *Data,
+                                 uint16_t Length, MID_CAN_TpResult_e Result);
+static void TpBench_TxConfirmation(MID_CAN_ModuleIns_e Ins, uint8_t Channel, MID_CAN_TpResult_e Result);
+
+static const MID_CAN_TpChannelConfigType TpBench_SenderCfg =
+{
+    .TxId = TPBENCH_ID_REQUEST,
+    .RxId = TPBENCH_ID_RESPONSE,
+    .IdType = FlexCAN_STANDARD,
+    .TxMbIndex = MB8,
+    .RxMbIndex = MB9,
+    .TimeoutMs = TPBENCH_TIMEOUT_MS,
+    .IsPadded = true,
+    .Padding = 0xCCU,
+    .TxConfirmation = TpBench_TxConfirmation
+};
+
+static const MID_CAN_TpChannelConfigType TpBench_ReceiverCfg =
+{
+    .TxId = TPBENCH_ID_RESPONSE,
+    .RxId = TPBENCH_ID_REQUEST,
+    .IdType = FlexCAN_STANDARD,
+    .TxMbIndex = MB8,
+    .RxMbIndex = MB9,
+    .TimeoutMs = TPBENCH_TIMEOUT_MS,
+    .IsPadded = true,
+    .Padding = 0xCCU,
+    .RxBuffer = TpBench_RxData,
+    .RxBufferSize = TPBENCH_LENGTH,
+    .RxIndication = TpBench_RxIndication
+};
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void TpBench_RxIndication(MID_CAN_ModuleIns_e Ins, uint8_t Channel, const uint8_t *Data,
+                                 uint16_t Length, MID_CAN_TpResult_e Result)
+{
+    bool IsValid = (Result == MID_CAN_TP_OK && Length == TPBENCH_LENGTH);
+    uint16_t Index = 0U;
+
+    for(Index = 0U; Index < Length && IsValid == true; Index++)
+    {
+        IsValid = (Data[Index] == TpBench_TxData[Index]);
+    }
+
+    TpBench_Status = (IsValid == true) ? TPBENCH_DONE : TPBENCH_FAILED;
+}
+
+static void TpBench_TxConfirmation(MID_CAN_ModuleIns_e Ins, uint8_t Channel, MID_CAN_TpResult_e Result)
+{
+    if(Result != MID_CAN_TP_OK)
+    {
+        TpBench_Status = TPBENCH_FAILED;
+    }
+}
+
+/* Bit times of one transfer, 0 if it failed */
+static uint32_t TpBench_Transfer(void)
+{
+    uint32_t Start = 0U;
+
+    TpBench_Status = TPBENCH_BUSY;
+    Start = FlexCAN_GetTime((FlexCAN_Instance_e)TPBENCH_SENDER);
+
+    if(MID_CAN_TpTransmit(TPBENCH_SENDER, 0U, TpBench_TxData, TPBENCH_LENGTH) == false)
+    {
+        TpBench_Status = TPBENCH_FAILED;
+    }
+
+    while(TpBench_Status == TPBENCH_BUSY)
+    {
+        MID_CAN_TpMainFunction(TPBENCH_SENDER);
+        MID_CAN_TpMainFunction(TPBENCH_RECEIVER);
+        SimCore_Poll();
+    }
+
+    return (TpBench_Status == TPBENCH_DONE) ? (FlexCAN_GetTime((FlexCAN_Instance_e)TPBENCH_SENDER) - Start) : 0U;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void SimTpBench_Run(void)
+{
+    uint32_t BitRate = SimBus_GetConfig()->BitRate;
+    uint32_t Ticks = 0U;
+    uint32_t Total = 0U;
+    uint32_t Index = 0U;
+    uint8_t Bs = 0U;
+    uint8_t St = 0U;
+    bool IsFailed = false;
+
+    for(Index = 0U; Index < TPBENCH_LENGTH; Index++)
+    {
+        TpBench_TxData[Index] = (uint8_t)((Index * 7U) + (Index >> 8U));
+    }
+
+    MID_CAN_Init(TPBENCH_SENDER);
+    MID_CAN_Init(TPBENCH_RECEIVER);
+
+    if(MID_CAN_TpInit(TPBENCH_SENDER, &TpBench_SenderCfg, 1U) == false
+       || MID_CAN_TpInit(TPBENCH_RECEIVER, &TpBench_ReceiverCfg, 1U) == false)
+    {
+        printf("tpbench: ISO-TP init failed\n");
+        fflush(stdout);
+        _exit(1);
+    }
+
+    printf("ISO-TP %u byte transfers at %u bit/s, payload bytes/s (mean of %u)\n",
+           (unsigned int)TPBENCH_LENGTH, (unsigned int)BitRate, (unsigned int)TPBENCH_TRANSFERS);
+    printf("%6s %10s %10s %10s %10s\n", "BS", "STmin 0", "500 us", "1 ms", "2 ms");
+
+    for(Bs = 0U; Bs < sizeof(TpBench_BlockSize); Bs++)
+    {
+        printf("%6u", (unsigned int)TpBench_BlockSize[Bs]);
+
+        for(St = 0U; St < sizeof(TpBench_STmin); St++)
+        {
+            MID_CAN_TpSetRxParameters(TPBENCH_RECEIVER, 0U, TpBench_BlockSize[Bs], TpBench_STmin[St]);
+            Total = 0U;
+            IsFailed = false;
+
+            for(Index = 0U; Index < TPBENCH_TRANSFERS && IsFailed == false; Index++)
+            {
+                Ticks = TpBench_Transfer();
+                IsFailed = (Ticks == 0U);
+                Total += Ticks;
+            }
+
+            if(IsFailed == true)
+            {
+                printf(" %10s", "failed");
+            }
+            else
+            {
+                /* Timer ticks are bit times */
+                printf(" %10llu", ((unsigned long long)TPBENCH_LENGTH * TPBENCH_TRANSFERS * BitRate) / Total);
+            }
+
+            fflush(stdout);
+        }
+
+        printf("\n");
+    }
+
+    fflush(stdout);
+    _exit(0);
+}
@@ -15,43 +15,38 @@
 #include "Driver_Header.h"
 
 /*****************************************************************************/
-/* Enumerations                                                              */
+/* Definitions                                                               */
 /*****************************************************************************/
-/* Define enumerations for CAN states, error states, and connection states.  */
 
-/**
- * @brief Enumeration for CAN speed states.
- *
- * Defines the possible states of the CAN speed readiness.
- */
-typedef enum {
-    CAN_SPEED_READY = 0u,     /*!< CAN speed is ready */
-    CAN_SPEED_NOT_READY,      /*!< CAN speed is not ready */
-    CAN_TEMP_READY,           /*!< CAN temperature is ready */
-    CAN_TEMP_NOT_READY,       /*!< CAN temperature is not ready */
-} CAN_State_t;
+/* UART response: "49", two hex digits per node, the checksum, "53\n" and the terminator */
+#define FWD_UART_MSG_LENGTH (8u + (2u * FWD_NODE_COUNT))
+
+/*****************************************************************************/
+/* Enumerations                                                              */
+/*****************************************************************************/
+/* Define enumerations for error states and connection states.              */
 
 /**
- * @brief Enumeration for temperature error states.
+ * @brief Enumeration for node error states.
  *
- * Defines the possible states of temperature error.
+ * Defines the possible heartbeat states of a node.
  */
 typedef enum {
-    TEMP_ERROR = 0u,         /*!< There is a temperature error */
-    TEMP_NOT_ERROR = 1u,     /*!< No temperature error */
-    TEMP_STILL_ERROR,        /*!< Temperature error persists */
-} TEMP_ERROR_State_t;
+    NODE_ERROR = 0u,         /*!< No heartbeat in the last period */
+    NODE_NOT_ERROR = 1u,     /*!< Heartbeat received */
+    NODE_STILL_ERROR,        /*!< No heartbeat for two periods, the node value is invalid */
+} NODE_ERROR_State_t;
 
 /**
- * @brief Enumeration for speed error states.
+ * @brief Nodes routed by the forwarder, also the tag of their route.
  *
- * Defines the possible states of speed error.
+ * The order is the order of the values in the UART response.
  */
 typedef enum {
-    SPEED_ERROR = 0u,        /*!< There is a speed error */
-    SPEED_NOT_ERROR = 1u,    /*!< No speed error */
-    SPEED_STILL_ERROR,       /*!< Speed error persists */
-} SPEED_ERROR_State_t;
+    FWD_NODE_TEMP = 0u,      /*!< Temperature node */
+    FWD_NODE_SPEED,          /*!< Speed node */
+    FWD_NODE_COUNT           /*!< Number of nodes */
+} FWD_Node_t;
 
 /**
  * @brief Enumeration for forwarder connection states.
@@ -69,13 +64,16 @@ typedef enum {
 /* Define a data structure for storing speed and temperature data.           */
 
 /**
- * @brief Data structure to store speed and temperature data of the node.
+ * @brief Data structure to store the data of the nodes.
  *
- * This structure holds the speed and temperature data that will be used for processing.
+ * This structure holds the node values that will be used for processing, indexed by FWD_Node_t.
+ * The main loop is its only writer, readers take a consistent copy of it from a snapshot.
  */
 typedef struct {
-    uint8_t NODE_Speed_Data;   /*!< The speed data of the node */
-    uint8_t NODE_Temp_Data;    /*!< The temperature data of the node */
+    uint8_t NODE_Data[FWD_NODE_COUNT];              /*!< The value of each node */
+    uint8_t NODE_Status[FWD_NODE_COUNT];            /*!< CAN health state reported by each node */
+    NODE_ERROR_State_t NODE_Quality[FWD_NODE_COUNT]; /*!< Heartbeat state of each node when the set was published */
+    uint32_t NODE_TimeStamp[FWD_NODE_COUNT];        /*!< CAN time of the last PDU of each node, bit times */
 } Data_t;
 
 /*****************************************************************************/
@@ -95,4 +93,28 @@ typedef struct {
  */
 void App_Forwarder_Run(void);
 
+/**
+ * @brief Runs the forwarder board as a bus monitor instead of the forwarder.
+ *
+ * CAN0 listens to the bus without acknowledging anything and every frame is streamed
+ * over LPUART1 in the MIDDLE_CanSniffer.h record format. The red LED turns on once a
+ * frame is lost.
+ *
+ * @param None
+ * @return None
+ */
+void App_Forwarder_Sniffer_Run(void);
+
+/**
+ * @brief Runs the forwarder board as a bus statistics monitor instead of the forwarder.
+ *
+ * CAN0 listens to the bus without acknowledging anything, every frame is counted per ID and
+ * in the bus load, and a text report goes out over LPUART1 every second. The red LED is on
+ * while the last second had error frames.
+ *
+ * @param None
+ * @return None
+ */
+void App_Forwarder_Monitor_Run(void);
+
 #endif /* NODE_FORWARDER_H_ */
@@ -9,13 +9,17 @@
 /* Includes */
 /******************************************************************************/
 #include "node_forwarder.h"
+#include "node_speed.h"
+#include "node_temp.h"
 #include <stdio.h>
 
 /******************************************************************************/
 /* Definations */
 /******************************************************************************/
 
-#define RX_MB_COUNT 4
+#define RX_RING_LENGTH 16
+#define MONITOR_RING_LENGTH 16
+#define MONITOR_DUMP_PERIOD_MS 1000
 #define DEFAULT_UART_MSG 0
 #define STD_UART_MSG 125
 #define ERROR_VALUE 250
@@ -24,53 +28,161 @@
 #define THRESHOLD_TEMP_HIGH 37
 #define THRESHOLD_TEMP_LOW 15
 
+/* Every node has a value slot and a status slot in the gateway */
+#define FWD_SLOT_VALUE(Node) ((uint8_t)((Node) * 2U))
+#define FWD_SLOT_STATUS(Node) ((uint8_t)(((Node) * 2U) + 1U))
+
 /******************************************************************************/
-/* Variables */
+/* Callback Prototypes */
 /******************************************************************************/
+void App_NodePdu_Notification(MID_CAN_ModuleIns_e Ins, uint8_t Node, const FlexCAN_FrameType *Frame);
 
-CAN_State_t g_CAN_TEMP_State = CAN_TEMP_NOT_READY;
-CAN_State_t g_CAN_SPEED_State = CAN_SPEED_NOT_READY;
+/******************************************************************************/
+/* Routing Configuration */
+/******************************************************************************/
 
-TEMP_ERROR_State_t Temp_Error_State = TEMP_ERROR;
-SPEED_ERROR_State_t Speed_Error_State = SPEED_ERROR;
+static const MID_CAN_GwSignalType Fwd_TempSignals[] = {
+	{ .Slot = FWD_SLOT_VALUE(FWD_NODE_TEMP), .StartBit = TEMP_SIG_VALUE_START_BIT,
+	  .Length = TEMP_SIG_VALUE_LENGTH, .UpdateBit = TEMP_SIG_VALUE_UPDATE_BIT },
+	{ .Slot = FWD_SLOT_STATUS(FWD_NODE_TEMP), .StartBit = TEMP_SIG_STATUS_START_BIT,
+	  .Length = TEMP_SIG_STATUS_LENGTH, .UpdateBit = MID_CAN_GW_NO_UPDATE_BIT }
+};
 
-Data_t g_Data = {
-	.NODE_Speed_Data = 0,
-	.NODE_Temp_Data = 0
+static const MID_CAN_GwSignalType Fwd_SpeedSignals[] = {
+	{ .Slot = FWD_SLOT_VALUE(FWD_NODE_SPEED), .StartBit = SPEED_SIG_VALUE_START_BIT,
+	  .Length = SPEED_SIG_VALUE_LENGTH, .UpdateBit = SPEED_SIG_VALUE_UPDATE_BIT },
+	{ .Slot = FWD_SLOT_STATUS(FWD_NODE_SPEED), .StartBit = SPEED_SIG_STATUS_START_BIT,
+	  .Length = SPEED_SIG_STATUS_LENGTH, .UpdateBit = MID_CAN_GW_NO_UPDATE_BIT }
 };
-uint8_t g_Msg = 0;
-uint8_t UART_Respone_Msg[12] = {0};
-uint8_t Request_CAN = 0x07;
 
-FWD_Connect_State_t FWD_Connect_State = FWD_NOT_OK;
+static const MID_CAN_E2EConfigType Fwd_TempE2E = TEMP_E2E_CONFIG;
+static const MID_CAN_E2EConfigType Fwd_SpeedE2E = SPEED_E2E_CONFIG;
+
+/* One route per node, tagged with the node index. A node PDU is also the heartbeat of its node,
+ * one failing its E2E check (corrupted, or a stuck node repeating itself) does not count */
+static const MID_CAN_GwRouteType Fwd_Routes[] = {
+	{
+		.Id = TEMP_PDU_ID,
+		.IdType = FlexCAN_STANDARD,
+		.SrcIns = MODULE_0_INS,
+		.Actions = MID_CAN_GW_SIGNAL | MID_CAN_GW_NOTIFY,
+		.Signals = Fwd_TempSignals,
+		.NoOfSignals = sizeof(Fwd_TempSignals) / sizeof(Fwd_TempSignals[0]),
+		.Tag = FWD_NODE_TEMP,
+		.Notification = App_NodePdu_Notification,
+		.E2E = &Fwd_TempE2E},
+	{
+		.Id = SPEED_PDU_ID,
+		.IdType = FlexCAN_STANDARD,
+		.SrcIns = MODULE_0_INS,
+		.Actions = MID_CAN_GW_SIGNAL | MID_CAN_GW_NOTIFY,
+		.Signals = Fwd_SpeedSignals,
+		.NoOfSignals = sizeof(Fwd_SpeedSignals) / sizeof(Fwd_SpeedSignals[0]),
+		.Tag = FWD_NODE_SPEED,
+		.Notification = App_NodePdu_Notification,
+		.E2E = &Fwd_SpeedE2E}
+};
+
+#define FWD_ROUTE_COUNT (sizeof(Fwd_Routes) / sizeof(Fwd_Routes[0]))
+
+/* Request mailbox of a node, from the first MB after the Rx FIFO filter elements */
+#define REQUEST_TX_MB(Node) ((FlexCAN_MbIndex_e)(FLEXCAN_RXFIFO_FIRST_FREE_MB(FWD_ROUTE_COUNT) + (Node)))
+
+/* Data requests: a remote frame with the node PDU ID, answered by the node controller with its
+ * last PDU, which comes in through the routes. Sent by polling, no callback */
+#define FWD_MB_LAYOUT(X) \
+	X(REMOTE, REQUEST_TX_MB(FWD_NODE_TEMP), TEMP_PDU_ID, FlexCAN_STANDARD, TEMP_PDU_LENGTH, NULL) \
+	X(REMOTE, REQUEST_TX_MB(FWD_NODE_SPEED), SPEED_PDU_ID, FlexCAN_STANDARD, SPEED_PDU_LENGTH, NULL)
+
+static const FlexCAN_MbLayoutType Fwd_MbLayout[] = {
+	FWD_MB_LAYOUT(MID_CAN_MB_LAYOUT_ENTRY)
+};
+
+static const MID_CAN_GwConfigType Fwd_GwCfg = {
+	.Routes = Fwd_Routes,
+	.NoOfRoutes = FWD_ROUTE_COUNT
+};
+
+static const MID_CAN_SnifferConfigType Fwd_SnifferCfg = {
+	.Ins = MODULE_0_INS,
+	.UseDma = false,
+	.DmaChannel = 0
+};
 
 /******************************************************************************/
-/* Callback Prototypes */
+/* Variables */
 /******************************************************************************/
-void App_NewTempValue_Notification(void);
-void App_NewTempPing_Notification(void);
-void App_NewSpeedValue_Notification(void);
-void App_NewSpeedPing_Notification(void);
 
+NODE_ERROR_State_t Node_Error_State[FWD_NODE_COUNT] = {NODE_ERROR};
+
+/* Writer copy of the node data, main loop only. Readers use g_Data_Snapshot */
+Data_t g_Data = {
+	.NODE_Data = {0},
+	.NODE_Status = {0},
+	.NODE_Quality = {NODE_ERROR},
+	.NODE_TimeStamp = {0}
+};
+MID_SNAPSHOT_DEFINE(static, g_Data_Snapshot, Data_t);
+uint8_t g_Msg = 0;
+uint8_t UART_Respone_Msg[FWD_UART_MSG_LENGTH] = {0};
+uint8_t Request_CAN[FLEXCAN_FRAME_MAX_DATA_LEN] = {0};	/* A remote frame carries no data */
+
+FWD_Connect_State_t FWD_Connect_State = FWD_NOT_OK;
 
+/* Frames accepted by the Rx FIFO, one filter per route, everything else is dropped by hardware */
+FlexCAN_RxFifoIdFilterType Rx_Filter_Table[FWD_ROUTE_COUNT];
+
+/* Ring filled by the Rx FIFO interrupt, drained by the main loop */
+FlexCAN_MbStructureType Rx_Ring[RX_RING_LENGTH];
+
+FlexCAN_RxFifoConfigType Rx_Fifo_Config = {
+	.Mode = FlexCAN_RXFIFO_LEGACY,
+	.IdFilterTable = Rx_Filter_Table,
+	.NoOfIdFilters = FWD_ROUTE_COUNT,
+	.GlobalMask = FLEXCAN_RXFIFO_STD_MASK(0x7FF),
+	.UseDma = false,
+	.DmaChannel = 0,
+	.RingBuffer = Rx_Ring,
+	.RingLength = RX_RING_LENGTH,
+	.BatchCallback = NULL
+};
 
-void (*CallBack_arr[RX_MB_COUNT])(void) = {App_NewTempValue_Notification, App_NewSpeedValue_Notification, App_NewTempPing_Notification, App_NewSpeedPing_Notification};
-MID_CAN_Handler_e Handler_Type_arr[RX_MB_COUNT] = {MIDDLE_HANDLER_MB_0_TYPE, MIDDLE_HANDLER_MB_1_TYPE, MIDDLE_HANDLER_MB_6_TYPE, MIDDLE_HANDLER_MB_7_TYPE};
-FlexCAN_MbIndex_e ReceiveMB[RX_MB_COUNT] = {MB0, MB1, MB6, MB7};
-uint32_t ReceiveMB_Adr[RX_MB_COUNT] = {0x11, 0x22, 0x33, 0x44};
+/* Bus monitor: no ID filter and a zero global mask, the statistics see every frame in the FIFO
+ * interrupt, the ring is only emptied */
+FlexCAN_MbStructureType Monitor_Ring[MONITOR_RING_LENGTH];
+
+FlexCAN_RxFifoConfigType Monitor_Fifo_Config = {
+	.Mode = FlexCAN_RXFIFO_LEGACY,
+	.IdFilterTable = NULL,
+	.NoOfIdFilters = 0,
+	.GlobalMask = 0,
+	.UseDma = false,
+	.DmaChannel = 0,
+	.RingBuffer = Monitor_Ring,
+	.RingLength = MONITOR_RING_LENGTH,
+	.BatchCallback = NULL
+};
 
 /******************************************************************************/
 /* Local APIs */
 /******************************************************************************/
 
 /**
- * @brief Creates a formatted string based on temperature and speed data.
+ * @brief Creates the UART response: "49", the value of every node, their 8-bit sum and "53".
  */
 static void createString(const Data_t* data, uint8_t* output, size_t outputSize) {
-	uint8_t dataTemp = data->NODE_Temp_Data;
-	uint8_t dataSpeed = data->NODE_Speed_Data;
+	size_t length = 0;
+	uint8_t checksum = 0;
+	uint8_t node;
     if (data != NULL && output != NULL) {
-    	snprintf((char*)output, outputSize, "49%02x%02x%02x53\n", dataTemp, dataSpeed, (uint8_t)(dataTemp+dataSpeed));
+    	length = snprintf((char*)output, outputSize, "49");
+    	for (node = 0; node < FWD_NODE_COUNT && length < outputSize; node++) {
+    		length += snprintf((char*)output + length, outputSize - length, "%02x", data->NODE_Data[node]);
+    		checksum += data->NODE_Data[node];
+    	}
+    	if (length < outputSize) {
+    		snprintf((char*)output + length, outputSize - length, "%02x53\n", checksum);
+    	}
     }
 }
 
@@ -80,8 +192,12 @@ static void createString(const Data_t* data, uint8_t* output, size_t outputSize)
  */
 static void App_Process_UART_Request(uint8_t* Rcv_Msg)
 {
+	Data_t Data;
+
 	if(*Rcv_Msg  == STD_UART_MSG){
-		createString(&g_Data, UART_Respone_Msg, sizeof(UART_Respone_Msg));
+		/* All values of the response come from the same publication */
+		MID_SnapshotRead(&g_Data_Snapshot, &Data);
+		createString(&Data, UART_Respone_Msg, sizeof(UART_Respone_Msg));
 		MID_UART_SendDataInterrupt(MID_UART_instance_1,
 						(uint8_t*)UART_Respone_Msg, sizeof(UART_Respone_Msg));
 		*Rcv_Msg = DEFAULT_UART_MSG;
@@ -89,16 +205,40 @@ static void App_Process_UART_Request(uint8_t* Rcv_Msg)
 }
 
 /**
- * @brief Processes new temperature or speed values received via CAN.
+ * @brief Drains the CAN Rx FIFO ring, the gateway runs the route of every frame.
+ */
+static void App_Process_CAN_NewValue(void)
+{
+	FlexCAN_FrameType Frame;
+
+	while(MID_CAN_RxFifoRead(MODULE_0_INS, &Frame) == true){
+		MID_CAN_GwRxIndication(MODULE_0_INS, &Frame);
+	}
+}
+
+/**
+ * @brief Takes the heartbeat states advanced by the LPIT interrupt into the node data.
+ *
+ * A node without heartbeat for two periods gets ERROR_VALUE.
  */
-static void App_Process_CAN_NewValue(CAN_State_t *state)
+static void App_Process_NodeState(void)
 {
-	if(*state == CAN_SPEED_READY){
-		MID_CAN_Receive(MODULE_0_INS, MB1, &(g_Data.NODE_Speed_Data));
-		*state = CAN_SPEED_NOT_READY;
-	}else if(*state == CAN_TEMP_READY){
-		MID_CAN_Receive(MODULE_0_INS, MB0, &(g_Data.NODE_Temp_Data));
-		*state = CAN_TEMP_NOT_READY;
+	NODE_ERROR_State_t State;
+	bool IsChanged = false;
+	uint8_t node;
+
+	for(node = 0; node < FWD_NODE_COUNT; node++){
+		State = Node_Error_State[node];
+		if(g_Data.NODE_Quality[node] != State){
+			g_Data.NODE_Quality[node] = State;
+			if(State == NODE_STILL_ERROR){
+				g_Data.NODE_Data[node] = ERROR_VALUE;
+			}
+			IsChanged = true;
+		}
+	}
+	if(IsChanged == true){
+		MID_SnapshotPublish(&g_Data_Snapshot, &g_Data);
 	}
 }
 
@@ -107,12 +247,16 @@ static void App_Process_CAN_NewValue(CAN_State_t *state)
  */
 static void App_Process_LEDWarning(void)
 {
-	if (g_Data.NODE_Temp_Data > THRESHOLD_TEMP_HIGH && g_Data.NODE_Temp_Data != ERROR_VALUE)
+	Data_t Data;
+
+	MID_SnapshotRead(&g_Data_Snapshot, &Data);
+
+	if (Data.NODE_Data[FWD_NODE_TEMP] > THRESHOLD_TEMP_HIGH && Data.NODE_Data[FWD_NODE_TEMP] != ERROR_VALUE)
 	{
 		MID_GPIO_LEDOn(RED);
 		MID_GPIO_LEDOff(BLUE);
 	}
-	else if (g_Data.NODE_Temp_Data < THRESHOLD_TEMP_LOW)
+	else if (Data.NODE_Data[FWD_NODE_TEMP] < THRESHOLD_TEMP_LOW)
 	{
 		MID_GPIO_LEDOn(BLUE);
 		MID_GPIO_LEDOff(RED);
@@ -122,7 +266,7 @@ static void App_Process_LEDWarning(void)
 		MID_GPIO_LEDOff(RED);
 		MID_GPIO_LEDOff(BLUE);
 	}
-	if (g_Data.NODE_Speed_Data > THRESHOLD_SPEED && g_Data.NODE_Speed_Data != ERROR_VALUE)
+	if (Data.NODE_Data[FWD_NODE_SPEED] > THRESHOLD_SPEED && Data.NODE_Data[FWD_NODE_SPEED] != ERROR_VALUE)
 	{
 		MID_GPIO_LEDOn(GREEN);
 	}
@@ -138,63 +282,44 @@ static void App_Process_LEDWarning(void)
 /******************************************************************************/
 
 /**
- * @brief Periodically checks for temperature and speed errors via ping.
+ * @brief Periodically checks every node for a missing heartbeat.
+ *
+ * LPIT interrupt: only advances the heartbeat states, the main loop applies them to the node data.
  */
 void App_CheckPing_Notification(uint8_t channel)
 {
-	if(Speed_Error_State == SPEED_NOT_ERROR){
-		Speed_Error_State = SPEED_ERROR;
-	}else if(Speed_Error_State == SPEED_ERROR){
-		Speed_Error_State = SPEED_STILL_ERROR;
-		g_Data.NODE_Speed_Data = ERROR_VALUE;
-	}else{
+	uint8_t node;
 
-	}
+	for(node = 0; node < FWD_NODE_COUNT; node++){
+		if(Node_Error_State[node] == NODE_NOT_ERROR){
+			Node_Error_State[node] = NODE_ERROR;
+		}else if(Node_Error_State[node] == NODE_ERROR){
+			Node_Error_State[node] = NODE_STILL_ERROR;
+		}else{
 
-	if(Temp_Error_State == TEMP_NOT_ERROR){
-		Temp_Error_State = TEMP_ERROR;
-	}else if(Temp_Error_State == TEMP_ERROR){
-		Temp_Error_State = TEMP_STILL_ERROR;
-		g_Data.NODE_Temp_Data = ERROR_VALUE;
+		}
 	}
 }
 
 /**
- * @brief Sets the CAN state to ready when new temperature data is available.
+ * @brief Node PDU routed: takes the new values and counts the PDU as the node heartbeat.
+ *
+ * Runs in the main loop through the gateway and publishes the new node data.
  */
-void App_NewTempValue_Notification(void)
+void App_NodePdu_Notification(MID_CAN_ModuleIns_e Ins, uint8_t Node, const FlexCAN_FrameType *Frame)
 {
-	g_CAN_TEMP_State = CAN_TEMP_READY;
-}
+	uint32_t Value = 0;
 
-/**
- * @brief Resets temperature error state and sends a CAN request if needed.
- */
-void App_NewTempPing_Notification(void)
-{
-	if(Temp_Error_State == TEMP_STILL_ERROR){
-		MID_CAN_Transmit(MODULE_0_INS, MB5, &Request_CAN);
+	if(MID_CAN_GwReadSlot(FWD_SLOT_VALUE(Node), &Value) == true){
+		g_Data.NODE_Data[Node] = (uint8_t)Value;
 	}
-	Temp_Error_State = TEMP_NOT_ERROR;
-}
-
-/**
- * @brief Sets the CAN state to ready when new speed data is available.
- */
-void App_NewSpeedValue_Notification(void)
-{
-	g_CAN_SPEED_State = CAN_SPEED_READY;
-}
-
-/**
- * @brief Resets speed error state and sends a CAN request if needed.
- */
-void App_NewSpeedPing_Notification(void)
-{
-	if(Speed_Error_State == SPEED_STILL_ERROR){
-		MID_CAN_Transmit(MODULE_0_INS, MB5, &Request_CAN);
+	if(MID_CAN_GwReadSlot(FWD_SLOT_STATUS(Node), &Value) == true){
+		g_Data.NODE_Status[Node] = (uint8_t)Value;
 	}
-	Speed_Error_State = SPEED_NOT_ERROR;
+	Node_Error_State[Node] = NODE_NOT_ERROR;
+	g_Data.NODE_Quality[Node] = NODE_NOT_ERROR;
+	g_Data.NODE_TimeStamp[Node] = Frame->TimeStamp;
+	MID_SnapshotPublish(&g_Data_Snapshot, &g_Data);
 }
 
 /**
@@ -214,6 +339,8 @@ void App_Check_Request_UART(void)
  */
 void App_Forwarder_Run(void)
 {
+		uint8_t route;
+		uint8_t node;
 
 		/*GPIO Init*/
 
@@ -224,26 +351,17 @@ void App_Forwarder_Run(void)
 
 		/*CAN Init*/
 
+		for(route = 0; route < FWD_ROUTE_COUNT; route++){
+			Rx_Filter_Table[route].Id = Fwd_Routes[route].Id;
+			Rx_Filter_Table[route].IdType = Fwd_Routes[route].IdType;
+			Rx_Filter_Table[route].IsRemote = false;
+		}
+
+	    MID_CAN_SetRxFifoConfig(MODULE_0_INS, &Rx_Fifo_Config);
+	    MID_CAN_SetMbLayout(MODULE_0_INS, Fwd_MbLayout, sizeof(Fwd_MbLayout) / sizeof(Fwd_MbLayout[0]));
 	    MID_CAN_Init(MODULE_0_INS);
-	    for(uint8_t MB_Index = 0; MB_Index < RX_MB_COUNT; MB_Index++){
-			MID_CAN_UserConfigType UserCfgMB = {
-					.HandlerFunc = CallBack_arr[MB_Index] ,
-					.HandlerType = Handler_Type_arr[MB_Index],
-					.MbID = ReceiveMB_Adr[MB_Index],
-					.MbIndex = ReceiveMB[MB_Index],
-					.MbInt = true
-			};
-	    	MID_CAN_StdRxMbInit(MODULE_0_INS, &UserCfgMB);
-			MID_CAN_SetCallback(MODULE_0_INS, &UserCfgMB);
-	    }
-
-		MID_CAN_UserConfigType InitialMB = {
-				.HandlerFunc = NULL,
-				.MbID = 0x55,
-				.MbIndex = MB5,
-				.MbInt = true
-		};
-		MID_CAN_StdTxMbInit(MODULE_0_INS, &InitialMB);
+	    MID_CAN_E2EInit(MID_CAN_E2E_CRC_UNIT);
+	    MID_CAN_GwInit(&Fwd_GwCfg);
 
 	    /*LPIT Init*/
 
@@ -258,12 +376,86 @@ void App_Forwarder_Run(void)
 
 		/*CAN Send Request when Starting*/
 
-		MID_CAN_Transmit(MODULE_0_INS, MB5, &Request_CAN);
+		for(node = 0; node < FWD_NODE_COUNT && MID_CAN_HealthIsTxAllowed(MODULE_0_INS) == true; node++){
+			MID_CAN_Transmit(MODULE_0_INS, REQUEST_TX_MB(node), Request_CAN);
+		}
     while(1){
-    	App_Process_CAN_NewValue(&g_CAN_TEMP_State);
-    	App_Process_CAN_NewValue(&g_CAN_SPEED_State);
+    	App_Process_CAN_NewValue();
+    	App_Process_NodeState();
     	App_Process_UART_Request(&g_Msg);
     	App_Process_LEDWarning();
     };
 }
 
+/**
+ * @brief Bus monitor: streams every CAN frame over UART, the red LED shows a lost frame.
+ */
+void App_Forwarder_Sniffer_Run(void)
+{
+		MID_CAN_SnifferStatsType Stats;
+
+		/*GPIO Init*/
+
+		MID_GPIO_Init();
+		MID_GPIO_LEDOff(BLUE);
+		MID_GPIO_LEDOff(GREEN);
+		MID_GPIO_LEDOff(RED);
+
+		/*CAN and UART Init*/
+
+		MID_CAN_SnifferInit(&Fwd_SnifferCfg);
+
+    while(1){
+    	MID_CAN_SnifferMainFunction();
+    	MID_CAN_SnifferGetStats(&Stats);
+    	if(Stats.UartDropped != 0 || Stats.FifoLost != 0){
+    		MID_GPIO_LEDOn(RED);
+    	}
+    };
+}
+
+/**
+ * @brief Bus statistics monitor: per-ID counters and bus load, reported over UART every second.
+ */
+void App_Forwarder_Monitor_Run(void)
+{
+		MID_CAN_StatsBusType Stats;
+		FlexCAN_MbStructureType Record;
+
+		/*GPIO Init*/
+
+		MID_GPIO_Init();
+		MID_GPIO_LEDOff(BLUE);
+		MID_GPIO_LEDOff(GREEN);
+		MID_GPIO_LEDOff(RED);
+
+		/*CAN Init, listen-only*/
+
+	    MID_CAN_SetRxFifoConfig(MODULE_0_INS, &Monitor_Fifo_Config);
+	    MID_CAN_SetMbLayout(MODULE_0_INS, NULL, 0);
+	    MID_CAN_SetRunMode(MODULE_0_INS, FlexCAN_MODE_LISTEN_ONLY);
+	    MID_CAN_Init(MODULE_0_INS);
+
+	    /*UART Init*/
+
+		MID_UART_Init();
+
+		/*Statistics Init*/
+
+		MID_CAN_StatsInit(MODULE_0_INS, MONITOR_DUMP_PERIOD_MS);
+
+    while(1){
+    	while(FlexCAN_RxFifoRead(MODULE_0_INS, &Record) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED){
+    		/* Already counted */
+    	}
+    	MID_CAN_StatsMainFunction();
+    	MID_CAN_StatsGetBus(MODULE_0_INS, &Stats);
+    	if(Stats.Window[MID_CAN_STATS_WINDOW_LONG].Errors != 0){
+    		MID_GPIO_LEDOn(RED);
+    	}
+    	else{
+    		MID_GPIO_LEDOff(RED);
+    	}
+    };
+}
+
@@ -15,19 +15,42 @@
 #include "Driver_Header.h"
 
 /*****************************************************************************/
-/* Enumerations                                                              */
+/* Definitions                                                               */
 /*****************************************************************************/
-/* Define enumerations for speed ping states and connection states.          */
+/* Layout of the speed PDU, shared with the forwarder.                       */
 
-/**
- * @brief Enumeration for the speed ping state.
- *
- * Defines the possible states of the speed ping readiness.
- */
-typedef enum {
-    SPEED_PING_READY,         /*!< Indicates that speed ping is ready */
-    SPEED_PING_NOT_READY,     /*!< Indicates that speed ping is not ready */
-} Speed_Ping_State_t;
+#define SPEED_PDU_ID                0x22U   /*!< Speed value, node status and heartbeat */
+#define SPEED_PDU_LENGTH            4U      /*!< Value and status, then the E2E CRC and counter */
+#define SPEED_PDU_CYCLE_MS          100U    /*!< Heartbeat period, the PDU replaces the 0x44 ping frame */
+#define SPEED_PDU_MIN_DELAY_MS      20U     /*!< Shortest gap between two sends on a speed change */
+#define SPEED_SCHED_TICK_US         1000U   /*!< Period of the CAN scheduler tick */
+#define SPEED_SCHED_TICK_LPIT       48000U  /*!< The same in LPIT counts, FIRCDIV2 at 48 MHz */
+#define SPEED_HEALTH_PERIOD_TICKS   10U     /*!< Scheduler ticks between two health checks of the main loop */
+#define SPEED_SIG_VALUE_START_BIT   0U      /*!< Byte 0, where the former 1-byte frame had it */
+#define SPEED_SIG_VALUE_LENGTH      8U
+#define SPEED_SIG_VALUE_UPDATE_BIT  15U     /*!< Set when the frame carries a new speed value */
+#define SPEED_SIG_STATUS_START_BIT  8U      /*!< MID_CAN_HealthState_e of the node */
+#define SPEED_SIG_STATUS_LENGTH     2U
+#define SPEED_ANSWER_MB            MB2     /*!< Answers remote requests for the PDU ID with the last PDU */
+#define SPEED_E2E_DATA_ID           0x0122U /*!< Protected with the PDU, not sent */
+#define SPEED_E2E_CRC_BYTE          2U
+#define SPEED_E2E_COUNTER_BYTE      3U      /*!< Low nibble */
+#define SPEED_E2E_MAX_DELTA         2U      /*!< One PDU may be lost */
+
+/* End-to-end protection of the PDU, the node protects it and the forwarder checks it */
+#define SPEED_E2E_CONFIG \
+    { .DataId = SPEED_E2E_DATA_ID, .DataLen = SPEED_PDU_LENGTH, .CrcByte = SPEED_E2E_CRC_BYTE, \
+      .CounterByte = SPEED_E2E_COUNTER_BYTE, .MaxDeltaCounter = SPEED_E2E_MAX_DELTA }
+
+/* Mailboxes written with the controller setup, apart from the COM layer ones. The data request of
+ * the forwarder is a remote frame with the PDU ID, answered by the controller */
+#define SPEED_MB_LAYOUT(X) \
+    X(ANSWER, SPEED_ANSWER_MB, SPEED_PDU_ID, FlexCAN_STANDARD, SPEED_PDU_LENGTH, NULL)
+
+/*****************************************************************************/
+/* Enumerations                                                              */
+/*****************************************************************************/
+/* Define enumerations for speed connection states.                          */
 
 /**
  * @brief Enumeration for speed connection state.
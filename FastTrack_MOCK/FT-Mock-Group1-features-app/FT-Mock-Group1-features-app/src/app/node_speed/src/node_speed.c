@@ -11,48 +11,109 @@
 
 #include "node_speed.h"
 
+/******************************************************************************/
+/* Definitions */
+/******************************************************************************/
+
+#define SPEED_PDU_INDEX 0U
+
+/* Signals of the speed node, index into Speed_ComSignals */
+typedef enum
+{
+	SPEED_SIG_VALUE = 0U,
+	SPEED_SIG_STATUS,
+	SPEED_SIG_COUNT
+} Speed_ComSignal_e;
+
 /******************************************************************************/
 /* Variables */
 /******************************************************************************/
 
-uint8_t MsgDataSpeed[2] = "OK";								/* Message data for speed ping */
+static volatile uint8_t Speed_HealthTicks = 0U;				/* Scheduler ticks since the last health check */
+static volatile bool Speed_IsHealthDue = false;				/* Set by the tick, the main loop checks the health */
+
 uint8_t value = 0;											/* Variable to store ADC data */
-Speed_Ping_State_t Speed_Ping_State = SPEED_PING_NOT_READY; /* Ping state */
 Speed_Connect_State_t Speed_Connect_State = SPEED_OK;		/* Connect state */
 
+/* CRC and alive counter in bytes 2 and 3, checked by the forwarder */
+static const MID_CAN_E2EConfigType Speed_E2ECfg = SPEED_E2E_CONFIG;
+
+/* One PDU carries the speed, the node status and the heartbeat */
+static const MID_CAN_ComPduType Speed_ComPdus[] = {
+	[SPEED_PDU_INDEX] = {
+		.Id = SPEED_PDU_ID,
+		.IdType = FlexCAN_STANDARD,
+		.DataLen = SPEED_PDU_LENGTH,
+		.Direction = MID_CAN_COM_TX,
+		.TxMode = MID_CAN_COM_MIXED,
+		.MbIndex = MB0,
+		.IsAnswered = true,
+		.IsLatestValue = true,
+		.AnswerMbIndex = SPEED_ANSWER_MB,
+		.CycleMs = SPEED_PDU_CYCLE_MS,
+		.MinDelayMs = SPEED_PDU_MIN_DELAY_MS,
+		.E2E = &Speed_E2ECfg}};
+
+static const MID_CAN_ComSignalType Speed_ComSignals[SPEED_SIG_COUNT] = {
+	[SPEED_SIG_VALUE] = {
+		.PduIndex = SPEED_PDU_INDEX,
+		.StartBit = SPEED_SIG_VALUE_START_BIT,
+		.Length = SPEED_SIG_VALUE_LENGTH,
+		.Endian = MID_CAN_COM_LITTLE_ENDIAN,
+		.Factor = 1,
+		.Divisor = 1,
+		.UpdateBit = SPEED_SIG_VALUE_UPDATE_BIT,
+		.IsTriggered = true},
+	[SPEED_SIG_STATUS] = {
+		.PduIndex = SPEED_PDU_INDEX,
+		.StartBit = SPEED_SIG_STATUS_START_BIT,
+		.Length = SPEED_SIG_STATUS_LENGTH,
+		.Endian = MID_CAN_COM_LITTLE_ENDIAN,
+		.Factor = 1,
+		.Divisor = 1,
+		.UpdateBit = MID_CAN_COM_NO_UPDATE_BIT,
+		.IsTriggered = false}};
+
+static const MID_CAN_ComConfigType Speed_ComCfg = {
+	.Pdus = Speed_ComPdus,
+	.NoOfPdus = sizeof(Speed_ComPdus) / sizeof(Speed_ComPdus[0]),
+	.Signals = Speed_ComSignals,
+	.NoOfSignals = SPEED_SIG_COUNT};
+
+/* Answer mailbox, written by MID_CAN_Init while the controller is frozen */
+static const FlexCAN_MbLayoutType Speed_MbLayout[] = {
+	SPEED_MB_LAYOUT(MID_CAN_MB_LAYOUT_ENTRY)};
+
+/* Bus-off recovery: 100 ms backoff, doubled up to 1 s while the fault keeps coming back */
+static const MID_CAN_HealthConfigType Speed_HealthCfg = {
+	.RecoveryMode = MID_CAN_RECOVERY_BACKOFF,
+	.BackoffMs = 100U,
+	.BackoffMaxMs = 1000U,
+	.StableMs = 5000U,
+	.Notification = NULL};
+
 /******************************************************************************/
 /* Static APIs */
 /******************************************************************************/
 
 /**
- * @brief Reads ADC data and transmits it via CAN.
+ * @brief Reads ADC data and sends it via CAN right away.
  */
 static void App_Read_Send_Speed_Data(void)
 {
 	value = MID_ADC_ReadData();
-	MID_CAN_Transmit(MODULE_0_INS, MB0, &value);
-}
-
-/**
- * @brief Processes the speed ping state and transmits a ping message if ready.
- */
-static void App_ProcessSpeedPing(Speed_Ping_State_t *State)
-{
-	if (*State == SPEED_PING_READY)
-	{
-		MID_CAN_Transmit(MODULE_0_INS, MB1, MsgDataSpeed);
-		*State = SPEED_PING_NOT_READY;
-	}
+	MID_CAN_ComSendSignal(MODULE_0_INS, SPEED_SIG_VALUE, value);
+	MID_CAN_ComTriggerTransmit(MODULE_0_INS, SPEED_PDU_INDEX);
 }
 
 /**
  * @brief Checks the connection status of the speed module.
  */
-static void App_CheckSpeedConnect()
+static void App_CheckSpeedConnect(void)
 {
-	uint8_t ACK_State = 0;
-	ACK_State = MID_CAN_GetAckStatus(MODULE_0_INS);
-	if (ACK_State == 1)
+	MID_CAN_HealthMainFunction(MODULE_0_INS);
+	MID_CAN_ComSendSignal(MODULE_0_INS, SPEED_SIG_STATUS, (int32_t)MID_CAN_HealthGetState(MODULE_0_INS));
+	if (MID_CAN_HealthGetState(MODULE_0_INS) != MID_CAN_HEALTH_ERROR_ACTIVE)
 	{
 		Speed_Connect_State = SPEED_NOT_OK;
 	}
@@ -63,9 +124,7 @@ static void App_CheckSpeedConnect()
  */
 static void App_SpeedReconnect(void)
 {
-	uint8_t ACK_State = 0;
-	ACK_State = MID_CAN_GetAckStatus(MODULE_0_INS);
-	if (Speed_Connect_State == SPEED_NOT_OK && ACK_State == 0)
+	if (Speed_Connect_State == SPEED_NOT_OK && MID_CAN_HealthGetState(MODULE_0_INS) == MID_CAN_HEALTH_ERROR_ACTIVE)
 	{
 		App_Read_Send_Speed_Data();
 		Speed_Connect_State = SPEED_OK;
@@ -81,32 +140,23 @@ static void App_SpeedReconnect(void)
  */
 void App_Speed_ADC_Notification(uint16_t x)
 {
-	MID_CAN_Transmit(MODULE_0_INS, MB0, (uint8_t *)&x);
+	MID_CAN_ComSendSignal(MODULE_0_INS, SPEED_SIG_VALUE, x);
 }
 
 /**
- * @brief Callback for LPIT timer events to update speed ping state.
+ * @brief Timebase of the CAN scheduler, sends the due PDUs.
  */
-void LPIT_Callback_Speed(uint8_t channel)
+void App_Speed_Tick_Notification(uint8_t channel)
 {
-	switch (channel)
+	MID_CAN_SchedTick();
+
+	if (++Speed_HealthTicks >= SPEED_HEALTH_PERIOD_TICKS)
 	{
-	case 0:
-		Speed_Ping_State = SPEED_PING_READY;
-		break;
-	default:
-		break;
+		Speed_HealthTicks = 0U;
+		Speed_IsHealthDue = true;
 	}
 }
 
-/**
- * @brief Processes incoming requests by reading and sending speed data.
- */
-void App_Speed_RcvRequest(void)
-{
-	App_Read_Send_Speed_Data();
-}
-
 /******************************************************************************/
 /* Public APIs */
 /******************************************************************************/
@@ -130,44 +180,26 @@ void App_NodeSpeed_Run()
 			.nodeConfigPtr = &Node_Speed_Cfg,
 			.callback = App_Speed_ADC_Notification};
 	MID_ADC_Init(&ADC_Cfg_Speed);
-	MID_LPIT_Init(LPIT_INS_0, LPIT_Callback_Speed);
+	MID_CAN_SetMbLayout(MODULE_0_INS, Speed_MbLayout, sizeof(Speed_MbLayout) / sizeof(Speed_MbLayout[0]));
 	MID_CAN_Init(MODULE_0_INS);
+	MID_CAN_HealthInit(MODULE_0_INS, &Speed_HealthCfg);
 
-	/* Configuration for sending data message */
-	MID_CAN_UserConfigType UserCfgMBSendData = {
-		.HandlerFunc = NULL,
-		.MbID = 0x22,
-		.MbIndex = MB0,
-		.MbInt = true};
-
-	/* Configuration for sending ping message */
-	MID_CAN_UserConfigType UserCfgMBSendPing = {
-		.HandlerFunc = NULL,
-		.MbID = 0x44,
-		.MbIndex = MB1,
-		.MbInt = true};
-
-	MID_CAN_StdTxMbInit(MODULE_0_INS, &UserCfgMBSendData);
-	MID_CAN_StdTxMbInit(MODULE_0_INS, &UserCfgMBSendPing);
-
-	/* Configuration for handling incoming requests */
-	MID_CAN_UserConfigType UserCfgMBRequest = {
-		.HandlerFunc = App_Speed_RcvRequest,
-		.HandlerType = MIDDLE_HANDLER_MB_2_TYPE,
-		.MbID = 0x55,
-		.MbIndex = MB2,
-		.MbInt = true};
-
-	MID_CAN_StdRxMbInit(MODULE_0_INS, &UserCfgMBRequest);
-	MID_CAN_SetCallback(MODULE_0_INS, &UserCfgMBRequest);
-
-	MID_LPIT_StartTimer(LPIT_INS_0, 0, 6000000);
+	/* Speed PDU on MB0, sent on change and every SPEED_PDU_CYCLE_MS as heartbeat from the scheduler tick */
+	MID_CAN_E2EInit(MID_CAN_E2E_CRC_UNIT);
+	MID_CAN_SchedInit(SPEED_SCHED_TICK_US);
+	MID_CAN_ComInit(MODULE_0_INS, &Speed_ComCfg);
+	MID_LPIT_Init(LPIT_INS_0, App_Speed_Tick_Notification);
+	MID_LPIT_StartTimer(LPIT_INS_0, LPIT_CHANNEL_0, SPEED_SCHED_TICK_LPIT);
 
 	App_Read_Send_Speed_Data();
 	while (1)
 	{
-		App_ProcessSpeedPing(&Speed_Ping_State);
-		App_CheckSpeedConnect();
-		App_SpeedReconnect();
+		/* ESR1 is cleared by the read, the health is sampled at the tick pace only */
+		if (Speed_IsHealthDue == true)
+		{
+			Speed_IsHealthDue = false;
+			App_CheckSpeedConnect();
+			App_SpeedReconnect();
+		}
 	}
 }
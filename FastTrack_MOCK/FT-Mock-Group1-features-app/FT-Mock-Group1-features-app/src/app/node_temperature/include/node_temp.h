@@ -10,16 +10,34 @@
 
 #include "Middleware_Header.h"
 
-/* Enumeration for temperature ping state */
-/**
- * @brief Enumeration for the temperature ping state.
- *
- * Defines the possible states for the temperature ping readiness.
- */
-typedef enum {
-    TEMP_PING_READY,         /*!< Temperature ping is ready */
-    TEMP_PING_NOT_READY      /*!< Temperature ping is not ready */
-} Temp_Ping_State_t;
+/* Layout of the temperature PDU, shared with the forwarder */
+#define TEMP_PDU_ID                 0x11U   /*!< Temperature value, node status and heartbeat */
+#define TEMP_PDU_LENGTH             4U      /*!< Value and status, then the E2E CRC and counter */
+#define TEMP_PDU_CYCLE_MS           100U    /*!< Heartbeat period, the PDU replaces the 0x33 ping frame */
+#define TEMP_PDU_MIN_DELAY_MS       20U     /*!< Shortest gap between two sends on a temperature change */
+#define TEMP_SCHED_TICK_US          1000U   /*!< Period of the CAN scheduler tick */
+#define TEMP_SCHED_TICK_LPIT        48000U  /*!< The same in LPIT counts, FIRCDIV2 at 48 MHz */
+#define TEMP_HEALTH_PERIOD_TICKS    10U     /*!< Scheduler ticks between two health checks of the main loop */
+#define TEMP_SIG_VALUE_START_BIT    0U      /*!< Byte 0, where the former 1-byte frame had it */
+#define TEMP_SIG_VALUE_LENGTH       8U
+#define TEMP_SIG_VALUE_UPDATE_BIT   15U     /*!< Set when the frame carries a new temperature value */
+#define TEMP_SIG_STATUS_START_BIT   8U      /*!< MID_CAN_HealthState_e of the node */
+#define TEMP_SIG_STATUS_LENGTH      2U
+#define TEMP_ANSWER_MB             MB2     /*!< Answers remote requests for the PDU ID with the last PDU */
+#define TEMP_E2E_DATA_ID            0x0111U /*!< Protected with the PDU, not sent */
+#define TEMP_E2E_CRC_BYTE           2U
+#define TEMP_E2E_COUNTER_BYTE       3U      /*!< Low nibble */
+#define TEMP_E2E_MAX_DELTA          2U      /*!< One PDU may be lost */
+
+/* End-to-end protection of the PDU, the node protects it and the forwarder checks it */
+#define TEMP_E2E_CONFIG \
+    { .DataId = TEMP_E2E_DATA_ID, .DataLen = TEMP_PDU_LENGTH, .CrcByte = TEMP_E2E_CRC_BYTE, \
+      .CounterByte = TEMP_E2E_COUNTER_BYTE, .MaxDeltaCounter = TEMP_E2E_MAX_DELTA }
+
+/* Mailboxes written with the controller setup, apart from the COM layer ones. The data request of
+ * the forwarder is a remote frame with the PDU ID, answered by the controller */
+#define TEMP_MB_LAYOUT(X) \
+    X(ANSWER, TEMP_ANSWER_MB, TEMP_PDU_ID, FlexCAN_STANDARD, TEMP_PDU_LENGTH, NULL)
 
 /* Enumeration for temperature connection state */
 /**
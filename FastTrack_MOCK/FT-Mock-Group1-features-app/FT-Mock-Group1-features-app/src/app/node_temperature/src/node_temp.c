@@ -11,38 +11,99 @@
 
 #include "node_temp.h"
 
+/******************************************************************************/
+/* Definitions */
+/******************************************************************************/
+
+#define TEMP_PDU_INDEX 0U
+
+/* Signals of the temperature node, index into Temp_ComSignals */
+typedef enum
+{
+	TEMP_SIG_VALUE = 0U,
+	TEMP_SIG_STATUS,
+	TEMP_SIG_COUNT
+} Temp_ComSignal_e;
+
 /******************************************************************************/
 /* Variables */
 /******************************************************************************/
 
-uint8_t MsgDataTemp[2] = "OK";
-Temp_Ping_State_t Temp_Ping_State = TEMP_PING_NOT_READY;
+static volatile uint8_t Temp_HealthTicks = 0U;				/* Scheduler ticks since the last health check */
+static volatile bool Temp_IsHealthDue = false;				/* Set by the tick, the main loop checks the health */
+
 Temp_Connect_State_t Temp_Connect_State = TEMP_OK;
 uint8_t Temp_value = 0;
 
+/* One PDU carries the temperature, the node status and the heartbeat */
+/* CRC and alive counter in bytes 2 and 3, checked by the forwarder */
+static const MID_CAN_E2EConfigType Temp_E2ECfg = TEMP_E2E_CONFIG;
+
+static const MID_CAN_ComPduType Temp_ComPdus[] = {
+	[TEMP_PDU_INDEX] = {
+		.Id = TEMP_PDU_ID,
+		.IdType = FlexCAN_STANDARD,
+		.DataLen = TEMP_PDU_LENGTH,
+		.Direction = MID_CAN_COM_TX,
+		.TxMode = MID_CAN_COM_MIXED,
+		.MbIndex = MB0,
+		.IsAnswered = true,
+		.IsLatestValue = true,
+		.AnswerMbIndex = TEMP_ANSWER_MB,
+		.CycleMs = TEMP_PDU_CYCLE_MS,
+		.MinDelayMs = TEMP_PDU_MIN_DELAY_MS,
+		.E2E = &Temp_E2ECfg}};
+
+static const MID_CAN_ComSignalType Temp_ComSignals[TEMP_SIG_COUNT] = {
+	[TEMP_SIG_VALUE] = {
+		.PduIndex = TEMP_PDU_INDEX,
+		.StartBit = TEMP_SIG_VALUE_START_BIT,
+		.Length = TEMP_SIG_VALUE_LENGTH,
+		.Endian = MID_CAN_COM_LITTLE_ENDIAN,
+		.Factor = 1,
+		.Divisor = 1,
+		.UpdateBit = TEMP_SIG_VALUE_UPDATE_BIT,
+		.IsTriggered = true},
+	[TEMP_SIG_STATUS] = {
+		.PduIndex = TEMP_PDU_INDEX,
+		.StartBit = TEMP_SIG_STATUS_START_BIT,
+		.Length = TEMP_SIG_STATUS_LENGTH,
+		.Endian = MID_CAN_COM_LITTLE_ENDIAN,
+		.Factor = 1,
+		.Divisor = 1,
+		.UpdateBit = MID_CAN_COM_NO_UPDATE_BIT,
+		.IsTriggered = false}};
+
+static const MID_CAN_ComConfigType Temp_ComCfg = {
+	.Pdus = Temp_ComPdus,
+	.NoOfPdus = sizeof(Temp_ComPdus) / sizeof(Temp_ComPdus[0]),
+	.Signals = Temp_ComSignals,
+	.NoOfSignals = TEMP_SIG_COUNT};
+
+/* Answer mailbox, written by MID_CAN_Init while the controller is frozen */
+static const FlexCAN_MbLayoutType Temp_MbLayout[] = {
+	TEMP_MB_LAYOUT(MID_CAN_MB_LAYOUT_ENTRY)};
+
+/* Bus-off recovery: 100 ms backoff, doubled up to 1 s while the fault keeps coming back */
+static const MID_CAN_HealthConfigType Temp_HealthCfg = {
+	.RecoveryMode = MID_CAN_RECOVERY_BACKOFF,
+	.BackoffMs = 100U,
+	.BackoffMaxMs = 1000U,
+	.StableMs = 5000U,
+	.Notification = NULL};
+
 /******************************************************************************/
 /* Local APIs */
 /******************************************************************************/
 
 /**
- * @brief Reads temperature data via ADC and transmits it via CAN.
+ * @brief Reads temperature data via ADC and sends it via CAN right away.
  */
 static void App_Read_Send_Temp_Data(void)
 {
 	Temp_value = MID_ADC_ReadData();
-	MID_CAN_Transmit(FlexCAN0_INS, MB0, &Temp_value);
-}
-
-/**
- * @brief Processes the temperature ping state and sends a ping message if ready.
- */
-static void App_ProcessTempPing(Temp_Ping_State_t *State)
-{
-	if (*State == TEMP_PING_READY)
-	{
-		FlexCAN_Transmit(FlexCAN0_INS, MB1, MsgDataTemp);
-		*State = TEMP_PING_NOT_READY;
-	}
+	MID_CAN_ComSendSignal(MODULE_0_INS, TEMP_SIG_VALUE, Temp_value);
+	MID_CAN_ComTriggerTransmit(MODULE_0_INS, TEMP_PDU_INDEX);
 }
 
 /**
@@ -50,9 +111,9 @@ static void App_ProcessTempPing(Temp_Ping_State_t *State)
  */
 static void App_CheckTempConnect(void)
 {
-	uint8_t ACK_State = 0;
-	ACK_State = MID_CAN_GetAckStatus(MODULE_0_INS);
-	if (ACK_State == 1)
+	MID_CAN_HealthMainFunction(MODULE_0_INS);
+	MID_CAN_ComSendSignal(MODULE_0_INS, TEMP_SIG_STATUS, (int32_t)MID_CAN_HealthGetState(MODULE_0_INS));
+	if (MID_CAN_HealthGetState(MODULE_0_INS) != MID_CAN_HEALTH_ERROR_ACTIVE)
 	{
 		Temp_Connect_State = TEMP_NOT_OK;
 	}
@@ -63,9 +124,7 @@ static void App_CheckTempConnect(void)
  */
 static void App_TempReconnect(void)
 {
-	uint8_t ACK_State = 0;
-	ACK_State = MID_CAN_GetAckStatus(MODULE_0_INS);
-	if (Temp_Connect_State == TEMP_NOT_OK && ACK_State == 0)
+	if (Temp_Connect_State == TEMP_NOT_OK && MID_CAN_HealthGetState(MODULE_0_INS) == MID_CAN_HEALTH_ERROR_ACTIVE)
 	{
 		App_Read_Send_Temp_Data();
 		Temp_Connect_State = TEMP_OK;
@@ -81,32 +140,23 @@ static void App_TempReconnect(void)
  */
 void App_Temp_ADC_Notification(uint16_t x)
 {
-	FlexCAN_Transmit(FlexCAN0_INS, MB0, (uint8_t *)&x);
+	MID_CAN_ComSendSignal(MODULE_0_INS, TEMP_SIG_VALUE, x);
 }
 
 /**
- * @brief Callback for LPIT timer events to update the temperature ping state.
+ * @brief Timebase of the CAN scheduler, sends the due PDUs.
  */
-void LPIT_Callback_Temp(uint8_t channel)
+void App_Temp_Tick_Notification(uint8_t channel)
 {
-	switch (channel)
+	MID_CAN_SchedTick();
+
+	if (++Temp_HealthTicks >= TEMP_HEALTH_PERIOD_TICKS)
 	{
-	case 0:
-		Temp_Ping_State = TEMP_PING_READY;
-		break;
-	default:
-		break;
+		Temp_HealthTicks = 0U;
+		Temp_IsHealthDue = true;
 	}
 }
 
-/**
- * @brief Handles incoming temperature requests by reading and sending data.
- */
-void App_Temp_RcvRequest(void)
-{
-	App_Read_Send_Temp_Data();
-}
-
 /******************************************************************************/
 /* Public APIs */
 /******************************************************************************/
@@ -128,39 +178,26 @@ void App_NodeTemp_Run()
 			.nodeConfigPtr = &Node_Temp_Cfg,
 			.callback = App_Temp_ADC_Notification};
 	MID_ADC_Init(&ADC_Cfg_Temp);
-	MID_LPIT_Init(LPIT_INS_0, LPIT_Callback_Temp);
+	MID_CAN_SetMbLayout(FlexCAN0_INS, Temp_MbLayout, sizeof(Temp_MbLayout) / sizeof(Temp_MbLayout[0]));
 	MID_CAN_Init(FlexCAN0_INS);
-	MID_CAN_UserConfigType UserCfgMBSendData = {
-		.HandlerFunc = NULL,
-		.MbID = 0x11,
-		.MbIndex = MB0,
-		.MbInt = true};
-
-	MID_CAN_UserConfigType UserCfgMBSendPing = {
-		.HandlerFunc = NULL,
-		.MbID = 0x33,
-		.MbIndex = MB1,
-		.MbInt = true};
+	MID_CAN_HealthInit(MODULE_0_INS, &Temp_HealthCfg);
 
-	MID_CAN_StdTxMbInit(FlexCAN0_INS, &UserCfgMBSendData);
-	MID_CAN_StdTxMbInit(FlexCAN0_INS, &UserCfgMBSendPing);
-
-	MID_CAN_UserConfigType UserCfgMBRequest = {
-		.HandlerFunc = App_Temp_RcvRequest,
-		.HandlerType = MIDDLE_HANDLER_MB_2_TYPE,
-		.MbID = 0x55,
-		.MbIndex = MB2,
-		.MbInt = true};
-	MID_CAN_StdRxMbInit(FlexCAN0_INS, &UserCfgMBRequest);
-	MID_CAN_SetCallback(FlexCAN0_INS, &UserCfgMBRequest);
-
-	MID_LPIT_StartTimer(LPIT_INS_0, 0, 6000000);
+	/* Temperature PDU on MB0, sent on change and every TEMP_PDU_CYCLE_MS as heartbeat from the scheduler tick */
+	MID_CAN_E2EInit(MID_CAN_E2E_CRC_UNIT);
+	MID_CAN_SchedInit(TEMP_SCHED_TICK_US);
+	MID_CAN_ComInit(MODULE_0_INS, &Temp_ComCfg);
+	MID_LPIT_Init(LPIT_INS_0, App_Temp_Tick_Notification);
+	MID_LPIT_StartTimer(LPIT_INS_0, LPIT_CHANNEL_0, TEMP_SCHED_TICK_LPIT);
 
 	App_Read_Send_Temp_Data();
 	while (1)
 	{
-		App_ProcessTempPing(&Temp_Ping_State);
-		App_CheckTempConnect();
-		App_TempReconnect();
+		/* ESR1 is cleared by the read, the health is sampled at the tick pace only */
+		if (Temp_IsHealthDue == true)
+		{
+			Temp_IsHealthDue = false;
+			App_CheckTempConnect();
+			App_TempReconnect();
+		}
 	}
 }
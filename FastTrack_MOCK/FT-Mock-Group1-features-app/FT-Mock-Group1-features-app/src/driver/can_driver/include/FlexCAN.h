@@ -51,7 +51,7 @@
 #define FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT  		(16U)
 #define FLEXCAN_RAMn_DATA_WORD_0_DLC(x)     		(((uint32_t)(((uint32_t)(x)) << FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT)) & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK)
 
-#define FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK   	(0x7FFFU)
+#define FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK   	(0xFFFFU)
 #define FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_SHIFT  	(0U)
 #define FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP(x)     	(((uint32_t)(((uint32_t)(x)) << FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_SHIFT)) & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK)
 
@@ -59,13 +59,54 @@
 #define FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT   		(18U)
 #define FLEXCAN_RAMn_DATA_WORD_1_ID(x)      		(((uint32_t)(((uint32_t)(x)) << FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT)) & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK)
 
+#define FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK		(0x1FFFFFFFU)
+#define FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT		(0U)
+#define FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(x)			(((uint32_t)(((uint32_t)(x)) << FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT)) & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK)
+
+#define FLEXCAN_FRAME_MAX_DATA_LEN					(8U)
+#define FLEXCAN_FD_FRAME_MAX_DATA_LEN				(64U)
+
+#define FLEXCAN_ERROR_CALLBACK_ID					(32U)      /*!< Callback ID of the error interrupt */
+#define FLEXCAN_ORED_CALLBACK_ID					(33U)      /*!< Callback ID of the bus-off / warning interrupt */
+
+#define FLEXCAN_SAMPLE_POINT_DEFAULT				(875U)     /*!< Nominal sample point in per mille (CiA 301) */
+
+#define FLEXCAN_RXFIFO_ID_FILTER_RTR_MASK			(0x80000000U)
+#define FLEXCAN_RXFIFO_ID_FILTER_IDE_MASK			(0x40000000U)
+#define FLEXCAN_RXFIFO_ID_FILTER_STD_SHIFT			(19U)
+#define FLEXCAN_RXFIFO_ID_FILTER_STD_MASK			(0x3FF80000U)
+#define FLEXCAN_RXFIFO_ID_FILTER_EXT_SHIFT			(1U)
+#define FLEXCAN_RXFIFO_ID_FILTER_EXT_MASK			(0x3FFFFFFEU)
+
+/* Rx FIFO global mask helpers: RTR and IDE are always compared */
+#define FLEXCAN_RXFIFO_STD_MASK(x)					(FLEXCAN_RXFIFO_ID_FILTER_RTR_MASK | FLEXCAN_RXFIFO_ID_FILTER_IDE_MASK | \
+													(((uint32_t)(x) << FLEXCAN_RXFIFO_ID_FILTER_STD_SHIFT) & FLEXCAN_RXFIFO_ID_FILTER_STD_MASK))
+#define FLEXCAN_RXFIFO_EXT_MASK(x)					(FLEXCAN_RXFIFO_ID_FILTER_RTR_MASK | FLEXCAN_RXFIFO_ID_FILTER_IDE_MASK | \
+													(((uint32_t)(x) << FLEXCAN_RXFIFO_ID_FILTER_EXT_SHIFT) & FLEXCAN_RXFIFO_ID_FILTER_EXT_MASK))
+
+/* CTRL2[RFFN] for a filter count: 8 filter elements per step */
+#define FLEXCAN_RXFIFO_RFFN(NoOfIdFilters)			(((NoOfIdFilters) > 8U) ? ((((uint32_t)(NoOfIdFilters) + 7U) / 8U) - 1U) : 0U)
+
+/* The FIFO engine owns MB0-MB5, the filter table takes 2 more MBs per RFFN step */
+#define FLEXCAN_RXFIFO_FIRST_FREE_MB(NoOfIdFilters)	(8U + (2U * FLEXCAN_RXFIFO_RFFN(NoOfIdFilters)))
+
+/* eDMA channel of the Rx FIFO drain, the driver defines this channel's vector only.
+   A plain number, it is pasted into the DMAn_IRQHandler name */
+#ifndef FLEXCAN_RXFIFO_DMA_CHANNEL
+#define FLEXCAN_RXFIFO_DMA_CHANNEL					0
+#endif
+
+/* Mailbox layout helpers: header words and Rx mask built by the compiler, see FlexCAN_MbLayoutType */
+#define FLEXCAN_MB_CS(Code, IdType, DataLen)		(FLEXCAN_RAMn_DATA_WORD_0_CODE(Code) | FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK | \
+													FLEXCAN_RAMn_DATA_WORD_0_IDE(IdType) | FLEXCAN_RAMn_DATA_WORD_0_DLC(DataLen))
+#define FLEXCAN_MB_ID(Id, IdType)					(((IdType) == FlexCAN_EXTENDED) ? FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Id) \
+													                                : FLEXCAN_RAMn_DATA_WORD_1_ID(Id))
+
 
 /* ------------------------------------------------------------------------------------------------------------------------------------------------------
    -- Typedefs
    ------------------------------------------------------------------------------------------------------------------------------------------------------ */
 
-typedef void (*FlexCAN_CallbackType)(void);
-
 /**
  * @brief Enum type for Adc function return type
  */
@@ -83,6 +124,14 @@ typedef enum
     FlexCAN2_INS = 2U,
 }FlexCAN_Instance_e;
 
+/**
+ * @brief Interrupt callback.
+ *
+ * CallbackID is the message buffer index for MB callbacks, FLEXCAN_ERROR_CALLBACK_ID or
+ * FLEXCAN_ORED_CALLBACK_ID otherwise, so one function can serve many sources.
+ */
+typedef void (*FlexCAN_CallbackType)(FlexCAN_Instance_e Ins, uint8_t CallbackID, void * Context);
+
 
 /**
  * @brief Enum type for FlexCAN Pin Tx
@@ -110,7 +159,8 @@ typedef enum
 typedef enum
 {
 	FlexCAN_MODE_NORMAL 	= 0U,	/*!< FlexCAN normal mode */
-	FlexCAN_MODE_LOOPBACK	= 1U		/*!< FlexCAN loopback mode */
+	FlexCAN_MODE_LOOPBACK	= 1U,	/*!< FlexCAN loopback mode */
+	FlexCAN_MODE_LISTEN_ONLY	= 2U	/*!< Receives without ACK or error frames, never transmits, error counters frozen */
 }FlexCAN_Mode_e;
 
 /**
@@ -175,6 +225,16 @@ typedef struct
     FlexCAN_IntRxWarning_e  IntRxWarning;/*!< Receive warning interrupt control */
 } FlexCAN_InterruptType;
 
+/**
+ * @brief Error counters and status of a FlexCAN instance, read together
+ */
+typedef struct
+{
+    uint8_t             Tec;         /*!< Transmit error counter */
+    uint8_t             Rec;         /*!< Receive error counter */
+    uint32_t            Esr1;        /*!< ESR1 snapshot, the error bits are cleared by the read */
+} FlexCAN_ErrorStateType;
+
 typedef enum
 {
     Rx_CODE_INACTIVE    = 0U, /*!< Receive code inactive */
@@ -194,6 +254,14 @@ typedef enum
     Tx_CODE_TANSWER     = 14U /*!< Transmit code answer */
 } FlexCAN_TxCODE_e;
 
+typedef enum
+{
+    FLEXCAN_TX_ABORT_IDLE = 0U,   /*!< No frame was pending */
+    FLEXCAN_TX_ABORT_DONE,        /*!< The pending frame was aborted, it was not sent */
+    FLEXCAN_TX_ABORT_LATE,        /*!< The pending frame was on the bus already and was sent */
+    FLEXCAN_TX_ABORT_TIMEOUT      /*!< No acknowledge in time, the message buffer is still pending */
+} FlexCAN_TxAbort_e;
+
 typedef enum
 {
     FlexCAN_STATUS_FLAG_ERRINT        = 1U, /*!< Error interrupt flag */
@@ -272,22 +340,263 @@ typedef struct
     FlexCAN_RxPin_e    RxPin; /*!< Receive Pin */
 } FlexCAN_PinType;
 
+typedef enum
+{
+    FlexCAN_STANDARD = 0U, /*!< Standard message ID format */
+    FlexCAN_EXTENDED = 1U  /*!< Extended message ID format */
+} FlexCAN_MsgIDType_e;
+
+typedef struct
+{
+    uint32_t            Header[2];  /*!< Message header */
+    uint32_t            Payload[2]; /*!< Message payload */
+} FlexCAN_MbStructureType;
+
+typedef struct
+{
+    FlexCAN_MbStructureType MB[32]; /*!< Array of message buffers */
+} FlexCAN_MbType;
+
+/**
+ * @brief Event seen by a frame observer
+ */
+typedef enum
+{
+    FLEXCAN_EVENT_RX    = 0U,   /*!< Frame received by a mailbox or the Rx FIFO */
+    FLEXCAN_EVENT_TX    = 1U,   /*!< Frame sent by a mailbox, remote answers included */
+    FLEXCAN_EVENT_ERROR = 2U    /*!< Error interrupt, errors before it was handled count once */
+} FlexCAN_Event_e;
+
+/**
+ * @brief Frame observer, called from interrupt context.
+ *
+ * Record is the frame in message buffer layout, only valid during the call, NULL for an error.
+ * Time is the frame time stamp extended to 32 bits, the interrupt time for an error.
+ */
+typedef void (*FlexCAN_ObserverType)(FlexCAN_Instance_e Ins, FlexCAN_Event_e Event,
+                                     const volatile FlexCAN_MbStructureType * Record, uint32_t Time);
+
+/**
+ * @brief How the mailboxes of FlexCAN_RxPollConfigType.MbMask are served
+ */
+typedef enum
+{
+    FlexCAN_RX_MODE_IRQ      = 0U,  /*!< One MB interrupt entry per burst, the default */
+    FlexCAN_RX_MODE_POLL     = 1U,  /*!< Interrupts masked, FlexCAN_RxPoll serves the mailboxes */
+    FlexCAN_RX_MODE_ADAPTIVE = 2U   /*!< Interrupt until a frame comes, then polled until the traffic drops */
+} FlexCAN_RxMode_e;
+
+/**
+ * @brief Receive mode of a group of mailboxes
+ *
+ * In adaptive mode the first MB interrupt of the group masks the interrupts of the group, the
+ * frames that follow are served by FlexCAN_RxPoll, Budget per pass at most. After QuietPasses
+ * passes in a row that served QuietFrames frames or less, the interrupts are enabled again.
+ */
+typedef struct
+{
+    FlexCAN_RxMode_e    Mode;        /*!< Receive mode */
+    uint32_t            MbMask;      /*!< Mailboxes of the group, bit n for MBn */
+    uint8_t             Budget;      /*!< Frames served by one FlexCAN_RxPoll pass at most, not 0 */
+    uint8_t             QuietFrames; /*!< A pass serving this many frames or less is quiet */
+    uint8_t             QuietPasses; /*!< Quiet passes in a row that enable the interrupts again, not 0 */
+} FlexCAN_RxPollConfigType;
+
+/**
+ * @brief Receive counters of an instance since FlexCAN_SetRxMode
+ */
+typedef struct
+{
+    uint32_t            IrqEntries;  /*!< MB interrupt entries that served a mailbox */
+    uint32_t            IrqFrames;   /*!< Mailboxes served by the MB interrupts */
+    uint32_t            PollPasses;  /*!< FlexCAN_RxPoll passes while the group was polled */
+    uint32_t            PollFrames;  /*!< Mailboxes served by FlexCAN_RxPoll */
+    uint32_t            Switches;    /*!< Adaptive mode switches from interrupt to polling */
+} FlexCAN_RxPollStatsType;
+
+/**
+ * @brief Enum type for FlexCAN Rx FIFO mode
+ *
+ * @note The S32K144 FlexCAN only implements the legacy Rx FIFO, the enhanced Rx FIFO
+ *       is not available on this derivative.
+ */
+typedef enum
+{
+    FlexCAN_RXFIFO_DISABLE = 0U,    /*!< Rx FIFO disabled, all MBs are regular mailboxes */
+    FlexCAN_RXFIFO_LEGACY  = 1U     /*!< Legacy 6-deep Rx FIFO in MB0-MB5 */
+} FlexCAN_RxFifoMode_e;
+
+/**
+ * @brief Rx FIFO ID filter table element (format A, one full ID per element)
+ */
+typedef struct
+{
+    uint32_t            Id;         /*!< Standard or extended ID to accept */
+    FlexCAN_MsgIDType_e IdType;     /*!< Message ID type */
+    bool                IsRemote;   /*!< Accept remote frames instead of data frames */
+    uint32_t            Mask;       /*!< ID bits that must match (1 = compare), 0 uses the global mask */
+} FlexCAN_RxFifoIdFilterType;
+
+/**
+ * @brief Rx mailbox acceptance filter: ID plus individual mask (RXIMR)
+ *
+ * A frame is accepted when (FrameId & Mask) == (Id & Mask) and its ID type matches.
+ * Id and Mask are in ID units, 11 bits for standard IDs and 29 bits for extended IDs.
+ */
+typedef struct
+{
+    uint32_t            Id;         /*!< Filter ID */
+    uint32_t            Mask;       /*!< ID bits that must match (1 = compare) */
+    FlexCAN_MsgIDType_e IdType;     /*!< Message ID type, always compared */
+} FlexCAN_RxFilterType;
+
+/**
+ * @brief Mailbox written by FlexCAN_Init in its freeze mode window
+ *
+ * The words are copied as they are, so a const table built with FLEXCAN_MB_CS and FLEXCAN_MB_ID
+ * is resolved at compile time and stays in flash.
+ */
+typedef struct
+{
+    FlexCAN_MbIndex_e   MbIndex;    /*!< Message buffer, after the Rx FIFO area if the FIFO is used */
+    uint32_t            Cs;         /*!< Header word 0: CODE, SRR, IDE, RTR and DLC */
+    uint32_t            Id;         /*!< Header word 1 */
+    uint32_t            RxMask;     /*!< Individual mask (RXIMR) in header word 1 units, Rx mailboxes */
+    FlexCAN_CallbackType Callback;  /*!< Message buffer callback, its interrupt is enabled unless NULL */
+    void              * Context;    /*!< Passed back to Callback */
+} FlexCAN_MbLayoutType;
+
+/**
+ * @brief Rx FIFO configuration
+ *
+ * Received frames are moved from the FIFO output into a RAM ring of raw frame records,
+ * either by the eDMA (one interrupt per half ring) or by the MB ISR (one interrupt per burst).
+ */
+typedef struct
+{
+    FlexCAN_RxFifoMode_e         Mode;          /*!< Rx FIFO mode */
+    const FlexCAN_RxFifoIdFilterType * IdFilterTable; /*!< ID filter table */
+    uint8_t                      NoOfIdFilters; /*!< Number of elements in IdFilterTable, the table must fit the MBs of the instance */
+    uint32_t                     GlobalMask;    /*!< RXFGMASK value in filter element layout, 0 accepts all */
+    bool                         UseDma;        /*!< Drain the FIFO with the eDMA instead of the CPU */
+    uint8_t                      DmaChannel;    /*!< eDMA channel used when UseDma is set, FLEXCAN_RXFIFO_DMA_CHANNEL */
+    FlexCAN_MbStructureType    * RingBuffer;    /*!< RAM ring of frame records */
+    uint16_t                     RingLength;    /*!< Number of records in RingBuffer, even, at most 32767 with the eDMA */
+    FlexCAN_CallbackType         BatchCallback; /*!< Invoked once per drained batch with CallbackID MB5, may be NULL */
+    void                       * BatchContext;  /*!< Passed back to BatchCallback */
+} FlexCAN_RxFifoConfigType;
+
+/**
+ * @brief Enum type for the payload size of the message buffers in a RAM block
+ *
+ * @note The S32K144 FlexCAN0 has a single RAM block (MBDSR0), so all its message buffers share one
+ *       payload size. The number of usable message buffers shrinks with it: 32, 21, 12 or 7.
+ */
+typedef enum
+{
+    FlexCAN_PAYLOAD_8_BYTES  = 0U,  /*!< 8-byte payload, 32 message buffers */
+    FlexCAN_PAYLOAD_16_BYTES = 1U,  /*!< 16-byte payload, 21 message buffers */
+    FlexCAN_PAYLOAD_32_BYTES = 2U,  /*!< 32-byte payload, 12 message buffers */
+    FlexCAN_PAYLOAD_64_BYTES = 3U   /*!< 64-byte payload, 7 message buffers */
+} FlexCAN_FdPayloadSize_e;
+
+/**
+ * @brief CAN FD configuration
+ *
+ * @note Only FlexCAN0 supports CAN FD on S32K144, and CAN FD cannot be combined with the legacy Rx FIFO.
+ */
+typedef struct
+{
+    bool                    Enable;         /*!< Enable CAN FD frames (MCR[FDEN]) */
+    uint32_t                DataBitRate;    /*!< Data phase bit rate in bit/s, e.g. 2000000 */
+    FlexCAN_FdPayloadSize_e PayloadSize;    /*!< Payload size of the RAM block 0 message buffers */
+    bool                    BitRateSwitch;  /*!< Allow frames to switch to the data phase bit rate (FDCTRL[FDRATE]) */
+    bool                    IsoCanFd;       /*!< ISO 11898-1 CAN FD instead of the non-ISO Bosch protocol */
+    bool                    TdcEnable;      /*!< Transceiver delay compensation, needed above ~2 Mbit/s */
+    uint8_t                 TdcOffset;      /*!< TDC offset in CAN clock cycles, 0 uses the data phase sample point */
+} FlexCAN_FdConfigType;
+
+/**
+ * @brief CAN FD frame as seen by the application
+ *
+ * DataLen is a byte count (0-64); it is rounded up to the next valid FD length (12, 16, 20, 24, 32, 48, 64)
+ * on transmission and bytes between DataLen and that length are sent as they are in Data.
+ */
+typedef struct
+{
+    uint32_t            Id;             /*!< Standard (11-bit) or extended (29-bit) ID */
+    FlexCAN_MsgIDType_e IdType;         /*!< Message ID type */
+    uint8_t             DataLen;        /*!< Payload length in bytes, 0-64 (0-8 for classic frames) */
+    bool                IsFd;           /*!< FD frame format (EDL) */
+    bool                BitRateSwitch;  /*!< Data phase sent at the data bit rate (BRS) */
+    bool                ErrorPassive;   /*!< Transmitter was error passive (ESI), Rx only */
+    uint32_t            TimeStamp;      /*!< Reception time, free running timer extended to 32 bits (bit times) */
+    uint32_t            IsrTimeStamp;   /*!< Time the interrupt handled the frame, same time base */
+    union
+    {
+        uint8_t         Byte[FLEXCAN_FD_FRAME_MAX_DATA_LEN];        /*!< Payload bytes */
+        uint32_t        Word[FLEXCAN_FD_FRAME_MAX_DATA_LEN / 4U];   /*!< Payload words */
+    } Data;
+} FlexCAN_FdFrameType;
+
+/**
+ * @brief Packs a nominal bit time given in time quanta into an extended CBT register value.
+ *
+ * Constant expression, used to write bit timing tables at build time.
+ */
+#define FLEXCAN_CBT_VALUE(Presdiv, PropSeg, PhaseSeg1, PhaseSeg2, Rjw) \
+        (FLEXCAN_CBT_BTF_MASK | FLEXCAN_CBT_EPRESDIV((Presdiv) - 1U) | FLEXCAN_CBT_EPROPSEG((PropSeg) - 1U) \
+         | FLEXCAN_CBT_EPSEG1((PhaseSeg1) - 1U) | FLEXCAN_CBT_EPSEG2((PhaseSeg2) - 1U) | FLEXCAN_CBT_ERJW((Rjw) - 1U))
+
+/**
+ * @brief Precomputed nominal bit timing for one clock / bit rate pair
+ */
+typedef struct
+{
+    uint32_t            ClkFreq;     /*!< CAN engine clock frequency in Hz */
+    uint32_t            BitRate;     /*!< Nominal bit rate in bit/s */
+    uint16_t            SamplePoint; /*!< Sample point in per mille */
+    uint8_t             Sjw;         /*!< Resynchronization jump width in time quanta, 0 for automatic */
+    uint32_t            Cbt;         /*!< CBT register value, see FLEXCAN_CBT_VALUE */
+} FlexCAN_BitTimingType;
+
 typedef struct
 {
     uint8_t             MaxNoMB;     /*!< Maximum number of message buffers */
     uint32_t            BitRate;     /*!< Bit rate for CAN communication */
     uint32_t            ClkFreq;     /*!< Clock frequency */
+    uint16_t            SamplePoint; /*!< Nominal sample point in per mille, 0 selects FLEXCAN_SAMPLE_POINT_DEFAULT */
+    uint8_t             Sjw;         /*!< Resynchronization jump width in time quanta, 0 for automatic */
+    const FlexCAN_BitTimingType * BitTiming; /*!< Precomputed bit timing, NULL uses the built-in table or the solver */
     FlexCAN_Mode_e      RunMode;     /*!< Operating mode */
     FlexCAN_ClkSrc_e    CLkSrc;      /*!< Clock source */
     FlexCAN_PinType     PortPin;     /*!< Port pin configuration */
     FlexCAN_InterruptType IntControl;/*!< Interrupt control configuration */
+    FlexCAN_RxFifoConfigType * RxFifoConfig; /*!< Rx FIFO configuration, NULL keeps MB0-MB7 as mailboxes */
+    FlexCAN_FdConfigType * FdConfig; /*!< CAN FD configuration, NULL keeps classic CAN */
+    const FlexCAN_MbLayoutType * MbLayout; /*!< Mailboxes set up during init, NULL for none */
+    uint8_t             NoOfMbLayout; /*!< Number of elements in MbLayout */
 } FlexCAN_ConfigType;
 
-typedef enum
+/**
+ * @brief Classic CAN frame as seen by the application
+ *
+ * Data is kept in bus byte order: Data.Byte[0] is the first byte on the bus.
+ * Data.Word gives word access for the single byte-reverse copy to and from the MB RAM.
+ */
+typedef struct
 {
-    FlexCAN_STANDARD = 0U, /*!< Standard message ID format */
-    FlexCAN_EXTENDED = 1U  /*!< Extended message ID format */
-} FlexCAN_MsgIDType_e;
+    uint32_t            Id;         /*!< Standard (11-bit) or extended (29-bit) ID */
+    FlexCAN_MsgIDType_e IdType;     /*!< Message ID type */
+    uint8_t             DataLen;    /*!< Data length code, 0-8 */
+    uint32_t            TimeStamp;  /*!< Reception time, free running timer extended to 32 bits (bit times) */
+    uint32_t            IsrTimeStamp; /*!< Time the interrupt handled the frame, same time base */
+    union
+    {
+        uint8_t         Byte[FLEXCAN_FRAME_MAX_DATA_LEN];           /*!< Payload bytes */
+        uint32_t        Word[FLEXCAN_FRAME_MAX_DATA_LEN / 4U];      /*!< Payload words */
+    } Data;
+} FlexCAN_FrameType;
 
 typedef struct
 {
@@ -302,17 +611,6 @@ typedef struct
     bool                IsEnableMbInt; /*!< Enable message buffer interrupt */
 } FlexCAN_MbHeaderType;
 
-typedef struct
-{
-    uint32_t            Header[2];  /*!< Message header */
-    uint32_t            Payload[2]; /*!< Message payload */
-} FlexCAN_MbStructureType;
-
-typedef struct
-{
-    FlexCAN_MbStructureType MB[32]; /*!< Array of message buffers */
-} FlexCAN_MbType;
-
 /* ------------------------------------------------------------------------------------------------------------------------------------------------------
    -- API
    ------------------------------------------------------------------------------------------------------------------------------------------------------ */
@@ -320,6 +618,7 @@ typedef struct
  * @brief FlexCAN initialization function
  *
  * This function initializes FlexCAN module with given configuration.
+ * The mailboxes of FlexCAN_Config->MbLayout are written in the same freeze mode session.
  *
  * @param FlexCAN_Ins - FlexCAN instance number
  * @param FlexCAN_Config - pointer to FlexCAN configuration structure
@@ -335,6 +634,28 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_Init(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN
  */
 FlexCAN_Driver_ReturnCode_e FlexCAN_DeInit(FlexCAN_Instance_e FlexCAN_Ins);
 
+/**
+ * @brief Initializes a message buffer with the given header configuration.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Message buffer index
+ * @param FLexCAN_MbConfig - Pointer to message buffer header configuration
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_MbInit(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, FlexCAN_MbHeaderType * FLexCAN_MbConfig);
+
+/**
+ * @brief Takes a message buffer out of the matching and the arbitration.
+ *
+ * The message buffer becomes INACTIVE, its interrupt is disabled and its flag cleared. A frame
+ * pending in a Tx message buffer must be aborted first with FlexCAN_AbortTx.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Message buffer index, must be below FlexCAN_GetMbCount
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_MbDeInit(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex);
+
 /**
  * @brief Transmits a message using the specified FlexCAN instance and message buffer index.
  *
@@ -355,15 +676,260 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_Transmit(FlexCAN_Instance_e FlexCAN_Ins, Fle
  */
 FlexCAN_Driver_ReturnCode_e FlexCAN_ReadMailboxData(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, uint8_t * MsgData);
 
+/**
+ * @brief Transmits a whole frame from a Tx message buffer.
+ *
+ * ID, ID type and DLC are taken from the frame on every call, the payload is copied
+ * word-wise with one byte-reverse per word.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Tx message buffer index
+ * @param Frame - Frame to send, DataLen must be 0-8
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_TransmitFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, const FlexCAN_FrameType * Frame);
+
+/**
+ * @brief Reads the frame held by an Rx message buffer straight into the caller's frame.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Rx message buffer index
+ * @param Frame - Frame to fill with ID, ID type, DLC, timestamp and payload
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_ReadFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, FlexCAN_FrameType * Frame);
+
+/**
+ * @brief Transmits a CAN FD (or classic) frame of up to 64 bytes from a Tx message buffer.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Tx message buffer index, must be below FlexCAN_GetMbCount
+ * @param Frame - Frame to send, DataLen must fit the configured payload size
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_TransmitFdFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, const FlexCAN_FdFrameType * Frame);
+
+/**
+ * @brief Reads a CAN FD (or classic) frame of up to 64 bytes from an Rx message buffer.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Rx message buffer index, must be below FlexCAN_GetMbCount
+ * @param Frame - Frame to fill
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_ReadFdFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, FlexCAN_FdFrameType * Frame);
+
+/**
+ * @brief Gets the free running timer of an instance extended to 32 bits.
+ *
+ * The timer counts nominal bit times. The extension relies on a call at least once per
+ * 65536 bit times; every MB interrupt and every frame read already make one.
+ * Reading the timer also unlocks a locked mailbox, the frame reads hold interrupts off from
+ * their C/S read to their TIMER read so a call from an interrupt cannot tear them.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @return uint32_t - current time in bit times
+ */
+uint32_t FlexCAN_GetTime(FlexCAN_Instance_e FlexCAN_Ins);
+
+/**
+ * @brief Gets the times of the last Rx or Tx-complete event of a message buffer.
+ *
+ * Captured by the MB interrupt before the callback runs, so a Tx callback can read
+ * when its frame was on the bus.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Message buffer index
+ * @param WireTime - Time the frame was on the bus (MB time stamp)
+ * @param IsrTime - Time the interrupt handled the event
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetMbEventTime(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                                                   uint32_t * WireTime, uint32_t * IsrTime);
+
+/**
+ * @brief Computes the nominal bit timing of a clock / bit rate pair.
+ *
+ * Picks the exact bit rate whose sample point is the closest to the target, with the smallest
+ * prescaler on a tie. The function does not touch any register, so it can also run on a host
+ * to generate FlexCAN_BitTimingType tables.
+ *
+ * @param ClkFreq - CAN engine clock frequency in Hz
+ * @param BitRate - Nominal bit rate in bit/s
+ * @param SamplePoint - Target sample point in per mille, 0 selects FLEXCAN_SAMPLE_POINT_DEFAULT
+ * @param Sjw - Resynchronization jump width in time quanta, 0 selects the largest allowed one
+ * @param Cbt - Resulting CBT register value
+ * @return bool - true if the bit rate is reachable exactly
+ */
+bool FlexCAN_CalcBitTiming(uint32_t ClkFreq, uint32_t BitRate, uint16_t SamplePoint, uint8_t Sjw, uint32_t * Cbt);
+
+/**
+ * @brief Programs consecutive Rx message buffers with ID + individual mask filters.
+ *
+ * All message buffers and their RXIMR registers are written in a single freeze mode session,
+ * so no frame is matched against a half-written filter set.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param FirstMb - First message buffer to program, must be after the Rx FIFO area if the FIFO is used
+ * @param Filters - Filter table, one message buffer per filter
+ * @param NoOfFilters - Number of filters
+ * @param IsEnableMbInt - Enable the interrupt of the programmed message buffers
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetRxFilters(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e FirstMb,
+                                                 const FlexCAN_RxFilterType * Filters, uint8_t NoOfFilters, bool IsEnableMbInt);
+
+/**
+ * @brief Checks whether a Tx message buffer is free for a new frame.
+ *
+ * A Tx message buffer returns to INACTIVE once its frame is sent, or to ABORT once an abort completes.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Tx message buffer index
+ * @return bool - true if the message buffer holds no pending frame
+ */
+bool FlexCAN_IsTxMbIdle(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex);
+
+/**
+ * @brief Aborts the frame pending in a Tx message buffer and waits for the abort acknowledge.
+ *
+ * A frame still waiting for the bus is aborted at once. A frame already on the bus is not cut, the
+ * acknowledge comes at its end, so the wait is one frame time at most. The message buffer is idle
+ * on return and its flag is cleared. Only its interrupt is masked during the wait.
+ * The wait gives up after 1024 bit times, or at once if the module is frozen or disabled.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Tx message buffer index
+ * @return FlexCAN_TxAbort_e - what happened to the pending frame
+ */
+FlexCAN_TxAbort_e FlexCAN_AbortTx(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex);
+
+/**
+ * @brief Loads the payload of a remote answer (RANSWER) message buffer.
+ *
+ * The controller sends the payload on its own when a remote request with the message buffer ID is
+ * received. An inactive Tx message buffer becomes a remote answer one with its first payload, so
+ * nothing is answered before. The message buffer leaves the matching while it is written, an answer
+ * never mixes the old and the new payload: a request received in between is not answered.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MbIndex - Remote answer or inactive Tx message buffer index, its individual mask set
+ * @param Data - New payload
+ * @param DataLen - Payload length, 0 to 8
+ * @return FlexCAN_Driver_ReturnCode_e - error if the message buffer is busy or receives
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetAnswerData(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                                                  const uint8_t * Data, uint8_t DataLen);
+
+/**
+ * @brief Gets the number of message buffers that fit in the RAM with the configured payload size.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @return uint8_t - 32 for classic CAN (16 on FlexCAN1/2), 21, 12 or 7 for 16, 32 or 64-byte FD payloads
+ */
+uint8_t FlexCAN_GetMbCount(FlexCAN_Instance_e FlexCAN_Ins);
+
+/**
+ * @brief Sets MCR[MAXMB], the last message buffer taking part in the Rx matching and the Tx arbitration.
+ *
+ * Both scan every message buffer up to MAXMB for each frame, a smaller value shortens them. Message
+ * buffers above it are ignored even if active. Changing the value goes through freeze mode: the
+ * module leaves the bus at the end of the current frame and misses the frames of that window.
+ * Nothing is done if MAXMB already has the value.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param MaxMb - Last message buffer, below FlexCAN_GetMbCount and not below the end of the Rx FIFO area
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetMaxMb(FlexCAN_Instance_e FlexCAN_Ins, uint8_t MaxMb);
+
+/**
+ * @brief Pops the oldest frame record from the Rx FIFO ring.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param Record - Pointer to the record to fill (raw CS, ID and data words)
+ * @return FlexCAN_Driver_ReturnCode_e - SUCCESSED if a record was read, ERROR if the ring is empty
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_RxFifoRead(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbStructureType * Record);
+
+/**
+ * @brief Gets the number of frames lost because the Rx FIFO or its ring overflowed.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @return uint32_t - number of lost frames since init
+ */
+uint32_t FlexCAN_RxFifoGetOverflowCount(FlexCAN_Instance_e FlexCAN_Ins);
+
+/**
+ * @brief Pops the oldest frame from the Rx FIFO ring, decoded like FlexCAN_ReadFrame.
+ *
+ * @param FlexCAN_Ins - FlexCAN instance number
+ * @param Frame - Frame to fill
+ * @return FlexCAN_Driver_ReturnCode_e - SUCCESSED if a frame was read, ERROR if the ring is empty
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_RxFifoReadFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_FrameType * Frame);
+
 /**
  * @brief Registers a callback function for the specified FlexCAN instance.
  *
+ * Each instance has its own callback table, the three modules can run at the same time.
+ *
  * @param Ins - FlexCAN instance number
- * @param CallbackFunc - Callback function to be registered
- * @param CallbackID - Identifier for the callback
+ * @param CallbackFunc - Callback function to be registered, NULL removes the callback
+ * @param CallbackID - Message buffer index, FLEXCAN_ERROR_CALLBACK_ID or FLEXCAN_ORED_CALLBACK_ID
+ * @param Context - Passed back to the callback
  * @return FlexCAN_Driver_ReturnCode_e - status of the operation
  */
-FlexCAN_Driver_ReturnCode_e FlexCAN_CallbackRegister(FlexCAN_Instance_e Ins, FlexCAN_CallbackType CallbackFunc, uint8_t CallbackID);
+FlexCAN_Driver_ReturnCode_e FlexCAN_CallbackRegister(FlexCAN_Instance_e Ins, FlexCAN_CallbackType CallbackFunc,
+                                                     uint8_t CallbackID, void * Context);
+
+/**
+ * @brief Installs the frame observer of an instance, next to its callbacks.
+ *
+ * The observer sees the frames of the mailboxes with an interrupt before their callback, every
+ * frame leaving the Rx FIFO, dropped ones included, and every error interrupt. Frames of
+ * mailboxes without an interrupt are not seen.
+ *
+ * @param Ins - FlexCAN instance number
+ * @param Observer - Observer to install, NULL removes it
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetObserver(FlexCAN_Instance_e Ins, FlexCAN_ObserverType Observer);
+
+/**
+ * @brief Selects how a group of mailboxes is served: interrupt, polling or adaptive.
+ *
+ * Call once the mailboxes are set up. A polled mailbox is served like in the MB interrupt, event
+ * time, observer and callback, from FlexCAN_RxPoll with the interrupts disabled. A mailbox holds
+ * one frame: the poll period and Budget must empty the group before a mailbox is overrun.
+ * The counters are cleared.
+ *
+ * @param Ins - FlexCAN instance number
+ * @param Config - Receive mode, copied
+ * @return FlexCAN_Driver_ReturnCode_e - ERROR if Budget or QuietPasses is 0 or MbMask covers the Rx FIFO
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetRxMode(FlexCAN_Instance_e Ins, const FlexCAN_RxPollConfigType * Config);
+
+/**
+ * @brief Serves the raised mailboxes of the polled group, lowest MB first, Budget at most.
+ *
+ * Called from the main loop or a timer. Does nothing in interrupt mode, nor in adaptive mode while
+ * the interrupts are enabled. A frame that comes while the interrupts are enabled again raises the
+ * interrupt at once, its flag is still set.
+ *
+ * @param Ins - FlexCAN instance number
+ * @return uint8_t - number of mailboxes served
+ */
+uint8_t FlexCAN_RxPoll(FlexCAN_Instance_e Ins);
+
+/**
+ * @brief Copies the receive counters of an instance.
+ *
+ * @param Ins - FlexCAN instance number
+ * @param Stats - Counters
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetRxPollStats(FlexCAN_Instance_e Ins, FlexCAN_RxPollStatsType * Stats);
 
 /**
  * @brief Gets the current state of the specified FlexCAN module.
@@ -382,4 +948,27 @@ FlexCAN_State_e FlexCAN_GetModuleState(FlexCAN_Instance_e Ins);
  */
 uint8_t FlexCAN_GetStatusFlag(FlexCAN_Instance_e Ins, FlexCAN_StatusFlag_e FlagType);
 
+/**
+ * @brief Reads the error counters and ESR1 of the specified FlexCAN instance.
+ *
+ * ESR1 is read once, so the error bits and the fault confinement state stay consistent.
+ *
+ * @param Ins - FlexCAN instance number
+ * @param State - Pointer to store the error counters and ESR1
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetErrorState(FlexCAN_Instance_e Ins, FlexCAN_ErrorStateType * State);
+
+/**
+ * @brief Selects how the specified FlexCAN instance leaves the bus-off state.
+ *
+ * With automatic recovery the module rejoins the bus after 128 occurrences of 11 recessive bits.
+ * Otherwise it stays bus-off until this function enables automatic recovery again.
+ *
+ * @param Ins - FlexCAN instance number
+ * @param IsAutomatic - true to recover automatically, false to hold the bus-off state
+ * @return FlexCAN_Driver_ReturnCode_e - status of the operation
+ */
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetBusOffRecovery(FlexCAN_Instance_e Ins, bool IsAutomatic);
+
 #endif /* FLEXCAN_H_ */
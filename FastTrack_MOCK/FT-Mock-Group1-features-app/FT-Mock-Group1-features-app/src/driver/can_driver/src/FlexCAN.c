@@ -6,24 +6,77 @@
  */
 
 #include "FlexCAN.h"
+#include "s32_core_cm4.h"
 #include <stddef.h>
 
 /* ----------------------------------------------------------------------------
    -- Definitions
    ---------------------------------------------------------------------------- */
-#define NUMBER_OF_ERROR_ORED_HANDLER_TYPE	(FLEXCAN_INSTANCE_COUNT*2U)
-#define ERROR_HANDLER_GAP			(2U)
-#define ORED_HANDLER_GAP			(1U)
 #define ERROR_INT                               (0x300002U)    /*!< Masks for ErrorOvr, ErrorFast, Error */
 #define BUS_OFF_INT                             (0xB0004U)     /*!< Masks for busOff, Tx/Rx Warning */
 #define NUMBER_OF_MB				(32U)
-#define ERROR_CALLBACK_ID			(32U)
+#define NUMBER_OF_CALLBACK			(FLEXCAN_ORED_CALLBACK_ID + 1U)
+#define MB_0_15_FLAGS_MASK			(0x0000FFFFU)  /*!< IFLAG1 bits served by the ORed_0_15_MB vector */
+#define MB_16_31_FLAGS_MASK			(0xFFFF0000U)  /*!< IFLAG1 bits served by the ORed_16_31_MB vector */
+#define MB_HEADER_WORDS				(2U)
+#define FLEXCAN_MB_RAM_WORDS			{ 128U, 64U, 64U } /*!< Message buffer RAM of FlexCAN0/1/2, in words */
+#define FD_DLC_COUNT				(16U)
+#define FD_TQ_MIN				(5U)           /*!< Minimum time quanta per data phase bit */
+#define CBT_PRESDIV_MAX				(1024U)
+#define CBT_PROPSEG_MAX				(64U)
+#define CBT_PSEG_MAX				(32U)
+#define CBT_PSEG2_MIN				(2U)
+#define CBT_TQ_MIN				(8U)
+#define CBT_TQ_MAX				(1U + CBT_PROPSEG_MAX + CBT_PSEG_MAX + CBT_PSEG_MAX)
+#define SAMPLE_POINT_SCALE			(1000U)        /*!< Sample points are given in per mille */
+#define BIT_TIMING_TABLE_SIZE			(sizeof(FlexCAN_BitTimingTable) / sizeof(FlexCAN_BitTimingTable[0]))
+#define BIT_TIMING_MATCH(Timing, Config, SamplePoint) \
+        ((Timing)->ClkFreq == (Config)->ClkFreq && (Timing)->BitRate == (Config)->BitRate \
+         && (Timing)->SamplePoint == (SamplePoint) && (Timing)->Sjw == (Config)->Sjw)
+#define FD_TQ_MAX				(48U)          /*!< 1 + FPROPSEG(31) + FPSEG1(8) + FPSEG2(8) */
+#define FD_PRESDIV_MAX				(1024U)
+#define FD_PSEG_MAX				(8U)
+#define FD_PSEG2_MIN				(2U)
+#define FD_TDCOFF_MAX				(31U)
+#define FLEXCAN_CTZ(x)				((uint8_t)__builtin_ctz(x)) /*!< RBIT + CLZ on Cortex-M4, x must not be 0 */
+#define RXFIFO_FRAME_AVAILABLE_MASK		(0x20U)        /*!< IFLAG1[BUF5I]: frames available in Rx FIFO */
+#define RXFIFO_WARNING_MASK			(0x40U)        /*!< IFLAG1[BUF6I]: Rx FIFO almost full */
+#define RXFIFO_OVERFLOW_MASK			(0x80U)        /*!< IFLAG1[BUF7I]: Rx FIFO overflow */
+#define RXFIFO_FLAGS_MASK			(RXFIFO_FRAME_AVAILABLE_MASK | RXFIFO_WARNING_MASK | RXFIFO_OVERFLOW_MASK)
+#define RXFIFO_FILTER_TABLE_OFFSET		(24U)          /*!< ID filter table starts at MB6 (RAMn[24]) */
+#define RXFIFO_RECORD_SIZE			(16U)          /*!< CS, ID and two data words */
+#define RXFIFO_MAX_ID_FILTERS			(128U)         /*!< CTRL2[RFFN] = 15 */
+#define RXIMR_COUNT				(32U)
+#define ABORT_TIMEOUT_BITS			(1024U)        /*!< Longest FD frame plus an error frame, in bit times */
+#define RXIMR_MATCH_ALL_BITS			(0xFFFFFFFFU)  /*!< Individual mask for an exact ID match */
+#define DMA_NO_OWNER				(0xFFU)
+#define DMA_CITER_MAX				(0x7FFFU)      /*!< 15-bit CITER/BITER, channel linking disabled */
+#define DMA_IRQ_HANDLER(Channel)		DMA_IRQ_HANDLER_NAME(Channel)
+#define DMA_IRQ_HANDLER_NAME(Channel)		DMA##Channel##_IRQHandler
+#define DMA_TRANSFER_SIZE_32BIT			(2U)
+#define DMA_SMOD_RXFIFO				(4U)           /*!< Source address wraps on the 16-byte FIFO output */
+#define FLEXCAN_DMA_REQUEST_SOURCES		{ 54U, 55U, 56U } /*!< DMAMUX sources of FlexCAN0/1/2 */
 
 /* ----------------------------------------------------------------------------
    -- Variables
    ---------------------------------------------------------------------------- */
-FlexCAN_CallbackType FlexCAN_Callback[NUMBER_OF_ERROR_ORED_HANDLER_TYPE] = { NULL };
-FlexCAN_CallbackType FlexCAN_MbCallback[NUMBER_OF_MB] = { NULL };
+typedef struct
+{
+    FlexCAN_CallbackType Func;
+    void * Context;
+} FlexCAN_CallbackEntryType;
+
+/**
+ * Callbacks of MB0-MB31, then the error and ORed callbacks.
+ * @note This array is indexed by FLEXCAN instance numbers, then by callback ID.
+ */
+static FlexCAN_CallbackEntryType FlexCAN_Callback[FLEXCAN_INSTANCE_COUNT][NUMBER_OF_CALLBACK];
+
+/**
+ * Frame observers, NULL if none.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static FlexCAN_ObserverType FlexCAN_Observer[FLEXCAN_INSTANCE_COUNT];
 
 FlexCAN_State_e	FlexCAN_CurrentState[FLEXCAN_INSTANCE_COUNT] = { FLEXCAN_STATE_UNINIT };
 
@@ -35,15 +88,115 @@ static FLEXCAN_Type *FlexCAN_Base_Addr[FLEXCAN_INSTANCE_COUNT] = IP_FLEXCAN_BASE
 
 FlexCAN_MbType * FlexCAN_MB[FLEXCAN_INSTANCE_COUNT] = {MB_FLEXCAN_0, MB_FLEXCAN_1, MB_FLEXCAN_2};
 
+/**
+ * Words per message buffer (header + payload) of FLEXCAN instances, set by FlexCAN_Init.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static uint8_t FlexCAN_MbWords[FLEXCAN_INSTANCE_COUNT] = { MB_HEADER_WORDS + 2U, MB_HEADER_WORDS + 2U, MB_HEADER_WORDS + 2U };
+
+/**
+ * Nominal bit timings of the usual S32K144 clocks (8 MHz SOSC, 40 MHz OSC, 48 MHz and 80 MHz SYS),
+ * generated with FlexCAN_CalcBitTiming for an 87.5% sample point and automatic SJW.
+ */
+static const FlexCAN_BitTimingType FlexCAN_BitTimingTable[] =
+{
+    {  8000000U,  125000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 28U, 27U, 8U, 8U) },
+    {  8000000U,  250000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 14U, 13U, 4U, 4U) },
+    {  8000000U,  500000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 7U, 6U, 2U, 2U) },
+    {  8000000U, 1000000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 3U, 2U, 2U, 2U) },
+    { 40000000U,  125000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(4U, 37U, 32U, 10U, 10U) },
+    { 40000000U,  250000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(2U, 37U, 32U, 10U, 10U) },
+    { 40000000U,  500000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 37U, 32U, 10U, 10U) },
+    { 40000000U, 1000000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 17U, 17U, 5U, 5U) },
+    { 48000000U,  125000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(4U, 51U, 32U, 12U, 12U) },
+    { 48000000U,  250000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(2U, 51U, 32U, 12U, 12U) },
+    { 48000000U,  500000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 51U, 32U, 12U, 12U) },
+    { 48000000U, 1000000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 21U, 20U, 6U, 6U) },
+    { 80000000U,  125000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(8U, 37U, 32U, 10U, 10U) },
+    { 80000000U,  250000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(4U, 37U, 32U, 10U, 10U) },
+    { 80000000U,  500000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(2U, 37U, 32U, 10U, 10U) },
+    { 80000000U, 1000000U, FLEXCAN_SAMPLE_POINT_DEFAULT, 0U, FLEXCAN_CBT_VALUE(1U, 37U, 32U, 10U, 10U) }
+};
+
+/**
+ * Payload length in bytes of each DLC code, classic DLC 9-15 are clamped to 8 by the readers.
+ */
+static const uint8_t FlexCAN_DlcToLength[FD_DLC_COUNT] = { 0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+
+/**
+ * Runtime state of the Rx FIFO ring of each instance.
+ * Produced is written by the ISR only, Consumed by FlexCAN_RxFifoRead only.
+ */
+typedef struct
+{
+    const FlexCAN_RxFifoConfigType * Config;
+    volatile uint32_t Produced;
+    volatile uint32_t Consumed;
+    volatile uint32_t OverflowCount;
+    volatile uint32_t BatchTime;    /*!< Time of the last drain interrupt */
+} FlexCAN_RxFifoStateType;
+
+static FlexCAN_RxFifoStateType FlexCAN_RxFifoState[FLEXCAN_INSTANCE_COUNT];
+
+/**
+ * Last 32-bit time of each instance, its low half always equals the hardware TIMER value.
+ */
+static volatile uint32_t FlexCAN_TimeLast[FLEXCAN_INSTANCE_COUNT];
+
+/**
+ * Times of the last event of each mailbox, captured by the MB interrupt.
+ */
+typedef struct
+{
+    uint32_t WireTime;
+    uint32_t IsrTime;
+    bool IsPending;     /*!< Event not consumed by a frame read yet */
+} FlexCAN_MbEventTimeType;
+
+static FlexCAN_MbEventTimeType FlexCAN_MbEventTime[FLEXCAN_INSTANCE_COUNT][NUMBER_OF_MB];
+
+/**
+ * Receive mode of each instance.
+ * IsPolling is set by the MB ISR or FlexCAN_SetRxMode, cleared by FlexCAN_RxPoll or FlexCAN_SetRxMode.
+ */
+typedef struct
+{
+    FlexCAN_RxPollConfigType Config;
+    uint32_t Group;                 /*!< Mailboxes of Config.MbMask that had their interrupt enabled */
+    volatile bool IsPolling;        /*!< Interrupts of Group masked, FlexCAN_RxPoll serves it */
+    uint8_t QuietCount;             /*!< Quiet passes in a row */
+    FlexCAN_RxPollStatsType Stats;
+} FlexCAN_RxPollStateType;
+
+static FlexCAN_RxPollStateType FlexCAN_RxPollState[FLEXCAN_INSTANCE_COUNT];
+
+/**
+ * FlexCAN instance draining its Rx FIFO through the FLEXCAN_RXFIFO_DMA_CHANNEL eDMA channel.
+ */
+static uint8_t FlexCAN_DmaOwner = DMA_NO_OWNER;
+
+/**
+ * DMAMUX request sources of the FlexCAN Rx FIFOs.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static const uint8_t FlexCAN_DmaRequest[FLEXCAN_INSTANCE_COUNT] = FLEXCAN_DMA_REQUEST_SOURCES;
+
+/**
+ * Message buffer RAM size, 32 classic MBs on FlexCAN0 and 16 on FlexCAN1/2.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static const uint8_t FlexCAN_MbRamWords[FLEXCAN_INSTANCE_COUNT] = FLEXCAN_MB_RAM_WORDS;
+
 /* ----------------------------------------------------------------------------
    -- Private functions
    ---------------------------------------------------------------------------- */
 static void FlexCAN_ModuleControl(FLEXCAN_Type *FlexCANx, uint8_t EnOrDis);
 static void FlexCAN_ClkSrcSelect(FLEXCAN_Type *FlexCANx, FlexCAN_ClkSrc_e CLkSrc);
-static void FlexCAN_ClearMB(FLEXCAN_Type *FlexCANx);
+static void FlexCAN_ClearMB(FLEXCAN_Type *FlexCANx, uint8_t RamWords);
 static void FlexCAN_RunModeSelect(FLEXCAN_Type *FlexCANx, FlexCAN_Mode_e Mode);
 static void FlexCAN_IntControl(FLEXCAN_Type *FlexCANx, FlexCAN_InterruptType IntType);
-static void FlexCAN_SetBitRate(FLEXCAN_Type *FlexCANx, uint32_t Clocks, uint32_t BitRate);
+static void FlexCAN_SetBitRate(FLEXCAN_Type *FlexCANx, uint32_t Cbt);
+static bool FlexCAN_GetBitTiming(const FlexCAN_ConfigType * FlexCAN_Config, uint32_t * Cbt);
 static void FLexCAN_FreezeModeControl(FLEXCAN_Type *FlexCANx, uint8_t EnOrDis);
 static void FlexCAN_SoftReset(FLEXCAN_Type *FlexCANx);
 static void FlexCAN_MBSetEDL(FlexCAN_MbStructureType * Mbx, uint8_t EDLValue);
@@ -52,18 +205,35 @@ static void FlexCAN_MBSetESI(FlexCAN_MbStructureType * Mbx, uint8_t ESIValue);
 static void FlexCAN_MBSetIDType(FlexCAN_MbStructureType * Mbx, FlexCAN_MsgIDType_e IDType);
 static void FlexCAN_MBSetRTR(FlexCAN_MbStructureType * Mbx, bool IsRemote);
 static void FlexCAN_MBSetDataLength(FlexCAN_MbStructureType * Mbx, uint16_t Datalen);
-static void FlexCAN_MBSetID(FlexCAN_MbStructureType * Mbx, uint16_t ID);
+static void FlexCAN_MBSetID(FlexCAN_MbStructureType * Mbx, uint32_t ID, FlexCAN_MsgIDType_e IDType);
 static void FlexCAN_MbSetType(FlexCAN_MbStructureType * Mbx, FlexCAN_MbType_e MbType);
 static void FlexCAN_MbSetInterrupt(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, bool IsEnableMbInt);
 static void FlexCAN_SetModuleState(FlexCAN_Instance_e Ins, FlexCAN_State_e Transition);
 static void FlexCAN_SetMBnumber(FLEXCAN_Type *FlexCANx, uint8_t MaxMB);
+static void FlexCAN_MbToFrame(const volatile FlexCAN_MbStructureType * Mbx, FlexCAN_FrameType * Frame);
+static uint32_t FlexCAN_ExtendTimeStamp(uint32_t Now, uint32_t TimeStamp);
+static uint32_t FlexCAN_ConsumeIsrTime(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, uint32_t Now);
+static FlexCAN_MbStructureType * FlexCAN_GetMb(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex);
+static void FlexCAN_MbService(FlexCAN_Instance_e Ins, uint8_t MbIndex, uint32_t Now);
+static uint8_t FlexCAN_LengthToDlc(uint8_t DataLen);
+static bool FlexCAN_FdCalcTiming(uint32_t Clocks, uint32_t DataBitRate, uint32_t * Fdcbt, uint8_t * SamplePointClocks);
+static bool FlexCAN_FdCheckConfig(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config);
+static void FlexCAN_FdControl(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config);
+static void FlexCAN_RxFifoControl(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_RxFifoConfigType * RxFifoConfig);
+static void FlexCAN_RxFifoSetFilterTable(FLEXCAN_Type *FlexCANx, const FlexCAN_RxFifoConfigType * RxFifoConfig);
+static void FlexCAN_RxFifoDmaInit(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_RxFifoConfigType * RxFifoConfig);
+static bool FlexCAN_CheckMbLayout(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config);
+static bool FlexCAN_CheckRxFifoConfig(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_RxFifoConfigType * RxFifoConfig);
+static void FlexCAN_SetMbLayout(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config);
 
 /* ----------------------------------------------------------------------------
    -- Private functions for interrupt handler
    ---------------------------------------------------------------------------- */
 static void FlexCAN_Error_IRQHandler(FlexCAN_Instance_e Ins);
 static void FlexCAN_BusOff_IRQHandler(FlexCAN_Instance_e Ins);
-static void FlexCAN_MB_IRQHandler(FlexCAN_Instance_e Ins);
+static void FlexCAN_MB_IRQHandler(FlexCAN_Instance_e Ins, uint32_t VectorMask);
+static void FlexCAN_RxFifo_IRQHandler(FlexCAN_Instance_e Ins);
+static void FlexCAN_RxFifoDma_IRQHandler(void);
 
 /* ----------------------------------------------------------------------------
    -- Handlers for FlexCAN interrupts
@@ -75,7 +245,7 @@ void CAN0_ORed_0_15_MB_IRQHandler(void);
 void CAN0_ORed_16_31_MB_IRQHandler(void);
 
 /* FlexCAN 1 interrupt handlers */
-void CAN1_Red_IRQHandler(void);
+void CAN1_ORed_IRQHandler(void);
 void CAN1_Error_IRQHandler(void);
 void CAN1_ORed_0_15_MB_IRQHandler(void);
 void CAN1_ORed_16_31_MB_IRQHandler(void);
@@ -86,6 +256,9 @@ void CAN2_Error_IRQHandler(void);
 void CAN2_ORed_0_15_MB_IRQHandler(void);
 void CAN2_ORed_16_31_MB_IRQHandler(void);
 
+/* eDMA channel interrupt handler used for Rx FIFO draining, the other channels stay free */
+void DMA_IRQ_HANDLER(FLEXCAN_RXFIFO_DMA_CHANNEL)(void);
+
 /* ----------------------------------------------------------------------------
    -- Global functions
    ---------------------------------------------------------------------------- */
@@ -94,8 +267,14 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_Init(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN
     FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
 
     FLEXCAN_Type *FlexCANx = NULL;
-
-   if(FlexCAN_Ins > FlexCAN2_INS || FlexCAN_Config == NULL || FlexCAN_CurrentState[FlexCAN_Ins] != FLEXCAN_STATE_UNINIT)
+    uint8_t MaskIndex = 0U;
+    uint32_t Cbt = 0U;
+
+   if(FlexCAN_Ins > FlexCAN2_INS || FlexCAN_Config == NULL || FlexCAN_CurrentState[FlexCAN_Ins] != FLEXCAN_STATE_UNINIT
+      || FlexCAN_FdCheckConfig(FlexCAN_Ins, FlexCAN_Config) == false
+      || FlexCAN_CheckMbLayout(FlexCAN_Ins, FlexCAN_Config) == false
+      || FlexCAN_CheckRxFifoConfig(FlexCAN_Ins, FlexCAN_Config->RxFifoConfig) == false
+      || FlexCAN_GetBitTiming(FlexCAN_Config, &Cbt) == false)
    {
        /* Invalid parameters or driver already in init state */
    }
@@ -113,18 +292,50 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_Init(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN
         FlexCAN_ModuleControl(FlexCANx, ENABLE);
 
         /* Sets desired bit rate for FlexCAN module */
-        FlexCAN_SetBitRate(FlexCANx, FlexCAN_Config->ClkFreq, FlexCAN_Config->BitRate);
+        FlexCAN_SetBitRate(FlexCANx, Cbt);
+
+        /* CAN FD mode, data phase bit timing and payload size */
+        FlexCAN_FdControl(FlexCAN_Ins, FlexCAN_Config);
 
         /* Clear MSG Buffers */
-        FlexCAN_ClearMB(FlexCANx);
+        FlexCAN_ClearMB(FlexCANx, FlexCAN_MbRamWords[FlexCAN_Ins]);
 
         /* Select mode for FlexCAN module */
         FlexCAN_RunModeSelect(FlexCANx, FlexCAN_Config->RunMode);
 
+        /* Among pending Tx MBs the lowest ID is sent first, not the lowest MB number */
+        FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_LBUF_MASK;
+
+        /* Remote requests are answered by RANSWER MBs, not stored */
+        FlexCANx->CTRL2 &= ~FLEXCAN_CTRL2_RRS_MASK;
+
+        /* Tx_CODE_ABORT takes pending frames back, see FlexCAN_AbortTx */
+        FlexCANx->MCR |= FLEXCAN_MCR_AEN_MASK;
+
+        /* Individual Rx masks, exact match until FlexCAN_SetRxFilters widens them */
+        FlexCANx->MCR |= FLEXCAN_MCR_IRMQ_MASK;
+        for(MaskIndex = 0U; MaskIndex < (FlexCAN_MbRamWords[FlexCAN_Ins] / (MB_HEADER_WORDS + 2U)); MaskIndex++)
+        {
+            FlexCANx->RXIMR[MaskIndex] = RXIMR_MATCH_ALL_BITS;
+        }
+
         /* Interrupts controlling for FLexCAN module */
         FlexCAN_IntControl(FlexCANx, FlexCAN_Config->IntControl);
 
-        FlexCAN_SetMBnumber(FlexCANx, FlexCAN_Config->MaxNoMB);
+        /* Larger FD payloads leave fewer message buffers in the RAM */
+        FlexCAN_SetMBnumber(FlexCANx, (FlexCAN_Config->MaxNoMB < FlexCAN_GetMbCount(FlexCAN_Ins))
+                                      ? FlexCAN_Config->MaxNoMB : (FlexCAN_GetMbCount(FlexCAN_Ins) - 1U));
+
+        /* Rx FIFO, ID filter table and optional eDMA draining */
+        FlexCAN_RxFifoControl(FlexCAN_Ins, FlexCAN_Config->RxFifoConfig);
+
+        /* Every mailbox is served by its interrupt until FlexCAN_SetRxMode */
+        FlexCAN_RxPollState[FlexCAN_Ins].Config.Mode = FlexCAN_RX_MODE_IRQ;
+        FlexCAN_RxPollState[FlexCAN_Ins].Group = 0U;
+        FlexCAN_RxPollState[FlexCAN_Ins].IsPolling = false;
+
+        /* Mailboxes, masks and callbacks of the const layout */
+        FlexCAN_SetMbLayout(FlexCAN_Ins, FlexCAN_Config);
 
         /* Exit Freeze mode */
         FLexCAN_FreezeModeControl(FlexCANx, DISABLE);
@@ -153,6 +364,14 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_DeInit(FlexCAN_Instance_e FlexCAN_Ins)
     {
         FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
 
+        /* Release the Rx FIFO eDMA channel */
+        if(FlexCAN_DmaOwner == (uint8_t)FlexCAN_Ins)
+        {
+            IP_DMA->CERQ = FLEXCAN_RXFIFO_DMA_CHANNEL;
+            IP_DMAMUX->CHCFG[FLEXCAN_RXFIFO_DMA_CHANNEL] = 0U;
+            FlexCAN_DmaOwner = DMA_NO_OWNER;
+        }
+
         /* Reset memory-mapped registers */
         FlexCAN_SoftReset(FlexCANx);
 
@@ -169,34 +388,180 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_DeInit(FlexCAN_Instance_e FlexCAN_Ins)
     return RetVal;
 }
 
-FlexCAN_Driver_ReturnCode_e FlexCAN_CallbackRegister(FlexCAN_Instance_e Ins, FlexCAN_CallbackType CallbackFunc, uint8_t CallbackID)
+FlexCAN_Driver_ReturnCode_e FlexCAN_CallbackRegister(FlexCAN_Instance_e Ins, FlexCAN_CallbackType CallbackFunc,
+                      uint8_t CallbackID, void * Context)
 {
     FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
 
-    uint8_t CallbackIndex = CallbackID;
-
-    if(Ins > FlexCAN2_INS || CallbackFunc == NULL)
+    if(Ins > FlexCAN2_INS || CallbackID >= NUMBER_OF_CALLBACK)
     {
         /* Invalid parameters */
     }
     else
     {
         /* Saving handler function to the corresponding callback pointer */
-        if(CallbackIndex < NUMBER_OF_MB)
+        FlexCAN_Callback[Ins][CallbackID].Func = CallbackFunc;
+        FlexCAN_Callback[Ins][CallbackID].Context = Context;
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetObserver(FlexCAN_Instance_e Ins, FlexCAN_ObserverType Observer)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    if(Ins > FlexCAN2_INS)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        FlexCAN_Observer[Ins] = Observer;
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetRxMode(FlexCAN_Instance_e Ins, const FlexCAN_RxPollConfigType * Config)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FLEXCAN_Type *FlexCANx = NULL;
+    FlexCAN_RxPollStateType * PollState = NULL;
+    uint32_t FifoMbs = 0U;
+
+    if(Ins > FlexCAN2_INS || Config == NULL || Config->Mode > FlexCAN_RX_MODE_ADAPTIVE
+       || Config->Budget == 0U || Config->QuietPasses == 0U)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[Ins];
+        PollState = &FlexCAN_RxPollState[Ins];
+
+        /* MB0-MB7 and the filter table belong to the FIFO engine */
+        if(FlexCAN_RxFifoState[Ins].Config != NULL)
         {
-            FlexCAN_MbCallback[CallbackID] = CallbackFunc;
+            FifoMbs = (SET << FLEXCAN_RXFIFO_FIRST_FREE_MB(FlexCAN_RxFifoState[Ins].Config->NoOfIdFilters)) - 1U;
         }
-        else
+
+        if((Config->MbMask & FifoMbs) == 0U)
         {
-            if(CallbackID == ERROR_CALLBACK_ID)
+            DISABLE_INTERRUPTS();
+
+            /* Give the previous group its interrupts back */
+            if(PollState->IsPolling == true)
             {
-                FlexCAN_Callback[Ins*ERROR_HANDLER_GAP] = CallbackFunc;
+                FlexCANx->IMASK1 |= PollState->Group;
             }
-            else
+
+            /* Mailboxes without interrupt stay with their owner, who polls them */
+            PollState->Config = *Config;
+            PollState->Group = FlexCANx->IMASK1 & Config->MbMask;
+            PollState->IsPolling = (Config->Mode == FlexCAN_RX_MODE_POLL);
+            PollState->QuietCount = 0U;
+            PollState->Stats = (FlexCAN_RxPollStatsType){ 0U };
+
+            if(PollState->IsPolling == true)
+            {
+                FlexCANx->IMASK1 &= ~PollState->Group;
+            }
+
+            ENABLE_INTERRUPTS();
+
+            RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+        }
+        else
+        {
+            /* Group overlaps the Rx FIFO */
+        }
+    }
+
+    return RetVal;
+}
+
+uint8_t FlexCAN_RxPoll(FlexCAN_Instance_e Ins)
+{
+    uint8_t Served = 0U;
+
+    FLEXCAN_Type *FlexCANx = NULL;
+    FlexCAN_RxPollStateType * PollState = NULL;
+    uint32_t RaisedFlags = 0U;
+    uint32_t Now = 0U;
+    uint8_t MbIndex = 0U;
+
+    if(Ins > FlexCAN2_INS || FlexCAN_RxPollState[Ins].IsPolling == false)
+    {
+        /* Invalid parameter or the interrupts serve the group */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[Ins];
+        PollState = &FlexCAN_RxPollState[Ins];
+
+        RaisedFlags = FlexCANx->IFLAG1 & PollState->Group;
+
+        if(RaisedFlags != 0U)
+        {
+            Now = FlexCAN_GetTime(Ins);
+        }
+
+        while(RaisedFlags != 0U && Served < PollState->Config.Budget)
+        {
+            MbIndex = FLEXCAN_CTZ(RaisedFlags);
+            RaisedFlags &= (RaisedFlags - 1U);
+
+            /* The callback runs as it would in the MB interrupt */
+            DISABLE_INTERRUPTS();
+            FlexCAN_MbService(Ins, MbIndex, Now);
+            ENABLE_INTERRUPTS();
+
+            Served++;
+        }
+
+        /* Reading C/S above may leave an Rx MB locked when its callback did not read it */
+        (void)FlexCANx->TIMER;
+
+        PollState->Stats.PollPasses++;
+        PollState->Stats.PollFrames += Served;
+
+        if(PollState->Config.Mode == FlexCAN_RX_MODE_ADAPTIVE)
+        {
+            PollState->QuietCount = (Served <= PollState->Config.QuietFrames) ? (PollState->QuietCount + 1U) : 0U;
+
+            if(PollState->QuietCount >= PollState->Config.QuietPasses)
             {
-                FlexCAN_Callback[Ins*ERROR_HANDLER_GAP + ORED_HANDLER_GAP] = CallbackFunc;
+                /* A flag raised since the IFLAG1 read interrupts as soon as its mask is set */
+                DISABLE_INTERRUPTS();
+                PollState->IsPolling = false;
+                FlexCANx->IMASK1 |= PollState->Group;
+                ENABLE_INTERRUPTS();
             }
         }
+    }
+
+    return Served;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetRxPollStats(FlexCAN_Instance_e Ins, FlexCAN_RxPollStatsType * Stats)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    if(Ins > FlexCAN2_INS || Stats == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        DISABLE_INTERRUPTS();
+        *Stats = FlexCAN_RxPollState[Ins].Stats;
+        ENABLE_INTERRUPTS();
 
         RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
     }
@@ -211,13 +576,13 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_MbInit(FlexCAN_Instance_e FlexCAN_Ins, FlexC
 
     FlexCAN_MbStructureType * Mbx = NULL;
 
-    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex > MB31 || FLexCAN_MbConfig == NULL)
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || FLexCAN_MbConfig == NULL)
     {
         /* Invalid parameters */
     }
     else
     {
-        Mbx = &((FlexCAN_MB[FlexCAN_Ins])->MB[MbIndex]);
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
 
         FlexCAN_MBSetEDL(Mbx, FLexCAN_MbConfig->EDL);
 
@@ -234,7 +599,7 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_MbInit(FlexCAN_Instance_e FlexCAN_Ins, FlexC
 
         FlexCAN_MBSetDataLength(Mbx, FLexCAN_MbConfig->DataLen);
 
-        FlexCAN_MBSetID(Mbx, FLexCAN_MbConfig->MbID);
+        FlexCAN_MBSetID(Mbx, FLexCAN_MbConfig->MbID, FLexCAN_MbConfig->IdType);
 
         FlexCAN_MbSetType(Mbx, FLexCAN_MbConfig->MbType);
 
@@ -246,6 +611,36 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_MbInit(FlexCAN_Instance_e FlexCAN_Ins, FlexC
     return RetVal;
 }
 
+FlexCAN_Driver_ReturnCode_e FlexCAN_MbDeInit(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FLEXCAN_Type * FlexCANx = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins))
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+
+        FlexCAN_MbSetInterrupt(FlexCAN_Ins, MbIndex, false);
+
+        /* Out of the matching and the arbitration, a pending frame was aborted by the caller */
+        Mbx->Header[0] = FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_INACTIVE);
+
+        /* Clear Int Flag, write-1-to-clear */
+        FlexCANx->IFLAG1 = (SET << MbIndex);
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
 FlexCAN_Driver_ReturnCode_e FlexCAN_Transmit(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
                       uint8_t * MsgData)
 {
@@ -260,18 +655,21 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_Transmit(FlexCAN_Instance_e FlexCAN_Ins, Fle
     uint8_t WordSize = 4;
     uint8_t ByteOffset = 0;
 
-    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex > MB31 || MsgData == NULL)
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || MsgData == NULL)
     {
         /* Invalid parameters*/
     }
     else
     {
         FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
-        Mbx = &((FlexCAN_MB[FlexCAN_Ins])->MB[MbIndex]);
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
         DataLen = (((Mbx->Header[0]) & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
 
-        /* Clear Int Flag */
-        FlexCANx->IFLAG1 &= ~(1 << MbIndex);
+        /* DLC 9-15 still carries 8 bytes on a classic frame */
+        DataLen = (DataLen > FLEXCAN_FRAME_MAX_DATA_LEN) ? FLEXCAN_FRAME_MAX_DATA_LEN : DataLen;
+
+        /* Clear Int Flag, write-1-to-clear */
+        FlexCANx->IFLAG1 = (SET << MbIndex);
 
         /* Clear data */
         Mbx->Payload[0] = 0;
@@ -301,115 +699,928 @@ FlexCAN_Driver_ReturnCode_e FlexCAN_Transmit(FlexCAN_Instance_e FlexCAN_Ins, Fle
     return RetVal;
 }
 
-FlexCAN_Driver_ReturnCode_e FlexCAN_ReadMailboxData(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
-                             uint8_t * MsgData)
+FlexCAN_Driver_ReturnCode_e FlexCAN_TransmitFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      const FlexCAN_FrameType * Frame)
 {
-    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
 
     FLEXCAN_Type * FlexCANx = NULL;
     FlexCAN_MbStructureType * Mbx = NULL;
-    uint8_t DataLen = 0U;
 
-    uint8_t Index = 0U;
-    uint8_t WordIndex = 0U;
-    uint8_t WordSize = 4U;
-    uint8_t ByteOffset = 0U;
-    
-    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex > MB31 || MsgData == NULL)
+    uint32_t Word = 0U;
+    uint32_t ControlStatus = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || Frame == NULL || Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
     {
         /* Invalid parameters */
     }
     else
     {
         FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
-        Mbx = &((FlexCAN_MB[FlexCAN_Ins])->MB[MbIndex]);
-        DataLen = (((Mbx->Header[0]) & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK)
-                                >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
-    
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+
+        /* Clear Int Flag, write-1-to-clear */
+        FlexCANx->IFLAG1 = (SET << MbIndex);
+
         /* Changes state to STARTED */
         FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_STARTED);
 
-        for(Index = 0; Index < DataLen; Index++)
+        /* Message data to RAM, bus byte order is big endian in the MB words */
+        REV_BYTES_32(Frame->Data.Word[0], Word);
+        Mbx->Payload[0] = Word;
+        REV_BYTES_32(Frame->Data.Word[1], Word);
+        Mbx->Payload[1] = Word;
+
+        /* Keep the FD bits of the MB configuration, SRR must always be 1 */
+        ControlStatus = (Mbx->Header[0] & (FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK | FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK
+                                           | FLEXCAN_RAMn_DATA_WORD_0_ESI_MASK))
+                      | FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK
+                      | FLEXCAN_RAMn_DATA_WORD_0_DLC(Frame->DataLen)
+                      | FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_DATA);
+
+        if(Frame->IdType == FlexCAN_EXTENDED)
         {
-            WordIndex = (Index / WordSize);
-            ByteOffset = 3 - (Index % WordSize);
-            MsgData[Index] = ((Mbx->Payload[WordIndex]) >> (8 * ByteOffset));
+            Mbx->Header[1] = FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Frame->Id);
+            ControlStatus |= FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK;
+        }
+        else
+        {
+            Mbx->Header[1] = FLEXCAN_RAMn_DATA_WORD_1_ID(Frame->Id);
         }
 
-        /* Unlock the Mailbox */
-        (void)FlexCANx->TIMER;
+        /* Start transmitting, CODE is written last in a single store */
+        Mbx->Header[0] = ControlStatus;
 
         /* Changes state to READY */
         FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_READY);
 
         RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
     }
-    
-    return RetVal;
-}
 
-FlexCAN_State_e FlexCAN_GetModuleState(FlexCAN_Instance_e Ins)
-{
-    FlexCAN_State_e RetState = FLEXCAN_STATE_UNINIT;
-
-    RetState = FlexCAN_CurrentState[Ins];
-
-    return RetState;
+    return RetVal;
 }
 
-uint8_t FlexCAN_GetStatusFlag(FlexCAN_Instance_e Ins, FlexCAN_StatusFlag_e FlagType)
+FlexCAN_Driver_ReturnCode_e FlexCAN_ReadFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      FlexCAN_FrameType * Frame)
 {
-    FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[Ins];
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
 
-    /* Variable to store status flag value */
-    uint8_t FlagValue = 0U;
+    uint32_t Now = 0U;
 
-    /* Get the value of the wanted status flag */
-    if(FlagType == FlexCAN_STATUS_FLAG_FLTCONF)
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || Frame == NULL)
     {
-        FlagValue = (FlexCANx->ESR1 >> FlagType) & 0x3;
+        /* Invalid parameters */
     }
     else
     {
-        FlagValue = (FlexCANx->ESR1 >> FlagType) & SET;
+        /* Changes state to STARTED */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_STARTED);
+
+        /* A TIMER or C/S read from an interrupt would unlock the Mailbox in the middle of the copy */
+        DISABLE_INTERRUPTS();
+
+        /* Reading the C/S word locks the Mailbox */
+        FlexCAN_MbToFrame(FlexCAN_GetMb(FlexCAN_Ins, MbIndex), Frame);
+
+        /* Unlock the Mailbox, the TIMER read also dates the frame */
+        Now = FlexCAN_GetTime(FlexCAN_Ins);
+
+        ENABLE_INTERRUPTS();
+
+        Frame->TimeStamp = FlexCAN_ExtendTimeStamp(Now, Frame->TimeStamp);
+        Frame->IsrTimeStamp = FlexCAN_ConsumeIsrTime(FlexCAN_Ins, MbIndex, Now);
+
+        /* Changes state to READY */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_READY);
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
     }
 
-    return FlagValue;
+    return RetVal;
 }
 
-/* ----------------------------------------------------------------------------
-   -- Private functions
-   ---------------------------------------------------------------------------- */
-static void FlexCAN_ModuleControl(FLEXCAN_Type *FlexCANx, uint8_t EnOrDis)
+FlexCAN_Driver_ReturnCode_e FlexCAN_TransmitFdFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      const FlexCAN_FdFrameType * Frame)
 {
-    if(EnOrDis == ENABLE)
-    {
-        /* Enable the FlexCAN module */
-       FlexCANx->MCR &= ~FLEXCAN_MCR_MDIS_MASK;
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
 
-       /* Wait for FRZACK */
-       while(((FlexCANx->MCR & FLEXCAN_MCR_FRZACK_MASK) >> FLEXCAN_MCR_FRZACK_SHIFT) != SET);
+    FLEXCAN_Type * FlexCANx = NULL;
+    volatile uint32_t * MbWords = NULL;
+
+    uint8_t Dlc = 0U;
+    uint8_t WordIndex = 0U;
+    uint8_t NoOfWords = 0U;
+    uint32_t Word = 0U;
+    uint32_t ControlStatus = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || Frame == NULL || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins)
+       || Frame->DataLen > (uint8_t)((FlexCAN_MbWords[FlexCAN_Ins] - MB_HEADER_WORDS) * 4U)
+       || (Frame->IsFd == false && Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN))
+    {
+        /* Invalid parameters or payload does not fit the message buffer */
     }
     else
     {
-        /* Disable the FlexCAN module */
-       FlexCANx->MCR |= FLEXCAN_MCR_MDIS_MASK;
-    }
-}
+        FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+        MbWords = (volatile uint32_t *)FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
 
-static void FlexCAN_ClkSrcSelect(FLEXCAN_Type *FlexCANx, FlexCAN_ClkSrc_e CLkSrc)
-{
-    /* Selects clock source for FlexCAN module*/
+        Dlc = FlexCAN_LengthToDlc(Frame->DataLen);
+        NoOfWords = (FlexCAN_DlcToLength[Dlc] + 3U) / 4U;
+
+        /* Padding up to the DLC length never writes past the payload area of the MB */
+        if(NoOfWords > (uint8_t)(FlexCAN_MbWords[FlexCAN_Ins] - MB_HEADER_WORDS))
+        {
+            NoOfWords = (uint8_t)(FlexCAN_MbWords[FlexCAN_Ins] - MB_HEADER_WORDS);
+        }
+
+        /* Clear Int Flag, write-1-to-clear */
+        FlexCANx->IFLAG1 = (SET << MbIndex);
+
+        /* Changes state to STARTED */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_STARTED);
+
+        /* Message data to RAM, one byte-reverse per word */
+        for(WordIndex = 0U; WordIndex < NoOfWords; WordIndex++)
+        {
+            REV_BYTES_32(Frame->Data.Word[WordIndex], Word);
+            MbWords[MB_HEADER_WORDS + WordIndex] = Word;
+        }
+
+        ControlStatus = FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK
+                      | FLEXCAN_RAMn_DATA_WORD_0_DLC(Dlc)
+                      | FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_DATA);
+
+        if(Frame->IsFd == true)
+        {
+            ControlStatus |= FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK;
+
+            if(Frame->BitRateSwitch == true)
+            {
+                ControlStatus |= FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK;
+            }
+        }
+
+        if(Frame->IdType == FlexCAN_EXTENDED)
+        {
+            MbWords[1] = FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Frame->Id);
+            ControlStatus |= FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK;
+        }
+        else
+        {
+            MbWords[1] = FLEXCAN_RAMn_DATA_WORD_1_ID(Frame->Id);
+        }
+
+        /* Start transmitting, CODE is written last in a single store */
+        MbWords[0] = ControlStatus;
+
+        /* Changes state to READY */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_READY);
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_ReadFdFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      FlexCAN_FdFrameType * Frame)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    volatile uint32_t * MbWords = NULL;
+
+    uint32_t ControlStatus = 0U;
+    uint32_t Identifier = 0U;
+    uint32_t Word = 0U;
+    uint32_t Now = 0U;
+    uint8_t WordIndex = 0U;
+    uint8_t NoOfWords = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || Frame == NULL || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins))
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        MbWords = (volatile uint32_t *)FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+
+        /* Changes state to STARTED */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_STARTED);
+
+        /* A TIMER or C/S read from an interrupt would unlock the Mailbox in the middle of the copy */
+        DISABLE_INTERRUPTS();
+
+        /* Reading the C/S word locks the Mailbox */
+        ControlStatus = MbWords[0];
+        Identifier = MbWords[1];
+
+        Frame->IsFd = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK) != 0U);
+        Frame->BitRateSwitch = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK) != 0U);
+        Frame->ErrorPassive = ((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_ESI_MASK) != 0U);
+        Frame->TimeStamp = (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_SHIFT;
+        Frame->DataLen = FlexCAN_DlcToLength[(ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT];
+
+        /* DLC 9-15 still means 8 bytes on classic frames */
+        if(Frame->IsFd == false && Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
+        {
+            Frame->DataLen = FLEXCAN_FRAME_MAX_DATA_LEN;
+        }
+
+        /* A DLC above the configured payload size only carries what fits the MB */
+        if(Frame->DataLen > (uint8_t)((FlexCAN_MbWords[FlexCAN_Ins] - MB_HEADER_WORDS) * 4U))
+        {
+            Frame->DataLen = (uint8_t)((FlexCAN_MbWords[FlexCAN_Ins] - MB_HEADER_WORDS) * 4U);
+        }
+
+        if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U)
+        {
+            Frame->IdType = FlexCAN_EXTENDED;
+            Frame->Id = (Identifier & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT;
+        }
+        else
+        {
+            Frame->IdType = FlexCAN_STANDARD;
+            Frame->Id = (Identifier & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT;
+        }
+
+        /* Only the words carrying data are copied */
+        NoOfWords = (Frame->DataLen + 3U) / 4U;
+
+        for(WordIndex = 0U; WordIndex < NoOfWords; WordIndex++)
+        {
+            REV_BYTES_32(MbWords[MB_HEADER_WORDS + WordIndex], Word);
+            Frame->Data.Word[WordIndex] = Word;
+        }
+
+        /* Unlock the Mailbox, the TIMER read also dates the frame */
+        Now = FlexCAN_GetTime(FlexCAN_Ins);
+
+        ENABLE_INTERRUPTS();
+
+        Frame->TimeStamp = FlexCAN_ExtendTimeStamp(Now, Frame->TimeStamp);
+        Frame->IsrTimeStamp = FlexCAN_ConsumeIsrTime(FlexCAN_Ins, MbIndex, Now);
+
+        /* Changes state to READY */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_READY);
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+uint32_t FlexCAN_GetTime(FlexCAN_Instance_e FlexCAN_Ins)
+{
+    uint32_t Now = 0U;
+    uint32_t Last = 0U;
+
+    if(FlexCAN_Ins <= FlexCAN2_INS)
+    {
+        Last = FlexCAN_TimeLast[FlexCAN_Ins];
+
+        /* Elapsed ticks since the last call, modulo the 16-bit timer */
+        Now = Last + (uint16_t)((uint16_t)FlexCAN_Base_Addr[FlexCAN_Ins]->TIMER - (uint16_t)Last);
+
+        /* A preempting caller may store a newer value first, an older one stays a valid reference */
+        FlexCAN_TimeLast[FlexCAN_Ins] = Now;
+    }
+
+    return Now;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetMbEventTime(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      uint32_t * WireTime, uint32_t * IsrTime)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || WireTime == NULL || IsrTime == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        *WireTime = FlexCAN_MbEventTime[FlexCAN_Ins][MbIndex].WireTime;
+        *IsrTime = FlexCAN_MbEventTime[FlexCAN_Ins][MbIndex].IsrTime;
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+bool FlexCAN_CalcBitTiming(uint32_t ClkFreq, uint32_t BitRate, uint16_t SamplePoint, uint8_t Sjw, uint32_t * Cbt)
+{
+    uint32_t BestError = UINT32_MAX;
+
+    uint32_t Target = (SamplePoint == 0U) ? FLEXCAN_SAMPLE_POINT_DEFAULT : SamplePoint;
+    uint32_t Presdiv = 0U;
+    uint32_t NoOfTq = 0U;
+    uint32_t Tseg1 = 0U;
+    uint32_t PropSeg = 0U;
+    uint32_t PhaseSeg1 = 0U;
+    uint32_t PhaseSeg2 = 0U;
+    uint32_t Rjw = 0U;
+    uint32_t Error = 0U;
+
+    if(BitRate == 0U || Cbt == NULL || Target >= SAMPLE_POINT_SCALE)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        /* Stop at the first exact sample point, it has the finest time quantum */
+        for(Presdiv = 1U; Presdiv <= CBT_PRESDIV_MAX && BestError != 0U; Presdiv++)
+        {
+            NoOfTq = ClkFreq / (Presdiv * BitRate);
+
+            if(NoOfTq < CBT_TQ_MIN)
+            {
+                /* Bit is too short for this clock, larger prescalers only make it worse */
+                break;
+            }
+            else if(NoOfTq > CBT_TQ_MAX || (Presdiv * BitRate * NoOfTq) != ClkFreq)
+            {
+                /* Bit rate is not reachable exactly with this prescaler */
+            }
+            else
+            {
+                /* Sync segment + TSEG1 as close as possible to the sample point, PSEG2 >= 2 for the IPT */
+                Tseg1 = ((NoOfTq * Target + (SAMPLE_POINT_SCALE / 2U)) / SAMPLE_POINT_SCALE) - 1U;
+                PhaseSeg2 = NoOfTq - 1U - Tseg1;
+                PhaseSeg2 = (PhaseSeg2 < CBT_PSEG2_MIN) ? CBT_PSEG2_MIN : ((PhaseSeg2 > CBT_PSEG_MAX) ? CBT_PSEG_MAX : PhaseSeg2);
+                Tseg1 = NoOfTq - 1U - PhaseSeg2;
+
+                /* Split TSEG1 evenly, the propagation segment takes what PSEG1 cannot hold */
+                PhaseSeg1 = Tseg1 / 2U;
+                PhaseSeg1 = (PhaseSeg1 > CBT_PSEG_MAX) ? CBT_PSEG_MAX : PhaseSeg1;
+                PropSeg = Tseg1 - PhaseSeg1;
+
+                Rjw = (Sjw != 0U) ? Sjw : ((PhaseSeg1 < PhaseSeg2) ? PhaseSeg1 : PhaseSeg2);
+
+                if(PhaseSeg1 == 0U || PropSeg > CBT_PROPSEG_MAX || Rjw > PhaseSeg1 || Rjw > PhaseSeg2)
+                {
+                    /* Segments or SJW out of range for this number of time quanta */
+                }
+                else
+                {
+                    /* Sample point error in 1/1000 per mille, comparable between quanta counts */
+                    Error = ((1U + Tseg1) * SAMPLE_POINT_SCALE * SAMPLE_POINT_SCALE) / NoOfTq;
+                    Error = (Error > Target * SAMPLE_POINT_SCALE) ? (Error - Target * SAMPLE_POINT_SCALE)
+                                                                 : (Target * SAMPLE_POINT_SCALE - Error);
+
+                    if(Error < BestError)
+                    {
+                        BestError = Error;
+                        *Cbt = FLEXCAN_CBT_VALUE(Presdiv, PropSeg, PhaseSeg1, PhaseSeg2, Rjw);
+                    }
+                }
+            }
+        }
+    }
+
+    return (BestError != UINT32_MAX);
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetRxFilters(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e FirstMb,
+                      const FlexCAN_RxFilterType * Filters, uint8_t NoOfFilters, bool IsEnableMbInt)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FLEXCAN_Type * FlexCANx = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint8_t Index = 0U;
+    uint8_t MbIndex = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || Filters == NULL || NoOfFilters == 0U
+       || ((uint32_t)FirstMb + NoOfFilters) > FlexCAN_GetMbCount(FlexCAN_Ins)
+       || (FlexCAN_RxFifoState[FlexCAN_Ins].Config != NULL
+           && FirstMb < FLEXCAN_RXFIFO_FIRST_FREE_MB(FlexCAN_RxFifoState[FlexCAN_Ins].Config->NoOfIdFilters)))
+    {
+        /* Invalid parameters, not enough message buffers or overlap with the Rx FIFO area */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+
+        /* RXIMR registers are only writable in freeze mode */
+        FLexCAN_FreezeModeControl(FlexCANx, ENABLE);
+
+        for(Index = 0U; Index < NoOfFilters; Index++)
+        {
+            MbIndex = (uint8_t)FirstMb + Index;
+            Mbx = FlexCAN_GetMb(FlexCAN_Ins, (FlexCAN_MbIndex_e)MbIndex);
+
+            /* Deactivate before changing the ID */
+            Mbx->Header[0] = FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_INACTIVE);
+
+            /* IDE is always compared (CTRL2[EACEN] = 0), mask bits line up with the ID word */
+            if(Filters[Index].IdType == FlexCAN_EXTENDED)
+            {
+                Mbx->Header[1] = FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Filters[Index].Id);
+                FlexCANx->RXIMR[MbIndex] = FLEXCAN_RAMn_DATA_WORD_1_ID_EXT(Filters[Index].Mask);
+                Mbx->Header[0] = FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_EMPTY) | FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK
+                               | FLEXCAN_RAMn_DATA_WORD_0_SRR_MASK;
+            }
+            else
+            {
+                Mbx->Header[1] = FLEXCAN_RAMn_DATA_WORD_1_ID(Filters[Index].Id);
+                FlexCANx->RXIMR[MbIndex] = FLEXCAN_RAMn_DATA_WORD_1_ID(Filters[Index].Mask);
+                Mbx->Header[0] = FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_EMPTY);
+            }
+
+            FlexCAN_MbSetInterrupt(FlexCAN_Ins, (FlexCAN_MbIndex_e)MbIndex, IsEnableMbInt);
+        }
+
+        /* Exit Freeze mode */
+        FLexCAN_FreezeModeControl(FlexCANx, DISABLE);
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+bool FlexCAN_IsTxMbIdle(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex)
+{
+    bool IsIdle = false;
+
+    uint32_t Code = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins))
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        Code = (FlexCAN_GetMb(FlexCAN_Ins, MbIndex)->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK)
+                                >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+
+        IsIdle = (Code == Tx_CODE_INACTIVE || Code == Tx_CODE_ABORT);
+    }
+
+    return IsIdle;
+}
+
+FlexCAN_TxAbort_e FlexCAN_AbortTx(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex)
+{
+    FlexCAN_TxAbort_e Result = FLEXCAN_TX_ABORT_IDLE;
+
+    FLEXCAN_Type * FlexCANx = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+
+    uint32_t Code = 0U;
+    uint32_t Start = 0U;
+    uint32_t IntMask = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins))
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+
+        /* Only this MB interrupt is masked during the wait so it cannot take the acknowledge flag,
+           the other interrupts keep running */
+        DISABLE_INTERRUPTS();
+
+        IntMask = FlexCANx->IMASK1 & (SET << MbIndex);
+        FlexCANx->IMASK1 &= ~IntMask;
+        Code = (Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+
+        if(Code == Tx_CODE_DATA)
+        {
+            /* The flag was cleared when the frame was written, the next one is the acknowledge */
+            Mbx->Header[0] = (Mbx->Header[0] & ~FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) | FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_ABORT);
+        }
+
+        ENABLE_INTERRUPTS();
+
+        if(Code != Tx_CODE_DATA)
+        {
+            /* Nothing pending */
+        }
+        else
+        {
+
+            /* Wait for the abort acknowledge, at the end of the frame if it is on the bus.
+               The TIMER stands still in freeze and disable modes, there is no acknowledge either */
+            Start = FlexCAN_GetTime(FlexCAN_Ins);
+            while((FlexCANx->IFLAG1 & (SET << MbIndex)) == 0U
+                  && (FlexCANx->MCR & (FLEXCAN_MCR_FRZACK_MASK | FLEXCAN_MCR_LPMACK_MASK)) == 0U
+                  && (FlexCAN_GetTime(FlexCAN_Ins) - Start) < ABORT_TIMEOUT_BITS);
+
+            if((FlexCANx->IFLAG1 & (SET << MbIndex)) == 0U)
+            {
+                /* No acknowledge, the message buffer is still pending */
+                Result = FLEXCAN_TX_ABORT_TIMEOUT;
+            }
+            else
+            {
+                /* ABORT if the frame was taken back, INACTIVE if it was sent */
+                Code = (Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+                Result = (Code == Tx_CODE_ABORT) ? FLEXCAN_TX_ABORT_DONE : FLEXCAN_TX_ABORT_LATE;
+
+                /* Clear Int Flag, write-1-to-clear */
+                FlexCANx->IFLAG1 = (SET << MbIndex);
+            }
+        }
+
+        DISABLE_INTERRUPTS();
+        FlexCANx->IMASK1 |= IntMask;
+        ENABLE_INTERRUPTS();
+    }
+
+    return Result;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetAnswerData(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                      const uint8_t * Data, uint8_t DataLen)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FLEXCAN_Type * FlexCANx = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+
+    uint32_t Words[2] = { 0U, 0U };
+    uint32_t ControlStatus = 0U;
+    uint32_t Code = 0U;
+    uint8_t Index = 0U;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || Data == NULL || DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+        ControlStatus = Mbx->Header[0];
+        Code = (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+
+        if(Code != Rx_CODE_RANSWER && Code != Tx_CODE_TANSWER && Code != Tx_CODE_INACTIVE)
+        {
+            /* Rx MB or frame pending */
+        }
+        else
+        {
+            for(Index = 0U; Index < DataLen; Index++)
+            {
+                Words[Index / 4U] |= (uint32_t)Data[Index] << (8U * (3U - (Index % 4U)));
+            }
+
+            ControlStatus &= ~(FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK | FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK
+                               | FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK);
+
+            /* Out of the matching while the payload is written. A frame already moved out to the
+             * Tx SMB is sent as it is */
+            Mbx->Header[0] = ControlStatus | FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_INACTIVE);
+            Mbx->Payload[0] = Words[0];
+            Mbx->Payload[1] = Words[1];
+
+            /* Clear the flag of the previous answer, write-1-to-clear */
+            FlexCANx->IFLAG1 = (SET << MbIndex);
+
+            /* Back in the matching, CODE is written last in a single store */
+            Mbx->Header[0] = ControlStatus | FLEXCAN_RAMn_DATA_WORD_0_DLC(DataLen)
+                           | FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_RANSWER);
+
+            RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+        }
+    }
+
+    return RetVal;
+}
+
+uint8_t FlexCAN_GetMbCount(FlexCAN_Instance_e FlexCAN_Ins)
+{
+    uint8_t Count = 0U;
+
+    if(FlexCAN_Ins <= FlexCAN2_INS)
+    {
+        Count = (uint8_t)(FlexCAN_MbRamWords[FlexCAN_Ins] / FlexCAN_MbWords[FlexCAN_Ins]);
+    }
+
+    return Count;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetMaxMb(FlexCAN_Instance_e FlexCAN_Ins, uint8_t MaxMb)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FLEXCAN_Type * FlexCANx = NULL;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || FlexCAN_CurrentState[FlexCAN_Ins] != FLEXCAN_STATE_READY
+       || MaxMb >= FlexCAN_GetMbCount(FlexCAN_Ins)
+       || (FlexCAN_RxFifoState[FlexCAN_Ins].Config != NULL
+           && MaxMb < (FLEXCAN_RXFIFO_FIRST_FREE_MB(FlexCAN_RxFifoState[FlexCAN_Ins].Config->NoOfIdFilters) - 1U)))
+    {
+        /* Invalid parameters, driver not ready or Rx FIFO area not covered */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+
+        if(((FlexCANx->MCR & FLEXCAN_MCR_MAXMB_MASK) >> FLEXCAN_MCR_MAXMB_SHIFT) != MaxMb)
+        {
+            /* MAXMB is only writable in freeze mode, the bus is left at the end of the current frame */
+            FLexCAN_FreezeModeControl(FlexCANx, ENABLE);
+
+            FlexCAN_SetMBnumber(FlexCANx, MaxMb);
+
+            /* Exit Freeze mode */
+            FLexCAN_FreezeModeControl(FlexCANx, DISABLE);
+        }
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_ReadMailboxData(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex,
+                             uint8_t * MsgData)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+
+    FLEXCAN_Type * FlexCANx = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint8_t DataLen = 0U;
+
+    uint8_t Index = 0U;
+    uint8_t WordIndex = 0U;
+    uint8_t WordSize = 4U;
+    uint8_t ByteOffset = 0U;
+    
+    if(FlexCAN_Ins > FlexCAN2_INS || MbIndex >= FlexCAN_GetMbCount(FlexCAN_Ins) || MsgData == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, MbIndex);
+
+        /* A TIMER or C/S read from an interrupt would unlock the Mailbox in the middle of the copy */
+        DISABLE_INTERRUPTS();
+
+        DataLen = (((Mbx->Header[0]) & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK)
+                                >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
+
+        /* DLC 9-15 still carries 8 bytes on a classic frame */
+        DataLen = (DataLen > FLEXCAN_FRAME_MAX_DATA_LEN) ? FLEXCAN_FRAME_MAX_DATA_LEN : DataLen;
+    
+        /* Changes state to STARTED */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_STARTED);
+
+        for(Index = 0; Index < DataLen; Index++)
+        {
+            WordIndex = (Index / WordSize);
+            ByteOffset = 3 - (Index % WordSize);
+            MsgData[Index] = ((Mbx->Payload[WordIndex]) >> (8 * ByteOffset));
+        }
+
+        /* Unlock the Mailbox */
+        (void)FlexCANx->TIMER;
+
+        ENABLE_INTERRUPTS();
+
+        /* Changes state to READY */
+        FlexCAN_SetModuleState(FlexCAN_Ins, FLEXCAN_STATE_READY);
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+    
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_RxFifoRead(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbStructureType * Record)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_RxFifoStateType * FifoState = NULL;
+    const FlexCAN_RxFifoConfigType * FifoConfig = NULL;
+    uint32_t Produced = 0U;
+    int32_t Pending = 0;
+    uint32_t ReadIndex = 0U;
+    uint32_t WriteIndex = 0U;
+    bool IsEmpty = true;
+
+    if(FlexCAN_Ins > FlexCAN2_INS || Record == NULL || FlexCAN_RxFifoState[FlexCAN_Ins].Config == NULL)
+    {
+        /* Invalid parameters or Rx FIFO not configured */
+    }
+    else
+    {
+        FifoState = &FlexCAN_RxFifoState[FlexCAN_Ins];
+        FifoConfig = FifoState->Config;
+        Produced = FifoState->Produced;
+        ReadIndex = FifoState->Consumed % FifoConfig->RingLength;
+
+        if(FifoConfig->UseDma == true)
+        {
+            /* Produced counts the halves closed by the ISR, Consumed may run ahead of it inside
+             * the current half, hence the signed distance */
+            Pending = (int32_t)(Produced - FifoState->Consumed);
+
+            /* A whole ring pending means the eDMA is writing over the oldest records,
+             * resync on the newest complete half */
+            if(Pending >= (int32_t)FifoConfig->RingLength)
+            {
+                FifoState->OverflowCount += (uint32_t)Pending - (FifoConfig->RingLength / 2U);
+                FifoState->Consumed = Produced - (FifoConfig->RingLength / 2U);
+                ReadIndex = FifoState->Consumed % FifoConfig->RingLength;
+                Pending = (int32_t)(FifoConfig->RingLength / 2U);
+            }
+
+            /* Inside the current half, records completed so far are given by the destination address.
+             * Equal indexes only mean empty when no closed half is pending, otherwise it is a full lap. */
+            WriteIndex = (IP_DMA->TCD[FifoConfig->DmaChannel].DADDR - (uint32_t)FifoConfig->RingBuffer) / RXFIFO_RECORD_SIZE;
+            IsEmpty = (Pending <= 0 && ReadIndex == WriteIndex);
+        }
+        else
+        {
+            IsEmpty = (Produced == FifoState->Consumed);
+        }
+
+        if(IsEmpty == false)
+        {
+            *Record = FifoConfig->RingBuffer[ReadIndex];
+            FifoState->Consumed++;
+
+            RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+        }
+        else
+        {
+            /* Ring is empty */
+        }
+    }
+
+    return RetVal;
+}
+
+uint32_t FlexCAN_RxFifoGetOverflowCount(FlexCAN_Instance_e FlexCAN_Ins)
+{
+    uint32_t Count = 0U;
+
+    if(FlexCAN_Ins <= FlexCAN2_INS)
+    {
+        Count = FlexCAN_RxFifoState[FlexCAN_Ins].OverflowCount;
+    }
+
+    return Count;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_RxFifoReadFrame(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_FrameType * Frame)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+
+    FlexCAN_MbStructureType Record;
+    uint32_t BatchTime = 0U;
+
+    if(Frame == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        RetVal = FlexCAN_RxFifoRead(FlexCAN_Ins, &Record);
+
+        if(RetVal == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+        {
+            FlexCAN_MbToFrame(&Record, Frame);
+            Frame->TimeStamp = FlexCAN_ExtendTimeStamp(FlexCAN_GetTime(FlexCAN_Ins), Frame->TimeStamp);
+
+            /* The ISR drains in batches, with eDMA no CPU handles the frame before the reader */
+            BatchTime = FlexCAN_RxFifoState[FlexCAN_Ins].BatchTime;
+            Frame->IsrTimeStamp = (FlexCAN_RxFifoState[FlexCAN_Ins].Config->UseDma == false
+                                   && (int32_t)(BatchTime - Frame->TimeStamp) >= 0) ? BatchTime : Frame->TimeStamp;
+        }
+        else
+        {
+            /* Ring is empty */
+        }
+    }
+
+    return RetVal;
+}
+
+FlexCAN_State_e FlexCAN_GetModuleState(FlexCAN_Instance_e Ins)
+{
+    FlexCAN_State_e RetState = FLEXCAN_STATE_UNINIT;
+
+    RetState = FlexCAN_CurrentState[Ins];
+
+    return RetState;
+}
+
+uint8_t FlexCAN_GetStatusFlag(FlexCAN_Instance_e Ins, FlexCAN_StatusFlag_e FlagType)
+{
+    FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[Ins];
+
+    /* Variable to store status flag value */
+    uint8_t FlagValue = 0U;
+
+    /* Get the value of the wanted status flag */
+    if(FlagType == FlexCAN_STATUS_FLAG_FLTCONF)
+    {
+        FlagValue = (FlexCANx->ESR1 >> FlagType) & 0x3;
+    }
+    else
+    {
+        FlagValue = (FlexCANx->ESR1 >> FlagType) & SET;
+    }
+
+    return FlagValue;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_GetErrorState(FlexCAN_Instance_e Ins, FlexCAN_ErrorStateType * State)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+    FLEXCAN_Type *FlexCANx = NULL;
+    uint32_t Ecr = 0U;
+
+    if(Ins > FlexCAN2_INS || State == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[Ins];
+        Ecr = FlexCANx->ECR;
+        State->Tec = (uint8_t)((Ecr & FLEXCAN_ECR_TXERRCNT_MASK) >> FLEXCAN_ECR_TXERRCNT_SHIFT);
+        State->Rec = (uint8_t)((Ecr & FLEXCAN_ECR_RXERRCNT_MASK) >> FLEXCAN_ECR_RXERRCNT_SHIFT);
+        State->Esr1 = FlexCANx->ESR1;
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+FlexCAN_Driver_ReturnCode_e FlexCAN_SetBusOffRecovery(FlexCAN_Instance_e Ins, bool IsAutomatic)
+{
+    FlexCAN_Driver_ReturnCode_e RetVal = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+    FLEXCAN_Type *FlexCANx = NULL;
+
+    if(Ins > FlexCAN2_INS)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        FlexCANx = FlexCAN_Base_Addr[Ins];
+
+        /* CTRL1[BOFFREC] can be written outside of freeze mode, clearing it while bus-off starts the recovery */
+        if(IsAutomatic == true)
+        {
+            FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_BOFFREC_MASK;
+        }
+        else
+        {
+            FlexCANx->CTRL1 |= FLEXCAN_CTRL1_BOFFREC_MASK;
+        }
+
+        RetVal = FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED;
+    }
+
+    return RetVal;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void FlexCAN_ModuleControl(FLEXCAN_Type *FlexCANx, uint8_t EnOrDis)
+{
+    if(EnOrDis == ENABLE)
+    {
+        /* Enable the FlexCAN module */
+       FlexCANx->MCR &= ~FLEXCAN_MCR_MDIS_MASK;
+
+       /* Wait for FRZACK */
+       while(((FlexCANx->MCR & FLEXCAN_MCR_FRZACK_MASK) >> FLEXCAN_MCR_FRZACK_SHIFT) != SET);
+    }
+    else
+    {
+        /* Disable the FlexCAN module */
+       FlexCANx->MCR |= FLEXCAN_MCR_MDIS_MASK;
+    }
+}
+
+static void FlexCAN_ClkSrcSelect(FLEXCAN_Type *FlexCANx, FlexCAN_ClkSrc_e CLkSrc)
+{
+    /* Selects clock source for FlexCAN module*/
    FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_CLKSRC_MASK;
    FlexCANx->CTRL1 |= FLEXCAN_CTRL1_CLKSRC(CLkSrc);
 }
 
-static void FlexCAN_ClearMB(FLEXCAN_Type *FlexCANx)
+static void FlexCAN_ClearMB(FLEXCAN_Type *FlexCANx, uint8_t RamWords)
 {
     uint8_t i = 0;
 
     /* Clears all MBs of FlexCAN module */
-   for(i = 0U; i < 128U ;i++)
+   for(i = 0U; i < RamWords ;i++)
    {
        FlexCANx->RAMn[i] = 0x0;
    }
@@ -417,15 +1628,21 @@ static void FlexCAN_ClearMB(FLEXCAN_Type *FlexCANx)
 
 static void FlexCAN_RunModeSelect(FLEXCAN_Type *FlexCANx, FlexCAN_Mode_e RunMode)
 {
+   FlexCANx->CTRL1 &= ~(FLEXCAN_CTRL1_LPB_MASK | FLEXCAN_CTRL1_LOM_MASK);
+
    if(RunMode == FlexCAN_MODE_LOOPBACK)
    {
        /* Enables loop back mode */
        FlexCANx->CTRL1 |= FLEXCAN_CTRL1_LPB_MASK;
    }
+   else if(RunMode == FlexCAN_MODE_LISTEN_ONLY)
+   {
+       /* Enables listen-only mode: the Tx pin stays recessive, not even the ACK bit is driven */
+       FlexCANx->CTRL1 |= FLEXCAN_CTRL1_LOM_MASK;
+   }
    else
    {
        /* Enables normal mode */
-       FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_LPB_MASK;
    }
 }
 
@@ -446,9 +1663,11 @@ static void FlexCAN_IntControl(FLEXCAN_Type *FlexCANx, FlexCAN_InterruptType Int
    /* ORed interrupt configuration */
    if((IntType.IntBusOff | IntType.IntTxWarning | IntType.IntRxWarning) == SET)
    {
-       /* Bus Off Interrupt configuration */
+       /* Bus Off and Bus Off Done Interrupt configuration */
        FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_BOFFMSK_MASK;
        FlexCANx->CTRL1 |= FLEXCAN_CTRL1_BOFFMSK(IntType.IntBusOff);
+       FlexCANx->CTRL2 &= ~FLEXCAN_CTRL2_BOFFDONEMSK_MASK;
+       FlexCANx->CTRL2 |= FLEXCAN_CTRL2_BOFFDONEMSK(IntType.IntBusOff);
 
        /* Tx warning Interrupt configuration */
        FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_TWRNMSK_MASK;
@@ -462,176 +1681,616 @@ static void FlexCAN_IntControl(FLEXCAN_Type *FlexCANx, FlexCAN_InterruptType Int
    {
        /* Interrupts disabled */
        FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_BOFFMSK_MASK;
-       FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_BOFFMSK_MASK;
-       FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_BOFFMSK_MASK;
+       FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_TWRNMSK_MASK;
+       FlexCANx->CTRL1 &= ~FLEXCAN_CTRL1_RWRNMSK_MASK;
+       FlexCANx->CTRL2 &= ~FLEXCAN_CTRL2_BOFFDONEMSK_MASK;
    }
 }
 
-static void FlexCAN_SetBitRate(FLEXCAN_Type *FlexCANx, uint32_t Clocks, uint32_t BitRate)
+static void FlexCAN_SetBitRate(FLEXCAN_Type *FlexCANx, uint32_t Cbt)
+{
+    /* Extended bit timing: one write sets the whole nominal bit time, CTRL1 timing fields are ignored */
+    FlexCANx->CBT = Cbt;
+}
+
+static bool FlexCAN_GetBitTiming(const FlexCAN_ConfigType * FlexCAN_Config, uint32_t * Cbt)
+{
+    bool IsFound = false;
+
+    uint16_t SamplePoint = (FlexCAN_Config->SamplePoint == 0U) ? FLEXCAN_SAMPLE_POINT_DEFAULT : FlexCAN_Config->SamplePoint;
+    const FlexCAN_BitTimingType * Timing = FlexCAN_Config->BitTiming;
+    uint8_t Index = 0U;
+
+    /* User entry first, then the built-in table, the solver only for unusual pairs */
+    if(Timing != NULL && BIT_TIMING_MATCH(Timing, FlexCAN_Config, SamplePoint))
+    {
+        *Cbt = Timing->Cbt;
+        IsFound = true;
+    }
+
+    for(Index = 0U; Index < BIT_TIMING_TABLE_SIZE && IsFound == false; Index++)
+    {
+        Timing = &FlexCAN_BitTimingTable[Index];
+
+        if(BIT_TIMING_MATCH(Timing, FlexCAN_Config, SamplePoint))
+        {
+            *Cbt = Timing->Cbt;
+            IsFound = true;
+        }
+    }
+
+    if(IsFound == false)
+    {
+        IsFound = FlexCAN_CalcBitTiming(FlexCAN_Config->ClkFreq, FlexCAN_Config->BitRate, SamplePoint, FlexCAN_Config->Sjw, Cbt);
+    }
+
+    return IsFound;
+}
+
+static void FLexCAN_FreezeModeControl(FLEXCAN_Type *FlexCANx, uint8_t EnOrDis)
+{
+    if(EnOrDis == ENABLE)
+    {
+        /* Enters freeze mode, HALT is needed once the module has left freeze mode after init */
+        FlexCANx->MCR |= (FLEXCAN_MCR_FRZ_MASK | FLEXCAN_MCR_HALT_MASK);
+
+       /* Wait for FRZACK */
+       while(((FlexCANx->MCR & FLEXCAN_MCR_FRZACK_MASK) >> FLEXCAN_MCR_FRZACK_SHIFT) != SET);
+    }
+    else
+    {
+        /* Exits freeze mode */
+        FlexCANx->MCR &= ~(FLEXCAN_MCR_FRZ_MASK | FLEXCAN_MCR_HALT_MASK);
+
+       /* Wait for FRZACK to clear (not in freeze mode) */
+       while ((FlexCANx->MCR & FLEXCAN_MCR_FRZACK_MASK) >> FLEXCAN_MCR_FRZACK_SHIFT);
+
+       /* Wait for NOTRDY to clear (module ready) */
+       while ((FlexCANx->MCR & FLEXCAN_MCR_NOTRDY_MASK) >> FLEXCAN_MCR_NOTRDY_SHIFT);
+    }
+}
+
+static void FlexCAN_SoftReset(FLEXCAN_Type *FlexCANx)
+{
+    /* Reset memory-mapped registers */
+    FlexCANx->MCR |= FLEXCAN_MCR_SOFTRST_MASK;
+
+    /* Wait for the reset procedure completed */
+    while(((FlexCANx->MCR & FLEXCAN_MCR_SOFTRST_MASK) >> FLEXCAN_MCR_SOFTRST_SHIFT) == SET);
+}
+
+static void FlexCAN_MBSetEDL(FlexCAN_MbStructureType * Mbx, uint8_t EDLValue)
+{
+    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK;
+    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_EDL(EDLValue);
+}
+
+static void FlexCAN_MBSetBRS(FlexCAN_MbStructureType * Mbx, uint8_t BRSValue)
+{
+    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK;
+    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_BRS(BRSValue);
+}
+
+static void FlexCAN_MBSetESI(FlexCAN_MbStructureType * Mbx, uint8_t ESIValue)
+{
+    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_ESI_MASK;
+    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_ESI(ESIValue);
+}
+
+static void FlexCAN_MBSetIDType(FlexCAN_MbStructureType * Mbx, FlexCAN_MsgIDType_e IDType)
+{
+    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK;
+    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_IDE(IDType);
+}
+
+static void FlexCAN_MBSetRTR(FlexCAN_MbStructureType * Mbx, bool IsRemote)
+{
+    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK;
+    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_RTR(IsRemote);
+}
+
+static void FlexCAN_MBSetDataLength(FlexCAN_MbStructureType * Mbx, uint16_t Datalen)
+{
+    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK;
+    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_DLC(Datalen);
+}
+
+static void FlexCAN_MBSetID(FlexCAN_MbStructureType * Mbx, uint32_t ID, FlexCAN_MsgIDType_e IDType)
+{
+    /* A standard ID sits in bits 28-18, an extended one fills bits 28-0 */
+    Mbx->Header[1] &= ~FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK;
+    Mbx->Header[1] |= FLEXCAN_MB_ID(ID, IDType);
+}
+
+static void FlexCAN_MbSetType(FlexCAN_MbStructureType * Mbx, FlexCAN_MbType_e MbType)
+{
+    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK;
+
+    if(MbType == FlexCAN_MB_TX)
+    {
+        /* Set code to INACTIVE status */
+        Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_INACTIVE);
+    }else
+    {
+        Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_EMPTY);
+    }
+}
+
+static void FlexCAN_MbSetInterrupt(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, bool IsEnableMbInt){
+    FLEXCAN_Type * FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+
+    if(IsEnableMbInt)
+    {
+        /* A mailbox of a polled group gets its interrupt back when the group stops being polled */
+        if(FlexCAN_RxPollState[FlexCAN_Ins].IsPolling == false || (FlexCAN_RxPollState[FlexCAN_Ins].Group & (1UL << MbIndex)) == 0U)
+        {
+            FlexCANx->IMASK1 |= (1 << MbIndex);
+        }
+    }
+    else
+    {
+        FlexCANx->IMASK1 &= ~(1 << MbIndex);
+    }
+}
+
+static void FlexCAN_SetModuleState(FlexCAN_Instance_e Ins, FlexCAN_State_e Transition)
+{
+    if(FlexCAN_CurrentState[Ins] != Transition)
+    {
+        /* Switching for desired state */
+        FlexCAN_CurrentState[Ins] = Transition;
+    }
+    else
+    {
+        /* Current state is already in desired state */
+    }
+}
+
+static void FlexCAN_SetMBnumber(FLEXCAN_Type *FlexCANx, uint8_t MaxMB)
+{
+    uint8_t NoMB = 0U;
+
+    if(MaxMB >= NUMBER_OF_MB)
+    {
+        NoMB = NUMBER_OF_MB - 1U;
+    }
+    else
+    {
+        NoMB = MaxMB;
+    }
+    FlexCANx->MCR &= ~FLEXCAN_MCR_MAXMB_MASK;
+    FlexCANx->MCR |= FLEXCAN_MCR_MAXMB(NoMB);
+}
+
+static void FlexCAN_MbToFrame(const volatile FlexCAN_MbStructureType * Mbx, FlexCAN_FrameType * Frame)
+{
+    uint32_t ControlStatus = Mbx->Header[0];
+    uint32_t Identifier = Mbx->Header[1];
+    uint32_t Word = 0U;
+
+    if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U)
+    {
+        Frame->IdType = FlexCAN_EXTENDED;
+        Frame->Id = (Identifier & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT;
+    }
+    else
+    {
+        Frame->IdType = FlexCAN_STANDARD;
+        Frame->Id = (Identifier & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT;
+    }
+
+    Frame->DataLen = (uint8_t)((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
+    Frame->TimeStamp = (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_SHIFT;
+
+    /* DLC 9-15 still means 8 bytes on classic CAN */
+    if(Frame->DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
+    {
+        Frame->DataLen = FLEXCAN_FRAME_MAX_DATA_LEN;
+    }
+
+    /* Both words are copied whatever the DLC, bytes past DataLen are don't care */
+    REV_BYTES_32(Mbx->Payload[0], Word);
+    Frame->Data.Word[0] = Word;
+    REV_BYTES_32(Mbx->Payload[1], Word);
+    Frame->Data.Word[1] = Word;
+}
+
+static uint32_t FlexCAN_ExtendTimeStamp(uint32_t Now, uint32_t TimeStamp)
+{
+    /* The stamp is in the past: go back from now by the 16-bit distance */
+    return Now - (uint16_t)((uint16_t)Now - (uint16_t)TimeStamp);
+}
+
+static uint32_t FlexCAN_ConsumeIsrTime(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, uint32_t Now)
+{
+    uint32_t IsrTime = Now;
+
+    /* Polled reads have no interrupt time, the read itself handles the frame */
+    if(FlexCAN_MbEventTime[FlexCAN_Ins][MbIndex].IsPending == true)
+    {
+        IsrTime = FlexCAN_MbEventTime[FlexCAN_Ins][MbIndex].IsrTime;
+        FlexCAN_MbEventTime[FlexCAN_Ins][MbIndex].IsPending = false;
+    }
+
+    return IsrTime;
+}
+
+static FlexCAN_MbStructureType * FlexCAN_GetMb(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex)
+{
+    /* Message buffers are packed back to back, their size depends on the payload size */
+    return (FlexCAN_MbStructureType *)&FlexCAN_Base_Addr[FlexCAN_Ins]->RAMn[(uint32_t)MbIndex * FlexCAN_MbWords[FlexCAN_Ins]];
+}
+
+static uint8_t FlexCAN_LengthToDlc(uint8_t DataLen)
 {
-    uint32_t prescaler = 0;
-    uint32_t prop_seg = 0;
-    uint32_t tseg = 0;
-    uint32_t actual_baud = 0;
-    uint32_t best_prescaler = 0, best_prop_seg = 0, best_tseg = 0;
-    uint32_t min_error = UINT32_MAX;
+    uint8_t Dlc = 0U;
 
-    for (prop_seg = 1; prop_seg <= 7; prop_seg++)
+    /* Smallest DLC whose length holds DataLen */
+    while(Dlc < (FD_DLC_COUNT - 1U) && FlexCAN_DlcToLength[Dlc] < DataLen)
     {
-        for (tseg = 2; tseg <= 8; tseg++)
-        {
-            prescaler = (Clocks / (BitRate * (1 + prop_seg + 2 * tseg))) - 1;
+        Dlc++;
+    }
+
+    return Dlc;
+}
 
-            if (prescaler > 255 || prescaler < 0)
-                continue;
-            if ((1 + prop_seg + 2 * tseg) < 11 || (1 + prop_seg + 2 * tseg) > 21)
-                continue;
-            if (((tseg * 100) / (1 + prop_seg + 2 * tseg) > 25) || ((tseg * 100) / (1 + prop_seg + 2 * tseg) < 20))
+static bool FlexCAN_FdCalcTiming(uint32_t Clocks, uint32_t DataBitRate, uint32_t * Fdcbt, uint8_t * SamplePointClocks)
+{
+    bool IsFound = false;
 
-                actual_baud = Clocks / ((prescaler + 1) * (1 + prop_seg + 2 * tseg));
+    uint32_t Presdiv = 0U;
+    uint32_t NoOfTq = 0U;
+    uint32_t PropSeg = 0U;
+    uint32_t PhaseSeg1 = 0U;
+    uint32_t PhaseSeg2 = 0U;
 
-            uint32_t error = (actual_baud > BitRate) ? (actual_baud - BitRate) : (BitRate - actual_baud);
+    if(DataBitRate == 0U)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        /* Smallest prescaler first: the finest time quantum gives the most accurate sample point */
+        for(Presdiv = 1U; Presdiv <= FD_PRESDIV_MAX && IsFound == false; Presdiv++)
+        {
+            NoOfTq = Clocks / (Presdiv * DataBitRate);
 
-            if (error < min_error)
+            if(NoOfTq < FD_TQ_MIN)
             {
-                min_error = error;
-                best_prescaler = prescaler;
-                best_prop_seg = prop_seg - 1;
-                best_tseg = tseg - 1;
+                /* Bit is too short for this clock, larger prescalers only make it worse */
+                break;
+            }
+            else if(NoOfTq <= FD_TQ_MAX && (Presdiv * DataBitRate * NoOfTq) == Clocks)
+            {
+                /* Sample point at 75%, phase segment 1 before propagation segment */
+                PhaseSeg2 = NoOfTq / 4U;
+                PhaseSeg2 = (PhaseSeg2 < FD_PSEG2_MIN) ? FD_PSEG2_MIN : ((PhaseSeg2 > FD_PSEG_MAX) ? FD_PSEG_MAX : PhaseSeg2);
+                PhaseSeg1 = NoOfTq - 1U - PhaseSeg2;
+                PhaseSeg1 = (PhaseSeg1 > FD_PSEG_MAX) ? FD_PSEG_MAX : PhaseSeg1;
+                PropSeg = NoOfTq - 1U - PhaseSeg1 - PhaseSeg2;
+
+                *Fdcbt = FLEXCAN_FDCBT_FPRESDIV(Presdiv - 1U)
+                       | FLEXCAN_FDCBT_FPROPSEG(PropSeg)
+                       | FLEXCAN_FDCBT_FPSEG1(PhaseSeg1 - 1U)
+                       | FLEXCAN_FDCBT_FPSEG2(PhaseSeg2 - 1U)
+                       | FLEXCAN_FDCBT_FRJW(PhaseSeg2 - 1U);
+
+                /* Sample point position in CAN clock cycles, default TDC offset */
+                *SamplePointClocks = (uint8_t)(((1U + PropSeg + PhaseSeg1) * Presdiv > FD_TDCOFF_MAX)
+                                               ? FD_TDCOFF_MAX : ((1U + PropSeg + PhaseSeg1) * Presdiv));
+
+                IsFound = true;
+            }
+            else
+            {
+                /* Bit rate is not reachable with this prescaler */
             }
         }
     }
-    FlexCANx->CTRL1 |= (best_prescaler << FLEXCAN_CTRL1_PRESDIV_SHIFT) | (best_prop_seg << FLEXCAN_CTRL1_PROPSEG_SHIFT) | (best_tseg << FLEXCAN_CTRL1_PSEG1_SHIFT) | (best_tseg << FLEXCAN_CTRL1_PSEG2_SHIFT);
+
+    return IsFound;
 }
 
-static void FLexCAN_FreezeModeControl(FLEXCAN_Type *FlexCANx, uint8_t EnOrDis)
+static bool FlexCAN_FdCheckConfig(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config)
 {
-    if(EnOrDis == ENABLE)
-    {
-        /* Enters freeze mode */
-        FlexCANx->MCR |= FLEXCAN_MCR_FRZ_MASK;
+    bool IsValid = true;
 
-       /* Wait for FRZACK */
-       while(((FlexCANx->MCR & FLEXCAN_MCR_FRZACK_MASK) >> FLEXCAN_MCR_FRZACK_SHIFT) != SET);
+    uint32_t Fdcbt = 0U;
+    uint8_t SamplePointClocks = 0U;
+
+    if(FlexCAN_Config->FdConfig == NULL || FlexCAN_Config->FdConfig->Enable == false)
+    {
+        /* Classic CAN */
+    }
+    else if(FlexCAN_Ins != FlexCAN0_INS
+            || (FlexCAN_Config->RxFifoConfig != NULL && FlexCAN_Config->RxFifoConfig->Mode != FlexCAN_RXFIFO_DISABLE)
+            || FlexCAN_Config->FdConfig->PayloadSize > FlexCAN_PAYLOAD_64_BYTES
+            || FlexCAN_FdCalcTiming(FlexCAN_Config->ClkFreq, FlexCAN_Config->FdConfig->DataBitRate, &Fdcbt, &SamplePointClocks) == false)
+    {
+        /* CAN FD only on FlexCAN0, not with the legacy Rx FIFO, and the data bit rate must be reachable */
+        IsValid = false;
     }
     else
     {
-        /* Exits freeze mode */
-        FlexCANx->MCR &= ~FLEXCAN_MCR_FRZ_MASK;
-
-       /* Wait for FRZACK to clear (not in freeze mode) */
-       while ((FlexCANx->MCR & FLEXCAN_MCR_FRZACK_MASK) >> FLEXCAN_MCR_FRZACK_SHIFT);
-
-       /* Wait for NOTRDY to clear (module ready) */
-       while ((FlexCANx->MCR & FLEXCAN_MCR_NOTRDY_MASK) >> FLEXCAN_MCR_NOTRDY_SHIFT);
+        /* Valid CAN FD configuration */
     }
+
+    return IsValid;
 }
 
-static void FlexCAN_SoftReset(FLEXCAN_Type *FlexCANx)
+static void FlexCAN_FdControl(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config)
 {
-    /* Reset memory-mapped registers */
-    FlexCANx->MCR |= FLEXCAN_MCR_SOFTRST_MASK;
+    FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+    const FlexCAN_FdConfigType * FdConfig = FlexCAN_Config->FdConfig;
 
-    /* Wait for the reset procedure completed */
-    while(((FlexCANx->MCR & FLEXCAN_MCR_SOFTRST_MASK) >> FLEXCAN_MCR_SOFTRST_SHIFT) == SET);
-}
+    uint32_t Fdcbt = 0U;
+    uint8_t SamplePointClocks = 0U;
+    uint32_t Fdctrl = 0U;
 
-static void FlexCAN_MBSetEDL(FlexCAN_MbStructureType * Mbx, uint8_t EDLValue)
-{
-    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_EDL_MASK;
-    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_EDL(EDLValue);
-}
+    if(FdConfig == NULL || FdConfig->Enable == false)
+    {
+        /* Classic CAN: 8-byte message buffers */
+        FlexCANx->MCR &= ~FLEXCAN_MCR_FDEN_MASK;
+        FlexCAN_MbWords[FlexCAN_Ins] = MB_HEADER_WORDS + 2U;
+    }
+    else
+    {
+        (void)FlexCAN_FdCalcTiming(FlexCAN_Config->ClkFreq, FdConfig->DataBitRate, &Fdcbt, &SamplePointClocks);
 
-static void FlexCAN_MBSetBRS(FlexCAN_MbStructureType * Mbx, uint8_t BRSValue)
-{
-    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_BRS_MASK;
-    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_BRS(BRSValue);
-}
+        FlexCANx->MCR |= FLEXCAN_MCR_FDEN_MASK;
 
-static void FlexCAN_MBSetESI(FlexCAN_MbStructureType * Mbx, uint8_t ESIValue)
-{
-    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_ESI_MASK;
-    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_ESI(ESIValue);
-}
+        if(FdConfig->IsoCanFd == true)
+        {
+            FlexCANx->CTRL2 |= FLEXCAN_CTRL2_ISOCANFDEN_MASK;
+        }
+        else
+        {
+            FlexCANx->CTRL2 &= ~FLEXCAN_CTRL2_ISOCANFDEN_MASK;
+        }
 
-static void FlexCAN_MBSetIDType(FlexCAN_MbStructureType * Mbx, FlexCAN_MsgIDType_e IDType)
-{
-    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK;
-    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_IDE(IDType);
-}
+        /* Data phase bit timing */
+        FlexCANx->FDCBT = Fdcbt;
 
-static void FlexCAN_MBSetRTR(FlexCAN_MbStructureType * Mbx, bool IsRemote)
-{
-    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK;
-    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_RTR(IsRemote);
-}
+        Fdctrl = FLEXCAN_FDCTRL_MBDSR0(FdConfig->PayloadSize) | FLEXCAN_FDCTRL_FDRATE(FdConfig->BitRateSwitch);
 
-static void FlexCAN_MBSetDataLength(FlexCAN_MbStructureType * Mbx, uint16_t Datalen)
-{
-    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK;
-    Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_DLC(Datalen);
-}
+        if(FdConfig->TdcEnable == true)
+        {
+            Fdctrl |= FLEXCAN_FDCTRL_TDCEN_MASK
+                    | FLEXCAN_FDCTRL_TDCOFF((FdConfig->TdcOffset != 0U) ? FdConfig->TdcOffset : SamplePointClocks);
+        }
 
-static void FlexCAN_MBSetID(FlexCAN_MbStructureType * Mbx, uint16_t ID)
-{
-    Mbx->Header[1] &= ~FLEXCAN_RAMn_DATA_WORD_1_ID_MASK;
-    Mbx->Header[1] |= FLEXCAN_RAMn_DATA_WORD_1_ID(ID);
+        FlexCANx->FDCTRL = Fdctrl;
+
+        /* 8, 16, 32 or 64-byte payload behind the 2 header words */
+        FlexCAN_MbWords[FlexCAN_Ins] = (uint8_t)(MB_HEADER_WORDS + (2U << FdConfig->PayloadSize));
+    }
 }
 
-static void FlexCAN_MbSetType(FlexCAN_MbStructureType * Mbx, FlexCAN_MbType_e MbType)
+static bool FlexCAN_CheckMbLayout(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config)
 {
-    Mbx->Header[0] &= ~FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK;
+    const FlexCAN_RxFifoConfigType * RxFifoConfig = FlexCAN_Config->RxFifoConfig;
+    const FlexCAN_FdConfigType * FdConfig = FlexCAN_Config->FdConfig;
+    uint8_t MbWords = MB_HEADER_WORDS + 2U;
+    uint8_t FirstMb = 0U;
+    uint8_t Index = 0U;
+    bool IsValid = (FlexCAN_Config->MbLayout != NULL || FlexCAN_Config->NoOfMbLayout == 0U);
 
-    if(MbType == FlexCAN_MB_TX)
+    if(RxFifoConfig != NULL && RxFifoConfig->Mode != FlexCAN_RXFIFO_DISABLE)
     {
-        /* Set code to INACTIVE status */
-        Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_INACTIVE);
-    }else
+        FirstMb = FLEXCAN_RXFIFO_FIRST_FREE_MB(RxFifoConfig->NoOfIdFilters);
+    }
+
+    /* MB size of the configuration being applied, not of the previous one */
+    if(FdConfig != NULL && FdConfig->Enable == true)
     {
-        Mbx->Header[0] |= FLEXCAN_RAMn_DATA_WORD_0_CODE(Rx_CODE_EMPTY);
+        MbWords = (uint8_t)(MB_HEADER_WORDS + (2U << FdConfig->PayloadSize));
+    }
+
+    for(Index = 0U; Index < FlexCAN_Config->NoOfMbLayout && IsValid == true; Index++)
+    {
+        IsValid = (FlexCAN_Config->MbLayout[Index].MbIndex >= FirstMb
+                   && FlexCAN_Config->MbLayout[Index].MbIndex <= FlexCAN_Config->MaxNoMB
+                   && FlexCAN_Config->MbLayout[Index].MbIndex < (FlexCAN_MbRamWords[FlexCAN_Ins] / MbWords));
     }
+
+    return IsValid;
 }
 
-static void FlexCAN_MbSetInterrupt(FlexCAN_Instance_e FlexCAN_Ins, FlexCAN_MbIndex_e MbIndex, bool IsEnableMbInt){
-    FLEXCAN_Type * FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+static bool FlexCAN_CheckRxFifoConfig(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_RxFifoConfigType * RxFifoConfig)
+{
+    bool IsValid = true;
 
-    if(IsEnableMbInt)
+    if(RxFifoConfig != NULL && RxFifoConfig->Mode != FlexCAN_RXFIFO_DISABLE)
     {
-        FlexCANx->IMASK1 |= (1 << MbIndex);
+        /* The filter table stays in the MB RAM of the instance (classic MBs, the FIFO excludes FD).
+           The ring is drained by halves, the eDMA counts records in CITER.
+           There is one eDMA channel for the FIFO, an instance keeps it until its de-init */
+        IsValid = (RxFifoConfig->RingBuffer != NULL && RxFifoConfig->RingLength >= 2U
+                   && RxFifoConfig->NoOfIdFilters <= RXFIFO_MAX_ID_FILTERS
+                   && FLEXCAN_RXFIFO_FIRST_FREE_MB(RxFifoConfig->NoOfIdFilters) <= (FlexCAN_MbRamWords[FlexCAN_Ins] / (MB_HEADER_WORDS + 2U))
+                   && (RxFifoConfig->RingLength % 2U) == 0U
+                   && (RxFifoConfig->UseDma == false
+                       || (RxFifoConfig->DmaChannel == FLEXCAN_RXFIFO_DMA_CHANNEL && RxFifoConfig->RingLength <= DMA_CITER_MAX
+                           && (FlexCAN_DmaOwner == DMA_NO_OWNER || FlexCAN_DmaOwner == (uint8_t)FlexCAN_Ins))));
     }
-    else
+
+    return IsValid;
+}
+
+/**
+ * Called in freeze mode: every mailbox is one store per header word and mask, the interrupt
+ * mask is written once for the whole layout.
+ */
+static void FlexCAN_SetMbLayout(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_ConfigType * FlexCAN_Config)
+{
+    FLEXCAN_Type * FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+    const FlexCAN_MbLayoutType * Layout = NULL;
+    FlexCAN_MbStructureType * Mbx = NULL;
+    uint32_t IntMask = 0U;
+    uint8_t Index = 0U;
+
+    for(Index = 0U; Index < FlexCAN_Config->NoOfMbLayout; Index++)
     {
-        FlexCANx->IMASK1 &= ~(1 << MbIndex);
+        Layout = &FlexCAN_Config->MbLayout[Index];
+        Mbx = FlexCAN_GetMb(FlexCAN_Ins, Layout->MbIndex);
+
+        Mbx->Header[1] = Layout->Id;
+        Mbx->Header[0] = Layout->Cs;
+        FlexCANx->RXIMR[Layout->MbIndex] = Layout->RxMask;
+
+        FlexCAN_Callback[FlexCAN_Ins][Layout->MbIndex].Func = Layout->Callback;
+        FlexCAN_Callback[FlexCAN_Ins][Layout->MbIndex].Context = Layout->Context;
+
+        if(Layout->Callback != NULL)
+        {
+            IntMask |= (1UL << Layout->MbIndex);
+        }
     }
+
+    FlexCANx->IMASK1 |= IntMask;
 }
 
-static void FlexCAN_SetModuleState(FlexCAN_Instance_e Ins, FlexCAN_State_e Transition)
+static void FlexCAN_RxFifoControl(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_RxFifoConfigType * RxFifoConfig)
 {
-    if(FlexCAN_CurrentState[Ins] != Transition)
+    FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+
+    FlexCAN_RxFifoState[FlexCAN_Ins].Produced = 0U;
+    FlexCAN_RxFifoState[FlexCAN_Ins].Consumed = 0U;
+    FlexCAN_RxFifoState[FlexCAN_Ins].OverflowCount = 0U;
+
+    if(RxFifoConfig == NULL || RxFifoConfig->Mode == FlexCAN_RXFIFO_DISABLE
+       || RxFifoConfig->RingBuffer == NULL || RxFifoConfig->RingLength < 2U)
     {
-        /* Switching for desired state */
-        FlexCAN_CurrentState[Ins] = Transition;
+        /* MB0-MB7 stay regular mailboxes */
+        FlexCANx->MCR &= ~(FLEXCAN_MCR_RFEN_MASK | FLEXCAN_MCR_DMA_MASK);
+        FlexCAN_RxFifoState[FlexCAN_Ins].Config = NULL;
     }
     else
     {
-        /* Current state is already in desired state */
+        /* Enable the legacy Rx FIFO */
+        FlexCANx->MCR |= FLEXCAN_MCR_RFEN_MASK;
+
+        /* Number of filter elements, 8 per RFFN step */
+        FlexCANx->CTRL2 &= ~FLEXCAN_CTRL2_RFFN_MASK;
+        FlexCANx->CTRL2 |= FLEXCAN_CTRL2_RFFN(FLEXCAN_RXFIFO_RFFN(RxFifoConfig->NoOfIdFilters));
+
+        /* Format A: one full ID per filter element, masked by RXFGMASK */
+        FlexCANx->MCR &= ~FLEXCAN_MCR_IDAM_MASK;
+        FlexCANx->RXFGMASK = FLEXCAN_RXFGMASK_FGM(RxFifoConfig->GlobalMask);
+
+        FlexCAN_RxFifoSetFilterTable(FlexCANx, RxFifoConfig);
+
+        if(RxFifoConfig->UseDma == true)
+        {
+            /* Frames available raises a DMA request instead of an interrupt */
+            FlexCANx->MCR |= FLEXCAN_MCR_DMA_MASK;
+            FlexCANx->IMASK1 &= ~RXFIFO_FLAGS_MASK;
+
+            FlexCAN_RxFifoDmaInit(FlexCAN_Ins, RxFifoConfig);
+        }
+        else
+        {
+            /* One interrupt per burst, the ISR drains the FIFO into the ring */
+            FlexCANx->MCR &= ~FLEXCAN_MCR_DMA_MASK;
+            FlexCANx->IMASK1 |= (RXFIFO_FRAME_AVAILABLE_MASK | RXFIFO_OVERFLOW_MASK);
+        }
+
+        FlexCAN_RxFifoState[FlexCAN_Ins].Config = RxFifoConfig;
     }
 }
 
-static void FlexCAN_SetMBnumber(FLEXCAN_Type *FlexCANx, uint8_t MaxMB)
+static void FlexCAN_RxFifoSetFilterTable(FLEXCAN_Type *FlexCANx, const FlexCAN_RxFifoConfigType * RxFifoConfig)
 {
-    uint8_t NoMB = 0U;
+    uint32_t NoOfElements = (FLEXCAN_RXFIFO_RFFN(RxFifoConfig->NoOfIdFilters) + 1U) * 8U;
+    uint32_t Element = 0U;
+    uint32_t ElementMask = 0U;
+    uint32_t Index = 0U;
+    const FlexCAN_RxFifoIdFilterType * Filter = NULL;
 
-    if(MaxMB >= NUMBER_OF_MB)
-    {
-        NoMB = NUMBER_OF_MB - 1U;
-    }
-    else
+    for(Index = 0U; Index < NoOfElements; Index++)
     {
-        NoMB = MaxMB;
+        if(RxFifoConfig->NoOfIdFilters == 0U || RxFifoConfig->IdFilterTable == NULL)
+        {
+            /* No table: every element accepts what passes the global mask */
+            Element = 0U;
+            ElementMask = RxFifoConfig->GlobalMask;
+        }
+        else
+        {
+            /* Unused elements repeat the last filter so they never widen the acceptance */
+            Filter = &RxFifoConfig->IdFilterTable[(Index < RxFifoConfig->NoOfIdFilters) ? Index : (RxFifoConfig->NoOfIdFilters - 1U)];
+
+            if(Filter->IdType == FlexCAN_EXTENDED)
+            {
+                Element = FLEXCAN_RXFIFO_ID_FILTER_IDE_MASK
+                        | ((Filter->Id << FLEXCAN_RXFIFO_ID_FILTER_EXT_SHIFT) & FLEXCAN_RXFIFO_ID_FILTER_EXT_MASK);
+            }
+            else
+            {
+                Element = (Filter->Id << FLEXCAN_RXFIFO_ID_FILTER_STD_SHIFT) & FLEXCAN_RXFIFO_ID_FILTER_STD_MASK;
+            }
+
+            if(Filter->IsRemote == true)
+            {
+                Element |= FLEXCAN_RXFIFO_ID_FILTER_RTR_MASK;
+            }
+
+            if(Filter->Mask == 0U)
+            {
+                ElementMask = RxFifoConfig->GlobalMask;
+            }
+            else if(Filter->IdType == FlexCAN_EXTENDED)
+            {
+                ElementMask = FLEXCAN_RXFIFO_EXT_MASK(Filter->Mask);
+            }
+            else
+            {
+                ElementMask = FLEXCAN_RXFIFO_STD_MASK(Filter->Mask);
+            }
+        }
+
+        FlexCANx->RAMn[RXFIFO_FILTER_TABLE_OFFSET + Index] = Element;
+
+        /* With MCR[IRMQ] the first elements use the individual masks, the others RXFGMASK */
+        if(Index < RXIMR_COUNT)
+        {
+            FlexCANx->RXIMR[Index] = ElementMask;
+        }
     }
-    FlexCANx->MCR &= ~FLEXCAN_MCR_MAXMB_MASK;
-    FlexCANx->MCR |= FLEXCAN_MCR_MAXMB(NoMB);
+}
+
+static void FlexCAN_RxFifoDmaInit(FlexCAN_Instance_e FlexCAN_Ins, const FlexCAN_RxFifoConfigType * RxFifoConfig)
+{
+    FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[FlexCAN_Ins];
+    uint8_t Channel = RxFifoConfig->DmaChannel;
+
+    /* Stop the channel while its TCD is rewritten */
+    IP_DMA->CERQ = Channel;
+    IP_DMAMUX->CHCFG[Channel] = 0U;
+
+    /* Source: the 16-byte FIFO output, wrapped by SMOD so it never needs an adjustment */
+    IP_DMA->TCD[Channel].SADDR = (uint32_t)&FlexCANx->RAMn[0];
+    IP_DMA->TCD[Channel].SOFF = 4U;
+    IP_DMA->TCD[Channel].ATTR = DMA_TCD_ATTR_SMOD(DMA_SMOD_RXFIFO) | DMA_TCD_ATTR_SSIZE(DMA_TRANSFER_SIZE_32BIT)
+                              | DMA_TCD_ATTR_DSIZE(DMA_TRANSFER_SIZE_32BIT);
+    IP_DMA->TCD[Channel].NBYTES.MLNO = RXFIFO_RECORD_SIZE;
+    IP_DMA->TCD[Channel].SLAST = 0U;
+
+    /* Destination: the RAM ring, one record per request, wrapping at the end of the major loop */
+    IP_DMA->TCD[Channel].DADDR = (uint32_t)RxFifoConfig->RingBuffer;
+    IP_DMA->TCD[Channel].DOFF = 4U;
+    IP_DMA->TCD[Channel].CITER.ELINKNO = RxFifoConfig->RingLength;
+    IP_DMA->TCD[Channel].BITER.ELINKNO = RxFifoConfig->RingLength;
+    IP_DMA->TCD[Channel].DLASTSGA = (uint32_t)(-(int32_t)(RxFifoConfig->RingLength * RXFIFO_RECORD_SIZE));
+
+    /* Interrupt once per half ring, keep the channel armed after the major loop */
+    IP_DMA->TCD[Channel].CSR = DMA_TCD_CSR_INTHALF_MASK | DMA_TCD_CSR_INTMAJOR_MASK;
+
+    FlexCAN_DmaOwner = (uint8_t)FlexCAN_Ins;
+
+    /* Route the FlexCAN Rx FIFO request to the channel and enable it */
+    IP_DMAMUX->CHCFG[Channel] = DMAMUX_CHCFG_SOURCE(FlexCAN_DmaRequest[FlexCAN_Ins]) | DMAMUX_CHCFG_ENBL_MASK;
+    IP_DMA->SERQ = Channel;
 }
 
 /* ----------------------------------------------------------------------------
@@ -641,10 +2300,15 @@ static void FlexCAN_Error_IRQHandler(FlexCAN_Instance_e Ins)
 {
     FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[Ins];
 
+    if(FlexCAN_Observer[Ins] != NULL)
+    {
+        FlexCAN_Observer[Ins](Ins, FLEXCAN_EVENT_ERROR, NULL, FlexCAN_GetTime(Ins));
+    }
+
     /* Invoke callback */
-    if(FlexCAN_Callback[Ins*ERROR_HANDLER_GAP] != NULL)
+    if(FlexCAN_Callback[Ins][FLEXCAN_ERROR_CALLBACK_ID].Func != NULL)
     {
-        FlexCAN_Callback[Ins*ERROR_HANDLER_GAP]();
+        FlexCAN_Callback[Ins][FLEXCAN_ERROR_CALLBACK_ID].Func(Ins, FLEXCAN_ERROR_CALLBACK_ID, FlexCAN_Callback[Ins][FLEXCAN_ERROR_CALLBACK_ID].Context);
     }
     else
     {
@@ -660,59 +2324,205 @@ static void FlexCAN_BusOff_IRQHandler(FlexCAN_Instance_e Ins)
     FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[Ins];
 
     /* Invoke callback */
-    if(FlexCAN_Callback[Ins*ERROR_HANDLER_GAP + ORED_HANDLER_GAP] != NULL)
+    if(FlexCAN_Callback[Ins][FLEXCAN_ORED_CALLBACK_ID].Func != NULL)
     {
-        FlexCAN_Callback[Ins*ERROR_HANDLER_GAP + ORED_HANDLER_GAP]();
+        FlexCAN_Callback[Ins][FLEXCAN_ORED_CALLBACK_ID].Func(Ins, FLEXCAN_ORED_CALLBACK_ID, FlexCAN_Callback[Ins][FLEXCAN_ORED_CALLBACK_ID].Context);
     }
     else
     {
         /* Callback is not registered */
     }
 
-    /* Clear all BusOff and Tx/Rx Warning interrupts in ESR1 register */
+    /* Clear all BusOff, BusOff Done and Tx/Rx Warning interrupts in ESR1 register */
     FlexCANx->ESR1 |= BUS_OFF_INT;
 }
 
-static void FlexCAN_MB_IRQHandler(FlexCAN_Instance_e Ins)
+static void FlexCAN_MB_IRQHandler(FlexCAN_Instance_e Ins, uint32_t VectorMask)
 {
     FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[Ins];
 
-    /* Variable for raised MB interrupt flag */
-    uint8_t RaisedFlag = 0;
+    /* Variable for raised MB interrupt flags of this vector */
+    uint32_t RaisedFlags = 0U;
 
     /* Variable for MBx's index */
-    uint8_t MbIndex = 0;
+    uint8_t MbIndex = 0U;
+
+    /* Variable for the event time of the MBs */
+    uint32_t Now = 0U;
+
+    /* Variable for the receive mode */
+    FlexCAN_RxPollStateType * PollState = &FlexCAN_RxPollState[Ins];
+
+    if(FlexCAN_RxFifoState[Ins].Config != NULL && (VectorMask & RXFIFO_FLAGS_MASK) != 0U)
+    {
+        if((FlexCANx->IFLAG1 & FlexCANx->IMASK1 & RXFIFO_FLAGS_MASK) != 0U)
+        {
+            /* Drain the whole Rx FIFO in one entry */
+            FlexCAN_RxFifo_IRQHandler(Ins);
+        }
+
+        /* MB0-MB7 belong to the FIFO engine, dispatch starts after the filter table */
+        VectorMask &= ~((SET << FLEXCAN_RXFIFO_FIRST_FREE_MB(FlexCAN_RxFifoState[Ins].Config->NoOfIdFilters)) - 1U);
+    }
+
+    /* Get the interrupts that are enabled and ready, once per entry */
+    RaisedFlags = FlexCANx->IFLAG1 & FlexCANx->IMASK1 & VectorMask;
+
+    if(RaisedFlags != 0U)
+    {
+        Now = FlexCAN_GetTime(Ins);
+        PollState->Stats.IrqEntries++;
+
+        if(PollState->Config.Mode == FlexCAN_RX_MODE_ADAPTIVE && (RaisedFlags & PollState->Group) != 0U)
+        {
+            /* A burst may start, the frames after these ones are polled until it ends */
+            FlexCANx->IMASK1 &= ~PollState->Group;
+            PollState->IsPolling = true;
+            PollState->QuietCount = 0U;
+            PollState->Stats.Switches++;
+        }
+    }
+
+    while(RaisedFlags != 0U)
+    {
+        /* Lowest raised flag first, same priority order as the former linear scan */
+        MbIndex = FLEXCAN_CTZ(RaisedFlags);
+        RaisedFlags &= (RaisedFlags - 1U);
+
+        FlexCAN_MbService(Ins, MbIndex, Now);
+        PollState->Stats.IrqFrames++;
+    }
+
+    /* Reading C/S above may leave an Rx MB locked when its callback did not read it */
+    (void)FlexCANx->TIMER;
+}
+
+static void FlexCAN_MbService(FlexCAN_Instance_e Ins, uint8_t MbIndex, uint32_t Now)
+{
+    FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[Ins];
+    const FlexCAN_MbStructureType * Mbx = FlexCAN_GetMb(Ins, (FlexCAN_MbIndex_e)MbIndex);
+    FlexCAN_MbEventTimeType * EventTime = &FlexCAN_MbEventTime[Ins][MbIndex];
+    FlexCAN_Event_e Event = FLEXCAN_EVENT_RX;
+
+    /* Rx or Tx-complete time, before the callback reuses the MB */
+    EventTime->WireTime = FlexCAN_ExtendTimeStamp(Now, Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK);
+    EventTime->IsrTime = Now;
+    EventTime->IsPending = true;
 
-    /* Get the interrupts that are enabled and ready */
-    while((RaisedFlag & SET) == 0U && (MbIndex < NUMBER_OF_MB))
+    if(FlexCAN_Observer[Ins] != NULL)
     {
-        /* Check if IFLAG is set with the corresponding IMASK bit */
-        RaisedFlag = (((FlexCANx->IFLAG1 & (FlexCANx->IMASK1 & FLEXCAN_IMASK1_BUF31TO0M_MASK)) >> MbIndex) & SET);
+        /* Tx codes, and RANSWER left by a sent remote answer, have CODE bit 3 set */
+        Event = ((Mbx->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_CODE(Tx_CODE_INACTIVE)) != 0U) ? FLEXCAN_EVENT_TX : FLEXCAN_EVENT_RX;
+        FlexCAN_Observer[Ins](Ins, Event, Mbx, EventTime->WireTime);
+    }
 
-        /* Forward to check next MB interrupt */
-        MbIndex++;
+    /* Invoke callback */
+    if(FlexCAN_Callback[Ins][MbIndex].Func != NULL)
+    {
+        FlexCAN_Callback[Ins][MbIndex].Func(Ins, MbIndex, FlexCAN_Callback[Ins][MbIndex].Context);
+    }
+    else
+    {
+        /* Callback is not registered */
     }
 
-    MbIndex--;
+    /* Clear the corresponding IFLAG only, the register is write-1-to-clear */
+    FlexCANx->IFLAG1 = (SET << MbIndex);
+}
+
+static void FlexCAN_RxFifo_IRQHandler(FlexCAN_Instance_e Ins)
+{
+    FLEXCAN_Type *FlexCANx = FlexCAN_Base_Addr[Ins];
+    FlexCAN_RxFifoStateType * FifoState = &FlexCAN_RxFifoState[Ins];
+    const FlexCAN_RxFifoConfigType * FifoConfig = FifoState->Config;
+
+    /* Variable for Rx FIFO output */
+    FlexCAN_MbStructureType * FifoOutput = &((FlexCAN_MB[Ins])->MB[0]);
+
+    /* Time base of the observed frames */
+    uint32_t Now = (FlexCAN_Observer[Ins] != NULL) ? FlexCAN_GetTime(Ins) : 0U;
+
+    if((FlexCANx->IFLAG1 & RXFIFO_OVERFLOW_MASK) != 0U)
+    {
+        /* Frames were lost inside the FIFO */
+        FifoState->OverflowCount++;
+        FlexCANx->IFLAG1 = RXFIFO_OVERFLOW_MASK;
+    }
 
-    if(RaisedFlag == SET)
+    while((FlexCANx->IFLAG1 & RXFIFO_FRAME_AVAILABLE_MASK) != 0U)
     {
-        /* Invoke callback */
-        if(FlexCAN_MbCallback[MbIndex] != NULL)
+        if((FifoState->Produced - FifoState->Consumed) < FifoConfig->RingLength)
         {
-            FlexCAN_MbCallback[MbIndex]();
+            FifoConfig->RingBuffer[FifoState->Produced % FifoConfig->RingLength] = *FifoOutput;
+            FifoState->Produced++;
         }
         else
         {
-            /* Callback is not registered */
+            /* Ring full, the frame is dropped but still popped from the FIFO */
+            FifoState->OverflowCount++;
+        }
+
+        if(FlexCAN_Observer[Ins] != NULL)
+        {
+            FlexCAN_Observer[Ins](Ins, FLEXCAN_EVENT_RX, FifoOutput,
+                                  FlexCAN_ExtendTimeStamp(Now, FifoOutput->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK));
+        }
+
+        /* Clearing BUF5I moves the next frame to the FIFO output */
+        FlexCANx->IFLAG1 = RXFIFO_FRAME_AVAILABLE_MASK;
+    }
+
+    /* Warning flag carries no extra information once the FIFO is drained */
+    FlexCANx->IFLAG1 = RXFIFO_WARNING_MASK;
+
+    /* Unlock the FIFO output */
+    FifoState->BatchTime = FlexCAN_GetTime(Ins);
+
+    if(FifoConfig->BatchCallback != NULL)
+    {
+        FifoConfig->BatchCallback(Ins, MB5, FifoConfig->BatchContext);
+    }
+}
+
+static void FlexCAN_RxFifoDma_IRQHandler(void)
+{
+    uint8_t Owner = FlexCAN_DmaOwner;
+    FlexCAN_RxFifoStateType * FifoState = NULL;
+    const FlexCAN_MbStructureType * Record = NULL;
+    uint32_t Now = 0U;
+    uint16_t Index = 0U;
+
+    /* Clear the channel interrupt request */
+    IP_DMA->CINT = FLEXCAN_RXFIFO_DMA_CHANNEL;
+
+    if(Owner != DMA_NO_OWNER && FlexCAN_RxFifoState[Owner].Config != NULL)
+    {
+        FifoState = &FlexCAN_RxFifoState[Owner];
+
+        if(FlexCAN_Observer[Owner] != NULL)
+        {
+            /* The half just written, the eDMA is filling the other one */
+            Now = FlexCAN_GetTime((FlexCAN_Instance_e)Owner);
+
+            for(Index = 0U; Index < (FifoState->Config->RingLength / 2U); Index++)
+            {
+                Record = &FifoState->Config->RingBuffer[(FifoState->Produced + Index) % FifoState->Config->RingLength];
+                FlexCAN_Observer[Owner]((FlexCAN_Instance_e)Owner, FLEXCAN_EVENT_RX, Record,
+                                        FlexCAN_ExtendTimeStamp(Now, Record->Header[0] & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK));
+            }
         }
 
-        /* Clear the corresponding IFLAG */
-        FlexCANx->IFLAG1 |= (SET << MbIndex);
+        /* Half and major interrupts both close a batch of half a ring */
+        FifoState->Produced += (FifoState->Config->RingLength / 2U);
+
+        if(FifoState->Config->BatchCallback != NULL)
+        {
+            FifoState->Config->BatchCallback((FlexCAN_Instance_e)Owner, MB5, FifoState->Config->BatchContext);
+        }
     }
     else
     {
-        /* No interrupt occurs */
+        /* Channel is not used for an Rx FIFO */
     }
 }
 
@@ -740,13 +2550,13 @@ void CAN0_Error_IRQHandler()
 void CAN0_ORed_0_15_MB_IRQHandler()
 {
     /* Handles message buffer interrupts for FlexCAN0, message buffers 0-15. */
-    FlexCAN_MB_IRQHandler(FlexCAN0_INS);
+    FlexCAN_MB_IRQHandler(FlexCAN0_INS, MB_0_15_FLAGS_MASK);
 }
 
 void CAN0_ORed_16_31_MB_IRQHandler()
 {
     /* Handles message buffer interrupts for FlexCAN0, message buffers 16-31. */
-    FlexCAN_MB_IRQHandler(FlexCAN0_INS);
+    FlexCAN_MB_IRQHandler(FlexCAN0_INS, MB_16_31_FLAGS_MASK);
 }
 
 /*
@@ -769,13 +2579,13 @@ void CAN1_Error_IRQHandler()
 void CAN1_ORed_0_15_MB_IRQHandler()
 {
     /* Handles message buffer interrupts for FlexCAN1, message buffers 0-15. */
-    FlexCAN_MB_IRQHandler(FlexCAN1_INS);
+    FlexCAN_MB_IRQHandler(FlexCAN1_INS, MB_0_15_FLAGS_MASK);
 }
 
 void CAN1_ORed_16_31_MB_IRQHandler()
 {
     /* Handles message buffer interrupts for FlexCAN1, message buffers 16-31. */
-    FlexCAN_MB_IRQHandler(FlexCAN1_INS);
+    FlexCAN_MB_IRQHandler(FlexCAN1_INS, MB_16_31_FLAGS_MASK);
 }
 
 /*
@@ -798,13 +2608,22 @@ void CAN2_Error_IRQHandler()
 void CAN2_ORed_0_15_MB_IRQHandler()
 {
     /* Handles message buffer interrupts for FlexCAN2, message buffers 0-15. */
-    FlexCAN_MB_IRQHandler(FlexCAN2_INS);
+    FlexCAN_MB_IRQHandler(FlexCAN2_INS, MB_0_15_FLAGS_MASK);
 }
 
 void CAN2_ORed_16_31_MB_IRQHandler()
 {
     /* Handles message buffer interrupts for FlexCAN2, message buffers 16-31. */
-    FlexCAN_MB_IRQHandler(FlexCAN2_INS);
+    FlexCAN_MB_IRQHandler(FlexCAN2_INS, MB_16_31_FLAGS_MASK);
+}
+
+/*
+ * eDMA Channel Interrupt Handler
+ * - Half and major loop interrupts of the channel draining a FlexCAN Rx FIFO.
+ */
+void DMA_IRQ_HANDLER(FLEXCAN_RXFIFO_DMA_CHANNEL)()
+{
+    FlexCAN_RxFifoDma_IRQHandler();
 }
 
 /* ----------------------------------------------------------------------------
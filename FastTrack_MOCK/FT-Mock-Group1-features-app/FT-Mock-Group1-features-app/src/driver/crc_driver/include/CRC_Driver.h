@@ -0,0 +1,53 @@
+/*
+ * CRC_Driver.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef CRC_DRIVER_H_
+#define CRC_DRIVER_H_
+
+#include "Driver_Header.h"
+
+/* ------------------------------------------------------------------------------------------------------------------------------------------------------
+   -- Definitions
+   ------------------------------------------------------------------------------------------------------------------------------------------------------ */
+/* Structures and enums for CRC configuration */
+typedef enum
+{
+    CRC_WIDTH_16BIT = 0U,           /*!< 16-bit CRC, result in the low half of the data register */
+    CRC_WIDTH_32BIT = 1U            /*!< 32-bit CRC */
+} CRC_Width_e;
+
+typedef struct
+{
+    CRC_Width_e         Width;      /*!< CRC width */
+    uint32_t            Poly;       /*!< Generator polynomial, without the x^16 or x^32 term */
+} CRC_ConfigType;
+
+/* ------------------------------------------------------------------------------------------------------------------------------------------------------
+   -- API
+   ------------------------------------------------------------------------------------------------------------------------------------------------------ */
+/**
+ * @brief Configures the CRC unit: width and polynomial, no transposition, no final XOR.
+ *
+ * The CRC clock must be enabled in the PCC first.
+ *
+ * @param Config - pointer to the CRC configuration
+ */
+void CRC_Init(const CRC_ConfigType *Config);
+
+/**
+ * @brief Computes the CRC of a byte stream.
+ *
+ * The unit holds one computation at a time, the caller serializes the users of the unit.
+ *
+ * @param Seed - initial value of the CRC register
+ * @param Data - bytes, fed in order
+ * @param Length - number of bytes
+ * @return uint32_t - CRC register after the last byte, in the low 16 bits for a 16-bit CRC
+ */
+uint32_t CRC_Calc(uint32_t Seed, const uint8_t *Data, uint32_t Length);
+
+#endif /* CRC_DRIVER_H_ */
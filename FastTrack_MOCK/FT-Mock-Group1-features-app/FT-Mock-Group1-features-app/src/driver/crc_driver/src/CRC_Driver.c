@@ -0,0 +1,58 @@
+/*
+ * CRC_Driver.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "CRC_Driver.h"
+#include <stddef.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define CRC_16BIT_RESULT_MASK			(0xFFFFU)
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static CRC_Width_e CRC_Width = CRC_WIDTH_16BIT;
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void CRC_Init(const CRC_ConfigType *Config)
+{
+    if(Config == NULL)
+    {
+        /* Invalid parameters */
+    }
+    else
+    {
+        /* TOT = TOTR = 0 and FXOR = 0: bits in and out in register order */
+        IP_CRC->CTRL = CRC_CTRL_TCRC(Config->Width);
+        IP_CRC->GPOLY = Config->Poly;
+        CRC_Width = Config->Width;
+    }
+}
+
+uint32_t CRC_Calc(uint32_t Seed, const uint8_t *Data, uint32_t Length)
+{
+    uint32_t Index = 0U;
+    uint32_t Result = 0U;
+
+    /* A data write with WAS set loads the seed */
+    IP_CRC->CTRL |= CRC_CTRL_WAS_MASK;
+    IP_CRC->DATAu.DATA = Seed;
+    IP_CRC->CTRL &= ~CRC_CTRL_WAS_MASK;
+
+    /* One byte-wide write per byte, the unit shifts it in during the bus cycle */
+    for(Index = 0U; Index < Length; Index++)
+    {
+        IP_CRC->DATAu.DATA_8.LL = Data[Index];
+    }
+
+    Result = IP_CRC->DATAu.DATA;
+
+    return (CRC_Width == CRC_WIDTH_16BIT) ? (Result & CRC_16BIT_RESULT_MASK) : Result;
+}
@@ -52,6 +52,7 @@ typedef enum
     DRV_UART_BAUDRATEVALUE_230400 = 230400U,
     DRV_UART_BAUDRATEVALUE_256000 = 256000U,
     DRV_UART_BAUDRATEVALUE_115200 = 115200U,
+    DRV_UART_BAUDRATEVALUE_1000000 = 1000000U,
 } Drv_Uart_BaudrateValueType;
 
 typedef enum
@@ -508,6 +508,7 @@ Drv_Uart_StatusType Drv_Uart_SendDataInterrupt(const Drv_Uart_InstanceType insta
 			s_UARTtxBufferstr[instance].txCount = 0;
 			s_UARTtxBufferstr[instance].txStatus = DRV_UART_TXBUSY;
 			s_UARTtxBufferstr[instance].isTxBusy = true;
+			ret_val = DRV_UART_OK;
 			/* Enable the LPUART transmitter */
 			base->CTRL = (base->CTRL & ~LPUART_CTRL_TE_MASK) | (1UL << LPUART_CTRL_TE_SHIFT);
 			/* Wait for the register write operation to complete */
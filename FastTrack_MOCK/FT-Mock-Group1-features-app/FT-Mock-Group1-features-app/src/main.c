@@ -33,6 +33,8 @@
 int main(void)
 {
 // 	App_Forwarder_Run();
+//	App_Forwarder_Sniffer_Run(); // bus monitor on LPUART1
+//	App_Forwarder_Monitor_Run(); // bus statistics on LPUART1
 //	App_NodeSpeed_Run(); // vng
  	App_NodeTemp_Run(); // xanh l
 
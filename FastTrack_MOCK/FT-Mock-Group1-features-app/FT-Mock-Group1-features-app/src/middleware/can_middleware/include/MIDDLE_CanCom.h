@@ -0,0 +1,202 @@
+/*
+ * MIDDLE_CanCom.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANCOM_H_
+#define INCLUDE_MIDDLE_CANCOM_H_
+
+#include "MIDDLE_FlexCAN.h"
+#include "MIDDLE_CanSched.h"
+#include "MIDDLE_CanE2E.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_COM_PDU_MAX_LEN         8U      /*!< Classic CAN payload, a PDU is packed as one 64-bit word */
+#define MID_CAN_COM_MAX_PDUS            8U      /*!< PDUs per instance */
+#define MID_CAN_COM_MAX_SIGNALS         32U     /*!< Signals per instance */
+#define MID_CAN_COM_SIGNAL_MAX_LEN      32U     /*!< Longest signal in bits */
+#define MID_CAN_COM_NO_UPDATE_BIT       0xFFU   /*!< Signal without update bit */
+
+/*==================================================================================================
+*                                        ENUMS
+==================================================================================================*/
+
+/**
+ * @brief PDU direction.
+ */
+typedef enum
+{
+    MID_CAN_COM_TX                = 0U,  /*!< Sent by this node */
+    MID_CAN_COM_RX                       /*!< Received by this node */
+} MID_CAN_ComDirection_e;
+
+/**
+ * @brief Transmission mode of a Tx PDU.
+ */
+typedef enum
+{
+    MID_CAN_COM_CYCLIC            = 0U,  /*!< Sent every CycleMs */
+    MID_CAN_COM_TRIGGERED,               /*!< Sent when a triggered signal is written, at most every MinDelayMs */
+    MID_CAN_COM_MIXED                    /*!< Cyclic, plus triggered sends in between */
+} MID_CAN_ComTxMode_e;
+
+/**
+ * @brief Byte order of a signal.
+ */
+typedef enum
+{
+    MID_CAN_COM_LITTLE_ENDIAN     = 0U,  /*!< Intel: StartBit is the LSB, the signal grows towards higher bytes */
+    MID_CAN_COM_BIG_ENDIAN               /*!< Motorola: StartBit is the MSB, the signal grows towards lower bytes */
+} MID_CAN_ComEndian_e;
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Reception notification of an Rx PDU, called from MID_CAN_ComRxIndication.
+ *
+ * @param[in]  Ins       The FlexCAN module instance.
+ * @param[in]  PduIndex  Index of the PDU in the configuration.
+ */
+typedef void (*MID_CAN_ComRxNotificationType)(MID_CAN_ModuleIns_e Ins, uint8_t PduIndex);
+
+/**
+ * @brief Signal descriptor.
+ *
+ * Bits are numbered byte by byte, bit n is bit (n % 8) of payload byte (n / 8), like in a DBC file.
+ * The physical value is Raw * Factor / Divisor + Offset.
+ */
+typedef struct
+{
+    uint8_t                      PduIndex;       /*!< PDU carrying the signal */
+    uint8_t                      StartBit;       /*!< LSB (little endian) or MSB (big endian) bit number */
+    uint8_t                      Length;         /*!< Length in bits, 1 to MID_CAN_COM_SIGNAL_MAX_LEN */
+    MID_CAN_ComEndian_e          Endian;         /*!< Byte order */
+    bool                         IsSigned;       /*!< Two's complement raw value */
+    int32_t                      Factor;         /*!< Scaling numerator, not 0 */
+    int32_t                      Divisor;        /*!< Scaling denominator, not 0 */
+    int32_t                      Offset;         /*!< Physical offset */
+    uint8_t                      UpdateBit;      /*!< Bit number of the update bit or MID_CAN_COM_NO_UPDATE_BIT */
+    bool                         IsTriggered;    /*!< A write requests a send of a TRIGGERED or MIXED PDU */
+} MID_CAN_ComSignalType;
+
+/**
+ * @brief PDU descriptor.
+ */
+typedef struct
+{
+    uint32_t                     Id;             /*!< CAN ID */
+    FlexCAN_MsgIDType_e          IdType;         /*!< Standard or extended ID */
+    uint8_t                      DataLen;        /*!< Payload length, 1 to MID_CAN_COM_PDU_MAX_LEN */
+    MID_CAN_ComDirection_e       Direction;      /*!< Tx or Rx */
+    MID_CAN_ComTxMode_e          TxMode;         /*!< Tx only: transmission mode */
+    FlexCAN_MbIndex_e            MbIndex;        /*!< Tx only: mailbox owned by the PDU */
+    bool                         IsAnswered;     /*!< Tx only: remote requests for Id are answered by the controller */
+    FlexCAN_MbIndex_e            AnswerMbIndex;  /*!< Tx only: ANSWER layout mailbox loaded with every frame sent */
+    bool                         IsLatestValue;  /*!< Tx only: a frame still waiting for the bus is aborted and replaced */
+    uint16_t                     CycleMs;        /*!< Tx only: period of CYCLIC and MIXED PDUs */
+    uint16_t                     MinDelayMs;     /*!< Tx only: minimum gap before a triggered send */
+    MID_CAN_ComRxNotificationType RxNotification; /*!< Rx only: reception notification, can be NULL */
+    const MID_CAN_E2EConfigType * E2E;           /*!< End-to-end protection, NULL if none. Signals must not use its bytes */
+} MID_CAN_ComPduType;
+
+/**
+ * @brief COM configuration of an instance, usually const tables.
+ *
+ * Signals are identified by their index in Signals.
+ */
+typedef struct
+{
+    const MID_CAN_ComPduType   * Pdus;           /*!< PDU table */
+    uint8_t                      NoOfPdus;       /*!< 1 to MID_CAN_COM_MAX_PDUS */
+    const MID_CAN_ComSignalType * Signals;       /*!< Signal table */
+    uint8_t                      NoOfSignals;    /*!< 1 to MID_CAN_COM_MAX_SIGNALS */
+} MID_CAN_ComConfigType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Initializes the COM layer of an instance.
+ *
+ * Checks the tables, precomputes the mask and shift of every signal, sets up the Tx mailboxes and
+ * registers every Tx PDU with the CAN scheduler, which then sends it from MID_CAN_SchedTick.
+ * Must be called after MID_CAN_Init and MID_CAN_SchedInit. Tx PDUs are sent once at start.
+ * The answer mailbox of an answered PDU is part of the layout given to MID_CAN_SetMbLayout.
+ *
+ * @param[in]  Ins     The FlexCAN module instance.
+ * @param[in]  Config  COM configuration, must stay valid while the layer is used.
+ *
+ * @return bool  false if a descriptor is invalid or the scheduler is full, the layer is then not active.
+ */
+bool MID_CAN_ComInit(MID_CAN_ModuleIns_e Ins, const MID_CAN_ComConfigType *Config);
+
+/**
+ * @brief  Writes a signal of a Tx PDU.
+ *
+ * The value is clamped to the raw range of the signal. Sets the update bit of the signal and,
+ * for a triggered signal, requests a send. Can be called from interrupt context.
+ *
+ * @param[in]  Ins       The FlexCAN module instance.
+ * @param[in]  SignalId  Index of the signal in the configuration.
+ * @param[in]  Value     Physical value.
+ *
+ * @return bool  false if the signal does not exist or is not in a Tx PDU.
+ */
+bool MID_CAN_ComSendSignal(MID_CAN_ModuleIns_e Ins, uint8_t SignalId, int32_t Value);
+
+/**
+ * @brief  Reads a signal of an Rx PDU.
+ *
+ * @param[in]   Ins       The FlexCAN module instance.
+ * @param[in]   SignalId  Index of the signal in the configuration.
+ * @param[out]  Value     Physical value, left unchanged when the function returns false.
+ *
+ * @return bool  false if the PDU was not received yet, was too short for the signal, or if the
+ *               update bit of the signal was clear in the last PDU.
+ */
+bool MID_CAN_ComReceiveSignal(MID_CAN_ModuleIns_e Ins, uint8_t SignalId, int32_t *Value);
+
+/**
+ * @brief  Requests a send of a Tx PDU at the next scheduler tick, whatever its mode.
+ *
+ * The minimum delay of the PDU still applies.
+ *
+ * @param[in]  Ins       The FlexCAN module instance.
+ * @param[in]  PduIndex  Index of the PDU in the configuration.
+ */
+void MID_CAN_ComTriggerTransmit(MID_CAN_ModuleIns_e Ins, uint8_t PduIndex);
+
+/**
+ * @brief  Hands a received frame to the COM layer.
+ *
+ * Called by the application for every frame it reads, from a mailbox handler or the Rx FIFO.
+ * Calls the notification of the matching Rx PDU. A protected PDU is dropped unless its E2E check
+ * is MID_CAN_E2E_OK. Must not be called with interrupts disabled.
+ *
+ * @param[in]  Ins    The FlexCAN module instance.
+ * @param[in]  Frame  Received frame.
+ *
+ * @return bool  true if the frame is an Rx PDU of the configuration.
+ */
+bool MID_CAN_ComRxIndication(MID_CAN_ModuleIns_e Ins, const FlexCAN_FrameType *Frame);
+
+/**
+ * @brief  Gets the measured period and jitter of a Tx PDU.
+ *
+ * @param[in]   Ins       The FlexCAN module instance.
+ * @param[in]   PduIndex  Index of the PDU in the configuration.
+ * @param[out]  Stats     Scheduler statistics of the PDU.
+ *
+ * @return bool  false if the PDU does not exist or is not a Tx PDU.
+ */
+bool MID_CAN_ComGetTxStats(MID_CAN_ModuleIns_e Ins, uint8_t PduIndex, MID_CAN_SchedStatsType *Stats);
+
+#endif /* INCLUDE_MIDDLE_CANCOM_H_ */
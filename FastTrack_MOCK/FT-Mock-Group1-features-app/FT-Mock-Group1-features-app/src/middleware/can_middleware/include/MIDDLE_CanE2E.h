@@ -0,0 +1,131 @@
+/*
+ * MIDDLE_CanE2E.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANE2E_H_
+#define INCLUDE_MIDDLE_CANE2E_H_
+
+#include "MIDDLE_FlexCAN.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_E2E_CRC_POLY            0x1DU     /*!< CRC-8 SAE J1850, as in AUTOSAR E2E profile 1 */
+#define MID_CAN_E2E_CRC_INIT            0xFFU
+#define MID_CAN_E2E_CRC_XOR             0xFFU     /*!< Applied to the final CRC */
+#define MID_CAN_E2E_COUNTER_MASK        0x0FU     /*!< 4-bit alive counter in the low nibble of its byte */
+
+/*==================================================================================================
+*                                        ENUMS
+==================================================================================================*/
+
+/**
+ * @brief Where the CRC is computed.
+ */
+typedef enum
+{
+    MID_CAN_E2E_CRC_UNIT          = 0U,  /*!< On-chip CRC unit, 16-bit mode with the polynomial shifted by 8 */
+    MID_CAN_E2E_CRC_TABLE                /*!< 256-byte table in flash, no peripheral needed */
+} MID_CAN_E2ECrcEngine_e;
+
+/**
+ * @brief Result of the check of a received PDU.
+ */
+typedef enum
+{
+    MID_CAN_E2E_OK                = 0U,  /*!< CRC correct, counter advanced by 1 to MaxDeltaCounter, or first PDU */
+    MID_CAN_E2E_REPEATED,                /*!< CRC correct, counter of the previous PDU: the sender is stuck or replayed */
+    MID_CAN_E2E_WRONG_SEQUENCE,          /*!< CRC correct, too many PDUs lost, the counter is taken as new reference */
+    MID_CAN_E2E_ERROR                    /*!< CRC wrong or PDU too short */
+} MID_CAN_E2EStatus_e;
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Protection of one PDU, shared by the sender and the receivers.
+ *
+ * The CRC covers the data ID, low byte first, then every payload byte but the CRC byte.
+ */
+typedef struct
+{
+    uint16_t                     DataId;         /*!< Protected but not sent, tells PDUs of the same layout apart */
+    uint8_t                      DataLen;        /*!< Protected length, 2 to 8, the CRC and counter bytes included */
+    uint8_t                      CrcByte;        /*!< Byte holding the CRC */
+    uint8_t                      CounterByte;    /*!< Byte holding the counter, its high nibble stays free for signals */
+    uint8_t                      MaxDeltaCounter; /*!< Largest counter step still OK, 1 when no PDU may be lost */
+} MID_CAN_E2EConfigType;
+
+/**
+ * @brief Counter state of one protected PDU, on the sender or on a receiver.
+ */
+typedef struct
+{
+    uint8_t                      Counter;        /*!< Sender: next counter. Receiver: last counter accepted */
+    bool                         IsSynced;       /*!< Receiver: a PDU was accepted since the state was reset */
+} MID_CAN_E2EStateType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Selects the CRC engine, sets up the CRC unit when it is selected.
+ *
+ * The table engine is used until this function is called.
+ *
+ * @param[in]  Engine  CRC engine.
+ */
+void MID_CAN_E2EInit(MID_CAN_E2ECrcEngine_e Engine);
+
+/**
+ * @brief  Checks a protection descriptor.
+ *
+ * @param[in]  Config  Descriptor.
+ *
+ * @return bool  false if a byte is out of the PDU, the CRC and counter share a byte or MaxDeltaCounter is 0.
+ */
+bool MID_CAN_E2ECheckConfig(const MID_CAN_E2EConfigType *Config);
+
+/**
+ * @brief  Resets a counter state, the next PDU sent has counter 0 and the next PDU received is accepted.
+ *
+ * @param[out]  State  Counter state.
+ */
+void MID_CAN_E2EResetState(MID_CAN_E2EStateType *State);
+
+/**
+ * @brief  Writes the counter and the CRC of a PDU about to be sent, then advances the counter.
+ *
+ * Must not be called with interrupts disabled.
+ *
+ * @param[in]     Config   Checked descriptor.
+ * @param[in,out] State    Sender state.
+ * @param[in,out] Data     Payload.
+ * @param[in]     DataLen  Length of Data, at least Config->DataLen.
+ *
+ * @return bool  false if the payload is too short, it is then left unchanged.
+ */
+bool MID_CAN_E2EProtect(const MID_CAN_E2EConfigType *Config, MID_CAN_E2EStateType *State, uint8_t *Data, uint8_t DataLen);
+
+/**
+ * @brief  Checks the CRC and the counter of a received PDU and updates the receiver state.
+ *
+ * Must not be called with interrupts disabled.
+ *
+ * @param[in]     Config   Checked descriptor.
+ * @param[in,out] State    Receiver state.
+ * @param[in]     Data     Payload.
+ * @param[in]     DataLen  Received length.
+ *
+ * @return MID_CAN_E2EStatus_e  Only MID_CAN_E2E_OK carries new data.
+ */
+MID_CAN_E2EStatus_e MID_CAN_E2ECheck(const MID_CAN_E2EConfigType *Config, MID_CAN_E2EStateType *State,
+                                     const uint8_t *Data, uint8_t DataLen);
+
+#endif /* INCLUDE_MIDDLE_CANE2E_H_ */
@@ -0,0 +1,70 @@
+/*
+ * MIDDLE_CanFilter.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANFILTER_H_
+#define INCLUDE_MIDDLE_CANFILTER_H_
+
+#include "MIDDLE_FlexCAN.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_FILTER_STD_ID_MAX       0x7FFU        /*!< Highest 11-bit identifier */
+#define MID_CAN_FILTER_EXT_ID_MAX       0x1FFFFFFFU   /*!< Highest 29-bit identifier */
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Range of identifiers an application wants to receive, bounds included.
+ *
+ * A single ID is a range with FirstId == LastId.
+ */
+typedef struct
+{
+    uint32_t                     FirstId;    /*!< First accepted ID */
+    uint32_t                     LastId;     /*!< Last accepted ID */
+    FlexCAN_MsgIDType_e          IdType;     /*!< Message ID type of the range */
+} MID_CAN_FilterRangeType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Computes ID + mask filters accepting exactly the requested ID ranges.
+ *
+ * Each range is split into aligned power-of-two blocks, then blocks with the same mask that differ
+ * in a single ID bit are merged, and blocks covered by another one are dropped. The result never
+ * accepts an ID outside the ranges, so the CPU only sees wanted frames.
+ *
+ * @param[in]   Ranges       ID ranges to accept.
+ * @param[in]   NoOfRanges   Number of ranges.
+ * @param[out]  Plan         Filter table, one mailbox or Rx FIFO element per entry.
+ * @param[in]   MaxEntries   Size of Plan.
+ * @param[out]  NoOfEntries  Number of filters written to Plan.
+ *
+ * @return bool  true if the ranges fit in MaxEntries filters, false otherwise.
+ */
+bool MID_CAN_FilterPlan(const MID_CAN_FilterRangeType *Ranges, uint8_t NoOfRanges,
+                        FlexCAN_RxFilterType *Plan, uint8_t MaxEntries, uint8_t *NoOfEntries);
+
+/**
+ * @brief  Converts a filter plan into an Rx FIFO ID filter table.
+ *
+ * The table is used through FlexCAN_RxFifoConfigType, each element gets its own RXIMR mask.
+ *
+ * @param[in]   Plan         Filter table computed by MID_CAN_FilterPlan.
+ * @param[in]   NoOfEntries  Number of filters in Plan.
+ * @param[out]  Table        Rx FIFO ID filter table, NoOfEntries elements.
+ */
+void MID_CAN_FilterToRxFifoTable(const FlexCAN_RxFilterType *Plan, uint8_t NoOfEntries,
+                                 FlexCAN_RxFifoIdFilterType *Table);
+
+#endif /* INCLUDE_MIDDLE_CANFILTER_H_ */
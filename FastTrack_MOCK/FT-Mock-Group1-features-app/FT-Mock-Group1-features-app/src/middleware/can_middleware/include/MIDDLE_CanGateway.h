@@ -0,0 +1,171 @@
+/*
+ * MIDDLE_CanGateway.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANGATEWAY_H_
+#define INCLUDE_MIDDLE_CANGATEWAY_H_
+
+#include "MIDDLE_FlexCAN.h"
+#include "MIDDLE_CanIdMap.h"
+#include "MIDDLE_CanE2E.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_GW_MAX_ROUTES           MID_CAN_IDMAP_MAX_KEYS  /*!< Routes of all instances */
+#define MID_CAN_GW_MAX_SLOTS            64U       /*!< Signal slots */
+#define MID_CAN_GW_UART_QUEUE_LENGTH    16U       /*!< UART records waiting for the application */
+#define MID_CAN_GW_NO_UPDATE_BIT        0xFFU     /*!< Signal without update bit */
+#define MID_CAN_GW_SAME_ID              0xFFFFFFFFU /*!< Forward with the received ID */
+
+/* Route actions, combined with | */
+#define MID_CAN_GW_FORWARD              0x01U     /*!< Send the frame on DstIns through its Tx queue */
+#define MID_CAN_GW_SIGNAL               0x02U     /*!< Store the signals of the frame in their slots */
+#define MID_CAN_GW_UART                 0x04U     /*!< Queue a UART record of the frame */
+#define MID_CAN_GW_NOTIFY               0x08U     /*!< Call the route notification, after the other actions */
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Unsigned little endian signal copied to a slot.
+ */
+typedef struct
+{
+    uint8_t                      Slot;           /*!< Slot written, below MID_CAN_GW_MAX_SLOTS */
+    uint8_t                      StartBit;       /*!< Bit of the signal LSB, bit 0 is the LSB of byte 0 */
+    uint8_t                      Length;         /*!< Bits, 1 to 32 */
+    uint8_t                      UpdateBit;      /*!< Bit set by the sender when the value is new, or MID_CAN_GW_NO_UPDATE_BIT */
+} MID_CAN_GwSignalType;
+
+/**
+ * @brief Called after the other actions of a route, from the context of MID_CAN_GwRxIndication.
+ *
+ * @param[in]  Ins    The FlexCAN module instance the frame came from.
+ * @param[in]  Tag    Tag of the route.
+ * @param[in]  Frame  Received frame.
+ */
+typedef void (*MID_CAN_GwNotificationType)(MID_CAN_ModuleIns_e Ins, uint8_t Tag, const FlexCAN_FrameType *Frame);
+
+/**
+ * @brief Route of one received CAN ID.
+ */
+typedef struct
+{
+    uint32_t                     Id;             /*!< Received ID */
+    FlexCAN_MsgIDType_e          IdType;         /*!< Received ID type */
+    MID_CAN_ModuleIns_e          SrcIns;         /*!< Instance the ID is received on */
+    uint8_t                      Actions;        /*!< MID_CAN_GW_FORWARD, _SIGNAL, _UART, _NOTIFY */
+    MID_CAN_ModuleIns_e          DstIns;         /*!< Forward: instance, its Tx queue must be initialized */
+    uint32_t                     DstId;          /*!< Forward: ID sent, or MID_CAN_GW_SAME_ID */
+    const MID_CAN_GwSignalType * Signals;        /*!< Signal: signals of the frame */
+    uint8_t                      NoOfSignals;    /*!< Signal: number of elements in Signals */
+    uint8_t                      Tag;            /*!< Given back in UART records and notifications */
+    MID_CAN_GwNotificationType   Notification;   /*!< Notify: function called */
+    const MID_CAN_E2EConfigType * E2E;           /*!< Checked before the actions, NULL if the ID is not protected */
+} MID_CAN_GwRouteType;
+
+/**
+ * @brief Routing table.
+ */
+typedef struct
+{
+    const MID_CAN_GwRouteType  * Routes;         /*!< One route per received ID */
+    uint8_t                      NoOfRoutes;     /*!< 1 to MID_CAN_GW_MAX_ROUTES */
+} MID_CAN_GwConfigType;
+
+/**
+ * @brief Frame of a route with the UART action.
+ */
+typedef struct
+{
+    uint8_t                      Tag;            /*!< Tag of the route */
+    uint32_t                     Id;             /*!< Received ID */
+    uint8_t                      DataLen;        /*!< Data length code, 0-8 */
+    uint8_t                      Data[FLEXCAN_FRAME_MAX_DATA_LEN]; /*!< Payload */
+    uint32_t                     TimeStamp;      /*!< Reception time, bit times */
+} MID_CAN_GwUartRecordType;
+
+/**
+ * @brief Routing counters since MID_CAN_GwInit.
+ */
+typedef struct
+{
+    uint32_t                     Routed;         /*!< Frames with a route */
+    uint32_t                     Dropped;        /*!< Frames without a route */
+    uint32_t                     ForwardOverflow; /*!< Forwards refused by a full Tx queue */
+    uint32_t                     UartOverflow;   /*!< UART records lost to a full queue */
+    uint32_t                     E2ERepeated;    /*!< Protected frames dropped, counter not advanced */
+    uint32_t                     E2EWrongSequence; /*!< Protected frames dropped, counter jumped too far */
+    uint32_t                     E2EError;       /*!< Protected frames dropped, CRC wrong or frame too short */
+} MID_CAN_GwStatsType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Checks the routing table and builds its perfect hash, clears the slots, queue and counters.
+ *
+ * @param[in]  Config  Routing table, must stay valid while the gateway is used.
+ *
+ * @return bool  false if a route is invalid or an ID is routed twice, every frame is then dropped.
+ */
+bool MID_CAN_GwInit(const MID_CAN_GwConfigType *Config);
+
+/**
+ * @brief  Runs the actions of the route of a received frame.
+ *
+ * The route is found in constant time whatever the size of the table. A frame of a protected route
+ * runs no action unless its E2E check is MID_CAN_E2E_OK. Must not be called with interrupts disabled.
+ *
+ * @param[in]  Ins    The FlexCAN module instance the frame came from.
+ * @param[in]  Frame  Received frame.
+ *
+ * @return bool  false if the frame has no route or failed its E2E check.
+ */
+bool MID_CAN_GwRxIndication(MID_CAN_ModuleIns_e Ins, const FlexCAN_FrameType *Frame);
+
+/**
+ * @brief  Gets the route of an ID.
+ *
+ * @param[in]  Ins     The FlexCAN module instance.
+ * @param[in]  Id      CAN ID.
+ * @param[in]  IdType  ID type.
+ *
+ * @return uint8_t  Index in the routing table, MID_CAN_IDMAP_NONE if the ID has no route.
+ */
+uint8_t MID_CAN_GwFind(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType);
+
+/**
+ * @brief  Reads a signal slot.
+ *
+ * @param[in]   Slot   Slot number.
+ * @param[out]  Value  Last value stored.
+ *
+ * @return bool  false if no signal was stored in the slot yet.
+ */
+bool MID_CAN_GwReadSlot(uint8_t Slot, uint32_t *Value);
+
+/**
+ * @brief  Takes the oldest UART record.
+ *
+ * @param[out]  Record  Record.
+ *
+ * @return bool  false if the queue is empty.
+ */
+bool MID_CAN_GwPopUartRecord(MID_CAN_GwUartRecordType *Record);
+
+/**
+ * @brief  Gets the routing counters.
+ *
+ * @param[out]  Stats  Counters.
+ */
+void MID_CAN_GwGetStats(MID_CAN_GwStatsType *Stats);
+
+#endif /* INCLUDE_MIDDLE_CANGATEWAY_H_ */
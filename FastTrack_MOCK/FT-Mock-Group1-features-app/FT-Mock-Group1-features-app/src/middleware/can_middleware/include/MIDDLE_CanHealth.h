@@ -0,0 +1,154 @@
+/*
+ * MIDDLE_CanHealth.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANHEALTH_H_
+#define INCLUDE_MIDDLE_CANHEALTH_H_
+
+#include "MIDDLE_FlexCAN.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_BITS_PER_MS             (MID_CAN_BIT_RATE / 1000U)   /*!< FlexCAN timer ticks per millisecond */
+
+/*==================================================================================================
+*                                        ENUMS
+==================================================================================================*/
+
+/**
+ * @brief Controller health state.
+ */
+typedef enum
+{
+    MID_CAN_HEALTH_ERROR_ACTIVE   = 0U,  /*!< TEC and REC below 128 */
+    MID_CAN_HEALTH_ERROR_PASSIVE,        /*!< TEC or REC above 127 */
+    MID_CAN_HEALTH_BUS_OFF,              /*!< Bus-off, recovery held during the backoff */
+    MID_CAN_HEALTH_RECOVERING,           /*!< Recovery released, waiting for 128 x 11 recessive bits */
+    MID_CAN_HEALTH_STATE_COUNT
+} MID_CAN_HealthState_e;
+
+/**
+ * @brief Bus-off recovery policy.
+ */
+typedef enum
+{
+    MID_CAN_RECOVERY_HARDWARE     = 0U,  /*!< The controller recovers on its own, no backoff */
+    MID_CAN_RECOVERY_BACKOFF,            /*!< Recovery starts when the backoff expires */
+    MID_CAN_RECOVERY_SOFTWARE            /*!< Recovery starts on MID_CAN_HealthRequestRecovery after the backoff */
+} MID_CAN_RecoveryMode_e;
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Notification of a health state change, called from interrupt or MID_CAN_HealthMainFunction.
+ */
+typedef void (*MID_CAN_HealthNotificationType)(MID_CAN_ModuleIns_e Ins, MID_CAN_HealthState_e OldState,
+                                               MID_CAN_HealthState_e NewState);
+
+/**
+ * @brief Health monitor configuration.
+ *
+ * A bus-off within StableMs of the previous recovery doubles the backoff, up to BackoffMaxMs.
+ * Recovery therefore takes at most BackoffMaxMs plus 128 x 11 recessive bit times.
+ */
+typedef struct
+{
+    MID_CAN_RecoveryMode_e       RecoveryMode;   /*!< Bus-off recovery policy */
+    uint32_t                     BackoffMs;      /*!< Backoff after a first bus-off */
+    uint32_t                     BackoffMaxMs;   /*!< Upper bound of the backoff */
+    uint32_t                     StableMs;       /*!< Time after a recovery that resets the backoff */
+    MID_CAN_HealthNotificationType Notification; /*!< State change notification, can be NULL */
+} MID_CAN_HealthConfigType;
+
+/**
+ * @brief Health counters of an instance.
+ */
+typedef struct
+{
+    uint32_t                     ErrorFrames;    /*!< Error frames, errors between two ESR1 samples count once */
+    uint32_t                     AckErrors;      /*!< Samples of ESR1 with an acknowledge error */
+    uint32_t                     BusOffCount;    /*!< Bus-off events */
+    uint8_t                      Tec;            /*!< Last transmit error counter */
+    uint8_t                      Rec;            /*!< Last receive error counter */
+    uint8_t                      TecPeak;        /*!< Highest transmit error counter */
+    uint8_t                      RecPeak;        /*!< Highest receive error counter */
+    uint32_t                     TimeInStateMs[MID_CAN_HEALTH_STATE_COUNT]; /*!< Time spent in each state */
+    uint32_t                     LastRecoveryMs; /*!< Bus-off to error active, last recovery */
+    uint32_t                     MaxRecoveryMs;  /*!< Bus-off to error active, longest recovery */
+} MID_CAN_HealthCountersType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Starts the health monitor of an instance.
+ *
+ * Call after MID_CAN_Init. The monitor owns the error and ORed callbacks of the instance.
+ *
+ * @param[in]  Ins     The FlexCAN module instance.
+ * @param[in]  Config  Health monitor configuration, must stay valid while the monitor runs.
+ */
+void MID_CAN_HealthInit(MID_CAN_ModuleIns_e Ins, const MID_CAN_HealthConfigType *Config);
+
+/**
+ * @brief  Runs the backoff timer and samples the error counters.
+ *
+ * Call periodically, at least once every 65536 bit times (131 ms at 500 kbit/s).
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ */
+void MID_CAN_HealthMainFunction(MID_CAN_ModuleIns_e Ins);
+
+/**
+ * @brief  Gets the health state of an instance.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ *
+ * @return MID_CAN_HealthState_e  Current state.
+ */
+MID_CAN_HealthState_e MID_CAN_HealthGetState(MID_CAN_ModuleIns_e Ins);
+
+/**
+ * @brief  Allows a software-gated recovery to start once the backoff expires.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ *
+ * @return bool  true if the instance is bus-off and waits for the request, false otherwise.
+ */
+bool MID_CAN_HealthRequestRecovery(MID_CAN_ModuleIns_e Ins);
+
+/**
+ * @brief  Tells whether new frames may be handed to the controller.
+ *
+ * Transmission is suspended from bus-off until the controller is error active or passive again.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ *
+ * @return bool  true if transmission is allowed, false otherwise.
+ */
+bool MID_CAN_HealthIsTxAllowed(MID_CAN_ModuleIns_e Ins);
+
+/**
+ * @brief  Gets the health counters of an instance.
+ *
+ * @param[in]   Ins       The FlexCAN module instance.
+ * @param[out]  Counters  Counters snapshot.
+ */
+void MID_CAN_HealthGetCounters(MID_CAN_ModuleIns_e Ins, MID_CAN_HealthCountersType *Counters);
+
+/**
+ * @brief  Clears the health counters of an instance, the state is kept.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ */
+void MID_CAN_HealthResetCounters(MID_CAN_ModuleIns_e Ins);
+
+#endif /* INCLUDE_MIDDLE_CANHEALTH_H_ */
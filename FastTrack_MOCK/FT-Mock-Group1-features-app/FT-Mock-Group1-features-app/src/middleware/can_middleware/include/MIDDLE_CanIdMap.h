@@ -0,0 +1,82 @@
+/*
+ * MIDDLE_CanIdMap.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANIDMAP_H_
+#define INCLUDE_MIDDLE_CANIDMAP_H_
+
+#include "MIDDLE_FlexCAN.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_IDMAP_MAX_BITS          7U        /*!< Largest table, 2^7 slots */
+#define MID_CAN_IDMAP_MAX_SLOTS         (1U << MID_CAN_IDMAP_MAX_BITS)
+#define MID_CAN_IDMAP_MAX_KEYS          64U       /*!< Keys per map */
+#define MID_CAN_IDMAP_NONE              0xFFU     /*!< Key not in the map */
+
+/**
+ * @brief Map key of a CAN ID: instance in bits 31-30, ID type in bit 29, ID in bits 28-0.
+ */
+#define MID_CAN_IDMAP_KEY(Ins, Id, IdType) \
+    (((uint32_t)(Ins) << 30U) | ((uint32_t)(IdType) << 29U) | ((uint32_t)(Id) & 0x1FFFFFFFU))
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Minimal perfect hash of a fixed key set, built once and read-only afterwards.
+ *
+ * Hash and displace: the low half of the key hash picks a group, the high half a slot, and the
+ * displacement of the group moves its keys to free slots of the table. A lookup is one
+ * multiplication, three table reads and one compare whatever the number of keys, and is safe
+ * from interrupt context.
+ */
+typedef struct
+{
+    uint32_t                     Keys[MID_CAN_IDMAP_MAX_SLOTS];       /*!< Key stored in each slot */
+    uint8_t                      Values[MID_CAN_IDMAP_MAX_SLOTS];     /*!< Index of the key, MID_CAN_IDMAP_NONE if free */
+    uint8_t                      Disp[MID_CAN_IDMAP_MAX_SLOTS / 2U];  /*!< Displacement of each group */
+    uint32_t                     Seed;           /*!< Multiplier of the key hash */
+    uint8_t                      SlotShift;      /*!< 32 - slot bits */
+    uint8_t                      GroupShift;     /*!< 16 - group bits */
+    uint8_t                      SlotMask;       /*!< Number of slots - 1 */
+} MID_CAN_IdMapType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Builds the map of a key set, key i maps to value i.
+ *
+ * @param[out]  Map       Map to build.
+ * @param[in]   Keys      Keys, usually MID_CAN_IDMAP_KEY values.
+ * @param[in]   NoOfKeys  0 to MID_CAN_IDMAP_MAX_KEYS.
+ *
+ * @return bool  false if a key is duplicated or no perfect hash was found, the map is then empty.
+ */
+bool MID_CAN_IdMapBuild(MID_CAN_IdMapType *Map, const uint32_t *Keys, uint8_t NoOfKeys);
+
+/**
+ * @brief  Looks a key up.
+ *
+ * @param[in]  Map  Built map.
+ * @param[in]  Key  Key to look for.
+ *
+ * @return uint8_t  Index of the key given to MID_CAN_IdMapBuild, or MID_CAN_IDMAP_NONE.
+ */
+static inline uint8_t MID_CAN_IdMapFind(const MID_CAN_IdMapType *Map, uint32_t Key)
+{
+    uint32_t Hash = Key * Map->Seed;
+    uint8_t Slot = (uint8_t)(((Hash >> Map->SlotShift) + Map->Disp[(Hash & 0xFFFFU) >> Map->GroupShift]) & Map->SlotMask);
+
+    return (Map->Keys[Slot] == Key) ? Map->Values[Slot] : MID_CAN_IDMAP_NONE;
+}
+
+#endif /* INCLUDE_MIDDLE_CANIDMAP_H_ */
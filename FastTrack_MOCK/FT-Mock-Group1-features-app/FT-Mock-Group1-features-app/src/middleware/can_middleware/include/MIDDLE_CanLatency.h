@@ -0,0 +1,87 @@
+/*
+ * MIDDLE_CanLatency.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANLATENCY_H_
+#define INCLUDE_MIDDLE_CANLATENCY_H_
+
+#include "MIDDLE_FlexCAN.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_LATENCY_MAX_IDS         8U    /*!< IDs tracked per instance, first come first served */
+#define MID_CAN_LATENCY_BUCKETS         16U   /*!< log2 histogram buckets */
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Statistics of one latency, in nominal bit times.
+ *
+ * Histogram[0] counts zero latencies, Histogram[n] counts latencies in [2^(n-1), 2^n),
+ * the last bucket also counts everything above.
+ */
+typedef struct
+{
+    uint32_t                     Count;      /*!< Number of samples */
+    uint32_t                     Min;        /*!< Smallest latency */
+    uint32_t                     Max;        /*!< Largest latency */
+    uint32_t                     Mean;       /*!< Average latency */
+    uint32_t                     Histogram[MID_CAN_LATENCY_BUCKETS]; /*!< log2 histogram */
+} MID_CAN_LatencyStatType;
+
+/**
+ * @brief Receive latencies of one ID.
+ */
+typedef struct
+{
+    uint32_t                     Id;             /*!< Message ID */
+    FlexCAN_MsgIDType_e          IdType;         /*!< Message ID type */
+    MID_CAN_LatencyStatType      WireToIsr;      /*!< Frame on the bus to interrupt */
+    MID_CAN_LatencyStatType      IsrToConsume;   /*!< Interrupt to read by the application */
+} MID_CAN_LatencyType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Records the latencies of a received frame.
+ *
+ * Called by the MID_CAN receive functions when the application consumes a frame.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  Id       Message ID of the frame.
+ * @param[in]  IdType   Message ID type of the frame.
+ * @param[in]  WireTime Reception time of the frame (FlexCAN_FrameType::TimeStamp).
+ * @param[in]  IsrTime  Interrupt time of the frame (FlexCAN_FrameType::IsrTimeStamp).
+ */
+void MID_CAN_LatencyRecord(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType,
+                           uint32_t WireTime, uint32_t IsrTime);
+
+/**
+ * @brief  Gets the receive latency statistics of an ID.
+ *
+ * @param[in]   Ins     The FlexCAN module instance.
+ * @param[in]   Id      Message ID.
+ * @param[in]   IdType  Message ID type.
+ * @param[out]  Latency Statistics snapshot.
+ *
+ * @return bool  true if the ID is tracked, false otherwise.
+ */
+bool MID_CAN_GetLatency(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType, MID_CAN_LatencyType *Latency);
+
+/**
+ * @brief  Clears the latency statistics of an instance and releases its tracked IDs.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ */
+void MID_CAN_LatencyReset(MID_CAN_ModuleIns_e Ins);
+
+#endif /* INCLUDE_MIDDLE_CANLATENCY_H_ */
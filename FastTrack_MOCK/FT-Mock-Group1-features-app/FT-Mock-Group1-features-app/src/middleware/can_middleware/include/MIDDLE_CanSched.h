@@ -0,0 +1,111 @@
+/*
+ * MIDDLE_CanSched.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANSCHED_H_
+#define INCLUDE_MIDDLE_CANSCHED_H_
+
+#include "MIDDLE_FlexCAN.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_SCHED_MAX_SLOTS         16U       /*!< PDUs of all instances */
+#define MID_CAN_SCHED_AUTO_OFFSET       0xFFFFU   /*!< Offset picked by the scheduler */
+#define MID_CAN_SCHED_INVALID_SLOT      0xFFU     /*!< Returned when a PDU cannot be registered */
+#define MID_CAN_SCHED_MAX_HYPERPERIOD   10000U    /*!< Ticks looked at when the offsets are spread */
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Sends a PDU, called from MID_CAN_SchedTick.
+ *
+ * @param[in]  Ins     The FlexCAN module instance of the slot.
+ * @param[in]  Handle  Value given to MID_CAN_SchedAdd, e.g. a PDU index.
+ *
+ * @return bool  false if the PDU could not be sent (mailbox busy, bus-off), it is retried at the next tick.
+ */
+typedef bool (*MID_CAN_SchedTxType)(MID_CAN_ModuleIns_e Ins, uint8_t Handle);
+
+/**
+ * @brief Slot registration.
+ */
+typedef struct
+{
+    MID_CAN_ModuleIns_e          Ins;            /*!< Instance the PDU is sent on, also the clock of the statistics */
+    uint16_t                     PeriodMs;       /*!< Cycle, 0 for a PDU only sent when triggered */
+    uint16_t                     OffsetMs;       /*!< First send after start, or MID_CAN_SCHED_AUTO_OFFSET */
+    uint16_t                     MinDelayMs;     /*!< Shortest gap before a triggered send */
+    MID_CAN_SchedTxType          TxFunc;         /*!< Send function */
+    uint8_t                      Handle;         /*!< Passed back to TxFunc */
+} MID_CAN_SchedSlotConfigType;
+
+/**
+ * @brief Measured period of a cyclic slot, from one send to the next cyclic send.
+ *
+ * Times are taken on the FlexCAN timer of the slot instance when the frame is handed to its mailbox.
+ */
+typedef struct
+{
+    uint32_t                     Count;          /*!< Periods measured */
+    uint32_t                     MinUs;          /*!< Shortest period */
+    uint32_t                     MaxUs;          /*!< Longest period */
+    uint32_t                     AvgUs;          /*!< Mean period */
+    uint32_t                     MaxJitterUs;    /*!< Largest distance to the configured period */
+    uint32_t                     Deferred;       /*!< Ticks a due send was held back by TxFunc */
+} MID_CAN_SchedStatsType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Sets the tick period and clears all slots.
+ *
+ * @param[in]  TickUs  Period of the MID_CAN_SchedTick calls, in microseconds.
+ */
+void MID_CAN_SchedInit(uint32_t TickUs);
+
+/**
+ * @brief  Registers a PDU.
+ *
+ * With MID_CAN_SCHED_AUTO_OFFSET, the offset is the one whose sends meet the fewest sends of the
+ * slots already registered, so frames of one node are spread instead of sent in bursts.
+ *
+ * @param[in]  Config  Slot registration.
+ *
+ * @return uint8_t  Slot number, MID_CAN_SCHED_INVALID_SLOT if the table is full or the scheduler not initialized.
+ */
+uint8_t MID_CAN_SchedAdd(const MID_CAN_SchedSlotConfigType *Config);
+
+/**
+ * @brief  Requests a send at the next tick once the minimum delay is over. A send restarts the cycle.
+ *
+ * Can be called from interrupt context.
+ *
+ * @param[in]  Slot  Slot number.
+ */
+void MID_CAN_SchedTrigger(uint8_t Slot);
+
+/**
+ * @brief  Sends the PDUs that are due, to be called from the timebase interrupt every TickUs.
+ */
+void MID_CAN_SchedTick(void);
+
+/**
+ * @brief  Gets the measured period of a slot.
+ *
+ * @param[in]   Slot   Slot number.
+ * @param[out]  Stats  Statistics.
+ *
+ * @return bool  false if the slot does not exist.
+ */
+bool MID_CAN_SchedGetStats(uint8_t Slot, MID_CAN_SchedStatsType *Stats);
+
+#endif /* INCLUDE_MIDDLE_CANSCHED_H_ */
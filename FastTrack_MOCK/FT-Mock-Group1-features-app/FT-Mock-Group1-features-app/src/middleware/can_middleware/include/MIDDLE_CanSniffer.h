@@ -0,0 +1,111 @@
+/*
+ * MIDDLE_CanSniffer.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANSNIFFER_H_
+#define INCLUDE_MIDDLE_CANSNIFFER_H_
+
+#include "MIDDLE_FlexCAN.h"
+#include "../../uart_middleware/include/MIDDLE_UART.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+/*
+ * Stream format, every field little endian.
+ *
+ * Batch:
+ *   0      MID_CAN_SNIFFER_SYNC_0, MID_CAN_SNIFFER_SYNC_1
+ *   2      Length of the records in bytes (uint16)
+ *   4      Number of records (uint8)
+ *   5      Frames lost just before the first record, saturated (uint16)
+ *   7      CAN time of the first record, bit times (uint32)
+ *   11     Records
+ *   11+n   XOR of bytes 2 to 10+n
+ *
+ * Record:
+ *   0      Flags: DLC in bits 0-3, MID_CAN_SNIFFER_FLAG_RTR, MID_CAN_SNIFFER_FLAG_IDE
+ *   1      Reception time after the batch time, bit times (uint16)
+ *   3      ID, 2 bytes for a standard ID, 4 bytes for an extended ID
+ *   5/7    Payload, min(DLC, 8) bytes, none for a remote frame
+ *
+ * At 500 kbit/s a saturated bus carries at most about 60 kB/s of records and batch headers,
+ * whatever the frame lengths. MID_CAN_SNIFFER_BAUD_RATE keeps it at 60 % of the UART.
+ */
+#define MID_CAN_SNIFFER_UART            MID_UART_instance_1      /*!< Set up by MID_UART_Init */
+#define MID_CAN_SNIFFER_BAUD_RATE       DRV_UART_BAUDRATEVALUE_1000000
+#define MID_CAN_SNIFFER_RING_LENGTH     64U       /*!< Rx FIFO ring records, 3 ms of a saturated bus */
+#define MID_CAN_SNIFFER_BATCH_SIZE      256U      /*!< Bytes of one batch, header and checksum included */
+
+#define MID_CAN_SNIFFER_SYNC_0          0xA5U
+#define MID_CAN_SNIFFER_SYNC_1          0x5AU
+#define MID_CAN_SNIFFER_HEADER_SIZE     11U
+#define MID_CAN_SNIFFER_FLAG_RTR        0x40U
+#define MID_CAN_SNIFFER_FLAG_IDE        0x80U
+#define MID_CAN_SNIFFER_DLC_MASK        0x0FU
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Sniffer setup.
+ */
+typedef struct
+{
+    MID_CAN_ModuleIns_e          Ins;            /*!< Instance listening to the bus */
+    bool                         UseDma;         /*!< Drain the Rx FIFO with the eDMA */
+    uint8_t                      DmaChannel;     /*!< eDMA channel used when UseDma is set */
+} MID_CAN_SnifferConfigType;
+
+/**
+ * @brief Counters since MID_CAN_SnifferInit.
+ *
+ * Every frame on the bus is streamed or counted in UartDropped or FifoLost.
+ */
+typedef struct
+{
+    uint32_t                     Frames;         /*!< Frames read from the Rx FIFO ring */
+    uint32_t                     Streamed;       /*!< Frames put in a batch */
+    uint32_t                     Batches;        /*!< Batches handed to the UART */
+    uint32_t                     Bytes;          /*!< Bytes handed to the UART */
+    uint32_t                     UartDropped;    /*!< Frames dropped, the UART was still busy with the other batch */
+    uint32_t                     FifoLost;       /*!< Frames lost by the Rx FIFO or its ring, the main loop was late */
+} MID_CAN_SnifferStatsType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Sets up the CAN instance in listen-only mode with an accept-all Rx FIFO, and the UART.
+ *
+ * Replaces MID_CAN_Init and MID_UART_Init, installs the UART transmitter callback.
+ * The instance never drives the bus, not even the ACK bit.
+ *
+ * @param[in]  Config  Sniffer setup.
+ *
+ * @return bool  false if Config is invalid, nothing is set up then.
+ */
+bool MID_CAN_SnifferInit(const MID_CAN_SnifferConfigType *Config);
+
+/**
+ * @brief  Moves the received frames into the batch being filled and sends it when the UART is free.
+ *
+ * Called from the main loop. When both batches are in use the frames read are dropped and counted,
+ * the Rx FIFO ring is always drained.
+ */
+void MID_CAN_SnifferMainFunction(void);
+
+/**
+ * @brief  Copies the sniffer counters.
+ *
+ * @param[out] Stats  Counters.
+ */
+void MID_CAN_SnifferGetStats(MID_CAN_SnifferStatsType *Stats);
+
+#endif /* INCLUDE_MIDDLE_CANSNIFFER_H_ */
@@ -0,0 +1,162 @@
+/*
+ * MIDDLE_CanStats.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANSTATS_H_
+#define INCLUDE_MIDDLE_CANSTATS_H_
+
+#include "MIDDLE_FlexCAN.h"
+#include "MIDDLE_CanIdMap.h"
+#include "../../uart_middleware/include/MIDDLE_UART.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_STATS_ID_BITS           6U        /*!< ID table of 2^6 entries, shared by the instances */
+#define MID_CAN_STATS_MAX_IDS           (1U << MID_CAN_STATS_ID_BITS)
+#define MID_CAN_STATS_MAX_PROBES        4U        /*!< Entries tried per frame, bounds the cost of a lookup */
+
+#define MID_CAN_STATS_SLOTS             10U       /*!< Slots of a sliding window */
+#define MID_CAN_STATS_SHORT_SLOT_BITS   (MID_CAN_BIT_RATE / 100U)  /*!< 10 ms slots, 100 ms window */
+#define MID_CAN_STATS_LONG_SLOT_BITS    (MID_CAN_BIT_RATE / 10U)   /*!< 100 ms slots, 1 s window */
+
+/* Error flag, its superposition and the delimiter. The part of the frame it destroyed is not known */
+#define MID_CAN_STATS_ERROR_FRAME_BITS  20U
+
+#define MID_CAN_STATS_UART              MID_UART_instance_1      /*!< Set up by the application */
+#define MID_CAN_STATS_LINE_SIZE         96U       /*!< Longest line of a report */
+
+/*==================================================================================================
+*                                        ENUMS
+==================================================================================================*/
+
+/**
+ * @brief Sliding windows of an instance.
+ */
+typedef enum
+{
+    MID_CAN_STATS_WINDOW_SHORT    = 0U,  /*!< MID_CAN_STATS_SLOTS x MID_CAN_STATS_SHORT_SLOT_BITS */
+    MID_CAN_STATS_WINDOW_LONG,           /*!< MID_CAN_STATS_SLOTS x MID_CAN_STATS_LONG_SLOT_BITS */
+    MID_CAN_STATS_WINDOW_COUNT
+} MID_CAN_StatsWindow_e;
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Bus activity over a sliding window.
+ *
+ * The window moves by one slot at a time: it covers the slots before the current one and the
+ * elapsed part of the current one. Loads are frame bits, stuff bits included, over elapsed bits.
+ */
+typedef struct
+{
+    uint32_t                     LengthMs;       /*!< Length of the window */
+    uint16_t                     Load;           /*!< Bus load, per mille */
+    uint16_t                     PeakLoad;       /*!< Highest load of a whole window, sampled when a slot closes */
+    uint32_t                     Frames;         /*!< Frames in the window */
+    uint32_t                     Errors;         /*!< Error interrupts in the window */
+} MID_CAN_StatsWindowType;
+
+/**
+ * @brief Bus counters of an instance since MID_CAN_StatsInit.
+ */
+typedef struct
+{
+    uint32_t                     Frames;         /*!< Frames received and sent */
+    uint32_t                     TxFrames;       /*!< Frames sent by this node */
+    uint32_t                     Errors;         /*!< Error interrupts, errors before the interrupt count once */
+    uint32_t                     Untracked;      /*!< Frames of IDs that found no free entry */
+    MID_CAN_StatsWindowType      Window[MID_CAN_STATS_WINDOW_COUNT]; /*!< Sliding windows */
+} MID_CAN_StatsBusType;
+
+/**
+ * @brief Counters of one ID. Times are in nominal bit times.
+ */
+typedef struct
+{
+    MID_CAN_ModuleIns_e          Ins;            /*!< Instance that saw the ID */
+    uint32_t                     Id;             /*!< Message ID */
+    FlexCAN_MsgIDType_e          IdType;         /*!< Message ID type */
+    uint32_t                     Frames;         /*!< Frames received and sent */
+    uint32_t                     TxFrames;       /*!< Frames sent by this node */
+    uint32_t                     Bytes;          /*!< Payload bytes */
+    uint32_t                     Bits;           /*!< Bus bits, stuff bits included */
+    uint32_t                     GapMin;         /*!< Shortest time between two frames, 0 before the second frame */
+    uint32_t                     GapMax;         /*!< Longest time between two frames */
+    uint32_t                     GapMean;        /*!< Average time between two frames */
+} MID_CAN_StatsIdType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Starts the statistics of an instance.
+ *
+ * Call after MID_CAN_Init. Installs the frame observer of the instance, so every frame of its Rx
+ * FIFO and of its mailboxes with an interrupt, and every error interrupt, is counted from the
+ * interrupt that handles it. The cost per frame is bounded: one frame length computation, at most
+ * MID_CAN_STATS_MAX_PROBES table reads and at most MID_CAN_STATS_SLOTS slot moves per window.
+ * The counters of the instance are cleared, its IDs keep their entry.
+ *
+ * @param[in]  Ins           The FlexCAN module instance.
+ * @param[in]  DumpPeriodMs  Period of the UART report of the instance, 0 for none. The report takes
+ *                           the transmitter callback of MID_CAN_STATS_UART.
+ */
+void MID_CAN_StatsInit(MID_CAN_ModuleIns_e Ins, uint32_t DumpPeriodMs);
+
+/**
+ * @brief  Sends the next line of the UART reports that are due.
+ *
+ * Called from the main loop. A report is one line per counter set and one line per ID, a line is
+ * sent when the previous one is out.
+ */
+void MID_CAN_StatsMainFunction(void);
+
+/**
+ * @brief  Gets the bus counters of an instance, the windows are moved to the current time.
+ *
+ * @param[in]  Ins    The FlexCAN module instance.
+ * @param[out] Stats  Counters.
+ *
+ * @return bool  false if the parameters are invalid or the statistics of Ins are not started.
+ */
+bool MID_CAN_StatsGetBus(MID_CAN_ModuleIns_e Ins, MID_CAN_StatsBusType *Stats);
+
+/**
+ * @brief  Gets the number of IDs seen, all instances together.
+ *
+ * @return uint8_t  Number of IDs, at most MID_CAN_STATS_MAX_IDS.
+ */
+uint8_t MID_CAN_StatsGetIdCount(void);
+
+/**
+ * @brief  Gets the counters of an ID.
+ *
+ * @param[in]  Index  0 to MID_CAN_StatsGetIdCount() - 1, IDs are in the order of their first frame.
+ * @param[out] Stats  Counters.
+ *
+ * @return bool  false if the parameters are invalid.
+ */
+bool MID_CAN_StatsGetId(uint8_t Index, MID_CAN_StatsIdType *Stats);
+
+/**
+ * @brief  Computes the length of a classic CAN frame on the bus.
+ *
+ * SOF to the end of the intermission, with the stuff bits the frame really gets: the CRC is
+ * computed and the stuffing is counted four bits at a time. A CAN FD frame is counted as a classic
+ * frame of at most 8 bytes.
+ *
+ * @param[in]  Record  Frame in message buffer layout.
+ *
+ * @return uint32_t  Length in bit times.
+ */
+uint32_t MID_CAN_StatsFrameBits(const volatile FlexCAN_MbStructureType *Record);
+
+#endif /* INCLUDE_MIDDLE_CANSTATS_H_ */
@@ -0,0 +1,153 @@
+/*
+ * MIDDLE_CanTp.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANTP_H_
+#define INCLUDE_MIDDLE_CANTP_H_
+
+#include "MIDDLE_FlexCAN.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_TP_MAX_CHANNELS         4U        /*!< Channels per instance */
+#define MID_CAN_TP_MAX_LENGTH           4095U     /*!< Largest message, 12-bit first frame length */
+#define MID_CAN_TP_NO_MB                0xFFU     /*!< Rx frames are handed over with MID_CAN_TpRxIndication */
+#define MID_CAN_TP_STMIN_US(Us)         ((uint8_t)(0xF0U + ((Us) / 100U)))  /*!< STmin of 100-900 us */
+
+/*==================================================================================================
+*                                        ENUMS
+==================================================================================================*/
+
+/**
+ * @brief Outcome of a transfer, given to the confirmation and indication callbacks.
+ */
+typedef enum
+{
+    MID_CAN_TP_OK                 = 0U,  /*!< Message sent or received completely */
+    MID_CAN_TP_TIMEOUT_BS,               /*!< Sender: no flow control within TimeoutMs */
+    MID_CAN_TP_TIMEOUT_CR,               /*!< Receiver: no consecutive frame within TimeoutMs */
+    MID_CAN_TP_WRONG_SN,                 /*!< Receiver: consecutive frame out of sequence */
+    MID_CAN_TP_UNEXPECTED_PDU,           /*!< Receiver: a new message started before the current one ended */
+    MID_CAN_TP_BUFFER_OVERFLOW,          /*!< Message longer than the buffer, on either side */
+    MID_CAN_TP_INVALID_FS,               /*!< Sender: flow control with an unknown flow status */
+    MID_CAN_TP_TIMEOUT_A                 /*!< Sender: a frame not sent within TimeoutMs, it was aborted */
+} MID_CAN_TpResult_e;
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief End of a transmission started with MID_CAN_TpTransmit.
+ *
+ * Called from the Tx mailbox interrupt or from MID_CAN_TpMainFunction. The data buffer given to
+ * MID_CAN_TpTransmit is free again.
+ */
+typedef void (*MID_CAN_TpTxConfirmationType)(MID_CAN_ModuleIns_e Ins, uint8_t Channel, MID_CAN_TpResult_e Result);
+
+/**
+ * @brief End of a reception.
+ *
+ * Called from the Rx path or from MID_CAN_TpMainFunction. On MID_CAN_TP_OK, Data points into the
+ * receive buffer of the channel, which is not written again before the next first or single frame.
+ * MID_CAN_TpSetRxBuffer can be called from the callback to receive the next message elsewhere.
+ *
+ * @param[in]  Data    Received message, NULL unless Result is MID_CAN_TP_OK.
+ * @param[in]  Length  Message length, 0 unless Result is MID_CAN_TP_OK.
+ */
+typedef void (*MID_CAN_TpRxIndicationType)(MID_CAN_ModuleIns_e Ins, uint8_t Channel, const uint8_t *Data,
+                                           uint16_t Length, MID_CAN_TpResult_e Result);
+
+/**
+ * @brief Channel configuration: one ISO 15765-2 connection between two nodes, full duplex.
+ *
+ * The node sends single, first and consecutive frames and its flow control on TxId, and gets the
+ * frames of the peer on RxId. Both sides use normal addressing.
+ */
+typedef struct
+{
+    uint32_t                     TxId;           /*!< ID of the frames sent by this node */
+    uint32_t                     RxId;           /*!< ID of the frames sent by the peer */
+    FlexCAN_MsgIDType_e          IdType;         /*!< Standard or extended IDs */
+    FlexCAN_MbIndex_e            TxMbIndex;      /*!< Tx mailbox owned by the channel */
+    uint8_t                      RxMbIndex;      /*!< Rx mailbox owned by the channel, or MID_CAN_TP_NO_MB */
+    uint8_t                      BlockSize;      /*!< BS sent to the peer, consecutive frames per flow control, 0 for all */
+    uint8_t                      STmin;          /*!< STmin sent to the peer: 0-127 ms, or MID_CAN_TP_STMIN_US(100-900) */
+    uint16_t                     TimeoutMs;      /*!< N_As, N_Bs and N_Cr */
+    bool                         IsPadded;       /*!< Always send 8 data bytes, filled with Padding */
+    uint8_t                      Padding;        /*!< Fill byte of padded frames */
+    uint8_t                    * RxBuffer;       /*!< First receive buffer, can be changed with MID_CAN_TpSetRxBuffer */
+    uint16_t                     RxBufferSize;   /*!< Size of RxBuffer */
+    MID_CAN_TpTxConfirmationType TxConfirmation; /*!< Can be NULL */
+    MID_CAN_TpRxIndicationType   RxIndication;   /*!< Can be NULL */
+} MID_CAN_TpChannelConfigType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Initializes the ISO-TP channels of an instance and their mailboxes.
+ *
+ * Must be called after MID_CAN_Init.
+ *
+ * @param[in]  Ins         The FlexCAN module instance.
+ * @param[in]  Channels    Channel table, must stay valid while the transport is used.
+ * @param[in]  NoOfChannels  1 to MID_CAN_TP_MAX_CHANNELS.
+ *
+ * @return bool  false if a parameter is invalid, the transport is then not active.
+ */
+bool MID_CAN_TpInit(MID_CAN_ModuleIns_e Ins, const MID_CAN_TpChannelConfigType *Channels, uint8_t NoOfChannels);
+
+/**
+ * @brief  Starts sending a message.
+ *
+ * The message is not copied: Data must stay valid until the Tx confirmation.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  Channel  Index of the channel.
+ * @param[in]  Data     Message.
+ * @param[in]  Length   1 to MID_CAN_TP_MAX_LENGTH bytes.
+ *
+ * @return bool  false if the channel is already sending or a parameter is invalid.
+ */
+bool MID_CAN_TpTransmit(MID_CAN_ModuleIns_e Ins, uint8_t Channel, const uint8_t *Data, uint16_t Length);
+
+/**
+ * @brief  Gives the buffer the next message of a channel is reassembled in.
+ *
+ * Consecutive frames are copied straight from the frame into this buffer.
+ *
+ * @return bool  false while a reception is in progress on the channel.
+ */
+bool MID_CAN_TpSetRxBuffer(MID_CAN_ModuleIns_e Ins, uint8_t Channel, uint8_t *Buffer, uint16_t Size);
+
+/**
+ * @brief  Changes the block size and STmin sent to the peer, from the next first frame on.
+ */
+void MID_CAN_TpSetRxParameters(MID_CAN_ModuleIns_e Ins, uint8_t Channel, uint8_t BlockSize, uint8_t STmin);
+
+/**
+ * @brief  Hands a received frame to the transport, for channels without an Rx mailbox.
+ *
+ * @return bool  true if the frame belongs to a channel of the instance.
+ */
+bool MID_CAN_TpRxIndication(MID_CAN_ModuleIns_e Ins, const FlexCAN_FrameType *Frame);
+
+/**
+ * @brief  Sends the consecutive frames held back by STmin and checks the timeouts.
+ *
+ * Without STmin, consecutive frames are sent from the Tx mailbox interrupt and the main function
+ * only watches the timeouts. STmin is kept to the resolution of the calls. A frame that stays in
+ * the Tx mailbox for TimeoutMs is aborted there, which frees the channel.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ */
+void MID_CAN_TpMainFunction(MID_CAN_ModuleIns_e Ins);
+
+#endif /* INCLUDE_MIDDLE_CANTP_H_ */
@@ -0,0 +1,100 @@
+/*
+ * MIDDLE_CanTxQueue.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_CANTXQUEUE_H_
+#define INCLUDE_MIDDLE_CANTXQUEUE_H_
+
+#include "MIDDLE_FlexCAN.h"
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_TX_QUEUE_LENGTH         16U   /*!< Frames waiting for a Tx mailbox, per instance */
+#define MID_CAN_TX_QUEUE_MAX_MB         8U    /*!< Maximum number of Tx mailboxes in a pool */
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Completion callback of a queued frame.
+ *
+ * Called from the FlexCAN MB interrupt once the frame has been sent on the bus.
+ *
+ * @param[in]  Id       ID of the sent frame.
+ * @param[in]  Context  Context given to MID_CAN_TxQueueSend.
+ */
+typedef void (*MID_CAN_TxDoneCallbackType)(uint32_t Id, void *Context);
+
+/**
+ * @brief Structure describing the Tx mailbox pool of a transmit queue.
+ */
+typedef struct
+{
+    const FlexCAN_MbIndex_e    * MbPool;     /*!< Tx mailboxes owned by the queue */
+    uint8_t                      NoOfMbs;    /*!< Number of mailboxes in MbPool, 1 to MID_CAN_TX_QUEUE_MAX_MB */
+} MID_CAN_TxQueueConfigType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Initializes the transmit queue of a FlexCAN module and its Tx mailbox pool.
+ *
+ * Must be called after MID_CAN_Init. The mailboxes of the pool must not be used by any other API.
+ *
+ * @param[in]  Ins     The FlexCAN module instance.
+ * @param[in]  Config  Tx mailbox pool, must stay valid while the queue is used.
+ */
+void MID_CAN_TxQueueInit(MID_CAN_ModuleIns_e Ins, const MID_CAN_TxQueueConfigType *Config);
+
+/**
+ * @brief  Queues a frame for transmission.
+ *
+ * Frames leave in CAN ID priority order, lowest ID first; frames with the same ID keep their order.
+ *
+ * @param[in]  Ins       The FlexCAN module instance.
+ * @param[in]  Frame     Frame to send, copied into the queue.
+ * @param[in]  Callback  Completion callback, may be NULL.
+ * @param[in]  Context   Context passed back to Callback.
+ *
+ * @return bool  true if the frame was queued, false if the queue is full.
+ */
+bool MID_CAN_TxQueueSend(MID_CAN_ModuleIns_e Ins, const FlexCAN_FrameType *Frame,
+                         MID_CAN_TxDoneCallbackType Callback, void *Context);
+
+/**
+ * @brief  Gets the number of frames waiting for a Tx mailbox.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ *
+ * @return uint8_t  Current queue depth.
+ */
+uint8_t MID_CAN_TxQueueGetDepth(MID_CAN_ModuleIns_e Ins);
+
+/**
+ * @brief  Gets the highest queue depth seen since MID_CAN_TxQueueInit.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ *
+ * @return uint8_t  Queue high-water mark, to size MID_CAN_TX_QUEUE_LENGTH.
+ */
+uint8_t MID_CAN_TxQueueGetHighWater(MID_CAN_ModuleIns_e Ins);
+
+/**
+ * @brief  Hands the queued frames to the free pool mailboxes again.
+ *
+ * The queue stops filling mailboxes while MID_CAN_HealthIsTxAllowed is false, the health monitor
+ * calls this function when the controller leaves bus-off.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ */
+void MID_CAN_TxQueueResume(MID_CAN_ModuleIns_e Ins);
+
+#endif /* INCLUDE_MIDDLE_CANTXQUEUE_H_ */
@@ -10,6 +10,49 @@
 
 #include "FlexCAN.h"
 
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+#define MID_CAN_BIT_RATE                500000U   /*!< Nominal bit rate set by MID_CAN_Init */
+
+/**
+ * @brief Mailbox layout entries, every field is a constant expression so the table stays in flash.
+ *
+ * An application lists its mailboxes once as an X-macro and expands it with MID_CAN_MB_LAYOUT_ENTRY:
+ *
+ *   #define APP_MB_LAYOUT(X) \
+ *       X(RX, MB2, 0x55U, FlexCAN_STANDARD, MID_CAN_MB_EXACT_MASK, App_Request) \
+ *       X(TX, MB8, 0x56U, FlexCAN_STANDARD, 1U, NULL)
+ *
+ *   static const FlexCAN_MbLayoutType App_MbLayout[] = { APP_MB_LAYOUT(MID_CAN_MB_LAYOUT_ENTRY) };
+ *
+ * The fifth field is the Rx mask of RX entries and the data length of the others. REMOTE entries
+ * send a remote request with MID_CAN_Transmit, ANSWER entries answer the remote requests for their
+ * ID with no CPU involvement once MID_CAN_SetAnswerData gave them a payload. A mailbox with a
+ * handler gets its interrupt enabled, NULL leaves it polled.
+ */
+#define MID_CAN_MB_EXACT_MASK           0x1FFFFFFFU  /*!< Rx mask comparing every ID bit */
+
+#define MID_CAN_MB_RX(MbIdx, MbId, MbIdType, Mask, Handler) \
+    { .MbIndex = (MbIdx), .Cs = FLEXCAN_MB_CS(Rx_CODE_EMPTY, (MbIdType), 0U), .Id = FLEXCAN_MB_ID((MbId), (MbIdType)), \
+      .RxMask = FLEXCAN_MB_ID((Mask), (MbIdType)), .Callback = (Handler), .Context = NULL }
+
+#define MID_CAN_MB_TX(MbIdx, MbId, MbIdType, DataLen, Handler) \
+    { .MbIndex = (MbIdx), .Cs = FLEXCAN_MB_CS(Tx_CODE_INACTIVE, (MbIdType), (DataLen)), .Id = FLEXCAN_MB_ID((MbId), (MbIdType)), \
+      .RxMask = 0U, .Callback = (Handler), .Context = NULL }
+
+#define MID_CAN_MB_REMOTE(MbIdx, MbId, MbIdType, DataLen, Handler) \
+    { .MbIndex = (MbIdx), .Cs = FLEXCAN_MB_CS(Tx_CODE_INACTIVE, (MbIdType), (DataLen)) | FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK, \
+      .Id = FLEXCAN_MB_ID((MbId), (MbIdType)), .RxMask = 0U, .Callback = (Handler), .Context = NULL }
+
+#define MID_CAN_MB_ANSWER(MbIdx, MbId, MbIdType, DataLen, Handler) \
+    { .MbIndex = (MbIdx), .Cs = FLEXCAN_MB_CS(Tx_CODE_INACTIVE, (MbIdType), (DataLen)), .Id = FLEXCAN_MB_ID((MbId), (MbIdType)), \
+      .RxMask = FLEXCAN_MB_ID(MID_CAN_MB_EXACT_MASK, (MbIdType)), .Callback = (Handler), .Context = NULL }
+
+#define MID_CAN_MB_LAYOUT_ENTRY(Direction, MbIdx, MbId, MbIdType, MaskOrDataLen, Handler) \
+    MID_CAN_MB_##Direction(MbIdx, MbId, MbIdType, MaskOrDataLen, Handler),
+
 /*==================================================================================================
 *                                        ENUMS
 ==================================================================================================*/
@@ -76,6 +119,17 @@ typedef enum
 *                                       STRUCTURES
 ==================================================================================================*/
 
+/**
+ * @brief Latest value counters of one Tx message buffer, see MID_CAN_AbortTx.
+ *
+ * Replaced - Aborted is the number of stale frames that still went out.
+ */
+typedef struct
+{
+    uint32_t                     Replaced;     /*!< Pending frames given up for a newer one */
+    uint32_t                     Aborted;      /*!< Of these, frames taken back before the bus */
+} MID_CAN_TxLatestStatsType;
+
 /**
  * @brief Structure to hold user-specific configuration for FlexCAN message buffer.
  *
@@ -86,15 +140,56 @@ typedef struct
 {
     FlexCAN_MbIndex_e            MbIndex;      /*!< Message buffer index */
     uint32_t                     MbID;         /*!< Message buffer ID */
+    uint8_t                      DataLen;      /*!< Data length code used by MID_CAN_Transmit, 0-8 */
     bool                         MbInt;        /*!< Message buffer interrupt enable flag */
     FlexCAN_CallbackType         HandlerFunc;  /*!< Callback function for message buffer */
+    void                       * Context;      /*!< Passed back to HandlerFunc */
     MID_CAN_Handler_e            HandlerType;  /*!< Handler type (e.g., message buffer or error handler) */
 } MID_CAN_UserConfigType;
 
+/**
+ * @brief Mailbox asked from the allocator, see MID_CAN_MbAlloc.
+ */
+typedef struct
+{
+    FlexCAN_MbType_e             MbType;       /*!< FlexCAN_MB_RX or FlexCAN_MB_TX */
+    uint32_t                     Id;           /*!< Rx filter ID or Tx ID */
+    FlexCAN_MsgIDType_e          IdType;       /*!< Standard or extended ID */
+    uint32_t                     Mask;         /*!< Rx only: ID bits compared, MID_CAN_MB_EXACT_MASK for one ID */
+    uint8_t                      DataLen;      /*!< Tx only: data length code used by MID_CAN_Transmit, 0-8 */
+    FlexCAN_CallbackType         HandlerFunc;  /*!< Mailbox interrupt callback, NULL leaves the mailbox polled */
+    void                       * Context;      /*!< Passed back to HandlerFunc */
+} MID_CAN_MbRequestType;
+
 /*==================================================================================================
 *                                     FUNCTION PROTOTYPES
 ==================================================================================================*/
 
+/**
+ * @brief  Selects the Rx FIFO configuration used by the next MID_CAN_Init of an instance.
+ *
+ * @param[in]  Ins           The FlexCAN module instance.
+ * @param[in]  RxFifoConfig  Rx FIFO configuration, NULL keeps MB0-MB7 as regular mailboxes.
+ *                           The structure and its ring buffer must stay valid while the module runs.
+ */
+void MID_CAN_SetRxFifoConfig(MID_CAN_ModuleIns_e Ins, FlexCAN_RxFifoConfigType *RxFifoConfig);
+
+/**
+ * @brief  Selects the CAN FD configuration used by the next MID_CAN_Init of an instance.
+ *
+ * @param[in]  Ins       The FlexCAN module instance (CAN FD is only available on MODULE_0_INS).
+ * @param[in]  FdConfig  CAN FD configuration, NULL keeps classic CAN.
+ */
+void MID_CAN_SetFdConfig(MID_CAN_ModuleIns_e Ins, FlexCAN_FdConfigType *FdConfig);
+
+/**
+ * @brief  Selects the operating mode used by the next MID_CAN_Init of an instance.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  RunMode  Operating mode, FlexCAN_MODE_NORMAL until this function is called.
+ */
+void MID_CAN_SetRunMode(MID_CAN_ModuleIns_e Ins, FlexCAN_Mode_e RunMode);
+
 /**
  * @brief  Initializes the specified FlexCAN module.
  *
@@ -109,6 +204,19 @@ void MID_CAN_Init(MID_CAN_ModuleIns_e Ins);
  */
 void MID_CAN_DeInit(MID_CAN_ModuleIns_e Ins);
 
+/**
+ * @brief  Selects the mailbox layout applied by the next MID_CAN_Init of an instance.
+ *
+ * The layout is written in the freeze mode window of the init, with one store per header word,
+ * and the NVIC line of each MB interrupt group is enabled once. Middleware modules (COM, ISO-TP,
+ * Tx queue) keep setting up their own mailboxes after the init.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  Layout   Mailbox table, usually const, must stay valid while the module runs. NULL for none.
+ * @param[in]  NoOfMbs  Number of elements in Layout.
+ */
+void MID_CAN_SetMbLayout(MID_CAN_ModuleIns_e Ins, const FlexCAN_MbLayoutType *Layout, uint8_t NoOfMbs);
+
 /**
  * @brief  Sets the callback function for a specific FlexCAN module and message buffer.
  *
@@ -133,6 +241,94 @@ void MID_CAN_StdTxMbInit(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserCo
  */
 void MID_CAN_StdRxMbInit(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserConfig);
 
+/**
+ * @brief  Initializes consecutive receive message buffers from an ID + mask filter table.
+ *
+ * The table is usually computed by MID_CAN_FilterPlan; all filters are programmed in one
+ * freeze mode session and share the same callback.
+ *
+ * @param[in]  Ins          The FlexCAN module instance.
+ * @param[in]  FirstMb      First message buffer of the filter block.
+ * @param[in]  Filters      Filter table, one message buffer per filter.
+ * @param[in]  NoOfFilters  Number of filters.
+ * @param[in]  UserConfig   Interrupt enable flag and callback of the message buffers,
+ *                          MbIndex, MbID and HandlerType are not used.
+ *
+ * @return bool  true if the filters were programmed, false otherwise.
+ */
+bool MID_CAN_RxFilterInit(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e FirstMb, const FlexCAN_RxFilterType *Filters,
+                          uint8_t NoOfFilters, const MID_CAN_UserConfigType *UserConfig);
+
+/**
+ * @brief  Sets up the lowest free message buffer for an Rx filter or a Tx ID.
+ *
+ * The handle is the message buffer index, used with the other MID_CAN functions. Message buffers
+ * in use stay packed at the bottom, after the Rx FIFO area, and MCR[MAXMB] follows the highest one
+ * so the Rx matching and the Tx arbitration only scan what is configured. The other setup
+ * functions keep MAXMB up to date the same way. An Rx mailbox, or a MAXMB change, goes through
+ * freeze mode: frames on the bus during that window are missed, allocate at startup when possible.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  Request  ID and properties of the mailbox.
+ * @param[out] MbIndex  Handle of the mailbox.
+ *
+ * @return bool  false if no message buffer is free or Request is invalid.
+ */
+bool MID_CAN_MbAlloc(MID_CAN_ModuleIns_e Ins, const MID_CAN_MbRequestType *Request, FlexCAN_MbIndex_e *MbIndex);
+
+/**
+ * @brief  Releases a message buffer, a pending frame is aborted first. MAXMB shrinks if it was the
+ *         highest one in use.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  Handle from MID_CAN_MbAlloc, or any active message buffer.
+ */
+void MID_CAN_MbFree(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex);
+
+/**
+ * @brief  Gets the MCR[MAXMB] value set by the middleware: the highest message buffer in use, or
+ *         the end of the Rx FIFO area.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ *
+ * @return uint8_t  Last message buffer scanned by the Rx matching and the Tx arbitration.
+ */
+uint8_t MID_CAN_GetMaxMb(MID_CAN_ModuleIns_e Ins);
+
+/**
+ * @brief  Transmits a frame by CAN ID, over the Tx mailbox set up with that ID.
+ *
+ * Every mailbox setup (layout, MID_CAN_MbAlloc, the Std and filter init functions) rebuilds a
+ * perfect hash table of the mailbox IDs of all instances, so the lookup is a few reads whatever the
+ * number of mailboxes and is safe from interrupt context. When several Tx mailboxes carry the same
+ * ID the lowest one is used; remote request, remote answer and Rx range mailboxes are not in the
+ * table, nor are IDs past the first MID_CAN_IDMAP_MAX_KEYS of a direction. Send each ID from one
+ * context only, the mailbox is checked idle before the frame is written.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  Id       Standard (11-bit) or extended (29-bit) ID.
+ * @param[in]  IdType   Message ID type.
+ * @param[in]  Data     Payload, NULL if DataLen is 0.
+ * @param[in]  DataLen  Payload length, 0 to 8.
+ *
+ * @return bool  false if no Tx mailbox has the ID or its previous frame is still pending.
+ */
+bool MID_CAN_SendId(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType, const uint8_t *Data, uint8_t DataLen);
+
+/**
+ * @brief  Receives the frame of an Rx mailbox found by CAN ID, see MID_CAN_SendId for the lookup.
+ *
+ * Only Rx mailboxes whose mask compares every ID bit are found.
+ *
+ * @param[in]  Ins     The FlexCAN module instance.
+ * @param[in]  Id      Standard (11-bit) or extended (29-bit) ID.
+ * @param[in]  IdType  Message ID type.
+ * @param[out] Frame   Frame to fill, like MID_CAN_ReceiveFrame.
+ *
+ * @return bool  false if no Rx mailbox has the ID.
+ */
+bool MID_CAN_ReadId(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType, FlexCAN_FrameType *Frame);
+
 /**
  * @brief  Transmits data over the specified message buffer.
  *
@@ -151,6 +347,134 @@ void MID_CAN_Transmit(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, uint8_
  */
 void MID_CAN_Receive(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, uint8_t *RxBuffer);
 
+/**
+ * @brief  Transmits a whole frame (ID, DLC 0-8 and payload) over the specified message buffer.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  The message buffer index for transmission.
+ * @param[in]  Frame    Frame to send.
+ */
+void MID_CAN_TransmitFrame(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, const FlexCAN_FrameType *Frame);
+
+/**
+ * @brief  Transmits a frame, latest value wins: a frame still pending in the message buffer is
+ *         aborted first, so only the newest value waits for the bus.
+ *
+ * Waits for the abort acknowledge, at most the frame already on the bus. The frame is never
+ * written into a message buffer that is still pending, on FLEXCAN_TX_ABORT_TIMEOUT it is dropped.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  The message buffer index for transmission.
+ * @param[in]  Frame    Frame to send.
+ *
+ * @return FlexCAN_TxAbort_e  What happened to the frame it replaced.
+ */
+FlexCAN_TxAbort_e MID_CAN_TransmitLatest(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, const FlexCAN_FrameType *Frame);
+
+/**
+ * @brief  Aborts the frame pending in a Tx message buffer, the first half of MID_CAN_TransmitLatest
+ *         for callers that build the new frame once the old one is gone.
+ *
+ * Waits for the abort acknowledge with only the message buffer interrupt masked, at most the frame
+ * already on the bus and never more than the driver timeout. Counts the replacement in the latest value counters of
+ * the message buffer, a timeout is not counted.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  The message buffer index.
+ *
+ * @return FlexCAN_TxAbort_e  FLEXCAN_TX_ABORT_DONE if the pending frame will never be sent.
+ */
+FlexCAN_TxAbort_e MID_CAN_AbortTx(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex);
+
+/**
+ * @brief  Gets the latest value counters of a Tx message buffer, reset by MID_CAN_Init.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  The message buffer index.
+ * @param[out] Stats    Counters.
+ */
+void MID_CAN_GetTxLatestStats(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, MID_CAN_TxLatestStatsType *Stats);
+
+/**
+ * @brief  Loads the payload sent by a remote answer mailbox, an ANSWER layout entry.
+ *
+ * From the first call on, the controller answers every remote request with the ID of the mailbox
+ * by itself. An answer is never a mix of two payloads, a request received during the update is not
+ * answered.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  The remote answer message buffer index.
+ * @param[in]  Data     New payload.
+ * @param[in]  DataLen  Payload length, 0 to 8.
+ *
+ * @return bool  false if the message buffer is inactive or not a remote answer one.
+ */
+bool MID_CAN_SetAnswerData(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, const uint8_t *Data, uint8_t DataLen);
+
+/**
+ * @brief  Receives a whole frame (ID, DLC, timestamp and payload) from the specified message buffer.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  The message buffer index for reception.
+ * @param[out] Frame    Frame to fill.
+ *
+ * @return bool  true if the frame was read, false if the message buffer is inactive.
+ */
+bool MID_CAN_ReceiveFrame(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, FlexCAN_FrameType *Frame);
+
+/**
+ * @brief  Transmits a CAN FD frame of up to 64 bytes over the specified message buffer.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  The message buffer index for transmission.
+ * @param[in]  Frame    Frame to send.
+ */
+void MID_CAN_TransmitFdFrame(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, const FlexCAN_FdFrameType *Frame);
+
+/**
+ * @brief  Receives a CAN FD frame of up to 64 bytes from the specified message buffer.
+ *
+ * @param[in]  Ins      The FlexCAN module instance.
+ * @param[in]  MbIndex  The message buffer index for reception.
+ * @param[out] Frame    Frame to fill.
+ *
+ * @return bool  true if the frame was read, false if the message buffer is inactive.
+ */
+bool MID_CAN_ReceiveFdFrame(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, FlexCAN_FdFrameType *Frame);
+
+/**
+ * @brief  Takes the oldest frame out of the Rx FIFO ring of the FlexCAN module.
+ *
+ * @param[in]  Ins    The FlexCAN module instance.
+ * @param[out] Frame  Received frame.
+ *
+ * @return bool  true if a frame was read, false if the ring is empty.
+ */
+bool MID_CAN_RxFifoRead(MID_CAN_ModuleIns_e Ins, FlexCAN_FrameType *Frame);
+
+/**
+ * @brief  Selects how a group of Rx mailboxes is served: interrupt, polling or adaptive.
+ *
+ * Call after MID_CAN_Init and the mailbox setup. In adaptive mode the first Rx interrupt of the
+ * group masks its interrupts and MID_CAN_RxPoll serves the frames that follow, until the traffic
+ * drops: the interrupt entry and exit are paid once per burst instead of once per frame.
+ *
+ * @param[in]  Ins     The FlexCAN module instance.
+ * @param[in]  Config  Receive mode and thresholds, see FlexCAN_RxPollConfigType.
+ *
+ * @return bool  false if Config is invalid.
+ */
+bool MID_CAN_SetRxMode(MID_CAN_ModuleIns_e Ins, const FlexCAN_RxPollConfigType *Config);
+
+/**
+ * @brief  Serves the raised mailboxes of the polled group, called from the main loop or a timer.
+ *
+ * @param[in]  Ins  The FlexCAN module instance.
+ *
+ * @return uint8_t  Number of mailboxes served, 0 while the interrupts serve the group.
+ */
+uint8_t MID_CAN_RxPoll(MID_CAN_ModuleIns_e Ins);
+
 /**
  * @brief  Gets the acknowledgment status of the FlexCAN module.
  *
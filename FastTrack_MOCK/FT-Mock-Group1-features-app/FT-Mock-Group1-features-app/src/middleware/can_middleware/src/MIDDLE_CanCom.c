@@ -0,0 +1,516 @@
+/*
+ * MIDDLE_CanCom.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanCom.h"
+#include "MIDDLE_CanHealth.h"
+#include "s32_core_cm4.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define COM_BITS_PER_BYTE				(8U)
+#define COM_PDU_BITS					(MID_CAN_COM_PDU_MAX_LEN * COM_BITS_PER_BYTE)
+
+/**
+ * Where a signal sits in the 64-bit view of its PDU. Little endian signals use the PDU word with
+ * byte 0 in the low bits, big endian signals the byte-reversed word, so every signal is one
+ * contiguous bit field and packing is a single mask and shift.
+ */
+typedef struct
+{
+	uint64_t					Mask;			/*!< Signal bits in the view */
+	uint64_t					UpdateMask;		/*!< Update bit in the PDU word, 0 if none */
+	uint8_t						Shift;			/*!< Position of the signal LSB in the view */
+	uint8_t						MinDataLen;		/*!< PDU length needed to carry the whole signal */
+	bool						IsBigEndian;	/*!< Use the byte-reversed view */
+} Com_SignalLayoutType;
+
+typedef struct
+{
+	uint64_t					Data;			/*!< Payload, byte 0 in the low bits */
+	uint64_t					UpdateMask;		/*!< Tx: update bits of all signals of the PDU */
+	uint64_t					SentUpdates;	/*!< Tx: update bits set in the frame last written to the mailbox */
+	uint8_t						Slot;			/*!< Tx: scheduler slot */
+	uint8_t						DataLen;		/*!< Rx: length of the last received frame */
+	bool						IsReceived;		/*!< Rx: received at least once */
+	MID_CAN_E2EStateType		E2E;			/*!< Alive counter of a protected PDU */
+} Com_PduStateType;
+
+typedef struct
+{
+	const MID_CAN_ComConfigType * Config;
+	Com_SignalLayoutType		Layout[MID_CAN_COM_MAX_SIGNALS];
+	Com_PduStateType			Pdu[MID_CAN_COM_MAX_PDUS];
+} Com_StateType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+/**
+ * COM state of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static Com_StateType Com_State[FLEXCAN_INSTANCE_COUNT];
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static bool Com_CheckPdu(const MID_CAN_ComPduType *Pdu);
+static bool Com_BuildLayout(const MID_CAN_ComSignalType *Signal, const MID_CAN_ComPduType *Pdu, Com_SignalLayoutType *Layout);
+static uint64_t Com_Swap64(uint64_t Value);
+static uint64_t Com_BytesToWord(const uint8_t *Bytes, uint8_t DataLen);
+static bool Com_Transmit(MID_CAN_ModuleIns_e Ins, uint8_t PduIndex);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+bool MID_CAN_ComInit(MID_CAN_ModuleIns_e Ins, const MID_CAN_ComConfigType *Config)
+{
+	Com_StateType *Com = &Com_State[Ins];
+	const MID_CAN_ComPduType *Pdu = NULL;
+	bool IsValid = false;
+	uint8_t Index = 0U;
+
+	MID_CAN_UserConfigType UserConfig = {
+			.MbInt = false,
+			.HandlerFunc = NULL,
+			.Context = NULL
+	};
+
+	MID_CAN_SchedSlotConfigType SlotConfig = {
+			.Ins = Ins,
+			.OffsetMs = MID_CAN_SCHED_AUTO_OFFSET,
+			.TxFunc = Com_Transmit
+	};
+
+	Com->Config = NULL;
+
+	if(Config == NULL || Config->Pdus == NULL || Config->Signals == NULL
+	   || Config->NoOfPdus == 0U || Config->NoOfPdus > MID_CAN_COM_MAX_PDUS
+	   || Config->NoOfSignals == 0U || Config->NoOfSignals > MID_CAN_COM_MAX_SIGNALS)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		IsValid = true;
+
+		for(Index = 0U; Index < Config->NoOfPdus && IsValid == true; Index++)
+		{
+			IsValid = Com_CheckPdu(&Config->Pdus[Index]);
+
+			Com->Pdu[Index].Data = 0U;
+			Com->Pdu[Index].UpdateMask = 0U;
+			Com->Pdu[Index].SentUpdates = 0U;
+			Com->Pdu[Index].DataLen = 0U;
+			Com->Pdu[Index].IsReceived = false;
+			MID_CAN_E2EResetState(&Com->Pdu[Index].E2E);
+		}
+
+		/* Masks and shifts are computed once, reads and writes only apply them */
+		for(Index = 0U; Index < Config->NoOfSignals && IsValid == true; Index++)
+		{
+			IsValid = (Config->Signals[Index].PduIndex < Config->NoOfPdus)
+			          && Com_BuildLayout(&Config->Signals[Index], &Config->Pdus[Config->Signals[Index].PduIndex], &Com->Layout[Index]);
+
+			if(IsValid == true)
+			{
+				Com->Pdu[Config->Signals[Index].PduIndex].UpdateMask |= Com->Layout[Index].UpdateMask;
+			}
+		}
+
+		for(Index = 0U; Index < Config->NoOfPdus && IsValid == true; Index++)
+		{
+			Pdu = &Config->Pdus[Index];
+
+			if(Pdu->Direction == MID_CAN_COM_TX)
+			{
+				UserConfig.MbIndex = Pdu->MbIndex;
+				UserConfig.MbID = Pdu->Id;
+				UserConfig.DataLen = Pdu->DataLen;
+				UserConfig.HandlerType = (MID_CAN_Handler_e)Pdu->MbIndex;
+				MID_CAN_StdTxMbInit(Ins, &UserConfig);
+
+				/* Timing belongs to the scheduler, a TRIGGERED PDU has no cycle */
+				SlotConfig.PeriodMs = (Pdu->TxMode == MID_CAN_COM_TRIGGERED) ? 0U : Pdu->CycleMs;
+				SlotConfig.MinDelayMs = Pdu->MinDelayMs;
+				SlotConfig.Handle = Index;
+				Com->Pdu[Index].Slot = MID_CAN_SchedAdd(&SlotConfig);
+				IsValid = (Com->Pdu[Index].Slot != MID_CAN_SCHED_INVALID_SLOT);
+			}
+		}
+
+		/* The scheduler may call Com_Transmit from now on */
+		Com->Config = (IsValid == true) ? Config : NULL;
+	}
+
+	return IsValid;
+}
+
+bool MID_CAN_ComSendSignal(MID_CAN_ModuleIns_e Ins, uint8_t SignalId, int32_t Value)
+{
+	Com_StateType *Com = &Com_State[Ins];
+	const MID_CAN_ComSignalType *Signal = NULL;
+	const Com_SignalLayoutType *Layout = NULL;
+	Com_PduStateType *PduState = NULL;
+	bool IsWritten = false;
+	int64_t Raw = 0;
+	int64_t RawMin = 0;
+	int64_t RawMax = 0;
+	uint64_t View = 0U;
+
+	if(Com->Config == NULL || SignalId >= Com->Config->NoOfSignals
+	   || Com->Config->Pdus[Com->Config->Signals[SignalId].PduIndex].Direction != MID_CAN_COM_TX)
+	{
+		/* Invalid parameters or layer not initialized */
+	}
+	else
+	{
+		Signal = &Com->Config->Signals[SignalId];
+		Layout = &Com->Layout[SignalId];
+		PduState = &Com->Pdu[Signal->PduIndex];
+
+		/* Physical to raw, clamped to what the signal can carry */
+		Raw = (((int64_t)Value - Signal->Offset) * Signal->Divisor) / Signal->Factor;
+		RawMax = (Signal->IsSigned == true) ? (((int64_t)1 << (Signal->Length - 1U)) - 1) : (((int64_t)1 << Signal->Length) - 1);
+		RawMin = (Signal->IsSigned == true) ? (-RawMax - 1) : 0;
+		Raw = (Raw > RawMax) ? RawMax : ((Raw < RawMin) ? RawMin : Raw);
+
+		/* The scheduler tick sends the same PDU */
+		DISABLE_INTERRUPTS();
+
+		View = (Layout->IsBigEndian == true) ? Com_Swap64(PduState->Data) : PduState->Data;
+		View = (View & ~Layout->Mask) | (((uint64_t)Raw << Layout->Shift) & Layout->Mask);
+		PduState->Data = ((Layout->IsBigEndian == true) ? Com_Swap64(View) : View) | Layout->UpdateMask;
+
+		ENABLE_INTERRUPTS();
+
+		if(Signal->IsTriggered == true && Com->Config->Pdus[Signal->PduIndex].TxMode != MID_CAN_COM_CYCLIC)
+		{
+			MID_CAN_SchedTrigger(PduState->Slot);
+		}
+
+		IsWritten = true;
+	}
+
+	return IsWritten;
+}
+
+bool MID_CAN_ComReceiveSignal(MID_CAN_ModuleIns_e Ins, uint8_t SignalId, int32_t *Value)
+{
+	Com_StateType *Com = &Com_State[Ins];
+	const MID_CAN_ComSignalType *Signal = NULL;
+	const Com_SignalLayoutType *Layout = NULL;
+	const Com_PduStateType *PduState = NULL;
+	bool IsRead = false;
+	uint64_t Data = 0U;
+	uint8_t DataLen = 0U;
+	int64_t Raw = 0;
+
+	if(Com->Config == NULL || Value == NULL || SignalId >= Com->Config->NoOfSignals
+	   || Com->Config->Pdus[Com->Config->Signals[SignalId].PduIndex].Direction != MID_CAN_COM_RX)
+	{
+		/* Invalid parameters or layer not initialized */
+	}
+	else
+	{
+		Signal = &Com->Config->Signals[SignalId];
+		Layout = &Com->Layout[SignalId];
+		PduState = &Com->Pdu[Signal->PduIndex];
+
+		/* Length and data of the same frame */
+		DISABLE_INTERRUPTS();
+
+		Data = PduState->Data;
+		DataLen = (PduState->IsReceived == true) ? PduState->DataLen : 0U;
+
+		ENABLE_INTERRUPTS();
+
+		if(DataLen < Layout->MinDataLen || (Layout->UpdateMask != 0U && (Data & Layout->UpdateMask) == 0U))
+		{
+			/* Not received, frame too short or value not updated by the sender */
+		}
+		else
+		{
+			Data = (Layout->IsBigEndian == true) ? Com_Swap64(Data) : Data;
+			Raw = (int64_t)((Data & Layout->Mask) >> Layout->Shift);
+
+			if(Signal->IsSigned == true && (Raw & ((int64_t)1 << (Signal->Length - 1U))) != 0)
+			{
+				Raw -= ((int64_t)1 << Signal->Length);
+			}
+
+			*Value = (int32_t)(((Raw * Signal->Factor) / Signal->Divisor) + Signal->Offset);
+			IsRead = true;
+		}
+	}
+
+	return IsRead;
+}
+
+void MID_CAN_ComTriggerTransmit(MID_CAN_ModuleIns_e Ins, uint8_t PduIndex)
+{
+	Com_StateType *Com = &Com_State[Ins];
+
+	if(Com->Config == NULL || PduIndex >= Com->Config->NoOfPdus || Com->Config->Pdus[PduIndex].Direction != MID_CAN_COM_TX)
+	{
+		/* Invalid parameters or layer not initialized */
+	}
+	else
+	{
+		MID_CAN_SchedTrigger(Com->Pdu[PduIndex].Slot);
+	}
+}
+
+bool MID_CAN_ComRxIndication(MID_CAN_ModuleIns_e Ins, const FlexCAN_FrameType *Frame)
+{
+	Com_StateType *Com = &Com_State[Ins];
+	const MID_CAN_ComPduType *Pdu = NULL;
+	Com_PduStateType *PduState = NULL;
+	bool IsAccepted = false;
+	uint8_t Index = 0U;
+
+	if(Com->Config == NULL || Frame == NULL)
+	{
+		/* Invalid parameters or layer not initialized */
+	}
+	else
+	{
+		for(Index = 0U; Index < Com->Config->NoOfPdus && IsAccepted == false; Index++)
+		{
+			Pdu = &Com->Config->Pdus[Index];
+			IsAccepted = (Pdu->Direction == MID_CAN_COM_RX && Pdu->Id == Frame->Id && Pdu->IdType == Frame->IdType);
+		}
+
+		if(IsAccepted == true && Pdu->E2E != NULL
+		   && MID_CAN_E2ECheck(Pdu->E2E, &Com->Pdu[Index - 1U].E2E, Frame->Data.Byte, Frame->DataLen) != MID_CAN_E2E_OK)
+		{
+			/* Corrupted, repeated or out of sequence, the last good data stays */
+		}
+		else if(IsAccepted == true)
+		{
+			PduState = &Com->Pdu[Index - 1U];
+
+			/* Frames are also handed over from mailbox interrupts */
+			DISABLE_INTERRUPTS();
+
+			PduState->Data = Com_BytesToWord(Frame->Data.Byte, Frame->DataLen);
+			PduState->DataLen = Frame->DataLen;
+			PduState->IsReceived = true;
+
+			ENABLE_INTERRUPTS();
+
+			if(Pdu->RxNotification != NULL)
+			{
+				Pdu->RxNotification(Ins, Index - 1U);
+			}
+		}
+		else
+		{
+			/* Not a PDU of this node */
+		}
+	}
+
+	return IsAccepted;
+}
+
+bool MID_CAN_ComGetTxStats(MID_CAN_ModuleIns_e Ins, uint8_t PduIndex, MID_CAN_SchedStatsType *Stats)
+{
+	Com_StateType *Com = &Com_State[Ins];
+	bool IsValid = false;
+
+	if(Com->Config == NULL || PduIndex >= Com->Config->NoOfPdus || Com->Config->Pdus[PduIndex].Direction != MID_CAN_COM_TX)
+	{
+		/* Invalid parameters or layer not initialized */
+	}
+	else
+	{
+		IsValid = MID_CAN_SchedGetStats(Com->Pdu[PduIndex].Slot, Stats);
+	}
+
+	return IsValid;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static bool Com_CheckPdu(const MID_CAN_ComPduType *Pdu)
+{
+	bool IsValid = (Pdu->DataLen > 0U && Pdu->DataLen <= MID_CAN_COM_PDU_MAX_LEN);
+
+	if(Pdu->E2E != NULL)
+	{
+		IsValid = IsValid && MID_CAN_E2ECheckConfig(Pdu->E2E) && Pdu->E2E->DataLen <= Pdu->DataLen;
+	}
+
+	if(Pdu->Direction == MID_CAN_COM_TX)
+	{
+		IsValid = IsValid && Pdu->MbIndex <= MB31
+		          && (Pdu->TxMode == MID_CAN_COM_TRIGGERED || Pdu->CycleMs > 0U)
+		          && (Pdu->IsAnswered == false || (Pdu->AnswerMbIndex <= MB31 && Pdu->AnswerMbIndex != Pdu->MbIndex));
+	}
+
+	return IsValid;
+}
+
+static bool Com_BuildLayout(const MID_CAN_ComSignalType *Signal, const MID_CAN_ComPduType *Pdu, Com_SignalLayoutType *Layout)
+{
+	bool IsValid = false;
+	uint8_t MsbPos = 0U;
+	uint8_t LastByte = 0U;
+
+	if(Signal->Length == 0U || Signal->Length > MID_CAN_COM_SIGNAL_MAX_LEN || Signal->StartBit >= COM_PDU_BITS
+	   || Signal->Factor == 0 || Signal->Divisor == 0
+	   || (Signal->UpdateBit != MID_CAN_COM_NO_UPDATE_BIT && Signal->UpdateBit >= (Pdu->DataLen * COM_BITS_PER_BYTE)))
+	{
+		/* Invalid descriptor */
+	}
+	else if(Signal->Endian == MID_CAN_COM_LITTLE_ENDIAN)
+	{
+		/* Bit n of the PDU is bit n of the word */
+		if((Signal->StartBit + Signal->Length) <= COM_PDU_BITS)
+		{
+			Layout->Shift = Signal->StartBit;
+			LastByte = (Signal->StartBit + Signal->Length - 1U) / COM_BITS_PER_BYTE;
+			IsValid = true;
+		}
+	}
+	else
+	{
+		/* Byte k of the PDU is byte 7 - k of the reversed word, bit numbers inside a byte are kept */
+		MsbPos = ((MID_CAN_COM_PDU_MAX_LEN - 1U - (Signal->StartBit / COM_BITS_PER_BYTE)) * COM_BITS_PER_BYTE)
+		         + (Signal->StartBit % COM_BITS_PER_BYTE);
+
+		if((MsbPos + 1U) >= Signal->Length)
+		{
+			Layout->Shift = MsbPos + 1U - Signal->Length;
+			LastByte = MID_CAN_COM_PDU_MAX_LEN - 1U - (Layout->Shift / COM_BITS_PER_BYTE);
+			IsValid = true;
+		}
+	}
+
+	if(IsValid == true)
+	{
+		Layout->Mask = (((uint64_t)1 << Signal->Length) - 1U) << Layout->Shift;
+		Layout->UpdateMask = (Signal->UpdateBit == MID_CAN_COM_NO_UPDATE_BIT) ? 0U : ((uint64_t)1 << Signal->UpdateBit);
+		Layout->MinDataLen = LastByte + 1U;
+		Layout->IsBigEndian = (Signal->Endian == MID_CAN_COM_BIG_ENDIAN);
+
+		/* The signal must fit the PDU it is declared in */
+		IsValid = (Layout->MinDataLen <= Pdu->DataLen);
+	}
+
+	return IsValid;
+}
+
+static uint64_t Com_Swap64(uint64_t Value)
+{
+	uint32_t High = 0U;
+	uint32_t Low = 0U;
+
+	REV_BYTES_32((uint32_t)Value, High);
+	REV_BYTES_32((uint32_t)(Value >> 32U), Low);
+
+	return ((uint64_t)High << 32U) | Low;
+}
+
+static uint64_t Com_BytesToWord(const uint8_t *Bytes, uint8_t DataLen)
+{
+	uint64_t Word = 0U;
+	uint8_t Byte = 0U;
+
+	for(Byte = 0U; Byte < DataLen && Byte < MID_CAN_COM_PDU_MAX_LEN; Byte++)
+	{
+		Word |= (uint64_t)Bytes[Byte] << (Byte * COM_BITS_PER_BYTE);
+	}
+
+	return Word;
+}
+
+/* Scheduler send function of the Tx PDUs, called from MID_CAN_SchedTick */
+static bool Com_Transmit(MID_CAN_ModuleIns_e Ins, uint8_t PduIndex)
+{
+	Com_StateType *Com = &Com_State[Ins];
+	const MID_CAN_ComPduType *Pdu = NULL;
+	Com_PduStateType *PduState = NULL;
+	FlexCAN_FrameType Frame;
+	FlexCAN_TxAbort_e Abort = FLEXCAN_TX_ABORT_IDLE;
+	bool IsSent = false;
+	uint8_t Byte = 0U;
+
+	if(Com->Config == NULL || MID_CAN_HealthIsTxAllowed(Ins) == false
+	   || (Com->Config->Pdus[PduIndex].IsLatestValue == false
+	       && FlexCAN_IsTxMbIdle((FlexCAN_Instance_e)Ins, Com->Config->Pdus[PduIndex].MbIndex) == false))
+	{
+		/* Layer not initialized, bus-off or mailbox still busy, the PDU stays due */
+	}
+	else
+	{
+		Pdu = &Com->Config->Pdus[PduIndex];
+		PduState = &Com->Pdu[PduIndex];
+
+		/* Latest value: a frame still waiting for the bus gives way to this one */
+		if(Pdu->IsLatestValue == true)
+		{
+			Abort = MID_CAN_AbortTx(Ins, Pdu->MbIndex);
+		}
+
+		if(Abort == FLEXCAN_TX_ABORT_TIMEOUT)
+		{
+			/* The old frame still holds the mailbox, the PDU stays due */
+		}
+		else
+		{
+			Frame.Id = Pdu->Id;
+			Frame.IdType = Pdu->IdType;
+			Frame.DataLen = Pdu->DataLen;
+
+			/* Snapshot and update bit clear in one step, a signal written meanwhile is sent next time */
+			DISABLE_INTERRUPTS();
+
+			/* The updates of a frame taken back before the bus go with this one */
+			if(Abort == FLEXCAN_TX_ABORT_DONE)
+			{
+				PduState->Data |= PduState->SentUpdates;
+			}
+
+			PduState->SentUpdates = PduState->Data & PduState->UpdateMask;
+
+			for(Byte = 0U; Byte < MID_CAN_COM_PDU_MAX_LEN; Byte++)
+			{
+				Frame.Data.Byte[Byte] = (uint8_t)(PduState->Data >> (Byte * COM_BITS_PER_BYTE));
+			}
+
+			PduState->Data &= ~PduState->UpdateMask;
+
+			ENABLE_INTERRUPTS();
+
+			/* An aborted frame never reached the bus, this one takes its counter */
+			if(Pdu->E2E != NULL)
+			{
+				if(Abort == FLEXCAN_TX_ABORT_DONE)
+				{
+					PduState->E2E.Counter = (uint8_t)((PduState->E2E.Counter - 1U) & MID_CAN_E2E_COUNTER_MASK);
+				}
+
+				MID_CAN_E2EProtect(Pdu->E2E, &PduState->E2E, Frame.Data.Byte, Frame.DataLen);
+			}
+
+			MID_CAN_TransmitFrame(Ins, Pdu->MbIndex, &Frame);
+
+			/* Remote requests get the last frame sent, counter included */
+			if(Pdu->IsAnswered == true)
+			{
+				MID_CAN_SetAnswerData(Ins, Pdu->AnswerMbIndex, Frame.Data.Byte, Frame.DataLen);
+			}
+
+			IsSent = true;
+		}
+	}
+
+	return IsSent;
+}
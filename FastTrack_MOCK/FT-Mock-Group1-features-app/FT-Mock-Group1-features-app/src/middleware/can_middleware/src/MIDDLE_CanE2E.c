@@ -0,0 +1,200 @@
+/*
+ * MIDDLE_CanE2E.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanE2E.h"
+#include "s32_core_cm4.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define E2E_MIN_DATA_LEN				(2U)
+#define E2E_DATA_ID_LEN					(2U)
+#define E2E_UNIT_SHIFT					(8U)		/*!< CRC-8 in the high byte of the 16-bit unit */
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static MID_CAN_E2ECrcEngine_e E2E_Engine = MID_CAN_E2E_CRC_TABLE;
+
+/* CRC-8 of every byte value, polynomial MID_CAN_E2E_CRC_POLY */
+static const uint8_t E2E_CrcTable[256] = {
+	0x00U, 0x1DU, 0x3AU, 0x27U, 0x74U, 0x69U, 0x4EU, 0x53U, 0xE8U, 0xF5U, 0xD2U, 0xCFU, 0x9CU, 0x81U, 0xA6U, 0xBBU,
+	0xCDU, 0xD0U, 0xF7U, 0xEAU, 0xB9U, 0xA4U, 0x83U, 0x9EU, 0x25U, 0x38U, 0x1FU, 0x02U, 0x51U, 0x4CU, 0x6BU, 0x76U,
+	0x87U, 0x9AU, 0xBDU, 0xA0U, 0xF3U, 0xEEU, 0xC9U, 0xD4U, 0x6FU, 0x72U, 0x55U, 0x48U, 0x1BU, 0x06U, 0x21U, 0x3CU,
+	0x4AU, 0x57U, 0x70U, 0x6DU, 0x3EU, 0x23U, 0x04U, 0x19U, 0xA2U, 0xBFU, 0x98U, 0x85U, 0xD6U, 0xCBU, 0xECU, 0xF1U,
+	0x13U, 0x0EU, 0x29U, 0x34U, 0x67U, 0x7AU, 0x5DU, 0x40U, 0xFBU, 0xE6U, 0xC1U, 0xDCU, 0x8FU, 0x92U, 0xB5U, 0xA8U,
+	0xDEU, 0xC3U, 0xE4U, 0xF9U, 0xAAU, 0xB7U, 0x90U, 0x8DU, 0x36U, 0x2BU, 0x0CU, 0x11U, 0x42U, 0x5FU, 0x78U, 0x65U,
+	0x94U, 0x89U, 0xAEU, 0xB3U, 0xE0U, 0xFDU, 0xDAU, 0xC7U, 0x7CU, 0x61U, 0x46U, 0x5BU, 0x08U, 0x15U, 0x32U, 0x2FU,
+	0x59U, 0x44U, 0x63U, 0x7EU, 0x2DU, 0x30U, 0x17U, 0x0AU, 0xB1U, 0xACU, 0x8BU, 0x96U, 0xC5U, 0xD8U, 0xFFU, 0xE2U,
+	0x26U, 0x3BU, 0x1CU, 0x01U, 0x52U, 0x4FU, 0x68U, 0x75U, 0xCEU, 0xD3U, 0xF4U, 0xE9U, 0xBAU, 0xA7U, 0x80U, 0x9DU,
+	0xEBU, 0xF6U, 0xD1U, 0xCCU, 0x9FU, 0x82U, 0xA5U, 0xB8U, 0x03U, 0x1EU, 0x39U, 0x24U, 0x77U, 0x6AU, 0x4DU, 0x50U,
+	0xA1U, 0xBCU, 0x9BU, 0x86U, 0xD5U, 0xC8U, 0xEFU, 0xF2U, 0x49U, 0x54U, 0x73U, 0x6EU, 0x3DU, 0x20U, 0x07U, 0x1AU,
+	0x6CU, 0x71U, 0x56U, 0x4BU, 0x18U, 0x05U, 0x22U, 0x3FU, 0x84U, 0x99U, 0xBEU, 0xA3U, 0xF0U, 0xEDU, 0xCAU, 0xD7U,
+	0x35U, 0x28U, 0x0FU, 0x12U, 0x41U, 0x5CU, 0x7BU, 0x66U, 0xDDU, 0xC0U, 0xE7U, 0xFAU, 0xA9U, 0xB4U, 0x93U, 0x8EU,
+	0xF8U, 0xE5U, 0xC2U, 0xDFU, 0x8CU, 0x91U, 0xB6U, 0xABU, 0x10U, 0x0DU, 0x2AU, 0x37U, 0x64U, 0x79U, 0x5EU, 0x43U,
+	0xB2U, 0xAFU, 0x88U, 0x95U, 0xC6U, 0xDBU, 0xFCU, 0xE1U, 0x5AU, 0x47U, 0x60U, 0x7DU, 0x2EU, 0x33U, 0x14U, 0x09U,
+	0x7FU, 0x62U, 0x45U, 0x58U, 0x0BU, 0x16U, 0x31U, 0x2CU, 0x97U, 0x8AU, 0xADU, 0xB0U, 0xE3U, 0xFEU, 0xD9U, 0xC4U
+};
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static uint8_t E2E_Crc8(const MID_CAN_E2EConfigType *Config, const uint8_t *Data);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void MID_CAN_E2EInit(MID_CAN_E2ECrcEngine_e Engine)
+{
+	/* Feeding x^8 * P(x) with the seed in the high byte leaves the CRC-8 in the high byte */
+	const CRC_ConfigType CrcConfig = {
+			.Width = CRC_WIDTH_16BIT,
+			.Poly = (uint32_t)MID_CAN_E2E_CRC_POLY << E2E_UNIT_SHIFT
+	};
+
+	if(Engine == MID_CAN_E2E_CRC_UNIT)
+	{
+		PCC_PeriClockControl(PCC_CRC_INDEX, CLOCK_NOSRC_CLK, CLOCK_DIV_DISABLED, ENABLE);
+		CRC_Init(&CrcConfig);
+	}
+
+	E2E_Engine = Engine;
+}
+
+bool MID_CAN_E2ECheckConfig(const MID_CAN_E2EConfigType *Config)
+{
+	return (Config != NULL && Config->DataLen >= E2E_MIN_DATA_LEN && Config->DataLen <= FLEXCAN_FRAME_MAX_DATA_LEN
+	        && Config->CrcByte < Config->DataLen && Config->CounterByte < Config->DataLen
+	        && Config->CrcByte != Config->CounterByte
+	        && Config->MaxDeltaCounter != 0U && Config->MaxDeltaCounter <= MID_CAN_E2E_COUNTER_MASK);
+}
+
+void MID_CAN_E2EResetState(MID_CAN_E2EStateType *State)
+{
+	if(State == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		DISABLE_INTERRUPTS();
+
+		State->Counter = 0U;
+		State->IsSynced = false;
+
+		ENABLE_INTERRUPTS();
+	}
+}
+
+bool MID_CAN_E2EProtect(const MID_CAN_E2EConfigType *Config, MID_CAN_E2EStateType *State, uint8_t *Data, uint8_t DataLen)
+{
+	bool IsProtected = false;
+	uint8_t Counter = 0U;
+
+	if(Config == NULL || State == NULL || Data == NULL || DataLen < Config->DataLen)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		/* One counter per PDU even when two contexts send it */
+		DISABLE_INTERRUPTS();
+
+		Counter = State->Counter;
+		State->Counter = (Counter + 1U) & MID_CAN_E2E_COUNTER_MASK;
+
+		ENABLE_INTERRUPTS();
+
+		Data[Config->CounterByte] = (Data[Config->CounterByte] & (uint8_t)~MID_CAN_E2E_COUNTER_MASK) | Counter;
+		Data[Config->CrcByte] = E2E_Crc8(Config, Data);
+		IsProtected = true;
+	}
+
+	return IsProtected;
+}
+
+MID_CAN_E2EStatus_e MID_CAN_E2ECheck(const MID_CAN_E2EConfigType *Config, MID_CAN_E2EStateType *State,
+                                     const uint8_t *Data, uint8_t DataLen)
+{
+	MID_CAN_E2EStatus_e Status = MID_CAN_E2E_ERROR;
+	uint8_t Counter = 0U;
+	uint8_t Delta = 0U;
+
+	if(Config == NULL || State == NULL || Data == NULL || DataLen < Config->DataLen)
+	{
+		/* Invalid parameters or PDU too short */
+	}
+	else if(E2E_Crc8(Config, Data) != Data[Config->CrcByte])
+	{
+		/* Corrupted, the counter is not trusted either */
+	}
+	else
+	{
+		Counter = Data[Config->CounterByte] & MID_CAN_E2E_COUNTER_MASK;
+
+		DISABLE_INTERRUPTS();
+
+		Delta = (Counter - State->Counter) & MID_CAN_E2E_COUNTER_MASK;
+
+		if(State->IsSynced == true && Delta == 0U)
+		{
+			Status = MID_CAN_E2E_REPEATED;
+		}
+		else
+		{
+			Status = (State->IsSynced == false || Delta <= Config->MaxDeltaCounter) ? MID_CAN_E2E_OK : MID_CAN_E2E_WRONG_SEQUENCE;
+			State->Counter = Counter;
+			State->IsSynced = true;
+		}
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return Status;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+/* CRC over the data ID and every byte of the protected length but the CRC byte */
+static uint8_t E2E_Crc8(const MID_CAN_E2EConfigType *Config, const uint8_t *Data)
+{
+	uint8_t Stream[E2E_DATA_ID_LEN + FLEXCAN_FRAME_MAX_DATA_LEN];
+	uint8_t Length = 0U;
+	uint8_t Crc = MID_CAN_E2E_CRC_INIT;
+	uint8_t Index = 0U;
+
+	Stream[Length++] = (uint8_t)Config->DataId;
+	Stream[Length++] = (uint8_t)(Config->DataId >> 8U);
+
+	for(Index = 0U; Index < Config->DataLen; Index++)
+	{
+		if(Index != Config->CrcByte)
+		{
+			Stream[Length++] = Data[Index];
+		}
+	}
+
+	if(E2E_Engine == MID_CAN_E2E_CRC_UNIT)
+	{
+		/* The unit holds one computation, senders and receivers may run in different contexts */
+		DISABLE_INTERRUPTS();
+
+		Crc = (uint8_t)(CRC_Calc((uint32_t)MID_CAN_E2E_CRC_INIT << E2E_UNIT_SHIFT, Stream, Length) >> E2E_UNIT_SHIFT);
+
+		ENABLE_INTERRUPTS();
+	}
+	else
+	{
+		for(Index = 0U; Index < Length; Index++)
+		{
+			Crc = E2E_CrcTable[Crc ^ Stream[Index]];
+		}
+	}
+
+	return Crc ^ MID_CAN_E2E_CRC_XOR;
+}
@@ -0,0 +1,193 @@
+/*
+ * MIDDLE_CanFilter.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanFilter.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+
+#define FILTER_STD_ID_BITS		(11U)
+#define FILTER_EXT_ID_BITS		(29U)
+
+/**
+ * True when filter A accepts every ID accepted by filter B.
+ */
+#define FILTER_CONTAINS(A, B) \
+		((((A)->Mask & ~(B)->Mask) == 0U) && ((((A)->Id ^ (B)->Id) & (A)->Mask) == 0U))
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static bool Filter_AddBlock(FlexCAN_RxFilterType *Plan, uint8_t *Count, uint8_t MaxEntries, FlexCAN_RxFilterType Block);
+static void Filter_Remove(FlexCAN_RxFilterType *Plan, uint8_t *Count, uint8_t Index);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+bool MID_CAN_FilterPlan(const MID_CAN_FilterRangeType *Ranges, uint8_t NoOfRanges,
+                        FlexCAN_RxFilterType *Plan, uint8_t MaxEntries, uint8_t *NoOfEntries)
+{
+	bool IsFit = true;
+	FlexCAN_RxFilterType Block;
+	uint32_t IdMask = 0U;
+	uint32_t Id = 0U;
+	uint32_t BlockBits = 0U;
+	uint8_t Count = 0U;
+	uint8_t Index = 0U;
+
+	if(Ranges == NULL || Plan == NULL || NoOfEntries == NULL)
+	{
+		/* Invalid parameters */
+		IsFit = false;
+	}
+	else
+	{
+		for(Index = 0U; Index < NoOfRanges && IsFit == true; Index++)
+		{
+			IdMask = (Ranges[Index].IdType == FlexCAN_EXTENDED) ? MID_CAN_FILTER_EXT_ID_MAX : MID_CAN_FILTER_STD_ID_MAX;
+
+			if(Ranges[Index].FirstId > Ranges[Index].LastId || Ranges[Index].LastId > IdMask)
+			{
+				/* Invalid range */
+				IsFit = false;
+			}
+			else
+			{
+				Id = Ranges[Index].FirstId;
+
+				do
+				{
+					/* Largest block aligned on Id that stays inside the range */
+					BlockBits = 0U;
+					while(BlockBits < ((Ranges[Index].IdType == FlexCAN_EXTENDED) ? FILTER_EXT_ID_BITS : FILTER_STD_ID_BITS)
+					      && (Id & ((2UL << BlockBits) - 1U)) == 0U
+					      && (Id + ((2UL << BlockBits) - 1U)) <= Ranges[Index].LastId)
+					{
+						BlockBits++;
+					}
+
+					Block.Id = Id;
+					Block.Mask = IdMask & ~((1UL << BlockBits) - 1U);
+					Block.IdType = Ranges[Index].IdType;
+
+					IsFit = Filter_AddBlock(Plan, &Count, MaxEntries, Block);
+
+					Id += (1UL << BlockBits);
+				} while(IsFit == true && (Id - 1U) < Ranges[Index].LastId);
+			}
+		}
+
+		*NoOfEntries = Count;
+	}
+
+	return IsFit;
+}
+
+void MID_CAN_FilterToRxFifoTable(const FlexCAN_RxFilterType *Plan, uint8_t NoOfEntries,
+                                 FlexCAN_RxFifoIdFilterType *Table)
+{
+	uint8_t Index = 0U;
+
+	if(Plan == NULL || Table == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		for(Index = 0U; Index < NoOfEntries; Index++)
+		{
+			Table[Index].Id = Plan[Index].Id;
+			Table[Index].IdType = Plan[Index].IdType;
+			Table[Index].IsRemote = false;
+			Table[Index].Mask = Plan[Index].Mask;
+		}
+	}
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static bool Filter_AddBlock(FlexCAN_RxFilterType *Plan, uint8_t *Count, uint8_t MaxEntries, FlexCAN_RxFilterType Block)
+{
+	bool IsFit = true;
+	bool IsMerged = true;
+	bool IsCovered = false;
+	uint32_t Diff = 0U;
+	uint8_t Index = 0U;
+
+	while(IsMerged == true && IsCovered == false)
+	{
+		IsMerged = false;
+
+		for(Index = 0U; Index < *Count && IsMerged == false && IsCovered == false; Index++)
+		{
+			if(Plan[Index].IdType != Block.IdType)
+			{
+				/* IDE is always compared, filters of different ID types never combine */
+			}
+			else if(FILTER_CONTAINS(&Plan[Index], &Block))
+			{
+				/* Already accepted */
+				IsCovered = true;
+			}
+			else if(Plan[Index].Mask == Block.Mask)
+			{
+				/* Two blocks that differ in one compared bit form one block twice as large */
+				Diff = (Plan[Index].Id ^ Block.Id) & Block.Mask;
+
+				if((Diff & (Diff - 1U)) == 0U)
+				{
+					Block.Mask &= ~Diff;
+					Block.Id &= Block.Mask;
+					Filter_Remove(Plan, Count, Index);
+					IsMerged = true;
+				}
+			}
+			else
+			{
+				/* Blocks overlap partially or not at all */
+			}
+		}
+	}
+
+	if(IsCovered == false)
+	{
+		/* Drop the filters the new block makes redundant */
+		Index = 0U;
+		while(Index < *Count)
+		{
+			if(Plan[Index].IdType == Block.IdType && FILTER_CONTAINS(&Block, &Plan[Index]))
+			{
+				Filter_Remove(Plan, Count, Index);
+			}
+			else
+			{
+				Index++;
+			}
+		}
+
+		if(*Count < MaxEntries)
+		{
+			Plan[*Count] = Block;
+			(*Count)++;
+		}
+		else
+		{
+			/* Not enough mailboxes or filter elements */
+			IsFit = false;
+		}
+	}
+
+	return IsFit;
+}
+
+static void Filter_Remove(FlexCAN_RxFilterType *Plan, uint8_t *Count, uint8_t Index)
+{
+	(*Count)--;
+	Plan[Index] = Plan[*Count];
+}
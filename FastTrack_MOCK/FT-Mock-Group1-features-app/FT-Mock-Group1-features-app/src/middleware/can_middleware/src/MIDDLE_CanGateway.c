@@ -0,0 +1,359 @@
+/*
+ * MIDDLE_CanGateway.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanGateway.h"
+#include "MIDDLE_CanTxQueue.h"
+#include "MIDDLE_CanFilter.h"
+#include "s32_core_cm4.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define GW_BITS_PER_BYTE				(8U)
+#define GW_FRAME_BITS					(FLEXCAN_FRAME_MAX_DATA_LEN * GW_BITS_PER_BYTE)
+#define GW_SIGNAL_MAX_LENGTH			(32U)
+
+typedef struct
+{
+	uint32_t					Value;
+	bool						IsValid;		/*!< Written at least once */
+} Gw_SlotType;
+
+typedef struct
+{
+	const MID_CAN_GwConfigType * Config;		/*!< NULL until a valid table is installed */
+	MID_CAN_IdMapType			Map;			/*!< Route of every (instance, ID, ID type) */
+	Gw_SlotType					Slot[MID_CAN_GW_MAX_SLOTS];
+	MID_CAN_E2EStateType		E2E[MID_CAN_GW_MAX_ROUTES];	/*!< Alive counter of every protected route */
+	MID_CAN_GwUartRecordType	Uart[MID_CAN_GW_UART_QUEUE_LENGTH];
+	uint8_t						UartHead;		/*!< Oldest record */
+	uint8_t						UartCount;
+	MID_CAN_GwStatsType			Stats;
+} Gw_StateType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static Gw_StateType Gw_State;
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static bool Gw_CheckRoute(const MID_CAN_GwRouteType *Route);
+static void Gw_StoreSignals(const MID_CAN_GwRouteType *Route, const FlexCAN_FrameType *Frame);
+static void Gw_QueueUart(const MID_CAN_GwRouteType *Route, const FlexCAN_FrameType *Frame);
+static void Gw_Forward(const MID_CAN_GwRouteType *Route, const FlexCAN_FrameType *Frame);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+bool MID_CAN_GwInit(const MID_CAN_GwConfigType *Config)
+{
+	uint32_t Keys[MID_CAN_GW_MAX_ROUTES];
+	const MID_CAN_GwRouteType *Route = NULL;
+	bool IsValid = (Config != NULL && Config->Routes != NULL && Config->NoOfRoutes != 0U
+	                && Config->NoOfRoutes <= MID_CAN_GW_MAX_ROUTES);
+	uint8_t Index = 0U;
+
+	DISABLE_INTERRUPTS();
+
+	/* Frames are dropped while the table is rebuilt */
+	Gw_State.Config = NULL;
+
+	ENABLE_INTERRUPTS();
+
+	for(Index = 0U; IsValid == true && Index < Config->NoOfRoutes; Index++)
+	{
+		Route = &Config->Routes[Index];
+		IsValid = Gw_CheckRoute(Route);
+		Keys[Index] = MID_CAN_IDMAP_KEY(Route->SrcIns, Route->Id, Route->IdType);
+		MID_CAN_E2EResetState(&Gw_State.E2E[Index]);
+	}
+
+	/* Fails on an ID routed twice */
+	IsValid = IsValid && MID_CAN_IdMapBuild(&Gw_State.Map, Keys, Config->NoOfRoutes);
+
+	for(Index = 0U; Index < MID_CAN_GW_MAX_SLOTS; Index++)
+	{
+		Gw_State.Slot[Index].Value = 0U;
+		Gw_State.Slot[Index].IsValid = false;
+	}
+
+	Gw_State.UartHead = 0U;
+	Gw_State.UartCount = 0U;
+	Gw_State.Stats.Routed = 0U;
+	Gw_State.Stats.Dropped = 0U;
+	Gw_State.Stats.ForwardOverflow = 0U;
+	Gw_State.Stats.UartOverflow = 0U;
+	Gw_State.Stats.E2ERepeated = 0U;
+	Gw_State.Stats.E2EWrongSequence = 0U;
+	Gw_State.Stats.E2EError = 0U;
+
+	if(IsValid == true)
+	{
+		Gw_State.Config = Config;
+	}
+
+	return IsValid;
+}
+
+bool MID_CAN_GwRxIndication(MID_CAN_ModuleIns_e Ins, const FlexCAN_FrameType *Frame)
+{
+	const MID_CAN_GwRouteType *Route = NULL;
+	MID_CAN_E2EStatus_e E2EStatus = MID_CAN_E2E_OK;
+	uint8_t Index = MID_CAN_IDMAP_NONE;
+
+	if(Frame == NULL || Gw_State.Config == NULL)
+	{
+		/* Invalid parameters or no routing table */
+	}
+	else
+	{
+		Index = MID_CAN_IdMapFind(&Gw_State.Map, MID_CAN_IDMAP_KEY(Ins, Frame->Id, Frame->IdType));
+
+		/* The check may use the CRC unit, which takes the lock itself */
+		if(Index != MID_CAN_IDMAP_NONE && Gw_State.Config->Routes[Index].E2E != NULL)
+		{
+			E2EStatus = MID_CAN_E2ECheck(Gw_State.Config->Routes[Index].E2E, &Gw_State.E2E[Index],
+			                             Frame->Data.Byte, Frame->DataLen);
+		}
+
+		/* Frames are also handed over from mailbox interrupts */
+		DISABLE_INTERRUPTS();
+
+		if(Index == MID_CAN_IDMAP_NONE)
+		{
+			Gw_State.Stats.Dropped++;
+		}
+		else if(E2EStatus != MID_CAN_E2E_OK)
+		{
+			Gw_State.Stats.E2ERepeated += (E2EStatus == MID_CAN_E2E_REPEATED) ? 1U : 0U;
+			Gw_State.Stats.E2EWrongSequence += (E2EStatus == MID_CAN_E2E_WRONG_SEQUENCE) ? 1U : 0U;
+			Gw_State.Stats.E2EError += (E2EStatus == MID_CAN_E2E_ERROR) ? 1U : 0U;
+		}
+		else
+		{
+			Route = &Gw_State.Config->Routes[Index];
+			Gw_State.Stats.Routed++;
+
+			if((Route->Actions & MID_CAN_GW_SIGNAL) != 0U)
+			{
+				Gw_StoreSignals(Route, Frame);
+			}
+
+			if((Route->Actions & MID_CAN_GW_UART) != 0U)
+			{
+				Gw_QueueUart(Route, Frame);
+			}
+		}
+
+		ENABLE_INTERRUPTS();
+
+		/* The Tx queue and the notification take the lock themselves */
+		if(Route != NULL && (Route->Actions & MID_CAN_GW_FORWARD) != 0U)
+		{
+			Gw_Forward(Route, Frame);
+		}
+
+		if(Route != NULL && (Route->Actions & MID_CAN_GW_NOTIFY) != 0U && Route->Notification != NULL)
+		{
+			Route->Notification(Ins, Route->Tag, Frame);
+		}
+	}
+
+	return (Route != NULL);
+}
+
+uint8_t MID_CAN_GwFind(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType)
+{
+	return (Gw_State.Config == NULL) ? MID_CAN_IDMAP_NONE
+	       : MID_CAN_IdMapFind(&Gw_State.Map, MID_CAN_IDMAP_KEY(Ins, Id, IdType));
+}
+
+bool MID_CAN_GwReadSlot(uint8_t Slot, uint32_t *Value)
+{
+	bool IsRead = false;
+
+	if(Slot >= MID_CAN_GW_MAX_SLOTS || Value == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		DISABLE_INTERRUPTS();
+
+		*Value = Gw_State.Slot[Slot].Value;
+		IsRead = Gw_State.Slot[Slot].IsValid;
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return IsRead;
+}
+
+bool MID_CAN_GwPopUartRecord(MID_CAN_GwUartRecordType *Record)
+{
+	bool IsPopped = false;
+
+	if(Record == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		DISABLE_INTERRUPTS();
+
+		if(Gw_State.UartCount != 0U)
+		{
+			*Record = Gw_State.Uart[Gw_State.UartHead];
+			Gw_State.UartHead = (Gw_State.UartHead + 1U) % MID_CAN_GW_UART_QUEUE_LENGTH;
+			Gw_State.UartCount--;
+			IsPopped = true;
+		}
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return IsPopped;
+}
+
+void MID_CAN_GwGetStats(MID_CAN_GwStatsType *Stats)
+{
+	if(Stats == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		DISABLE_INTERRUPTS();
+
+		*Stats = Gw_State.Stats;
+
+		ENABLE_INTERRUPTS();
+	}
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static bool Gw_CheckRoute(const MID_CAN_GwRouteType *Route)
+{
+	const MID_CAN_GwSignalType *Signal = NULL;
+	bool IsValid = (Route->SrcIns < FLEXCAN_INSTANCE_COUNT
+	                && Route->Id <= ((Route->IdType == FlexCAN_EXTENDED) ? MID_CAN_FILTER_EXT_ID_MAX : MID_CAN_FILTER_STD_ID_MAX));
+	uint8_t Index = 0U;
+
+	if((Route->Actions & MID_CAN_GW_FORWARD) != 0U)
+	{
+		IsValid = IsValid && Route->DstIns < FLEXCAN_INSTANCE_COUNT;
+	}
+
+	if((Route->Actions & MID_CAN_GW_SIGNAL) != 0U)
+	{
+		IsValid = IsValid && (Route->Signals != NULL || Route->NoOfSignals == 0U);
+
+		for(Index = 0U; IsValid == true && Index < Route->NoOfSignals; Index++)
+		{
+			Signal = &Route->Signals[Index];
+			IsValid = (Signal->Slot < MID_CAN_GW_MAX_SLOTS && Signal->Length != 0U && Signal->Length <= GW_SIGNAL_MAX_LENGTH
+			           && ((uint16_t)Signal->StartBit + Signal->Length) <= GW_FRAME_BITS
+			           && (Signal->UpdateBit < GW_FRAME_BITS || Signal->UpdateBit == MID_CAN_GW_NO_UPDATE_BIT));
+		}
+	}
+
+	if((Route->Actions & MID_CAN_GW_NOTIFY) != 0U)
+	{
+		IsValid = IsValid && Route->Notification != NULL;
+	}
+
+	if(Route->E2E != NULL)
+	{
+		IsValid = IsValid && MID_CAN_E2ECheckConfig(Route->E2E);
+	}
+
+	return IsValid;
+}
+
+/* Called with interrupts disabled */
+static void Gw_StoreSignals(const MID_CAN_GwRouteType *Route, const FlexCAN_FrameType *Frame)
+{
+	const MID_CAN_GwSignalType *Signal = NULL;
+	uint64_t Data = 0U;
+	uint8_t FrameBits = Frame->DataLen * GW_BITS_PER_BYTE;
+	uint8_t Index = 0U;
+
+	for(Index = 0U; Index < Frame->DataLen && Index < FLEXCAN_FRAME_MAX_DATA_LEN; Index++)
+	{
+		Data |= (uint64_t)Frame->Data.Byte[Index] << (Index * GW_BITS_PER_BYTE);
+	}
+
+	for(Index = 0U; Index < Route->NoOfSignals; Index++)
+	{
+		Signal = &Route->Signals[Index];
+
+		if(((uint16_t)Signal->StartBit + Signal->Length) > FrameBits)
+		{
+			/* Frame too short */
+		}
+		else if(Signal->UpdateBit != MID_CAN_GW_NO_UPDATE_BIT && ((Data >> Signal->UpdateBit) & 1U) == 0U)
+		{
+			/* Value not updated by the sender */
+		}
+		else
+		{
+			Gw_State.Slot[Signal->Slot].Value = (uint32_t)((Data >> Signal->StartBit) & (((uint64_t)1U << Signal->Length) - 1U));
+			Gw_State.Slot[Signal->Slot].IsValid = true;
+		}
+	}
+}
+
+/* Called with interrupts disabled */
+static void Gw_QueueUart(const MID_CAN_GwRouteType *Route, const FlexCAN_FrameType *Frame)
+{
+	MID_CAN_GwUartRecordType *Record = NULL;
+	uint8_t Index = 0U;
+
+	if(Gw_State.UartCount >= MID_CAN_GW_UART_QUEUE_LENGTH)
+	{
+		/* The oldest records are kept */
+		Gw_State.Stats.UartOverflow++;
+	}
+	else
+	{
+		Record = &Gw_State.Uart[(Gw_State.UartHead + Gw_State.UartCount) % MID_CAN_GW_UART_QUEUE_LENGTH];
+		Record->Tag = Route->Tag;
+		Record->Id = Frame->Id;
+		Record->DataLen = Frame->DataLen;
+		Record->TimeStamp = Frame->TimeStamp;
+
+		for(Index = 0U; Index < FLEXCAN_FRAME_MAX_DATA_LEN; Index++)
+		{
+			Record->Data[Index] = Frame->Data.Byte[Index];
+		}
+
+		Gw_State.UartCount++;
+	}
+}
+
+static void Gw_Forward(const MID_CAN_GwRouteType *Route, const FlexCAN_FrameType *Frame)
+{
+	FlexCAN_FrameType Copy = *Frame;
+
+	if(Route->DstId != MID_CAN_GW_SAME_ID)
+	{
+		Copy.Id = Route->DstId;
+	}
+
+	if(MID_CAN_TxQueueSend(Route->DstIns, &Copy, NULL, NULL) == false)
+	{
+		DISABLE_INTERRUPTS();
+
+		Gw_State.Stats.ForwardOverflow++;
+
+		ENABLE_INTERRUPTS();
+	}
+}
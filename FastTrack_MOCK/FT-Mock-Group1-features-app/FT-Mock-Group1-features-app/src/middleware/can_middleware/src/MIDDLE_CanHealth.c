@@ -0,0 +1,317 @@
+/*
+ * MIDDLE_CanHealth.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanHealth.h"
+#include "MIDDLE_CanTxQueue.h"
+#include "s32_core_cm4.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+
+#define HEALTH_ERROR_MASK		(FLEXCAN_ESR1_STFERR_MASK | FLEXCAN_ESR1_FRMERR_MASK | FLEXCAN_ESR1_CRCERR_MASK | \
+								 FLEXCAN_ESR1_ACKERR_MASK | FLEXCAN_ESR1_BIT0ERR_MASK | FLEXCAN_ESR1_BIT1ERR_MASK)
+
+#define HEALTH_FLTCONF_PASSIVE	(1U)	/*!< FLTCONF value of error passive, higher values are bus-off */
+
+#define HEALTH_IS_BUS_OFF(State) \
+		(((State) == MID_CAN_HEALTH_BUS_OFF) || ((State) == MID_CAN_HEALTH_RECOVERING))
+
+typedef struct
+{
+	const MID_CAN_HealthConfigType * Config;
+	MID_CAN_HealthState_e		State;
+	bool						IsRecoveryRequested;
+	bool						HasRecovered;		/*!< RecoveredTime is valid */
+	uint32_t					LastUpdate;			/*!< FlexCAN time of the last sample */
+	uint32_t					BusOffTime;			/*!< FlexCAN time of the last bus-off */
+	uint32_t					RecoveredTime;		/*!< FlexCAN time of the last recovery */
+	uint32_t					BackoffMs;			/*!< Backoff of the current bus-off */
+	uint64_t					TimeInState[MID_CAN_HEALTH_STATE_COUNT];	/*!< In bit times */
+	MID_CAN_HealthCountersType	Counters;
+} Health_StateType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+/**
+ * Health monitor of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static Health_StateType Health_State[FLEXCAN_INSTANCE_COUNT];
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void Health_Process(MID_CAN_ModuleIns_e Ins);
+static void Health_Update(MID_CAN_ModuleIns_e Ins, const FlexCAN_ErrorStateType *ErrorState);
+static void Health_IrqNotification(FlexCAN_Instance_e Ins, uint8_t CallbackID, void *Context);
+static void Health_ClearCounters(Health_StateType *Health);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void MID_CAN_HealthInit(MID_CAN_ModuleIns_e Ins, const MID_CAN_HealthConfigType *Config)
+{
+	Health_StateType *Health = &Health_State[Ins];
+
+	MID_CAN_UserConfigType UserConfig = {
+			.HandlerFunc = Health_IrqNotification,
+			.Context = NULL
+	};
+
+	if(Config == NULL || Config->BackoffMs > Config->BackoffMaxMs)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		DISABLE_INTERRUPTS();
+
+		Health->Config = Config;
+		Health->State = MID_CAN_HEALTH_ERROR_ACTIVE;
+		Health->IsRecoveryRequested = false;
+		Health->HasRecovered = false;
+		Health->LastUpdate = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+		Health->BackoffMs = Config->BackoffMs;
+		Health_ClearCounters(Health);
+
+		/* With a backoff, the controller holds bus-off until the monitor releases it */
+		FlexCAN_SetBusOffRecovery((FlexCAN_Instance_e)Ins, Config->RecoveryMode == MID_CAN_RECOVERY_HARDWARE);
+
+		ENABLE_INTERRUPTS();
+
+		/* Error frames and bus-off / bus-off done / warnings are sampled as they happen */
+		UserConfig.HandlerType = MIDDLE_HANDLER_ERROR_TYPE;
+		MID_CAN_SetCallback(Ins, &UserConfig);
+		UserConfig.HandlerType = MIDDLE_HANDLER_ORED_TYPE;
+		MID_CAN_SetCallback(Ins, &UserConfig);
+
+		Health_Process(Ins);
+	}
+}
+
+void MID_CAN_HealthMainFunction(MID_CAN_ModuleIns_e Ins)
+{
+	if(Health_State[Ins].Config != NULL)
+	{
+		Health_Process(Ins);
+	}
+	else
+	{
+		/* Monitor not initialized */
+	}
+}
+
+MID_CAN_HealthState_e MID_CAN_HealthGetState(MID_CAN_ModuleIns_e Ins)
+{
+	return Health_State[Ins].State;
+}
+
+bool MID_CAN_HealthRequestRecovery(MID_CAN_ModuleIns_e Ins)
+{
+	Health_StateType *Health = &Health_State[Ins];
+	bool IsAccepted = false;
+
+	if(Health->Config != NULL && Health->State == MID_CAN_HEALTH_BUS_OFF)
+	{
+		Health->IsRecoveryRequested = true;
+		IsAccepted = true;
+
+		/* Starts right away if the backoff already expired */
+		Health_Process(Ins);
+	}
+	else
+	{
+		/* Not bus-off or monitor not initialized */
+	}
+
+	return IsAccepted;
+}
+
+bool MID_CAN_HealthIsTxAllowed(MID_CAN_ModuleIns_e Ins)
+{
+	return (HEALTH_IS_BUS_OFF(Health_State[Ins].State) == false);
+}
+
+void MID_CAN_HealthGetCounters(MID_CAN_ModuleIns_e Ins, MID_CAN_HealthCountersType *Counters)
+{
+	Health_StateType *Health = &Health_State[Ins];
+	uint8_t State = 0U;
+
+	if(Counters == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		DISABLE_INTERRUPTS();
+
+		*Counters = Health->Counters;
+
+		for(State = 0U; State < MID_CAN_HEALTH_STATE_COUNT; State++)
+		{
+			Counters->TimeInStateMs[State] = (uint32_t)(Health->TimeInState[State] / MID_CAN_BITS_PER_MS);
+		}
+
+		ENABLE_INTERRUPTS();
+	}
+}
+
+void MID_CAN_HealthResetCounters(MID_CAN_ModuleIns_e Ins)
+{
+	DISABLE_INTERRUPTS();
+
+	Health_ClearCounters(&Health_State[Ins]);
+
+	ENABLE_INTERRUPTS();
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void Health_Process(MID_CAN_ModuleIns_e Ins)
+{
+	Health_StateType *Health = &Health_State[Ins];
+	FlexCAN_ErrorStateType ErrorState;
+	MID_CAN_HealthState_e OldState = MID_CAN_HEALTH_ERROR_ACTIVE;
+	MID_CAN_HealthState_e NewState = MID_CAN_HEALTH_ERROR_ACTIVE;
+
+	/* Error and ORed interrupts sample the controller too */
+	DISABLE_INTERRUPTS();
+
+	OldState = Health->State;
+	FlexCAN_GetErrorState((FlexCAN_Instance_e)Ins, &ErrorState);
+	Health_Update(Ins, &ErrorState);
+	NewState = Health->State;
+
+	ENABLE_INTERRUPTS();
+
+	if(OldState != NewState)
+	{
+		if(HEALTH_IS_BUS_OFF(OldState) == true && HEALTH_IS_BUS_OFF(NewState) == false)
+		{
+			/* Frames held while bus-off leave in priority order */
+			MID_CAN_TxQueueResume(Ins);
+		}
+
+		if(Health->Config->Notification != NULL)
+		{
+			Health->Config->Notification(Ins, OldState, NewState);
+		}
+	}
+}
+
+static void Health_Update(MID_CAN_ModuleIns_e Ins, const FlexCAN_ErrorStateType *ErrorState)
+{
+	Health_StateType *Health = &Health_State[Ins];
+	MID_CAN_HealthCountersType *Counters = &Health->Counters;
+	uint32_t Now = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+	uint32_t FaultConf = (ErrorState->Esr1 & FLEXCAN_ESR1_FLTCONF_MASK) >> FLEXCAN_ESR1_FLTCONF_SHIFT;
+	uint32_t RecoveryMs = 0U;
+
+	/* Account the time spent in the state left by this sample */
+	Health->TimeInState[Health->State] += (uint32_t)(Now - Health->LastUpdate);
+	Health->LastUpdate = Now;
+
+	/* The error bits are cleared by the read, every sample reports new errors only */
+	if((ErrorState->Esr1 & HEALTH_ERROR_MASK) != 0U)
+	{
+		Counters->ErrorFrames++;
+	}
+
+	if((ErrorState->Esr1 & FLEXCAN_ESR1_ACKERR_MASK) != 0U)
+	{
+		Counters->AckErrors++;
+	}
+
+	Counters->Tec = ErrorState->Tec;
+	Counters->Rec = ErrorState->Rec;
+	Counters->TecPeak = (ErrorState->Tec > Counters->TecPeak) ? ErrorState->Tec : Counters->TecPeak;
+	Counters->RecPeak = (ErrorState->Rec > Counters->RecPeak) ? ErrorState->Rec : Counters->RecPeak;
+
+	if(FaultConf > HEALTH_FLTCONF_PASSIVE)
+	{
+		if(HEALTH_IS_BUS_OFF(Health->State) == false)
+		{
+			Counters->BusOffCount++;
+			Health->BusOffTime = Now;
+			Health->IsRecoveryRequested = false;
+
+			/* A bus fault that comes back soon after a recovery doubles the backoff */
+			if(Health->HasRecovered == true
+			   && (Now - Health->RecoveredTime) < (Health->Config->StableMs * MID_CAN_BITS_PER_MS))
+			{
+				Health->BackoffMs = (Health->BackoffMs * 2U > Health->Config->BackoffMaxMs) ?
+				                    Health->Config->BackoffMaxMs : (Health->BackoffMs * 2U);
+			}
+			else
+			{
+				Health->BackoffMs = Health->Config->BackoffMs;
+			}
+
+			Health->State = (Health->Config->RecoveryMode == MID_CAN_RECOVERY_HARDWARE) ?
+			                MID_CAN_HEALTH_RECOVERING : MID_CAN_HEALTH_BUS_OFF;
+		}
+		else if(Health->State == MID_CAN_HEALTH_BUS_OFF
+		        && (Now - Health->BusOffTime) >= (Health->BackoffMs * MID_CAN_BITS_PER_MS)
+		        && (Health->Config->RecoveryMode == MID_CAN_RECOVERY_BACKOFF || Health->IsRecoveryRequested == true))
+		{
+			/* Backoff expired, the controller now waits for 128 x 11 recessive bits */
+			FlexCAN_SetBusOffRecovery((FlexCAN_Instance_e)Ins, true);
+			Health->State = MID_CAN_HEALTH_RECOVERING;
+		}
+		else
+		{
+			/* Still waiting for the backoff, the request or the recessive bits */
+		}
+	}
+	else
+	{
+		if(HEALTH_IS_BUS_OFF(Health->State) == true)
+		{
+			RecoveryMs = (Now - Health->BusOffTime) / MID_CAN_BITS_PER_MS;
+			Counters->LastRecoveryMs = RecoveryMs;
+			Counters->MaxRecoveryMs = (RecoveryMs > Counters->MaxRecoveryMs) ? RecoveryMs : Counters->MaxRecoveryMs;
+			Health->RecoveredTime = Now;
+			Health->HasRecovered = true;
+
+			/* Hold the next bus-off for the backoff again */
+			if(Health->Config->RecoveryMode != MID_CAN_RECOVERY_HARDWARE)
+			{
+				FlexCAN_SetBusOffRecovery((FlexCAN_Instance_e)Ins, false);
+			}
+		}
+
+		Health->State = (FaultConf == HEALTH_FLTCONF_PASSIVE) ? MID_CAN_HEALTH_ERROR_PASSIVE : MID_CAN_HEALTH_ERROR_ACTIVE;
+	}
+}
+
+static void Health_IrqNotification(FlexCAN_Instance_e Ins, uint8_t CallbackID, void *Context)
+{
+	if(Health_State[Ins].Config != NULL)
+	{
+		Health_Process((MID_CAN_ModuleIns_e)Ins);
+	}
+	else
+	{
+		/* Monitor is being initialized */
+	}
+}
+
+static void Health_ClearCounters(Health_StateType *Health)
+{
+	static const MID_CAN_HealthCountersType NoCounters;
+	uint8_t State = 0U;
+
+	for(State = 0U; State < MID_CAN_HEALTH_STATE_COUNT; State++)
+	{
+		Health->TimeInState[State] = 0U;
+	}
+
+	Health->Counters = NoCounters;
+}
@@ -0,0 +1,210 @@
+/*
+ * MIDDLE_CanIdMap.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanIdMap.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define IDMAP_SEED_FIRST				(0x9E3779B1U)	/*!< Golden ratio multiplier */
+#define IDMAP_SEED_STEP					(0x6C8E9CF5U)	/*!< Odd, every seed stays odd */
+#define IDMAP_SEEDS_PER_SIZE			(32U)			/*!< Seeds tried before the table is doubled */
+#define IDMAP_GROUP_HASH_BITS			(16U)
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static bool IdMap_Try(MID_CAN_IdMapType *Map, const uint32_t *Keys, uint8_t NoOfKeys, uint8_t Bits, uint32_t Seed);
+static bool IdMap_PlaceGroup(MID_CAN_IdMapType *Map, const uint32_t *Keys, const uint8_t *Group,
+                             const uint8_t *Base, uint8_t NoOfKeys, uint8_t Current);
+static void IdMap_Clear(MID_CAN_IdMapType *Map, uint8_t Bits, uint32_t Seed);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+bool MID_CAN_IdMapBuild(MID_CAN_IdMapType *Map, const uint32_t *Keys, uint8_t NoOfKeys)
+{
+	bool IsBuilt = false;
+	bool IsDuplicated = false;
+	uint32_t Seed = IDMAP_SEED_FIRST;
+	uint8_t Bits = 1U;
+	uint8_t Try = 0U;
+	uint8_t Index = 0U;
+	uint8_t Other = 0U;
+
+	if(Map == NULL || (Keys == NULL && NoOfKeys != 0U) || NoOfKeys > MID_CAN_IDMAP_MAX_KEYS)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		for(Index = 0U; Index < NoOfKeys && IsDuplicated == false; Index++)
+		{
+			for(Other = Index + 1U; Other < NoOfKeys && IsDuplicated == false; Other++)
+			{
+				IsDuplicated = (Keys[Index] == Keys[Other]);
+			}
+		}
+
+		/* Smallest table that holds every key */
+		while((1U << Bits) < NoOfKeys)
+		{
+			Bits++;
+		}
+
+		for(; Bits <= MID_CAN_IDMAP_MAX_BITS && IsDuplicated == false && IsBuilt == false; Bits++)
+		{
+			for(Try = 0U; Try < IDMAP_SEEDS_PER_SIZE && IsBuilt == false; Try++)
+			{
+				IsBuilt = IdMap_Try(Map, Keys, NoOfKeys, Bits, Seed);
+				Seed += IDMAP_SEED_STEP;
+			}
+		}
+
+		if(IsBuilt == false)
+		{
+			/* Every lookup misses */
+			IdMap_Clear(Map, 1U, IDMAP_SEED_FIRST);
+		}
+	}
+
+	return IsBuilt;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void IdMap_Clear(MID_CAN_IdMapType *Map, uint8_t Bits, uint32_t Seed)
+{
+	uint8_t GroupBits = Bits - 1U;
+	uint8_t Slot = 0U;
+
+	Map->Seed = Seed;
+	Map->SlotShift = 32U - Bits;
+	Map->GroupShift = IDMAP_GROUP_HASH_BITS - GroupBits;
+	Map->SlotMask = (uint8_t)((1U << Bits) - 1U);
+
+	for(Slot = 0U; Slot <= Map->SlotMask; Slot++)
+	{
+		Map->Keys[Slot] = 0U;
+		Map->Values[Slot] = MID_CAN_IDMAP_NONE;
+	}
+
+	for(Slot = 0U; Slot < (1U << GroupBits); Slot++)
+	{
+		Map->Disp[Slot] = 0U;
+	}
+}
+
+/* One attempt with a table size and a seed, groups placed largest first. Fails when a group fits nowhere */
+static bool IdMap_Try(MID_CAN_IdMapType *Map, const uint32_t *Keys, uint8_t NoOfKeys, uint8_t Bits, uint32_t Seed)
+{
+	uint8_t Group[MID_CAN_IDMAP_MAX_KEYS];
+	uint8_t Base[MID_CAN_IDMAP_MAX_KEYS];
+	uint8_t GroupSize[MID_CAN_IDMAP_MAX_SLOTS / 2U];
+	uint8_t NoOfGroups = 0U;
+	uint8_t Largest = 0U;
+	uint8_t Index = 0U;
+	bool IsPlaced = true;
+	bool IsDone = false;
+
+	IdMap_Clear(Map, Bits, Seed);
+	NoOfGroups = (uint8_t)(1U << (Bits - 1U));
+
+	for(Index = 0U; Index < NoOfGroups; Index++)
+	{
+		GroupSize[Index] = 0U;
+	}
+
+	for(Index = 0U; Index < NoOfKeys; Index++)
+	{
+		Group[Index] = (uint8_t)(((Keys[Index] * Seed) & 0xFFFFU) >> Map->GroupShift);
+		Base[Index] = (uint8_t)((Keys[Index] * Seed) >> Map->SlotShift);
+		GroupSize[Group[Index]]++;
+	}
+
+	while(IsPlaced == true && IsDone == false)
+	{
+		/* Largest group not placed yet, a placed group has its size cleared */
+		Largest = 0U;
+
+		for(Index = 1U; Index < NoOfGroups; Index++)
+		{
+			Largest = (GroupSize[Index] > GroupSize[Largest]) ? Index : Largest;
+		}
+
+		if(GroupSize[Largest] == 0U)
+		{
+			/* All groups placed */
+			IsDone = true;
+		}
+		else
+		{
+			IsPlaced = IdMap_PlaceGroup(Map, Keys, Group, Base, NoOfKeys, Largest);
+			GroupSize[Largest] = 0U;
+		}
+	}
+
+	return IsPlaced;
+}
+
+/* Puts the keys of one group at the first displacement where they all land on free slots */
+static bool IdMap_PlaceGroup(MID_CAN_IdMapType *Map, const uint32_t *Keys, const uint8_t *Group,
+                             const uint8_t *Base, uint8_t NoOfKeys, uint8_t Current)
+{
+	uint8_t Disp = 0U;
+	uint8_t Slot = 0U;
+	uint8_t Index = 0U;
+	uint8_t Other = 0U;
+	bool IsFree = false;
+
+	for(Disp = 0U; Disp <= Map->SlotMask && IsFree == false; Disp++)
+	{
+		IsFree = true;
+
+		for(Index = 0U; Index < NoOfKeys && IsFree == true; Index++)
+		{
+			Slot = (Base[Index] + Disp) & Map->SlotMask;
+
+			if(Group[Index] != Current)
+			{
+				/* Other group */
+			}
+			else if(Map->Values[Slot] != MID_CAN_IDMAP_NONE)
+			{
+				IsFree = false;
+			}
+			else
+			{
+				/* Two keys of the group on one slot */
+				for(Other = 0U; Other < Index && IsFree == true; Other++)
+				{
+					IsFree = (Group[Other] != Current || Base[Other] != Base[Index]);
+				}
+			}
+		}
+	}
+
+	if(IsFree == true)
+	{
+		/* The loop stepped past the displacement found */
+		Disp--;
+		Map->Disp[Current] = Disp;
+
+		for(Index = 0U; Index < NoOfKeys; Index++)
+		{
+			if(Group[Index] == Current)
+			{
+				Slot = (Base[Index] + Disp) & Map->SlotMask;
+				Map->Keys[Slot] = Keys[Index];
+				Map->Values[Slot] = Index;
+			}
+		}
+	}
+
+	return IsFree;
+}
@@ -0,0 +1,192 @@
+/*
+ * MIDDLE_CanLatency.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanLatency.h"
+#include "s32_core_cm4.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+
+typedef struct
+{
+	MID_CAN_LatencyStatType		Stat;
+	uint64_t					Sum;		/*!< Sum of the samples, for the mean */
+} Latency_AccumulatorType;
+
+typedef struct
+{
+	bool						IsUsed;
+	uint32_t					Id;
+	FlexCAN_MsgIDType_e			IdType;
+	Latency_AccumulatorType		WireToIsr;
+	Latency_AccumulatorType		IsrToConsume;
+} Latency_EntryType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+/**
+ * Latency statistics of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static Latency_EntryType Latency_Table[FLEXCAN_INSTANCE_COUNT][MID_CAN_LATENCY_MAX_IDS];
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static Latency_EntryType * Latency_Find(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType, bool IsAllocate);
+static void Latency_Add(Latency_AccumulatorType *Accumulator, uint32_t Latency);
+static void Latency_Export(const Latency_AccumulatorType *Accumulator, MID_CAN_LatencyStatType *Stat);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void MID_CAN_LatencyRecord(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType,
+                           uint32_t WireTime, uint32_t IsrTime)
+{
+	Latency_EntryType *Entry = NULL;
+	uint32_t Now = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+
+	/* Receive callbacks record from the MB interrupt too */
+	DISABLE_INTERRUPTS();
+
+	Entry = Latency_Find(Ins, Id, IdType, true);
+
+	if(Entry != NULL)
+	{
+		Latency_Add(&Entry->WireToIsr, IsrTime - WireTime);
+		Latency_Add(&Entry->IsrToConsume, Now - IsrTime);
+	}
+	else
+	{
+		/* No free slot, the ID is not tracked */
+	}
+
+	ENABLE_INTERRUPTS();
+}
+
+bool MID_CAN_GetLatency(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType, MID_CAN_LatencyType *Latency)
+{
+	Latency_EntryType *Entry = NULL;
+	bool IsTracked = false;
+
+	if(Latency == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		/* Consistent snapshot of both statistics */
+		DISABLE_INTERRUPTS();
+
+		Entry = Latency_Find(Ins, Id, IdType, false);
+
+		if(Entry != NULL)
+		{
+			Latency->Id = Id;
+			Latency->IdType = IdType;
+			Latency_Export(&Entry->WireToIsr, &Latency->WireToIsr);
+			Latency_Export(&Entry->IsrToConsume, &Latency->IsrToConsume);
+			IsTracked = true;
+		}
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return IsTracked;
+}
+
+void MID_CAN_LatencyReset(MID_CAN_ModuleIns_e Ins)
+{
+	uint8_t Index = 0U;
+
+	DISABLE_INTERRUPTS();
+
+	for(Index = 0U; Index < MID_CAN_LATENCY_MAX_IDS; Index++)
+	{
+		Latency_Table[Ins][Index].IsUsed = false;
+	}
+
+	ENABLE_INTERRUPTS();
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static Latency_EntryType * Latency_Find(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType, bool IsAllocate)
+{
+	Latency_EntryType *Entry = NULL;
+	Latency_EntryType *FreeEntry = NULL;
+	uint8_t Index = 0U;
+
+	for(Index = 0U; Index < MID_CAN_LATENCY_MAX_IDS && Entry == NULL; Index++)
+	{
+		if(Latency_Table[Ins][Index].IsUsed == false)
+		{
+			if(FreeEntry == NULL)
+			{
+				FreeEntry = &Latency_Table[Ins][Index];
+			}
+		}
+		else if(Latency_Table[Ins][Index].Id == Id && Latency_Table[Ins][Index].IdType == IdType)
+		{
+			Entry = &Latency_Table[Ins][Index];
+		}
+		else
+		{
+			/* Slot used by another ID */
+		}
+	}
+
+	if(Entry == NULL && FreeEntry != NULL && IsAllocate == true)
+	{
+		Entry = FreeEntry;
+		Entry->IsUsed = true;
+		Entry->Id = Id;
+		Entry->IdType = IdType;
+		Entry->WireToIsr.Stat.Count = 0U;
+		Entry->IsrToConsume.Stat.Count = 0U;
+	}
+
+	return Entry;
+}
+
+static void Latency_Add(Latency_AccumulatorType *Accumulator, uint32_t Latency)
+{
+	MID_CAN_LatencyStatType *Stat = &Accumulator->Stat;
+	uint32_t Bucket = 0U;
+
+	if(Stat->Count == 0U)
+	{
+		/* First sample, also clears what a previous ID left in the slot */
+		Stat->Min = Latency;
+		Stat->Max = Latency;
+		Accumulator->Sum = 0U;
+
+		for(Bucket = 0U; Bucket < MID_CAN_LATENCY_BUCKETS; Bucket++)
+		{
+			Stat->Histogram[Bucket] = 0U;
+		}
+	}
+
+	Stat->Min = (Latency < Stat->Min) ? Latency : Stat->Min;
+	Stat->Max = (Latency > Stat->Max) ? Latency : Stat->Max;
+	Accumulator->Sum += Latency;
+	Stat->Count++;
+
+	/* Bucket n holds [2^(n-1), 2^n) */
+	Bucket = (Latency == 0U) ? 0U : (32U - (uint32_t)__builtin_clz(Latency));
+	Bucket = (Bucket >= MID_CAN_LATENCY_BUCKETS) ? (MID_CAN_LATENCY_BUCKETS - 1U) : Bucket;
+	Stat->Histogram[Bucket]++;
+}
+
+static void Latency_Export(const Latency_AccumulatorType *Accumulator, MID_CAN_LatencyStatType *Stat)
+{
+	*Stat = Accumulator->Stat;
+	Stat->Mean = (Stat->Count == 0U) ? 0U : (uint32_t)(Accumulator->Sum / Stat->Count);
+}
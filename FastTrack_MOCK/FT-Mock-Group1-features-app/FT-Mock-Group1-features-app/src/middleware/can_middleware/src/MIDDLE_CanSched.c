@@ -0,0 +1,327 @@
+/*
+ * MIDDLE_CanSched.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanSched.h"
+#include "MIDDLE_CanHealth.h"
+#include "s32_core_cm4.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define SCHED_US_PER_MS					(1000U)
+#define SCHED_STOPPED					(0xFFFFFFFFU)	/*!< Countdown of a slot without cycle */
+
+typedef struct
+{
+	MID_CAN_SchedSlotConfigType	Config;
+	uint32_t					PeriodTicks;	/*!< 0 without cycle */
+	uint32_t					MinDelayTicks;
+	uint32_t					FirstTick;		/*!< Tick of the first send, phase of the cycle */
+	uint32_t					Countdown;		/*!< Ticks to the next cyclic send, or SCHED_STOPPED */
+	uint32_t					SinceSend;		/*!< Ticks since the last send */
+	volatile bool				IsTriggerPending;
+	bool						IsSent;
+	uint32_t					LastSendTime;	/*!< FlexCAN time of the last send */
+
+	/* Statistics in FlexCAN timer ticks */
+	uint32_t					Count;
+	uint32_t					MinPeriod;
+	uint32_t					MaxPeriod;
+	uint64_t					SumPeriod;
+	uint32_t					MaxJitter;
+	uint32_t					Deferred;
+} Sched_SlotType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static Sched_SlotType Sched_Slot[MID_CAN_SCHED_MAX_SLOTS];
+static volatile uint8_t Sched_NoOfSlots = 0U;
+static uint32_t Sched_TickUs = 0U;
+static volatile uint32_t Sched_TickCount = 0U;
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static uint32_t Sched_MsToTicks(uint16_t Ms);
+static uint32_t Sched_AutoOffset(uint32_t PeriodTicks, uint32_t BaseTick);
+static uint32_t Sched_Gcd(uint32_t A, uint32_t B);
+static void Sched_Record(Sched_SlotType *Slot, uint32_t Period);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void MID_CAN_SchedInit(uint32_t TickUs)
+{
+	DISABLE_INTERRUPTS();
+
+	Sched_NoOfSlots = 0U;
+	Sched_TickCount = 0U;
+	Sched_TickUs = TickUs;
+
+	ENABLE_INTERRUPTS();
+}
+
+uint8_t MID_CAN_SchedAdd(const MID_CAN_SchedSlotConfigType *Config)
+{
+	Sched_SlotType *Slot = NULL;
+	uint8_t Index = MID_CAN_SCHED_INVALID_SLOT;
+	uint32_t Offset = 0U;
+	uint32_t BaseTick = 0U;
+	uint32_t FirstTick = 0U;
+	uint32_t Late = 0U;
+	bool IsAutoOffset = false;
+
+	if(Config == NULL || Config->TxFunc == NULL || Sched_TickUs == 0U || Sched_NoOfSlots >= MID_CAN_SCHED_MAX_SLOTS)
+	{
+		/* Invalid parameters, scheduler not initialized or table full */
+	}
+	else
+	{
+		/* The tick only sees published slots, this one is filled with interrupts enabled */
+		Slot = &Sched_Slot[Sched_NoOfSlots];
+		Slot->Config = *Config;
+		Slot->PeriodTicks = Sched_MsToTicks(Config->PeriodMs);
+		Slot->MinDelayTicks = Sched_MsToTicks(Config->MinDelayMs);
+
+		if(Config->OffsetMs != MID_CAN_SCHED_AUTO_OFFSET)
+		{
+			Offset = Sched_MsToTicks(Config->OffsetMs);
+		}
+		else if(Slot->PeriodTicks != 0U)
+		{
+			/* The search walks the hyperperiod, it runs before the critical section */
+			BaseTick = Sched_TickCount + 1U;
+			FirstTick = BaseTick + Sched_AutoOffset(Slot->PeriodTicks, BaseTick);
+			IsAutoOffset = true;
+		}
+		else
+		{
+			/* Triggered only, sent once at start */
+		}
+
+		Slot->SinceSend = 0U;
+		Slot->IsTriggerPending = false;
+		Slot->IsSent = false;
+		Slot->Count = 0U;
+		Slot->MinPeriod = SCHED_STOPPED;
+		Slot->MaxPeriod = 0U;
+		Slot->SumPeriod = 0U;
+		Slot->MaxJitter = 0U;
+		Slot->Deferred = 0U;
+
+		DISABLE_INTERRUPTS();
+
+		/* Sends counted from the next tick */
+		BaseTick = Sched_TickCount + 1U;
+
+		if(IsAutoOffset == true)
+		{
+			/* Ticks that ran during the search keep the phase, the first send moves by whole periods */
+			Late = ((int32_t)(BaseTick - FirstTick) > 0) ? (BaseTick - FirstTick) : 0U;
+			FirstTick += ((Late + Slot->PeriodTicks - 1U) / Slot->PeriodTicks) * Slot->PeriodTicks;
+		}
+		else
+		{
+			FirstTick = BaseTick + Offset;
+		}
+
+		Slot->FirstTick = FirstTick;
+		Slot->Countdown = (FirstTick - BaseTick) + 1U;
+
+		/* The tick sees the slot once it is complete */
+		Index = Sched_NoOfSlots;
+		Sched_NoOfSlots = Index + 1U;
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return Index;
+}
+
+void MID_CAN_SchedTrigger(uint8_t Slot)
+{
+	if(Slot >= Sched_NoOfSlots)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		Sched_Slot[Slot].IsTriggerPending = true;
+	}
+}
+
+void MID_CAN_SchedTick(void)
+{
+	Sched_SlotType *Slot = NULL;
+	uint32_t Now = 0U;
+	bool IsCycleDue = false;
+	uint8_t Index = 0U;
+
+	Sched_TickCount++;
+
+	for(Index = 0U; Index < Sched_NoOfSlots; Index++)
+	{
+		Slot = &Sched_Slot[Index];
+
+		if(Slot->SinceSend != SCHED_STOPPED)
+		{
+			Slot->SinceSend++;
+		}
+
+		if(Slot->Countdown != SCHED_STOPPED && Slot->Countdown > 0U)
+		{
+			Slot->Countdown--;
+		}
+
+		IsCycleDue = (Slot->Countdown == 0U);
+
+		if(IsCycleDue == false && (Slot->IsTriggerPending == false || Slot->SinceSend < Slot->MinDelayTicks))
+		{
+			/* Not due */
+		}
+		else if(Slot->Config.TxFunc(Slot->Config.Ins, Slot->Config.Handle) == true)
+		{
+			Now = FlexCAN_GetTime((FlexCAN_Instance_e)Slot->Config.Ins);
+
+			/* Only cyclic sends measure the period, a triggered send restarts the cycle */
+			if(IsCycleDue == true && Slot->IsSent == true && Slot->PeriodTicks != 0U)
+			{
+				Sched_Record(Slot, Now - Slot->LastSendTime);
+			}
+
+			Slot->LastSendTime = Now;
+			Slot->IsSent = true;
+			Slot->SinceSend = 0U;
+			Slot->IsTriggerPending = false;
+			Slot->Countdown = (Slot->PeriodTicks != 0U) ? Slot->PeriodTicks : SCHED_STOPPED;
+		}
+		else
+		{
+			/* Stays due, retried at the next tick */
+			Slot->Deferred++;
+		}
+	}
+}
+
+bool MID_CAN_SchedGetStats(uint8_t Slot, MID_CAN_SchedStatsType *Stats)
+{
+	const Sched_SlotType *State = &Sched_Slot[Slot];
+	bool IsValid = false;
+
+	if(Slot >= Sched_NoOfSlots || Stats == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		/* The tick updates the statistics */
+		DISABLE_INTERRUPTS();
+
+		Stats->Count = State->Count;
+		Stats->MinUs = (State->Count == 0U) ? 0U : (State->MinPeriod * SCHED_US_PER_MS) / MID_CAN_BITS_PER_MS;
+		Stats->MaxUs = (State->MaxPeriod * SCHED_US_PER_MS) / MID_CAN_BITS_PER_MS;
+		Stats->AvgUs = (State->Count == 0U) ? 0U
+		               : (uint32_t)((State->SumPeriod * SCHED_US_PER_MS) / ((uint64_t)State->Count * MID_CAN_BITS_PER_MS));
+		Stats->MaxJitterUs = (State->MaxJitter * SCHED_US_PER_MS) / MID_CAN_BITS_PER_MS;
+		Stats->Deferred = State->Deferred;
+
+		ENABLE_INTERRUPTS();
+
+		IsValid = true;
+	}
+
+	return IsValid;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static uint32_t Sched_MsToTicks(uint16_t Ms)
+{
+	/* Rounded up, a PDU is never sent faster than configured */
+	return (((uint32_t)Ms * SCHED_US_PER_MS) + Sched_TickUs - 1U) / Sched_TickUs;
+}
+
+/**
+ * Offset in [0, PeriodTicks) whose sends meet the fewest sends of the cyclic slots already
+ * registered, over their common hyperperiod. The first offset wins a tie.
+ */
+static uint32_t Sched_AutoOffset(uint32_t PeriodTicks, uint32_t BaseTick)
+{
+	const Sched_SlotType *Slot = NULL;
+	uint32_t Hyper = PeriodTicks;
+	uint64_t Lcm = 0U;
+	uint32_t Offset = 0U;
+	uint32_t BestOffset = 0U;
+	uint32_t BestCost = SCHED_STOPPED;
+	uint32_t Cost = 0U;
+	uint32_t Tick = 0U;
+	uint8_t Index = 0U;
+
+	for(Index = 0U; Index < Sched_NoOfSlots && Hyper < MID_CAN_SCHED_MAX_HYPERPERIOD; Index++)
+	{
+		if(Sched_Slot[Index].PeriodTicks != 0U)
+		{
+			Lcm = ((uint64_t)Hyper / Sched_Gcd(Hyper, Sched_Slot[Index].PeriodTicks)) * Sched_Slot[Index].PeriodTicks;
+			Hyper = (Lcm > MID_CAN_SCHED_MAX_HYPERPERIOD) ? MID_CAN_SCHED_MAX_HYPERPERIOD : (uint32_t)Lcm;
+		}
+	}
+
+	for(Offset = 0U; Offset < PeriodTicks && BestCost != 0U; Offset++)
+	{
+		Cost = 0U;
+
+		for(Tick = BaseTick + Offset; (Tick - BaseTick) < Hyper; Tick += PeriodTicks)
+		{
+			for(Index = 0U; Index < Sched_NoOfSlots; Index++)
+			{
+				Slot = &Sched_Slot[Index];
+
+				/* Signed distance, a slot may start after the candidate tick */
+				if(Slot->PeriodTicks != 0U && (((int64_t)(int32_t)(Tick - Slot->FirstTick)) % Slot->PeriodTicks) == 0)
+				{
+					Cost++;
+				}
+			}
+		}
+
+		if(Cost < BestCost)
+		{
+			BestCost = Cost;
+			BestOffset = Offset;
+		}
+	}
+
+	return BestOffset;
+}
+
+static uint32_t Sched_Gcd(uint32_t A, uint32_t B)
+{
+	uint32_t Rest = 0U;
+
+	while(B != 0U)
+	{
+		Rest = A % B;
+		A = B;
+		B = Rest;
+	}
+
+	return A;
+}
+
+static void Sched_Record(Sched_SlotType *Slot, uint32_t Period)
+{
+	uint32_t Nominal = (uint32_t)(((uint64_t)Slot->PeriodTicks * Sched_TickUs * MID_CAN_BITS_PER_MS) / SCHED_US_PER_MS);
+	uint32_t Jitter = (Period > Nominal) ? (Period - Nominal) : (Nominal - Period);
+
+	Slot->Count++;
+	Slot->SumPeriod += Period;
+	Slot->MinPeriod = (Period < Slot->MinPeriod) ? Period : Slot->MinPeriod;
+	Slot->MaxPeriod = (Period > Slot->MaxPeriod) ? Period : Slot->MaxPeriod;
+	Slot->MaxJitter = (Jitter > Slot->MaxJitter) ? Jitter : Slot->MaxJitter;
+}
@@ -0,0 +1,303 @@
+/*
+ * MIDDLE_CanSniffer.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanSniffer.h"
+#include <string.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define SNIFFER_BATCH_COUNT				(2U)
+#define SNIFFER_CHECKSUM_SIZE			(1U)
+#define SNIFFER_RECORD_HEADER_SIZE		(3U)		/*!< Flags and time offset */
+#define SNIFFER_STD_ID_SIZE				(2U)
+#define SNIFFER_EXT_ID_SIZE				(4U)
+#define SNIFFER_MAX_OFFSET				(0xFFFFU)
+#define SNIFFER_MAX_LOST				(0xFFFFU)
+#define SNIFFER_MAX_RECORDS				(0xFFU)
+
+typedef struct
+{
+	uint8_t						Data[MID_CAN_SNIFFER_BATCH_SIZE];
+	uint16_t					Length;			/*!< Header and records written so far */
+	uint8_t						Records;
+	uint16_t					Lost;			/*!< Frames lost before the first record */
+	uint32_t					Time;			/*!< CAN time of the first record */
+} Sniffer_BatchType;
+
+typedef struct
+{
+	MID_CAN_ModuleIns_e			Ins;
+	bool						IsInit;
+	Sniffer_BatchType			Batch[SNIFFER_BATCH_COUNT];
+	uint8_t						Fill;			/*!< Batch being filled, the other one may be on the UART */
+	volatile bool				IsSending;		/*!< Cleared by the UART transmitter callback */
+	uint32_t					Lost;			/*!< Frames lost since the last record */
+	uint32_t					FifoOverflow;	/*!< Rx FIFO overflow count already accounted */
+	MID_CAN_SnifferStatsType	Stats;
+} Sniffer_StateType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+static Sniffer_StateType Sniffer_State;
+
+/* Ring filled by the Rx FIFO, drained by MID_CAN_SnifferMainFunction */
+static FlexCAN_MbStructureType Sniffer_Ring[MID_CAN_SNIFFER_RING_LENGTH];
+
+/* No ID filter and a zero global mask: every data and remote frame, standard or extended */
+static FlexCAN_RxFifoConfigType Sniffer_RxFifoConfig = {
+	.Mode = FlexCAN_RXFIFO_LEGACY,
+	.IdFilterTable = NULL,
+	.NoOfIdFilters = 0U,
+	.GlobalMask = 0U,
+	.UseDma = false,
+	.DmaChannel = 0U,
+	.RingBuffer = Sniffer_Ring,
+	.RingLength = MID_CAN_SNIFFER_RING_LENGTH,
+	.BatchCallback = NULL,
+	.BatchContext = NULL
+};
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void Sniffer_TxDone(void);
+static void Sniffer_CountFifoLost(void);
+static bool Sniffer_IsFull(const Sniffer_BatchType *Batch, uint16_t Size, uint32_t Time);
+static void Sniffer_Send(void);
+static void Sniffer_Put(const FlexCAN_MbStructureType *Record, uint32_t Time);
+
+static void Sniffer_TxDone(void)
+{
+	/* UART transmitter interrupt, the main loop starts the next batch */
+	Sniffer_State.IsSending = false;
+}
+
+/* Frames the Rx FIFO lost since the last call precede the next record */
+static void Sniffer_CountFifoLost(void)
+{
+	uint32_t Overflow = FlexCAN_RxFifoGetOverflowCount(Sniffer_State.Ins);
+
+	Sniffer_State.Lost += Overflow - Sniffer_State.FifoOverflow;
+	Sniffer_State.Stats.FifoLost += Overflow - Sniffer_State.FifoOverflow;
+	Sniffer_State.FifoOverflow = Overflow;
+}
+
+/* A loss inside a batch closes it, so every loss is reported at the start of a batch */
+static bool Sniffer_IsFull(const Sniffer_BatchType *Batch, uint16_t Size, uint32_t Time)
+{
+	return (Batch->Records != 0U
+	        && (Sniffer_State.Lost != 0U || Batch->Records == SNIFFER_MAX_RECORDS
+	            || (Batch->Length + Size + SNIFFER_CHECKSUM_SIZE) > MID_CAN_SNIFFER_BATCH_SIZE
+	            || (Time - Batch->Time) > SNIFFER_MAX_OFFSET));
+}
+
+static void Sniffer_Send(void)
+{
+	Sniffer_BatchType *Batch = &Sniffer_State.Batch[Sniffer_State.Fill];
+	uint16_t RecordsLength = Batch->Length - MID_CAN_SNIFFER_HEADER_SIZE;
+	uint8_t Checksum = 0U;
+	uint16_t Index = 0U;
+
+	Batch->Data[0] = MID_CAN_SNIFFER_SYNC_0;
+	Batch->Data[1] = MID_CAN_SNIFFER_SYNC_1;
+	Batch->Data[2] = (uint8_t)RecordsLength;
+	Batch->Data[3] = (uint8_t)(RecordsLength >> 8U);
+	Batch->Data[4] = Batch->Records;
+	Batch->Data[5] = (uint8_t)Batch->Lost;
+	Batch->Data[6] = (uint8_t)(Batch->Lost >> 8U);
+	Batch->Data[7] = (uint8_t)Batch->Time;
+	Batch->Data[8] = (uint8_t)(Batch->Time >> 8U);
+	Batch->Data[9] = (uint8_t)(Batch->Time >> 16U);
+	Batch->Data[10] = (uint8_t)(Batch->Time >> 24U);
+
+	for(Index = 2U; Index < Batch->Length; Index++)
+	{
+		Checksum ^= Batch->Data[Index];
+	}
+
+	Batch->Data[Batch->Length] = Checksum;
+
+	/* Set first, the callback may come before the function returns */
+	Sniffer_State.IsSending = true;
+
+	if(MID_UART_SendDataInterrupt(MID_CAN_SNIFFER_UART, Batch->Data, Batch->Length + SNIFFER_CHECKSUM_SIZE) == true)
+	{
+		Sniffer_State.Stats.Batches++;
+		Sniffer_State.Stats.Bytes += Batch->Length + SNIFFER_CHECKSUM_SIZE;
+
+		Sniffer_State.Fill ^= 1U;
+		Sniffer_State.Batch[Sniffer_State.Fill].Records = 0U;
+	}
+	else
+	{
+		/* Transmitter still busy, the batch is sent later */
+		Sniffer_State.IsSending = false;
+	}
+}
+
+static void Sniffer_Put(const FlexCAN_MbStructureType *Record, uint32_t Time)
+{
+	Sniffer_BatchType *Batch = &Sniffer_State.Batch[Sniffer_State.Fill];
+	uint32_t ControlStatus = Record->Header[0];
+	uint32_t Id = 0U;
+	uint16_t Offset = 0U;
+	uint8_t Dlc = (uint8_t)((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
+	uint8_t DataLen = (Dlc > FLEXCAN_FRAME_MAX_DATA_LEN) ? FLEXCAN_FRAME_MAX_DATA_LEN : Dlc;
+	uint8_t Flags = Dlc & MID_CAN_SNIFFER_DLC_MASK;
+	uint8_t Index = 0U;
+	uint8_t * Out = NULL;
+	uint16_t Size = SNIFFER_RECORD_HEADER_SIZE;
+
+	if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK) != 0U)
+	{
+		Flags |= MID_CAN_SNIFFER_FLAG_RTR;
+		DataLen = 0U;
+	}
+
+	if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U)
+	{
+		Flags |= MID_CAN_SNIFFER_FLAG_IDE;
+		Id = (Record->Header[1] & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT;
+		Size += SNIFFER_EXT_ID_SIZE;
+	}
+	else
+	{
+		Id = (Record->Header[1] & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT;
+		Size += SNIFFER_STD_ID_SIZE;
+	}
+
+	Size += DataLen;
+
+	if(Sniffer_IsFull(Batch, Size, Time) == true && Sniffer_State.IsSending == false)
+	{
+		Sniffer_Send();
+		Batch = &Sniffer_State.Batch[Sniffer_State.Fill];
+	}
+
+	if(Sniffer_IsFull(Batch, Size, Time) == true)
+	{
+		/* Both batches in use: the UART is behind the bus */
+		Sniffer_State.Lost++;
+		Sniffer_State.Stats.UartDropped++;
+	}
+	else
+	{
+		if(Batch->Records == 0U)
+		{
+			Batch->Length = MID_CAN_SNIFFER_HEADER_SIZE;
+			Batch->Time = Time;
+			Batch->Lost = (Sniffer_State.Lost > SNIFFER_MAX_LOST) ? SNIFFER_MAX_LOST : (uint16_t)Sniffer_State.Lost;
+			Sniffer_State.Lost = 0U;
+		}
+
+		Offset = (uint16_t)(Time - Batch->Time);
+		Out = &Batch->Data[Batch->Length];
+
+		*Out++ = Flags;
+		*Out++ = (uint8_t)Offset;
+		*Out++ = (uint8_t)(Offset >> 8U);
+		*Out++ = (uint8_t)Id;
+		*Out++ = (uint8_t)(Id >> 8U);
+
+		if((Flags & MID_CAN_SNIFFER_FLAG_IDE) != 0U)
+		{
+			*Out++ = (uint8_t)(Id >> 16U);
+			*Out++ = (uint8_t)(Id >> 24U);
+		}
+
+		/* Payload words hold the first bus byte in their MSB */
+		for(Index = 0U; Index < DataLen; Index++)
+		{
+			*Out++ = (uint8_t)(Record->Payload[Index / 4U] >> (24U - (8U * (Index % 4U))));
+		}
+
+		Batch->Length += Size;
+		Batch->Records++;
+		Sniffer_State.Stats.Streamed++;
+	}
+}
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+bool MID_CAN_SnifferInit(const MID_CAN_SnifferConfigType *Config)
+{
+	bool IsValid = (Config != NULL && Config->Ins <= MODULE_2_INS);
+
+	if(IsValid == false)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		memset(&Sniffer_State, 0, sizeof(Sniffer_State));
+		Sniffer_State.Ins = Config->Ins;
+
+		Sniffer_RxFifoConfig.UseDma = Config->UseDma;
+		Sniffer_RxFifoConfig.DmaChannel = Config->DmaChannel;
+
+		/* The Rx FIFO is the only receiver, no mailbox is set up */
+		MID_CAN_SetRxFifoConfig(Config->Ins, &Sniffer_RxFifoConfig);
+		MID_CAN_SetMbLayout(Config->Ins, NULL, 0U);
+		MID_CAN_SetRunMode(Config->Ins, FlexCAN_MODE_LISTEN_ONLY);
+		MID_CAN_Init(Config->Ins);
+
+		MID_UART_SetBaudRate(MID_CAN_SNIFFER_BAUD_RATE);
+		MID_UART_Init();
+		MID_UART_InstallCallBack(MID_UART_callBackTransmitter, Sniffer_TxDone);
+
+		Sniffer_State.FifoOverflow = FlexCAN_RxFifoGetOverflowCount(Config->Ins);
+		Sniffer_State.IsInit = true;
+	}
+
+	return IsValid;
+}
+
+void MID_CAN_SnifferMainFunction(void)
+{
+	FlexCAN_MbStructureType Record;
+	uint32_t Now = 0U;
+
+	if(Sniffer_State.IsInit == false)
+	{
+		/* Not initialized */
+	}
+	else
+	{
+		while(FlexCAN_RxFifoRead(Sniffer_State.Ins, &Record) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+		{
+			Sniffer_State.Stats.Frames++;
+			Sniffer_CountFifoLost();
+
+			/* The record keeps the 16-bit timer, read within a timer period of the reception */
+			Now = FlexCAN_GetTime(Sniffer_State.Ins);
+			Sniffer_Put(&Record, Now - (uint16_t)((uint16_t)Now - (uint16_t)(Record.Header[0] & FLEXCAN_RAMn_DATA_WORD_0_TIME_STAMP_MASK)));
+		}
+
+		Sniffer_CountFifoLost();
+
+		/* A partial batch goes out as soon as the UART is free: small batches at low bus load */
+		if(Sniffer_State.IsSending == false && Sniffer_State.Batch[Sniffer_State.Fill].Records != 0U)
+		{
+			Sniffer_Send();
+		}
+	}
+}
+
+void MID_CAN_SnifferGetStats(MID_CAN_SnifferStatsType *Stats)
+{
+	if(Stats == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		*Stats = Sniffer_State.Stats;
+	}
+}
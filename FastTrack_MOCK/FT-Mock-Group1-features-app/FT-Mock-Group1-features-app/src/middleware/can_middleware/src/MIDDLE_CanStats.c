@@ -0,0 +1,784 @@
+/*
+ * MIDDLE_CanStats.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanStats.h"
+#include "s32_core_cm4.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define STATS_FREE_KEY					(0xFFFFFFFFU)	/*!< Instance 3 in MID_CAN_IDMAP_KEY layout, never a key */
+#define STATS_HASH_SEED					(0x9E3779B1U)
+#define STATS_HASH_SHIFT				(32U - MID_CAN_STATS_ID_BITS)
+#define STATS_KEY_INS_SHIFT				(30U)
+#define STATS_KEY_IDTYPE_SHIFT			(29U)
+#define STATS_KEY_ID_MASK				(0x1FFFFFFFU)
+
+#define STATS_PER_MILLE					(1000U)
+#define STATS_BITS_PER_MS				(MID_CAN_BIT_RATE / 1000U)
+#define STATS_US_PER_S					(1000000U)
+
+/* Frame layout, ISO 11898-1 classic frames */
+#define STATS_STD_ID_BITS				(11U)
+#define STATS_EXT_ID_B_BITS				(18U)
+#define STATS_EXT_ID_B_MASK				(0x3FFFFU)
+#define STATS_DLC_BITS					(4U)
+#define STATS_CRC_BITS					(15U)
+#define STATS_CRC_POLY					(0x4599U)
+#define STATS_CRC_MASK					(0x7FFFU)
+#define STATS_TRAILER_BITS				(13U)		/*!< CRC delimiter, ACK slot and delimiter, EOF, intermission */
+
+/* Stuffing state: level of the last bit times STATS_STUFF_RUN plus the length of its run.
+ * The start state is a recessive level with no run, SOF starts the first run */
+#define STATS_STUFF_RUN					(5U)
+#define STATS_STUFF_STATES				(2U * STATS_STUFF_RUN)
+#define STATS_STUFF_START				(STATS_STUFF_RUN)
+#define STATS_STUFF_STATE_MASK			(0x0FU)
+#define STATS_STUFF_COUNT_SHIFT			(4U)
+
+#define STATS_NIBBLE_BITS				(4U)
+#define STATS_NIBBLE_VALUES				(16U)
+#define STATS_HEADER_LINES				(1U + MID_CAN_STATS_WINDOW_COUNT)
+
+typedef struct
+{
+	uint32_t					Bits;
+	uint32_t					Frames;
+	uint32_t					Errors;
+} Stats_SlotType;
+
+typedef struct
+{
+	Stats_SlotType				Slot[MID_CAN_STATS_SLOTS];
+	Stats_SlotType				Sum;			/*!< Sum of the slots */
+	uint32_t					SlotBits;		/*!< Length of a slot */
+	uint32_t					SlotEnd;		/*!< Time the current slot closes */
+	uint8_t						Current;
+	uint8_t						Closed;			/*!< Slots closed since the start, up to a whole window */
+	uint16_t					PeakLoad;
+} Stats_WindowType;
+
+typedef struct
+{
+	bool						IsStarted;
+	uint32_t					StartTime;
+	uint32_t					Frames;
+	uint32_t					TxFrames;
+	uint32_t					Errors;
+	uint32_t					Untracked;
+	Stats_WindowType			Window[MID_CAN_STATS_WINDOW_COUNT];
+	uint32_t					DumpPeriod;		/*!< Bit times, 0 for no report */
+	uint32_t					DumpTime;		/*!< Time of the next report */
+} Stats_BusType;
+
+typedef struct
+{
+	uint32_t					Key;			/*!< MID_CAN_IDMAP_KEY of the ID, STATS_FREE_KEY if unused */
+	uint32_t					Frames;
+	uint32_t					TxFrames;
+	uint32_t					Bytes;
+	uint32_t					Bits;
+	uint32_t					LastTime;
+	uint32_t					GapMin;
+	uint32_t					GapMax;
+	uint32_t					GapCount;
+	uint64_t					GapSum;
+} Stats_EntryType;
+
+/* Bits of the frame not fed to the CRC and the stuffing yet, the last one in bit 0 */
+typedef struct
+{
+	uint64_t					Pending;
+	uint8_t						NoOfPending;
+	uint8_t						Stuff;			/*!< Stuffing state */
+	uint8_t						StuffBits;
+	uint16_t					Crc;
+	bool						IsCrcDone;		/*!< CRC field, stuffed but not part of the CRC */
+} Stats_StreamType;
+
+typedef struct
+{
+	bool						IsActive;		/*!< A report is being sent */
+	bool						IsPending;		/*!< Text holds a line not handed to the UART yet */
+	volatile bool				IsSending;		/*!< Cleared by the UART transmitter callback */
+	MID_CAN_ModuleIns_e			Ins;
+	uint8_t						Line;			/*!< Next header line, then next entry of Stats_Order */
+	char						Text[MID_CAN_STATS_LINE_SIZE];
+	uint16_t					Length;
+} Stats_DumpType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+/**
+ * Bus counters of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static Stats_BusType Stats_Bus[FLEXCAN_INSTANCE_COUNT];
+
+/* Open addressing on the key hash. Entries are never freed, so a free entry ends a probe */
+static Stats_EntryType Stats_Table[MID_CAN_STATS_MAX_IDS];
+static uint8_t Stats_Order[MID_CAN_STATS_MAX_IDS];			/*!< Table index of the IDs, first frame first */
+static volatile uint8_t Stats_NoOfIds;
+static bool Stats_IsTableReady;
+
+/* Four bits per step: CRC of (CRC >> 11) ^ nibble, next stuffing state and stuff bit count */
+static uint16_t Stats_CrcTable[STATS_NIBBLE_VALUES];
+static uint8_t Stats_StuffTable[STATS_STUFF_STATES][STATS_NIBBLE_VALUES];
+
+static Stats_DumpType Stats_Dump;
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static uint16_t Stats_CrcBit(uint16_t Crc, uint8_t Bit);
+static uint8_t Stats_StuffBit(uint8_t State, uint8_t Bit, uint8_t *StuffBits);
+static void Stats_BuildTables(void);
+static void Stats_Push(Stats_StreamType *Stream, uint32_t Value, uint8_t Width);
+static void Stats_Flush(Stats_StreamType *Stream);
+static Stats_EntryType * Stats_Find(uint32_t Key, bool IsAllocate);
+static void Stats_Advance(Stats_WindowType *Window, uint32_t Time);
+static uint16_t Stats_Load(const Stats_BusType *Bus, const Stats_WindowType *Window, uint32_t Time);
+static void Stats_Observer(FlexCAN_Instance_e Ins, FlexCAN_Event_e Event,
+                           const volatile FlexCAN_MbStructureType *Record, uint32_t Time);
+static void Stats_TxDone(void);
+static uint16_t Stats_FormatLine(void);
+
+static uint16_t Stats_CrcBit(uint16_t Crc, uint8_t Bit)
+{
+	uint16_t Feedback = ((Crc >> (STATS_CRC_BITS - 1U)) ^ Bit) & 1U;
+
+	Crc = (uint16_t)((Crc << 1U) & STATS_CRC_MASK);
+
+	return (Feedback != 0U) ? (Crc ^ STATS_CRC_POLY) : Crc;
+}
+
+/* After 5 bits of the same level the transmitter inserts one of the other level, it starts the next run */
+static uint8_t Stats_StuffBit(uint8_t State, uint8_t Bit, uint8_t *StuffBits)
+{
+	uint8_t Level = State / STATS_STUFF_RUN;
+	uint8_t Run = State % STATS_STUFF_RUN;
+
+	if(Bit == Level)
+	{
+		Run++;
+
+		if(Run == STATS_STUFF_RUN)
+		{
+			(*StuffBits)++;
+			Level ^= 1U;
+			Run = 1U;
+		}
+	}
+	else
+	{
+		Level = Bit;
+		Run = 1U;
+	}
+
+	return (uint8_t)((Level * STATS_STUFF_RUN) + Run);
+}
+
+/* The nibble tables are built from the bit functions, at most one stuff bit fits in four bits */
+static void Stats_BuildTables(void)
+{
+	uint8_t State = 0U;
+	uint8_t Nibble = 0U;
+	uint8_t Bit = 0U;
+	uint8_t Next = 0U;
+	uint8_t StuffBits = 0U;
+	uint16_t Crc = 0U;
+
+	for(Nibble = 0U; Nibble < STATS_NIBBLE_VALUES; Nibble++)
+	{
+		Crc = (uint16_t)Nibble << (STATS_CRC_BITS - STATS_NIBBLE_BITS);
+
+		for(Bit = 0U; Bit < STATS_NIBBLE_BITS; Bit++)
+		{
+			Crc = Stats_CrcBit(Crc, 0U);
+		}
+
+		Stats_CrcTable[Nibble] = Crc;
+
+		for(State = 0U; State < STATS_STUFF_STATES; State++)
+		{
+			Next = State;
+			StuffBits = 0U;
+
+			for(Bit = 0U; Bit < STATS_NIBBLE_BITS; Bit++)
+			{
+				Next = Stats_StuffBit(Next, (uint8_t)((Nibble >> (STATS_NIBBLE_BITS - 1U - Bit)) & 1U), &StuffBits);
+			}
+
+			Stats_StuffTable[State][Nibble] = (uint8_t)(Next | (StuffBits << STATS_STUFF_COUNT_SHIFT));
+		}
+	}
+}
+
+static void Stats_Push(Stats_StreamType *Stream, uint32_t Value, uint8_t Width)
+{
+	uint8_t Nibble = 0U;
+	uint8_t Entry = 0U;
+
+	Stream->Pending = (Stream->Pending << Width) | Value;
+	Stream->NoOfPending += Width;
+
+	while(Stream->NoOfPending >= STATS_NIBBLE_BITS)
+	{
+		Stream->NoOfPending -= STATS_NIBBLE_BITS;
+		Nibble = (uint8_t)((Stream->Pending >> Stream->NoOfPending) & (STATS_NIBBLE_VALUES - 1U));
+
+		if(Stream->IsCrcDone == false)
+		{
+			Stream->Crc = (uint16_t)(((Stream->Crc << STATS_NIBBLE_BITS)
+			                          ^ Stats_CrcTable[((Stream->Crc >> (STATS_CRC_BITS - STATS_NIBBLE_BITS)) ^ Nibble) & (STATS_NIBBLE_VALUES - 1U)])
+			                         & STATS_CRC_MASK);
+		}
+
+		Entry = Stats_StuffTable[Stream->Stuff][Nibble];
+		Stream->Stuff = Entry & STATS_STUFF_STATE_MASK;
+		Stream->StuffBits += Entry >> STATS_STUFF_COUNT_SHIFT;
+	}
+}
+
+/* Less than four bits are left, one at a time */
+static void Stats_Flush(Stats_StreamType *Stream)
+{
+	uint8_t Bit = 0U;
+
+	while(Stream->NoOfPending > 0U)
+	{
+		Stream->NoOfPending--;
+		Bit = (uint8_t)((Stream->Pending >> Stream->NoOfPending) & 1U);
+
+		if(Stream->IsCrcDone == false)
+		{
+			Stream->Crc = Stats_CrcBit(Stream->Crc, Bit);
+		}
+
+		Stream->Stuff = Stats_StuffBit(Stream->Stuff, Bit, &Stream->StuffBits);
+	}
+}
+
+static Stats_EntryType * Stats_Find(uint32_t Key, bool IsAllocate)
+{
+	Stats_EntryType *Found = NULL;
+	uint8_t Home = (uint8_t)((Key * STATS_HASH_SEED) >> STATS_HASH_SHIFT);
+	uint8_t Index = 0U;
+	uint8_t Probe = 0U;
+	bool IsEnd = false;
+
+	for(Probe = 0U; Probe < MID_CAN_STATS_MAX_PROBES && Found == NULL && IsEnd == false; Probe++)
+	{
+		Index = (uint8_t)((Home + Probe) & (MID_CAN_STATS_MAX_IDS - 1U));
+
+		if(Stats_Table[Index].Key == Key)
+		{
+			Found = &Stats_Table[Index];
+		}
+		else if(Stats_Table[Index].Key == STATS_FREE_KEY)
+		{
+			if(IsAllocate == true)
+			{
+				Found = &Stats_Table[Index];
+				memset(Found, 0, sizeof(*Found));
+				Found->Key = Key;
+				Stats_Order[Stats_NoOfIds] = Index;
+				Stats_NoOfIds++;
+			}
+
+			IsEnd = true;
+		}
+		else
+		{
+			/* Another ID, try the next entry */
+		}
+	}
+
+	return Found;
+}
+
+/* Closes the slots ended before Time, a window idle for its whole length is just emptied */
+static void Stats_Advance(Stats_WindowType *Window, uint32_t Time)
+{
+	uint8_t Steps = 0U;
+	uint32_t Load = 0U;
+
+	while((int32_t)(Time - Window->SlotEnd) >= 0)
+	{
+		if(Steps == MID_CAN_STATS_SLOTS)
+		{
+			Window->SlotEnd += (((Time - Window->SlotEnd) / Window->SlotBits) + 1U) * Window->SlotBits;
+		}
+		else
+		{
+			if(Window->Closed < MID_CAN_STATS_SLOTS)
+			{
+				Window->Closed++;
+			}
+
+			if(Window->Closed == MID_CAN_STATS_SLOTS)
+			{
+				Load = (uint32_t)(((uint64_t)Window->Sum.Bits * STATS_PER_MILLE) / (MID_CAN_STATS_SLOTS * Window->SlotBits));
+				Window->PeakLoad = (Load > Window->PeakLoad) ? (uint16_t)Load : Window->PeakLoad;
+			}
+
+			Window->Current = (uint8_t)((Window->Current + 1U) % MID_CAN_STATS_SLOTS);
+			Window->Sum.Bits -= Window->Slot[Window->Current].Bits;
+			Window->Sum.Frames -= Window->Slot[Window->Current].Frames;
+			Window->Sum.Errors -= Window->Slot[Window->Current].Errors;
+			memset(&Window->Slot[Window->Current], 0, sizeof(Stats_SlotType));
+
+			Window->SlotEnd += Window->SlotBits;
+			Steps++;
+		}
+	}
+}
+
+static uint16_t Stats_Load(const Stats_BusType *Bus, const Stats_WindowType *Window, uint32_t Time)
+{
+	uint32_t Span = ((MID_CAN_STATS_SLOTS - 1U) * Window->SlotBits) + (Time - (Window->SlotEnd - Window->SlotBits));
+	uint32_t Load = 0U;
+
+	/* Shorter until the window is filled */
+	if((Time - Bus->StartTime) < Span)
+	{
+		Span = Time - Bus->StartTime;
+	}
+
+	if(Span != 0U)
+	{
+		Load = (uint32_t)(((uint64_t)Window->Sum.Bits * STATS_PER_MILLE) / Span);
+	}
+
+	return (Load > STATS_PER_MILLE) ? (uint16_t)STATS_PER_MILLE : (uint16_t)Load;
+}
+
+static void Stats_Observer(FlexCAN_Instance_e Ins, FlexCAN_Event_e Event,
+                           const volatile FlexCAN_MbStructureType *Record, uint32_t Time)
+{
+	Stats_BusType *Bus = &Stats_Bus[Ins];
+	Stats_EntryType *Entry = NULL;
+	Stats_WindowType *Window = NULL;
+	uint32_t ControlStatus = 0U;
+	uint32_t Key = 0U;
+	uint32_t Bits = MID_CAN_STATS_ERROR_FRAME_BITS;
+	uint32_t Gap = 0U;
+	uint8_t DataLen = 0U;
+	uint8_t Index = 0U;
+	bool IsError = (Event == FLEXCAN_EVENT_ERROR || Record == NULL);
+
+	if(IsError == false)
+	{
+		ControlStatus = Record->Header[0];
+		Bits = MID_CAN_StatsFrameBits(Record);
+
+		if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK) == 0U)
+		{
+			DataLen = (uint8_t)((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
+			DataLen = (DataLen > FLEXCAN_FRAME_MAX_DATA_LEN) ? FLEXCAN_FRAME_MAX_DATA_LEN : DataLen;
+		}
+
+		if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U)
+		{
+			Key = MID_CAN_IDMAP_KEY(Ins, (Record->Header[1] & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT,
+			                        FlexCAN_EXTENDED);
+		}
+		else
+		{
+			Key = MID_CAN_IDMAP_KEY(Ins, (Record->Header[1] & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT,
+			                        FlexCAN_STANDARD);
+		}
+	}
+
+	/* The MB, Rx FIFO, eDMA and error interrupts may preempt each other */
+	DISABLE_INTERRUPTS();
+
+	for(Index = 0U; Index < MID_CAN_STATS_WINDOW_COUNT; Index++)
+	{
+		Window = &Bus->Window[Index];
+		Stats_Advance(Window, Time);
+
+		Window->Slot[Window->Current].Bits += Bits;
+		Window->Sum.Bits += Bits;
+
+		if(IsError == true)
+		{
+			Window->Slot[Window->Current].Errors++;
+			Window->Sum.Errors++;
+		}
+		else
+		{
+			Window->Slot[Window->Current].Frames++;
+			Window->Sum.Frames++;
+		}
+	}
+
+	if(IsError == true)
+	{
+		Bus->Errors++;
+	}
+	else
+	{
+		Bus->Frames++;
+		Bus->TxFrames += (Event == FLEXCAN_EVENT_TX) ? 1U : 0U;
+
+		Entry = Stats_Find(Key, true);
+
+		if(Entry == NULL)
+		{
+			/* No free entry within the probe limit */
+			Bus->Untracked++;
+		}
+		else
+		{
+			Gap = Time - Entry->LastTime;
+
+			/* Frames handled late, an Rx FIFO batch after a mailbox, may come out of order */
+			if(Entry->Frames != 0U && (int32_t)Gap >= 0)
+			{
+				Entry->GapMin = (Entry->GapCount == 0U || Gap < Entry->GapMin) ? Gap : Entry->GapMin;
+				Entry->GapMax = (Gap > Entry->GapMax) ? Gap : Entry->GapMax;
+				Entry->GapSum += Gap;
+				Entry->GapCount++;
+			}
+
+			Entry->LastTime = Time;
+			Entry->Frames++;
+			Entry->TxFrames += (Event == FLEXCAN_EVENT_TX) ? 1U : 0U;
+			Entry->Bytes += DataLen;
+			Entry->Bits += Bits;
+		}
+	}
+
+	ENABLE_INTERRUPTS();
+}
+
+static void Stats_TxDone(void)
+{
+	/* UART transmitter interrupt, the main loop sends the next line */
+	Stats_Dump.IsSending = false;
+}
+
+/* Formats the next line of the report in progress, 0 when the report is complete */
+static uint16_t Stats_FormatLine(void)
+{
+	MID_CAN_StatsBusType Bus;
+	MID_CAN_StatsIdType Id;
+	const MID_CAN_StatsWindowType *Window = NULL;
+	unsigned int Ins = (unsigned int)Stats_Dump.Ins;
+	int Length = 0;
+
+	if(Stats_Dump.Line == 0U)
+	{
+		(void)MID_CAN_StatsGetBus(Stats_Dump.Ins, &Bus);
+		Length = snprintf(Stats_Dump.Text, sizeof(Stats_Dump.Text), "can%u frames %lu tx %lu errors %lu untracked %lu\n",
+		                  Ins, (unsigned long)Bus.Frames, (unsigned long)Bus.TxFrames,
+		                  (unsigned long)Bus.Errors, (unsigned long)Bus.Untracked);
+		Stats_Dump.Line++;
+	}
+	else if(Stats_Dump.Line < STATS_HEADER_LINES)
+	{
+		(void)MID_CAN_StatsGetBus(Stats_Dump.Ins, &Bus);
+		Window = &Bus.Window[Stats_Dump.Line - 1U];
+		Length = snprintf(Stats_Dump.Text, sizeof(Stats_Dump.Text), "can%u %lums load %u.%u%% peak %u.%u%% frames %lu errors %lu\n",
+		                  Ins, (unsigned long)Window->LengthMs, Window->Load / 10U, Window->Load % 10U,
+		                  Window->PeakLoad / 10U, Window->PeakLoad % 10U,
+		                  (unsigned long)Window->Frames, (unsigned long)Window->Errors);
+		Stats_Dump.Line++;
+	}
+	else
+	{
+		/* IDs of the other instances are skipped */
+		while(Length == 0 && MID_CAN_StatsGetId((uint8_t)(Stats_Dump.Line - STATS_HEADER_LINES), &Id) == true)
+		{
+			if(Id.Ins == Stats_Dump.Ins)
+			{
+				Length = snprintf(Stats_Dump.Text, sizeof(Stats_Dump.Text),
+				                  "can%u %s 0x%lX rx %lu tx %lu bytes %lu bits %lu gap %lu/%lu/%lu us\n",
+				                  Ins, (Id.IdType == FlexCAN_EXTENDED) ? "ext" : "std", (unsigned long)Id.Id,
+				                  (unsigned long)(Id.Frames - Id.TxFrames), (unsigned long)Id.TxFrames,
+				                  (unsigned long)Id.Bytes, (unsigned long)Id.Bits,
+				                  (unsigned long)(((uint64_t)Id.GapMin * STATS_US_PER_S) / MID_CAN_BIT_RATE),
+				                  (unsigned long)(((uint64_t)Id.GapMean * STATS_US_PER_S) / MID_CAN_BIT_RATE),
+				                  (unsigned long)(((uint64_t)Id.GapMax * STATS_US_PER_S) / MID_CAN_BIT_RATE));
+			}
+
+			Stats_Dump.Line++;
+		}
+	}
+
+	/* A truncated line keeps its start */
+	if(Length >= (int)sizeof(Stats_Dump.Text))
+	{
+		Length = (int)sizeof(Stats_Dump.Text) - 1;
+	}
+
+	return (Length > 0) ? (uint16_t)Length : 0U;
+}
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void MID_CAN_StatsInit(MID_CAN_ModuleIns_e Ins, uint32_t DumpPeriodMs)
+{
+	Stats_BusType *Bus = NULL;
+	uint32_t Now = 0U;
+	uint32_t Key = 0U;
+	uint8_t Index = 0U;
+
+	if(Ins > MODULE_2_INS)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		Bus = &Stats_Bus[Ins];
+		Now = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+
+		DISABLE_INTERRUPTS();
+
+		if(Stats_IsTableReady == false)
+		{
+			Stats_BuildTables();
+
+			for(Index = 0U; Index < MID_CAN_STATS_MAX_IDS; Index++)
+			{
+				Stats_Table[Index].Key = STATS_FREE_KEY;
+			}
+
+			Stats_NoOfIds = 0U;
+			Stats_IsTableReady = true;
+		}
+
+		/* Entries of the instance are cleared in place, the probe chains stay intact */
+		for(Index = 0U; Index < MID_CAN_STATS_MAX_IDS; Index++)
+		{
+			Key = Stats_Table[Index].Key;
+
+			if(Key != STATS_FREE_KEY && (Key >> STATS_KEY_INS_SHIFT) == (uint32_t)Ins)
+			{
+				memset(&Stats_Table[Index], 0, sizeof(Stats_EntryType));
+				Stats_Table[Index].Key = Key;
+			}
+		}
+
+		memset(Bus, 0, sizeof(*Bus));
+		Bus->StartTime = Now;
+		Bus->Window[MID_CAN_STATS_WINDOW_SHORT].SlotBits = MID_CAN_STATS_SHORT_SLOT_BITS;
+		Bus->Window[MID_CAN_STATS_WINDOW_LONG].SlotBits = MID_CAN_STATS_LONG_SLOT_BITS;
+
+		for(Index = 0U; Index < MID_CAN_STATS_WINDOW_COUNT; Index++)
+		{
+			Bus->Window[Index].SlotEnd = Now + Bus->Window[Index].SlotBits;
+		}
+
+		Bus->DumpPeriod = DumpPeriodMs * STATS_BITS_PER_MS;
+		Bus->DumpTime = Now + Bus->DumpPeriod;
+		Bus->IsStarted = true;
+
+		ENABLE_INTERRUPTS();
+
+		FlexCAN_SetObserver((FlexCAN_Instance_e)Ins, Stats_Observer);
+
+		if(DumpPeriodMs != 0U)
+		{
+			MID_UART_InstallCallBack(MID_UART_callBackTransmitter, Stats_TxDone);
+		}
+	}
+}
+
+void MID_CAN_StatsMainFunction(void)
+{
+	Stats_BusType *Bus = NULL;
+	uint32_t Now = 0U;
+	uint8_t Ins = 0U;
+
+	/* Reports are due on the CAN timer of their instance, one at a time */
+	for(Ins = 0U; Ins < FLEXCAN_INSTANCE_COUNT && Stats_Dump.IsActive == false; Ins++)
+	{
+		Bus = &Stats_Bus[Ins];
+
+		if(Bus->IsStarted == true && Bus->DumpPeriod != 0U)
+		{
+			Now = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+
+			if((int32_t)(Now - Bus->DumpTime) >= 0)
+			{
+				/* A late report does not make the next ones come faster */
+				Bus->DumpTime = ((Now - Bus->DumpTime) >= Bus->DumpPeriod) ? (Now + Bus->DumpPeriod)
+				                                                           : (Bus->DumpTime + Bus->DumpPeriod);
+				Stats_Dump.IsActive = true;
+				Stats_Dump.Ins = (MID_CAN_ModuleIns_e)Ins;
+				Stats_Dump.Line = 0U;
+			}
+		}
+	}
+
+	if(Stats_Dump.IsActive == true && Stats_Dump.IsSending == false)
+	{
+		if(Stats_Dump.IsPending == false)
+		{
+			Stats_Dump.Length = Stats_FormatLine();
+			Stats_Dump.IsPending = (Stats_Dump.Length != 0U);
+			Stats_Dump.IsActive = Stats_Dump.IsPending;
+		}
+
+		if(Stats_Dump.IsPending == true)
+		{
+			/* Set first, the callback may come before the function returns */
+			Stats_Dump.IsSending = true;
+
+			if(MID_UART_SendDataInterrupt(MID_CAN_STATS_UART, (uint8_t *)Stats_Dump.Text, Stats_Dump.Length) == true)
+			{
+				Stats_Dump.IsPending = false;
+			}
+			else
+			{
+				/* Transmitter busy with something else, the line is sent later */
+				Stats_Dump.IsSending = false;
+			}
+		}
+	}
+}
+
+bool MID_CAN_StatsGetBus(MID_CAN_ModuleIns_e Ins, MID_CAN_StatsBusType *Stats)
+{
+	Stats_BusType *Bus = NULL;
+	Stats_WindowType *Window = NULL;
+	uint32_t Now = 0U;
+	uint8_t Index = 0U;
+	bool IsValid = (Ins <= MODULE_2_INS && Stats != NULL && Stats_Bus[Ins].IsStarted == true);
+
+	if(IsValid == false)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		Bus = &Stats_Bus[Ins];
+
+		/* Read inside, an error interrupt takes its time at the interrupt */
+		DISABLE_INTERRUPTS();
+
+		Now = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+		Stats->Frames = Bus->Frames;
+		Stats->TxFrames = Bus->TxFrames;
+		Stats->Errors = Bus->Errors;
+		Stats->Untracked = Bus->Untracked;
+
+		for(Index = 0U; Index < MID_CAN_STATS_WINDOW_COUNT; Index++)
+		{
+			Window = &Bus->Window[Index];
+			Stats_Advance(Window, Now);
+
+			Stats->Window[Index].LengthMs = (MID_CAN_STATS_SLOTS * Window->SlotBits) / STATS_BITS_PER_MS;
+			Stats->Window[Index].Load = Stats_Load(Bus, Window, Now);
+			Stats->Window[Index].PeakLoad = Window->PeakLoad;
+			Stats->Window[Index].Frames = Window->Sum.Frames;
+			Stats->Window[Index].Errors = Window->Sum.Errors;
+		}
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return IsValid;
+}
+
+uint8_t MID_CAN_StatsGetIdCount(void)
+{
+	return Stats_NoOfIds;
+}
+
+bool MID_CAN_StatsGetId(uint8_t Index, MID_CAN_StatsIdType *Stats)
+{
+	Stats_EntryType Entry;
+	bool IsValid = (Stats != NULL && Index < Stats_NoOfIds);
+
+	if(IsValid == false)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		/* Consistent copy, the observer updates the entry from interrupt */
+		DISABLE_INTERRUPTS();
+		Entry = Stats_Table[Stats_Order[Index]];
+		ENABLE_INTERRUPTS();
+
+		Stats->Ins = (MID_CAN_ModuleIns_e)(Entry.Key >> STATS_KEY_INS_SHIFT);
+		Stats->IdType = (FlexCAN_MsgIDType_e)((Entry.Key >> STATS_KEY_IDTYPE_SHIFT) & 1U);
+		Stats->Id = Entry.Key & STATS_KEY_ID_MASK;
+		Stats->Frames = Entry.Frames;
+		Stats->TxFrames = Entry.TxFrames;
+		Stats->Bytes = Entry.Bytes;
+		Stats->Bits = Entry.Bits;
+		Stats->GapMin = Entry.GapMin;
+		Stats->GapMax = Entry.GapMax;
+		Stats->GapMean = (Entry.GapCount != 0U) ? (uint32_t)(Entry.GapSum / Entry.GapCount) : 0U;
+	}
+
+	return IsValid;
+}
+
+uint32_t MID_CAN_StatsFrameBits(const volatile FlexCAN_MbStructureType *Record)
+{
+	Stats_StreamType Stream;
+	uint32_t ControlStatus = Record->Header[0];
+	uint32_t Id = 0U;
+	uint32_t Rtr = (ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_RTR_SHIFT;
+	uint8_t Dlc = (uint8_t)((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_DLC_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_DLC_SHIFT);
+	uint8_t DataLen = (Dlc > FLEXCAN_FRAME_MAX_DATA_LEN) ? FLEXCAN_FRAME_MAX_DATA_LEN : Dlc;
+	uint8_t Bytes = 0U;
+	uint8_t Word = 0U;
+	uint32_t NoOfBits = 0U;
+
+	memset(&Stream, 0, sizeof(Stream));
+	Stream.Stuff = STATS_STUFF_START;
+
+	DataLen = (Rtr != 0U) ? 0U : DataLen;
+
+	/* SOF, arbitration and control fields */
+	Stats_Push(&Stream, 0U, 1U);
+
+	if((ControlStatus & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U)
+	{
+		Id = (Record->Header[1] & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_SHIFT;
+		Stats_Push(&Stream, Id >> STATS_EXT_ID_B_BITS, STATS_STD_ID_BITS);
+		Stats_Push(&Stream, 3U, 2U);								/* SRR, IDE */
+		Stats_Push(&Stream, Id & STATS_EXT_ID_B_MASK, STATS_EXT_ID_B_BITS);
+		Stats_Push(&Stream, Rtr << 2U, 3U);							/* RTR, r1, r0 */
+		NoOfBits = 1U + STATS_STD_ID_BITS + 2U + STATS_EXT_ID_B_BITS + 3U;
+	}
+	else
+	{
+		Id = (Record->Header[1] & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT;
+		Stats_Push(&Stream, Id, STATS_STD_ID_BITS);
+		Stats_Push(&Stream, Rtr << 2U, 3U);							/* RTR, IDE, r0 */
+		NoOfBits = 1U + STATS_STD_ID_BITS + 3U;
+	}
+
+	Stats_Push(&Stream, Dlc, STATS_DLC_BITS);
+
+	/* Payload words hold the first bus byte in their MSB */
+	for(Word = 0U; (Word * 4U) < DataLen; Word++)
+	{
+		Bytes = ((DataLen - (Word * 4U)) > 4U) ? 4U : (uint8_t)(DataLen - (Word * 4U));
+		Stats_Push(&Stream, Record->Payload[Word] >> (32U - (8U * Bytes)), (uint8_t)(8U * Bytes));
+	}
+
+	Stats_Flush(&Stream);
+
+	/* The CRC field is stuffed too */
+	Stream.IsCrcDone = true;
+	Stats_Push(&Stream, Stream.Crc, STATS_CRC_BITS);
+	Stats_Flush(&Stream);
+
+	return NoOfBits + STATS_DLC_BITS + (8U * DataLen) + STATS_CRC_BITS + Stream.StuffBits + STATS_TRAILER_BITS;
+}
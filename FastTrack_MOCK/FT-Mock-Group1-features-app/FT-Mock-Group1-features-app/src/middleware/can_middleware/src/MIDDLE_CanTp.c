@@ -0,0 +1,805 @@
+/*
+ * MIDDLE_CanTp.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanTp.h"
+#include "MIDDLE_CanHealth.h"
+#include "MIDDLE_CanFilter.h"
+#include "s32_core_cm4.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define TP_FRAME_LEN					(8U)
+#define TP_PCI_TYPE_MASK				(0xF0U)
+#define TP_PCI_LOW_MASK					(0x0FU)
+#define TP_PCI_SF						(0x00U)
+#define TP_PCI_FF						(0x10U)
+#define TP_PCI_CF						(0x20U)
+#define TP_PCI_FC						(0x30U)
+#define TP_SF_MAX_DATA					(7U)
+#define TP_FF_DATA						(6U)
+#define TP_CF_MAX_DATA					(7U)
+#define TP_FC_LEN						(3U)
+#define TP_FS_CTS						(0U)
+#define TP_FS_WAIT						(1U)
+#define TP_FS_OVFLW						(2U)
+#define TP_SN_MASK						(0x0FU)
+#define TP_STMIN_MAX_MS					(0x7FU)
+#define TP_STMIN_US_FIRST				(0xF1U)
+#define TP_STMIN_US_LAST				(0xF9U)
+#define TP_BITS_PER_100US				(MID_CAN_BITS_PER_MS / 10U)
+
+typedef enum
+{
+	TP_TX_IDLE = 0U,
+	TP_TX_SEND_SF,						/*!< Single frame waits for the mailbox */
+	TP_TX_SEND_FF,						/*!< First frame waits for the mailbox */
+	TP_TX_WAIT_FC,						/*!< N_Bs running */
+	TP_TX_SEND_CF,						/*!< Consecutive frames of the block, paced by STmin */
+	TP_TX_WAIT_DONE						/*!< Last frame handed to the mailbox */
+} Tp_TxState_e;
+
+typedef enum
+{
+	TP_IN_FLIGHT_NONE = 0U,
+	TP_IN_FLIGHT_DATA,
+	TP_IN_FLIGHT_FC,
+	TP_IN_FLIGHT_ABORT					/*!< N_As or N_Ar expired, the main function aborts the frame */
+} Tp_InFlight_e;
+
+typedef struct
+{
+	const MID_CAN_TpChannelConfigType * Config;
+	uint8_t						Index;			/*!< Channel number given to the callbacks */
+
+	/* Sender */
+	Tp_TxState_e				TxState;
+	Tp_InFlight_e				InFlight;		/*!< Frame owning the Tx mailbox */
+	const uint8_t			  * TxData;			/*!< Caller buffer, not copied */
+	uint16_t					TxLength;
+	uint16_t					TxOffset;		/*!< Next byte to send */
+	uint8_t						TxSn;
+	uint8_t						TxBs;			/*!< Block size of the peer */
+	uint8_t						TxBlockLeft;	/*!< Frames left before the next flow control */
+	bool						IsCfImmediate;	/*!< First CF after a CTS ignores STmin */
+	uint32_t					TxStminTicks;	/*!< STmin of the peer in FlexCAN timer ticks */
+	uint32_t					TxLastTime;		/*!< End of the last CF, or start of N_Bs */
+	uint32_t					TxFrameTime;	/*!< Start of N_As or N_Ar, frame handed to the mailbox */
+
+	/* Receiver */
+	bool						IsRxActive;
+	bool						IsFcPending;
+	uint8_t						FcStatus;
+	uint8_t					  * RxBuffer;		/*!< Caller buffer, frames are copied straight into it */
+	uint16_t					RxBufferSize;
+	uint16_t					RxLength;
+	uint16_t					RxOffset;
+	uint8_t						RxSn;
+	uint8_t						RxBs;			/*!< Block size sent to the peer */
+	uint8_t						RxStmin;		/*!< STmin sent to the peer */
+	uint8_t						RxBlockLeft;
+	uint32_t					RxLastTime;		/*!< Start of N_Cr */
+} Tp_ChannelStateType;
+
+/**
+ * Callbacks collected while the channel is locked, called once it is released.
+ */
+typedef struct
+{
+	bool						IsTxDone;
+	MID_CAN_TpResult_e			TxResult;
+	bool						IsRxReplaced;	/*!< A reception was dropped for a new message */
+	bool						IsRxDone;
+	MID_CAN_TpResult_e			RxResult;
+	const uint8_t			  * RxData;
+	uint16_t					RxLength;
+} Tp_EventType;
+
+typedef struct
+{
+	uint8_t						NoOfChannels;	/*!< 0 while the transport is not initialized */
+	Tp_ChannelStateType			Channel[MID_CAN_TP_MAX_CHANNELS];
+} Tp_StateType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+/**
+ * ISO-TP state of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static Tp_StateType Tp_State[FLEXCAN_INSTANCE_COUNT];
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void Tp_TxMbHandler(FlexCAN_Instance_e Ins, uint8_t MbIndex, void *Context);
+static void Tp_RxMbHandler(FlexCAN_Instance_e Ins, uint8_t MbIndex, void *Context);
+static void Tp_ProcessFrame(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel, const FlexCAN_FrameType *Frame, Tp_EventType *Event);
+static void Tp_ProcessFc(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel, const FlexCAN_FrameType *Frame, Tp_EventType *Event);
+static void Tp_StartRx(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel, const FlexCAN_FrameType *Frame, Tp_EventType *Event);
+static void Tp_Schedule(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel);
+static void Tp_SendFrame(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel, const uint8_t *Pci, uint8_t PciLen,
+                         const uint8_t *Data, uint8_t DataLen);
+static uint32_t Tp_StminToTicks(uint8_t STmin);
+static void Tp_Notify(MID_CAN_ModuleIns_e Ins, const Tp_ChannelStateType *Channel, const Tp_EventType *Event);
+static bool Tp_CheckChannel(const MID_CAN_TpChannelConfigType *Config);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+bool MID_CAN_TpInit(MID_CAN_ModuleIns_e Ins, const MID_CAN_TpChannelConfigType *Channels, uint8_t NoOfChannels)
+{
+	Tp_StateType *Tp = &Tp_State[Ins];
+	Tp_ChannelStateType *Channel = NULL;
+	const MID_CAN_TpChannelConfigType *Config = NULL;
+	FlexCAN_RxFilterType Filter;
+	bool IsValid = false;
+	uint8_t Index = 0U;
+
+	MID_CAN_UserConfigType UserConfig = {
+			.DataLen = TP_FRAME_LEN,
+			.MbInt = true
+	};
+
+	Tp->NoOfChannels = 0U;
+
+	if(Channels == NULL || NoOfChannels == 0U || NoOfChannels > MID_CAN_TP_MAX_CHANNELS)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		IsValid = true;
+
+		for(Index = 0U; Index < NoOfChannels && IsValid == true; Index++)
+		{
+			IsValid = Tp_CheckChannel(&Channels[Index]);
+		}
+
+		for(Index = 0U; Index < NoOfChannels && IsValid == true; Index++)
+		{
+			Config = &Channels[Index];
+			Channel = &Tp->Channel[Index];
+
+			Channel->Config = Config;
+			Channel->Index = Index;
+			Channel->TxState = TP_TX_IDLE;
+			Channel->InFlight = TP_IN_FLIGHT_NONE;
+			Channel->IsRxActive = false;
+			Channel->IsFcPending = false;
+			Channel->RxBuffer = Config->RxBuffer;
+			Channel->RxBufferSize = Config->RxBufferSize;
+			Channel->RxBs = Config->BlockSize;
+			Channel->RxStmin = Config->STmin;
+
+			/* Tx complete interrupt sends the next frame without waiting for the main loop */
+			UserConfig.MbIndex = Config->TxMbIndex;
+			UserConfig.MbID = Config->TxId;
+			UserConfig.HandlerFunc = Tp_TxMbHandler;
+			UserConfig.Context = Channel;
+			UserConfig.HandlerType = (MID_CAN_Handler_e)Config->TxMbIndex;
+			MID_CAN_SetCallback(Ins, &UserConfig);
+			MID_CAN_StdTxMbInit(Ins, &UserConfig);
+
+			if(Config->RxMbIndex != MID_CAN_TP_NO_MB)
+			{
+				Filter.Id = Config->RxId;
+				Filter.Mask = (Config->IdType == FlexCAN_EXTENDED) ? MID_CAN_FILTER_EXT_ID_MAX : MID_CAN_FILTER_STD_ID_MAX;
+				Filter.IdType = Config->IdType;
+
+				UserConfig.HandlerFunc = Tp_RxMbHandler;
+				IsValid = MID_CAN_RxFilterInit(Ins, (FlexCAN_MbIndex_e)Config->RxMbIndex, &Filter, 1U, &UserConfig);
+			}
+		}
+
+		Tp->NoOfChannels = (IsValid == true) ? NoOfChannels : 0U;
+	}
+
+	return IsValid;
+}
+
+bool MID_CAN_TpTransmit(MID_CAN_ModuleIns_e Ins, uint8_t Channel, const uint8_t *Data, uint16_t Length)
+{
+	Tp_ChannelStateType *State = &Tp_State[Ins].Channel[Channel];
+	bool IsStarted = false;
+
+	if(Channel >= Tp_State[Ins].NoOfChannels || Data == NULL || Length == 0U || Length > MID_CAN_TP_MAX_LENGTH)
+	{
+		/* Invalid parameters or transport not initialized */
+	}
+	else
+	{
+		/* The Tx and Rx interrupts drive the same channel */
+		DISABLE_INTERRUPTS();
+
+		if(State->TxState == TP_TX_IDLE)
+		{
+			State->TxData = Data;
+			State->TxLength = Length;
+			State->TxOffset = 0U;
+			State->TxState = (Length <= TP_SF_MAX_DATA) ? TP_TX_SEND_SF : TP_TX_SEND_FF;
+
+			Tp_Schedule(Ins, State);
+
+			IsStarted = true;
+		}
+		else
+		{
+			/* Previous message still being sent */
+		}
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return IsStarted;
+}
+
+bool MID_CAN_TpSetRxBuffer(MID_CAN_ModuleIns_e Ins, uint8_t Channel, uint8_t *Buffer, uint16_t Size)
+{
+	Tp_ChannelStateType *State = &Tp_State[Ins].Channel[Channel];
+	bool IsSet = false;
+
+	if(Channel >= Tp_State[Ins].NoOfChannels || (Buffer == NULL && Size != 0U))
+	{
+		/* Invalid parameters or transport not initialized */
+	}
+	else
+	{
+		DISABLE_INTERRUPTS();
+
+		if(State->IsRxActive == false)
+		{
+			State->RxBuffer = Buffer;
+			State->RxBufferSize = Size;
+			IsSet = true;
+		}
+		else
+		{
+			/* The current message is being written to the old buffer */
+		}
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return IsSet;
+}
+
+void MID_CAN_TpSetRxParameters(MID_CAN_ModuleIns_e Ins, uint8_t Channel, uint8_t BlockSize, uint8_t STmin)
+{
+	Tp_ChannelStateType *State = &Tp_State[Ins].Channel[Channel];
+
+	if(Channel >= Tp_State[Ins].NoOfChannels)
+	{
+		/* Invalid parameters or transport not initialized */
+	}
+	else
+	{
+		/* Both are latched at the next first frame */
+		DISABLE_INTERRUPTS();
+
+		State->RxBs = BlockSize;
+		State->RxStmin = STmin;
+
+		ENABLE_INTERRUPTS();
+	}
+}
+
+bool MID_CAN_TpRxIndication(MID_CAN_ModuleIns_e Ins, const FlexCAN_FrameType *Frame)
+{
+	Tp_StateType *Tp = &Tp_State[Ins];
+	Tp_ChannelStateType *Channel = NULL;
+	Tp_EventType Event = { 0 };
+	bool IsAccepted = false;
+	uint8_t Index = 0U;
+
+	if(Frame == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		for(Index = 0U; Index < Tp->NoOfChannels && IsAccepted == false; Index++)
+		{
+			Channel = &Tp->Channel[Index];
+			IsAccepted = (Channel->Config->RxId == Frame->Id && Channel->Config->IdType == Frame->IdType);
+		}
+
+		if(IsAccepted == true)
+		{
+			/* Frames are also handed over from mailbox interrupts */
+			DISABLE_INTERRUPTS();
+
+			Tp_ProcessFrame(Ins, Channel, Frame, &Event);
+			Tp_Schedule(Ins, Channel);
+
+			ENABLE_INTERRUPTS();
+
+			Tp_Notify(Ins, Channel, &Event);
+		}
+		else
+		{
+			/* Not a channel of this node */
+		}
+	}
+
+	return IsAccepted;
+}
+
+void MID_CAN_TpMainFunction(MID_CAN_ModuleIns_e Ins)
+{
+	Tp_StateType *Tp = &Tp_State[Ins];
+	Tp_ChannelStateType *Channel = NULL;
+	Tp_EventType Event;
+	uint32_t Timeout = 0U;
+	uint32_t Now = 0U;
+	uint8_t Index = 0U;
+	bool IsAborting = false;
+
+	for(Index = 0U; Index < Tp->NoOfChannels; Index++)
+	{
+		Channel = &Tp->Channel[Index];
+		Timeout = (uint32_t)Channel->Config->TimeoutMs * MID_CAN_BITS_PER_MS;
+		Event = (Tp_EventType){ 0 };
+		IsAborting = false;
+
+		DISABLE_INTERRUPTS();
+
+		Now = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+
+		if((Channel->InFlight == TP_IN_FLIGHT_DATA || Channel->InFlight == TP_IN_FLIGHT_FC)
+		   && (Now - Channel->TxFrameTime) >= Timeout)
+		{
+			/* N_As or N_Ar: the frame never left the mailbox, a lost flow control ends in N_Cr */
+			if(Channel->InFlight == TP_IN_FLIGHT_DATA && Channel->TxState != TP_TX_IDLE)
+			{
+				Channel->TxState = TP_TX_IDLE;
+				Event.IsTxDone = true;
+				Event.TxResult = MID_CAN_TP_TIMEOUT_A;
+			}
+
+			/* Nothing else is sent on the mailbox until the abort is done */
+			Channel->InFlight = TP_IN_FLIGHT_ABORT;
+			IsAborting = true;
+		}
+		else if(Channel->TxState == TP_TX_WAIT_FC && (Now - Channel->TxLastTime) >= Timeout)
+		{
+			Channel->TxState = TP_TX_IDLE;
+			Event.IsTxDone = true;
+			Event.TxResult = MID_CAN_TP_TIMEOUT_BS;
+		}
+
+		if(Channel->IsRxActive == true && (Now - Channel->RxLastTime) >= Timeout)
+		{
+			Channel->IsRxActive = false;
+			Event.IsRxDone = true;
+			Event.RxResult = MID_CAN_TP_TIMEOUT_CR;
+		}
+
+		/* Consecutive frames held back by STmin */
+		Tp_Schedule(Ins, Channel);
+
+		ENABLE_INTERRUPTS();
+
+		if(IsAborting == true)
+		{
+			/* The abort waits for the bus, outside the channel lock */
+			(void)FlexCAN_AbortTx((FlexCAN_Instance_e)Ins, Channel->Config->TxMbIndex);
+
+			DISABLE_INTERRUPTS();
+
+			Channel->InFlight = TP_IN_FLIGHT_NONE;
+			Tp_Schedule(Ins, Channel);
+
+			ENABLE_INTERRUPTS();
+		}
+
+		Tp_Notify(Ins, Channel, &Event);
+	}
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void Tp_TxMbHandler(FlexCAN_Instance_e Ins, uint8_t MbIndex, void *Context)
+{
+	Tp_ChannelStateType *Channel = (Tp_ChannelStateType *)Context;
+	Tp_EventType Event = { 0 };
+
+	if(Channel->InFlight == TP_IN_FLIGHT_DATA)
+	{
+		/* STmin counts from the end of the frame */
+		Channel->TxLastTime = FlexCAN_GetTime(Ins);
+
+		if(Channel->TxState == TP_TX_WAIT_DONE)
+		{
+			Channel->TxState = TP_TX_IDLE;
+			Event.IsTxDone = true;
+			Event.TxResult = MID_CAN_TP_OK;
+		}
+	}
+
+	/* A frame being aborted is released by the main function */
+	if(Channel->InFlight != TP_IN_FLIGHT_ABORT)
+	{
+		Channel->InFlight = TP_IN_FLIGHT_NONE;
+	}
+
+	Tp_Schedule((MID_CAN_ModuleIns_e)Ins, Channel);
+	Tp_Notify((MID_CAN_ModuleIns_e)Ins, Channel, &Event);
+}
+
+static void Tp_RxMbHandler(FlexCAN_Instance_e Ins, uint8_t MbIndex, void *Context)
+{
+	Tp_ChannelStateType *Channel = (Tp_ChannelStateType *)Context;
+	Tp_EventType Event = { 0 };
+	FlexCAN_FrameType Frame;
+
+	if(MID_CAN_ReceiveFrame((MID_CAN_ModuleIns_e)Ins, (FlexCAN_MbIndex_e)MbIndex, &Frame) == true)
+	{
+		Tp_ProcessFrame((MID_CAN_ModuleIns_e)Ins, Channel, &Frame, &Event);
+		Tp_Schedule((MID_CAN_ModuleIns_e)Ins, Channel);
+		Tp_Notify((MID_CAN_ModuleIns_e)Ins, Channel, &Event);
+	}
+}
+
+static void Tp_ProcessFrame(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel, const FlexCAN_FrameType *Frame, Tp_EventType *Event)
+{
+	const uint8_t *Byte = Frame->Data.Byte;
+	uint16_t Remaining = 0U;
+	uint8_t Count = 0U;
+
+	switch((Frame->DataLen > 0U) ? (Byte[0] & TP_PCI_TYPE_MASK) : TP_PCI_TYPE_MASK)
+	{
+		case TP_PCI_SF:
+		case TP_PCI_FF:
+			Tp_StartRx(Ins, Channel, Frame, Event);
+			break;
+
+		case TP_PCI_CF:
+			Remaining = Channel->RxLength - Channel->RxOffset;
+			Count = (Remaining < TP_CF_MAX_DATA) ? (uint8_t)Remaining : TP_CF_MAX_DATA;
+
+			if(Channel->IsRxActive == false || Frame->DataLen < (Count + 1U))
+			{
+				/* Not expected or too short, ignored */
+			}
+			else if((Byte[0] & TP_SN_MASK) != Channel->RxSn)
+			{
+				Channel->IsRxActive = false;
+				Event->IsRxDone = true;
+				Event->RxResult = MID_CAN_TP_WRONG_SN;
+			}
+			else
+			{
+				/* Zero-copy reassembly: frame payload straight into the caller buffer */
+				for(Remaining = 0U; Remaining < Count; Remaining++)
+				{
+					Channel->RxBuffer[Channel->RxOffset + Remaining] = Byte[1U + Remaining];
+				}
+
+				Channel->RxOffset += Count;
+				Channel->RxSn = (Channel->RxSn + 1U) & TP_SN_MASK;
+				Channel->RxLastTime = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+
+				if(Channel->RxOffset == Channel->RxLength)
+				{
+					Channel->IsRxActive = false;
+					Event->IsRxDone = true;
+					Event->RxResult = MID_CAN_TP_OK;
+					Event->RxData = Channel->RxBuffer;
+					Event->RxLength = Channel->RxLength;
+				}
+				else if(Channel->RxBs != 0U && --Channel->RxBlockLeft == 0U)
+				{
+					Channel->RxBlockLeft = Channel->RxBs;
+					Channel->FcStatus = TP_FS_CTS;
+					Channel->IsFcPending = true;
+				}
+				else
+				{
+					/* More frames of the block to come */
+				}
+			}
+			break;
+
+		case TP_PCI_FC:
+			Tp_ProcessFc(Ins, Channel, Frame, Event);
+			break;
+
+		default:
+			/* Unknown frame type, ignored */
+			break;
+	}
+}
+
+static void Tp_ProcessFc(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel, const FlexCAN_FrameType *Frame, Tp_EventType *Event)
+{
+	const uint8_t *Byte = Frame->Data.Byte;
+
+	if(Channel->TxState != TP_TX_WAIT_FC || Frame->DataLen < TP_FC_LEN)
+	{
+		/* Not expected, ignored */
+	}
+	else
+	{
+		switch(Byte[0] & TP_PCI_LOW_MASK)
+		{
+			case TP_FS_CTS:
+				Channel->TxBs = Byte[1];
+				Channel->TxBlockLeft = Byte[1];
+				Channel->TxStminTicks = Tp_StminToTicks(Byte[2]);
+				Channel->IsCfImmediate = true;
+				Channel->TxState = TP_TX_SEND_CF;
+				break;
+
+			case TP_FS_WAIT:
+				/* Restarts N_Bs */
+				Channel->TxLastTime = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+				break;
+
+			case TP_FS_OVFLW:
+				Channel->TxState = TP_TX_IDLE;
+				Event->IsTxDone = true;
+				Event->TxResult = MID_CAN_TP_BUFFER_OVERFLOW;
+				break;
+
+			default:
+				Channel->TxState = TP_TX_IDLE;
+				Event->IsTxDone = true;
+				Event->TxResult = MID_CAN_TP_INVALID_FS;
+				break;
+		}
+	}
+}
+
+static void Tp_StartRx(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel, const FlexCAN_FrameType *Frame, Tp_EventType *Event)
+{
+	const uint8_t *Byte = Frame->Data.Byte;
+	bool IsFirstFrame = ((Byte[0] & TP_PCI_TYPE_MASK) == TP_PCI_FF);
+	uint16_t Length = 0U;
+	uint8_t Header = 0U;
+	uint8_t Count = 0U;
+	uint8_t Index = 0U;
+
+	if(IsFirstFrame == true)
+	{
+		Length = ((uint16_t)(Byte[0] & TP_PCI_LOW_MASK) << 8U) | Byte[1];
+		Header = 2U;
+		Count = TP_FF_DATA;
+	}
+	else
+	{
+		Length = Byte[0] & TP_PCI_LOW_MASK;
+		Header = 1U;
+		Count = (uint8_t)Length;
+	}
+
+	if((IsFirstFrame == true && (Frame->DataLen != TP_FRAME_LEN || Length <= TP_SF_MAX_DATA))
+	   || (IsFirstFrame == false && (Length == 0U || Frame->DataLen < (Length + 1U))))
+	{
+		/* Malformed, ignored */
+	}
+	else
+	{
+		/* A new message replaces the one being received */
+		Event->IsRxReplaced = Channel->IsRxActive;
+		Channel->IsRxActive = false;
+
+		if(Length > Channel->RxBufferSize)
+		{
+			if(IsFirstFrame == true)
+			{
+				Channel->FcStatus = TP_FS_OVFLW;
+				Channel->IsFcPending = true;
+			}
+
+			Event->IsRxDone = true;
+			Event->RxResult = MID_CAN_TP_BUFFER_OVERFLOW;
+		}
+		else
+		{
+			for(Index = 0U; Index < Count; Index++)
+			{
+				Channel->RxBuffer[Index] = Byte[Header + Index];
+			}
+
+			if(IsFirstFrame == true)
+			{
+				Channel->RxLength = Length;
+				Channel->RxOffset = Count;
+				Channel->RxSn = 1U;
+				Channel->RxBlockLeft = Channel->RxBs;
+				Channel->RxLastTime = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+				Channel->IsRxActive = true;
+				Channel->FcStatus = TP_FS_CTS;
+				Channel->IsFcPending = true;
+			}
+			else
+			{
+				Event->IsRxDone = true;
+				Event->RxResult = MID_CAN_TP_OK;
+				Event->RxData = Channel->RxBuffer;
+				Event->RxLength = Length;
+			}
+		}
+	}
+}
+
+static void Tp_Schedule(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel)
+{
+	const MID_CAN_TpChannelConfigType *Config = Channel->Config;
+	uint8_t Pci[TP_FC_LEN];
+	uint16_t Remaining = 0U;
+	uint32_t Now = 0U;
+
+	if(Channel->InFlight != TP_IN_FLIGHT_NONE || MID_CAN_HealthIsTxAllowed(Ins) == false
+	   || FlexCAN_IsTxMbIdle((FlexCAN_Instance_e)Ins, Config->TxMbIndex) == false)
+	{
+		/* Mailbox busy or bus-off, the Tx interrupt or the main function comes back */
+	}
+	else if(Channel->IsFcPending == true)
+	{
+		/* Flow control first, the peer is waiting for it */
+		Pci[0] = TP_PCI_FC | Channel->FcStatus;
+		Pci[1] = Channel->RxBs;
+		Pci[2] = Channel->RxStmin;
+
+		Channel->IsFcPending = false;
+		Channel->InFlight = TP_IN_FLIGHT_FC;
+		Tp_SendFrame(Ins, Channel, Pci, TP_FC_LEN, NULL, 0U);
+	}
+	else
+	{
+		Remaining = Channel->TxLength - Channel->TxOffset;
+
+		switch(Channel->TxState)
+		{
+			case TP_TX_SEND_SF:
+				Pci[0] = TP_PCI_SF | (uint8_t)Channel->TxLength;
+
+				Channel->TxState = TP_TX_WAIT_DONE;
+				Channel->InFlight = TP_IN_FLIGHT_DATA;
+				Tp_SendFrame(Ins, Channel, Pci, 1U, Channel->TxData, (uint8_t)Channel->TxLength);
+				break;
+
+			case TP_TX_SEND_FF:
+				Pci[0] = TP_PCI_FF | (uint8_t)(Channel->TxLength >> 8U);
+				Pci[1] = (uint8_t)Channel->TxLength;
+
+				Channel->TxOffset = TP_FF_DATA;
+				Channel->TxSn = 1U;
+				Channel->TxLastTime = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+				Channel->TxState = TP_TX_WAIT_FC;
+				Channel->InFlight = TP_IN_FLIGHT_DATA;
+				Tp_SendFrame(Ins, Channel, Pci, 2U, Channel->TxData, TP_FF_DATA);
+				break;
+
+			case TP_TX_SEND_CF:
+				Now = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+
+				if(Channel->IsCfImmediate == true || (Now - Channel->TxLastTime) >= Channel->TxStminTicks)
+				{
+					Remaining = (Remaining < TP_CF_MAX_DATA) ? Remaining : TP_CF_MAX_DATA;
+					Pci[0] = TP_PCI_CF | Channel->TxSn;
+
+					Channel->InFlight = TP_IN_FLIGHT_DATA;
+					Tp_SendFrame(Ins, Channel, Pci, 1U, &Channel->TxData[Channel->TxOffset], (uint8_t)Remaining);
+
+					Channel->TxOffset += Remaining;
+					Channel->TxSn = (Channel->TxSn + 1U) & TP_SN_MASK;
+					Channel->IsCfImmediate = false;
+
+					if(Channel->TxOffset == Channel->TxLength)
+					{
+						Channel->TxState = TP_TX_WAIT_DONE;
+					}
+					else if(Channel->TxBs != 0U && --Channel->TxBlockLeft == 0U)
+					{
+						/* N_Bs starts with the last frame of the block */
+						Channel->TxLastTime = Now;
+						Channel->TxState = TP_TX_WAIT_FC;
+					}
+					else
+					{
+						/* Next frame of the block */
+					}
+				}
+				break;
+
+			default:
+				/* Nothing to send */
+				break;
+		}
+	}
+}
+
+static void Tp_SendFrame(MID_CAN_ModuleIns_e Ins, Tp_ChannelStateType *Channel, const uint8_t *Pci, uint8_t PciLen,
+                         const uint8_t *Data, uint8_t DataLen)
+{
+	const MID_CAN_TpChannelConfigType *Config = Channel->Config;
+	FlexCAN_FrameType Frame;
+	uint8_t Index = 0U;
+
+	Frame.Id = Config->TxId;
+	Frame.IdType = Config->IdType;
+	Frame.DataLen = PciLen + DataLen;
+
+	for(Index = 0U; Index < PciLen; Index++)
+	{
+		Frame.Data.Byte[Index] = Pci[Index];
+	}
+
+	for(Index = 0U; Index < DataLen; Index++)
+	{
+		Frame.Data.Byte[PciLen + Index] = Data[Index];
+	}
+
+	if(Config->IsPadded == true)
+	{
+		for(Index = Frame.DataLen; Index < TP_FRAME_LEN; Index++)
+		{
+			Frame.Data.Byte[Index] = Config->Padding;
+		}
+
+		Frame.DataLen = TP_FRAME_LEN;
+	}
+
+	Channel->TxFrameTime = FlexCAN_GetTime((FlexCAN_Instance_e)Ins);
+	MID_CAN_TransmitFrame(Ins, Config->TxMbIndex, &Frame);
+}
+
+static uint32_t Tp_StminToTicks(uint8_t STmin)
+{
+	uint32_t Ticks = 0U;
+
+	if(STmin <= TP_STMIN_MAX_MS)
+	{
+		Ticks = (uint32_t)STmin * MID_CAN_BITS_PER_MS;
+	}
+	else if(STmin >= TP_STMIN_US_FIRST && STmin <= TP_STMIN_US_LAST)
+	{
+		Ticks = (uint32_t)(STmin - MID_CAN_TP_STMIN_US(0U)) * TP_BITS_PER_100US;
+	}
+	else
+	{
+		/* Reserved values are read as the longest STmin */
+		Ticks = (uint32_t)TP_STMIN_MAX_MS * MID_CAN_BITS_PER_MS;
+	}
+
+	return Ticks;
+}
+
+static void Tp_Notify(MID_CAN_ModuleIns_e Ins, const Tp_ChannelStateType *Channel, const Tp_EventType *Event)
+{
+	const MID_CAN_TpChannelConfigType *Config = Channel->Config;
+
+	if(Config->RxIndication != NULL)
+	{
+		if(Event->IsRxReplaced == true)
+		{
+			Config->RxIndication(Ins, Channel->Index, NULL, 0U, MID_CAN_TP_UNEXPECTED_PDU);
+		}
+
+		if(Event->IsRxDone == true)
+		{
+			Config->RxIndication(Ins, Channel->Index, Event->RxData, Event->RxLength, Event->RxResult);
+		}
+	}
+
+	if(Config->TxConfirmation != NULL && Event->IsTxDone == true)
+	{
+		Config->TxConfirmation(Ins, Channel->Index, Event->TxResult);
+	}
+}
+
+static bool Tp_CheckChannel(const MID_CAN_TpChannelConfigType *Config)
+{
+	return (Config->TxMbIndex <= MB31 && (Config->RxMbIndex <= MB31 || Config->RxMbIndex == MID_CAN_TP_NO_MB)
+	        && Config->RxMbIndex != (uint8_t)Config->TxMbIndex && Config->TimeoutMs > 0U
+	        && (Config->RxBuffer != NULL || Config->RxBufferSize == 0U));
+}
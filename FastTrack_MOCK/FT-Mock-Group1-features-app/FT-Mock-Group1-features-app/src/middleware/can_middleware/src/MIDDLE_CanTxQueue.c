@@ -0,0 +1,246 @@
+/*
+ * MIDDLE_CanTxQueue.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_CanTxQueue.h"
+#include "MIDDLE_CanHealth.h"
+#include "s32_core_cm4.h"
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+
+/**
+ * Standard IDs are compared on the same scale as extended IDs, like on the bus.
+ */
+#define TX_QUEUE_ARBITRATION_VALUE(Frame) \
+		(((Frame)->IdType == FlexCAN_EXTENDED) ? (Frame)->Id : ((Frame)->Id << 18U))
+
+typedef struct
+{
+	FlexCAN_FrameType			Frame;			/*!< Frame to send */
+	uint32_t					Arbitration;	/*!< Sort key, lower value is sent first */
+	MID_CAN_TxDoneCallbackType	Callback;		/*!< Completion callback */
+	void					  * Context;		/*!< Completion callback context */
+} TxQueue_EntryType;
+
+typedef struct
+{
+	bool						Busy;			/*!< A frame of the queue is pending in the mailbox */
+	uint32_t					Id;				/*!< ID of the pending frame */
+	MID_CAN_TxDoneCallbackType	Callback;		/*!< Completion callback of the pending frame */
+	void					  * Context;		/*!< Completion callback context */
+} TxQueue_InFlightType;
+
+typedef struct
+{
+	const MID_CAN_TxQueueConfigType * Config;
+	/* Sorted by decreasing arbitration value, the next frame to send is the last one */
+	TxQueue_EntryType			Entries[MID_CAN_TX_QUEUE_LENGTH];
+	uint8_t						Count;
+	uint8_t						HighWater;
+	TxQueue_InFlightType		InFlight[MID_CAN_TX_QUEUE_MAX_MB];
+} TxQueue_StateType;
+
+/* ----------------------------------------------------------------------------
+   -- Variables
+   ---------------------------------------------------------------------------- */
+/**
+ * Transmit queue of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static TxQueue_StateType TxQueue_State[FLEXCAN_INSTANCE_COUNT];
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void TxQueue_Refill(MID_CAN_ModuleIns_e Ins);
+static void TxQueue_MbNotification(FlexCAN_Instance_e Ins, uint8_t MbIndex, void *Context);
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void MID_CAN_TxQueueInit(MID_CAN_ModuleIns_e Ins, const MID_CAN_TxQueueConfigType *Config)
+{
+	TxQueue_StateType *Queue = &TxQueue_State[Ins];
+	uint8_t Slot = 0U;
+
+	MID_CAN_UserConfigType UserConfig = {
+			.MbID = 0U,
+			.DataLen = 0U,
+			.MbInt = true,
+			.HandlerFunc = TxQueue_MbNotification,
+			.Context = &TxQueue_State[Ins]
+	};
+
+	if(Config == NULL || Config->MbPool == NULL || Config->NoOfMbs == 0U || Config->NoOfMbs > MID_CAN_TX_QUEUE_MAX_MB)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		Queue->Config = NULL;
+		Queue->Count = 0U;
+		Queue->HighWater = 0U;
+
+		for(Slot = 0U; Slot < Config->NoOfMbs; Slot++)
+		{
+			Queue->InFlight[Slot].Busy = false;
+
+			/* Every pool mailbox reports its completion to the queue */
+			UserConfig.MbIndex = Config->MbPool[Slot];
+			UserConfig.HandlerType = (MID_CAN_Handler_e)Config->MbPool[Slot];
+			MID_CAN_StdTxMbInit(Ins, &UserConfig);
+			MID_CAN_SetCallback(Ins, &UserConfig);
+		}
+
+		Queue->Config = Config;
+	}
+}
+
+bool MID_CAN_TxQueueSend(MID_CAN_ModuleIns_e Ins, const FlexCAN_FrameType *Frame,
+                         MID_CAN_TxDoneCallbackType Callback, void *Context)
+{
+	TxQueue_StateType *Queue = &TxQueue_State[Ins];
+	bool IsQueued = false;
+	uint32_t Arbitration = 0U;
+	uint8_t Index = 0U;
+
+	if(Frame == NULL || Queue->Config == NULL)
+	{
+		/* Invalid parameters or queue not initialized */
+	}
+	else
+	{
+		Arbitration = TX_QUEUE_ARBITRATION_VALUE(Frame);
+
+		/* The MB interrupt pops and refills the same queue */
+		DISABLE_INTERRUPTS();
+
+		if(Queue->Count < MID_CAN_TX_QUEUE_LENGTH)
+		{
+			/* Shift the entries that must leave after the new frame, equal IDs stay in FIFO order */
+			Index = Queue->Count;
+			while(Index > 0U && Queue->Entries[Index - 1U].Arbitration <= Arbitration)
+			{
+				Queue->Entries[Index] = Queue->Entries[Index - 1U];
+				Index--;
+			}
+
+			Queue->Entries[Index].Frame = *Frame;
+			Queue->Entries[Index].Arbitration = Arbitration;
+			Queue->Entries[Index].Callback = Callback;
+			Queue->Entries[Index].Context = Context;
+			Queue->Count++;
+
+			if(Queue->Count > Queue->HighWater)
+			{
+				Queue->HighWater = Queue->Count;
+			}
+
+			/* Start right away if a pool mailbox is free */
+			TxQueue_Refill(Ins);
+
+			IsQueued = true;
+		}
+		else
+		{
+			/* Queue is full */
+		}
+
+		ENABLE_INTERRUPTS();
+	}
+
+	return IsQueued;
+}
+
+uint8_t MID_CAN_TxQueueGetDepth(MID_CAN_ModuleIns_e Ins)
+{
+	return TxQueue_State[Ins].Count;
+}
+
+uint8_t MID_CAN_TxQueueGetHighWater(MID_CAN_ModuleIns_e Ins)
+{
+	return TxQueue_State[Ins].HighWater;
+}
+
+void MID_CAN_TxQueueResume(MID_CAN_ModuleIns_e Ins)
+{
+	if(TxQueue_State[Ins].Config != NULL)
+	{
+		DISABLE_INTERRUPTS();
+
+		TxQueue_Refill(Ins);
+
+		ENABLE_INTERRUPTS();
+	}
+	else
+	{
+		/* Queue not initialized */
+	}
+}
+
+/* ----------------------------------------------------------------------------
+   -- Private functions
+   ---------------------------------------------------------------------------- */
+static void TxQueue_Refill(MID_CAN_ModuleIns_e Ins)
+{
+	TxQueue_StateType *Queue = &TxQueue_State[Ins];
+	TxQueue_EntryType *Next = NULL;
+	uint8_t Slot = 0U;
+
+	/* Frames stay queued while the controller is bus-off */
+	for(Slot = 0U; Slot < Queue->Config->NoOfMbs && Queue->Count > 0U && MID_CAN_HealthIsTxAllowed(Ins) == true; Slot++)
+	{
+		if(Queue->InFlight[Slot].Busy == false)
+		{
+			/* Highest priority frame is the last entry */
+			Queue->Count--;
+			Next = &Queue->Entries[Queue->Count];
+
+			Queue->InFlight[Slot].Busy = true;
+			Queue->InFlight[Slot].Id = Next->Frame.Id;
+			Queue->InFlight[Slot].Callback = Next->Callback;
+			Queue->InFlight[Slot].Context = Next->Context;
+
+			/* Pending mailboxes are arbitrated internally by ID (CTRL1[LBUF] = 0) */
+			FlexCAN_TransmitFrame(Ins, Queue->Config->MbPool[Slot], &Next->Frame);
+		}
+		else
+		{
+			/* Mailbox still holds a pending frame */
+		}
+	}
+}
+
+static void TxQueue_MbNotification(FlexCAN_Instance_e Ins, uint8_t MbIndex, void *Context)
+{
+	TxQueue_StateType *Queue = (TxQueue_StateType *)Context;
+	uint8_t Slot = 0U;
+
+	if(Queue->Config != NULL)
+	{
+		/* The callback names the completed mailbox, find its pool slot */
+		for(Slot = 0U; Slot < Queue->Config->NoOfMbs; Slot++)
+		{
+			if(Queue->Config->MbPool[Slot] == MbIndex && Queue->InFlight[Slot].Busy == true)
+			{
+				Queue->InFlight[Slot].Busy = false;
+
+				if(Queue->InFlight[Slot].Callback != NULL)
+				{
+					Queue->InFlight[Slot].Callback(Queue->InFlight[Slot].Id, Queue->InFlight[Slot].Context);
+				}
+			}
+		}
+
+		TxQueue_Refill((MID_CAN_ModuleIns_e)Ins);
+	}
+	else
+	{
+		/* Queue is being initialized */
+	}
+}
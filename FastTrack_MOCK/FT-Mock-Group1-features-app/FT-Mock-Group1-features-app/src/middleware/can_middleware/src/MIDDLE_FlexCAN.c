@@ -5,9 +5,12 @@
  *      Author: adm
  */
 
-#include "MIDDLE_FLexCAN.h"
+#include "MIDDLE_FlexCAN.h"
+#include "MIDDLE_CanLatency.h"
+#include "MIDDLE_CanIdMap.h"
 #include "CLOCK.h"
 #include "PORT_Driver.h"
+#include "s32_core_cm4.h"
 
 /* ----------------------------------------------------------------------------
    -- Definitions
@@ -19,6 +22,30 @@ typedef enum
 	CAN_MB_ACTIVE		= 1U
 }CAN_MbStatus_e;
 
+/* Direction a mailbox serves its ID in, for the ID lookup of MID_CAN_SendId and MID_CAN_ReadId */
+typedef enum
+{
+	CAN_MB_ID_TX		= 0U,
+	CAN_MB_ID_RX		= 1U,
+	CAN_MB_ID_NONE		= 2U	/* Rx ID range, remote request or remote answer */
+}CAN_MbIdDir_e;
+
+#define CAN_MB_ID_DIR_COUNT	2U
+
+/* ID of a mailbox */
+typedef struct
+{
+	uint32_t			Key;		/* MID_CAN_IDMAP_KEY of the ID */
+	CAN_MbIdDir_e		Dir;
+}CAN_MbIdType;
+
+/* ID lookup of one direction, read-only once published */
+typedef struct
+{
+	MID_CAN_IdMapType	Map;
+	uint8_t				MbIndex[MID_CAN_IDMAP_MAX_KEYS];	/* Mailbox of each key */
+}CAN_IdTableType;
+
 /**
  * Array of PORT for instances FLEXCAN modules. Indexed by FLEXCAN instance number.
  */
@@ -34,6 +61,19 @@ typedef enum
  */
 #define FLEXCAN_MUX_Index { portMuxAlt5, portMuxAlt3, portMuxAlt4 }
 
+/**
+ * PCC indices of the PORT of each FLEXCAN instance.
+ */
+#define PCC_FLEXCAN_PORT_Index { PCC_PORTE_INDEX, PCC_PORTC_INDEX, PCC_PORTB_INDEX }
+
+/**
+ * Tx and Rx pins of each FLEXCAN instance.
+ */
+#define FLEXCAN_TX_PIN { FlexCAN0_Tx, FlexCAN1_Tx, FlexCAN2_Tx }
+#define FLEXCAN_RX_PIN { FlexCAN0_Rx, FlexCAN1_Rx, FlexCAN2_Rx }
+
+#define FLEXCAN_MB_COUNT	32U
+
 #define FLEXCAN_MB_BASE_PTR { MB_FLEXCAN_0, MB_FLEXCAN_1, MB_FLEXCAN_2 }
 
 /**
@@ -65,6 +105,12 @@ static uint8_t FlexCAN_PORT[FLEXCAN_INSTANCE_COUNT] = FLEXCAN_PORT_INSTANCE;
 
 static uint8_t FlexCAN_MUX[FLEXCAN_INSTANCE_COUNT] = FLEXCAN_MUX_Index;
 
+static uint8_t PCC_FlexCAN_PORT[FLEXCAN_INSTANCE_COUNT] = PCC_FLEXCAN_PORT_Index;
+
+static const FlexCAN_TxPin_e FlexCAN_TxPin[FLEXCAN_INSTANCE_COUNT] = FLEXCAN_TX_PIN;
+
+static const FlexCAN_RxPin_e FlexCAN_RxPin[FLEXCAN_INSTANCE_COUNT] = FLEXCAN_RX_PIN;
+
 /**
  * Array to map FLEXCAN instances to their corresponding NVIC IRQ numbers.
  *
@@ -75,7 +121,62 @@ static IRQn_Type NVIC_FLEXCAN[NVIC_FLEXCAN_COUNT]	= NVIC_FLEXCAN_Index;
 
 static IRQn_Type NVIC_MBFLEXCAN[NVIC_FLEXCAN_MB_COUNT]	= NVIC_MB_FLEXCAN_INDEX;
 
-CAN_MbStatus_e AllMbStatus[32] = { CAN_MB_INACTIVE };
+/**
+ * Status of the message buffers of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers, then by MB index.
+ */
+static CAN_MbStatus_e AllMbStatus[FLEXCAN_INSTANCE_COUNT][FLEXCAN_MB_COUNT] = { { CAN_MB_INACTIVE } };
+
+/**
+ * Latest value counters of the message buffers of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers, then by MB index.
+ */
+static MID_CAN_TxLatestStatsType MID_CAN_TxLatestStats[FLEXCAN_INSTANCE_COUNT][FLEXCAN_MB_COUNT];
+
+/**
+ * Rx FIFO configuration of FLEXCAN instances, NULL when the FIFO is not used.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static FlexCAN_RxFifoConfigType * MID_CAN_RxFifoConfig[FLEXCAN_INSTANCE_COUNT] = { NULL };
+
+/**
+ * CAN FD configuration of FLEXCAN instances, NULL for classic CAN.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static FlexCAN_FdConfigType * MID_CAN_FdConfig[FLEXCAN_INSTANCE_COUNT] = { NULL };
+
+/**
+ * Operating mode of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static FlexCAN_Mode_e MID_CAN_RunMode[FLEXCAN_INSTANCE_COUNT] = { FlexCAN_MODE_NORMAL };
+
+/**
+ * Constant mailbox layout of FLEXCAN instances, NULL when every mailbox is set up at run time.
+ * @note These arrays are indexed by FLEXCAN instance numbers.
+ */
+static const FlexCAN_MbLayoutType * MID_CAN_MbLayout[FLEXCAN_INSTANCE_COUNT] = { NULL };
+static uint8_t MID_CAN_NoOfMbLayout[FLEXCAN_INSTANCE_COUNT] = { 0U };
+
+/**
+ * MCR[MAXMB] of FLEXCAN instances, the highest active mailbox or the end of the Rx FIFO area.
+ * @note This array is indexed by FLEXCAN instance numbers.
+ */
+static uint8_t MID_CAN_MaxMb[FLEXCAN_INSTANCE_COUNT] = { 0U };
+
+/**
+ * ID of the message buffers of FLEXCAN instances.
+ * @note This array is indexed by FLEXCAN instance numbers, then by MB index.
+ */
+static CAN_MbIdType MID_CAN_MbId[FLEXCAN_INSTANCE_COUNT][FLEXCAN_MB_COUNT];
+
+/**
+ * ID lookup tables of every instance, two per direction: a table is rebuilt in the spare one and
+ * published with a single pointer store, so a lookup from an interrupt never sees it half built.
+ * @note These arrays are indexed by CAN_MbIdDir_e.
+ */
+static CAN_IdTableType MID_CAN_IdTable[CAN_MB_ID_DIR_COUNT][2];
+static const CAN_IdTableType * volatile MID_CAN_IdTableActive[CAN_MB_ID_DIR_COUNT] = { NULL, NULL };
 
 /* ----------------------------------------------------------------------------
    -- Private functions
@@ -83,23 +184,65 @@ CAN_MbStatus_e AllMbStatus[32] = { CAN_MB_INACTIVE };
 static void FlexCAN_PORT_Init(MID_CAN_ModuleIns_e Ins, FlexCAN_PinType PortPin);
 static void FlexCAN_NVIC_Control(MID_CAN_ModuleIns_e Ins, FlexCAN_InterruptType IntControl);
 static void FlexCAN_NVIC_MbControl(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, bool IsEnableInt);
+static void FlexCAN_RxFifo_Control(MID_CAN_ModuleIns_e Ins, FlexCAN_RxFifoConfigType *RxFifoConfig);
+static void FlexCAN_MbLayout_Control(MID_CAN_ModuleIns_e Ins);
+static uint8_t FlexCAN_FirstFreeMb(MID_CAN_ModuleIns_e Ins);
+static uint8_t FlexCAN_MaxMb_Init(MID_CAN_ModuleIns_e Ins);
+static void FlexCAN_MaxMb_Control(MID_CAN_ModuleIns_e Ins);
+static void FlexCAN_MbId_Set(MID_CAN_ModuleIns_e Ins, uint8_t MbIndex, CAN_MbIdDir_e Dir, uint32_t Id,
+                             uint32_t Mask, FlexCAN_MsgIDType_e IdType);
+static void FlexCAN_IdTable_Control(void);
+static bool FlexCAN_IdTable_Find(MID_CAN_ModuleIns_e Ins, CAN_MbIdDir_e Dir, uint32_t Id, FlexCAN_MsgIDType_e IdType,
+                                 FlexCAN_MbIndex_e *MbIndex);
 
 /* ----------------------------------------------------------------------------
    -- Global functions
    ---------------------------------------------------------------------------- */
+void MID_CAN_SetRxFifoConfig(MID_CAN_ModuleIns_e Ins, FlexCAN_RxFifoConfigType *RxFifoConfig)
+{
+	MID_CAN_RxFifoConfig[Ins] = RxFifoConfig;
+}
+
+void MID_CAN_SetFdConfig(MID_CAN_ModuleIns_e Ins, FlexCAN_FdConfigType *FdConfig)
+{
+	MID_CAN_FdConfig[Ins] = FdConfig;
+}
+
+void MID_CAN_SetRunMode(MID_CAN_ModuleIns_e Ins, FlexCAN_Mode_e RunMode)
+{
+	MID_CAN_RunMode[Ins] = RunMode;
+}
+
+void MID_CAN_SetMbLayout(MID_CAN_ModuleIns_e Ins, const FlexCAN_MbLayoutType *Layout, uint8_t NoOfMbs)
+{
+	MID_CAN_MbLayout[Ins] = Layout;
+	MID_CAN_NoOfMbLayout[Ins] = (Layout == NULL) ? 0U : NoOfMbs;
+}
+
 void MID_CAN_Init(MID_CAN_ModuleIns_e Ins)
 {
 	FlexCAN_ConfigType FlexCANConfig;
+	uint8_t MbIndex = 0U;
 
 	/* Configuration elements for FlexCAN module */
-	FlexCANConfig.BitRate = 500000;
-	FlexCANConfig.MaxNoMB = 31U;
+	FlexCANConfig.BitRate = MID_CAN_BIT_RATE;
+	FlexCANConfig.MaxNoMB = FlexCAN_MaxMb_Init(Ins);
 	FlexCANConfig.CLkSrc = FlexCAN_CLKSRC_SYS;
 	FlexCANConfig.IntControl.IntError = FlexCAN_INT_ERROR_ENABLE;
-	FlexCANConfig.PortPin.TxPin = FlexCAN0_Tx;
-	FlexCANConfig.PortPin.RxPin = FlexCAN0_Rx;
-	FlexCANConfig.RunMode = FlexCAN_MODE_NORMAL;
+	FlexCANConfig.IntControl.IntBusOff = FlexCAN_INT_BUSOFF_ENABLE;
+	FlexCANConfig.IntControl.IntTxWarning = FlexCAN_INT_TxWARNING_ENABLE;
+	FlexCANConfig.IntControl.IntRxWarning = FlexCAN_INT_RxWARNING_ENABLE;
+	FlexCANConfig.PortPin.TxPin = FlexCAN_TxPin[Ins];
+	FlexCANConfig.PortPin.RxPin = FlexCAN_RxPin[Ins];
+	FlexCANConfig.RunMode = MID_CAN_RunMode[Ins];
 	FlexCANConfig.ClkFreq = FLEXCAN_GET_FREQ(FlexCANConfig.CLkSrc);
+	FlexCANConfig.SamplePoint = FLEXCAN_SAMPLE_POINT_DEFAULT;
+	FlexCANConfig.Sjw = 0U;
+	FlexCANConfig.BitTiming = NULL;
+	FlexCANConfig.RxFifoConfig = MID_CAN_RxFifoConfig[Ins];
+	FlexCANConfig.FdConfig = MID_CAN_FdConfig[Ins];
+	FlexCANConfig.MbLayout = MID_CAN_MbLayout[Ins];
+	FlexCANConfig.NoOfMbLayout = MID_CAN_NoOfMbLayout[Ins];
 
 	/* PORT initialization */
 	FlexCAN_PORT_Init(Ins, FlexCANConfig.PortPin);
@@ -110,20 +253,41 @@ void MID_CAN_Init(MID_CAN_ModuleIns_e Ins)
 	/* NVIC IRQ line configuration for FlexCAN interrupts */
 	FlexCAN_NVIC_Control(Ins, FlexCANConfig.IntControl);
 
-	/* Initializes FlexCAN driver */
-	FlexCAN_Init(Ins, &FlexCANConfig);
+	/* DMAMUX clock and NVIC IRQ line for the Rx FIFO */
+	FlexCAN_RxFifo_Control(Ins, FlexCANConfig.RxFifoConfig);
+
+	/* Initializes FlexCAN driver, the mailbox layout is written in the same freeze session */
+	if(FlexCAN_Init(Ins, &FlexCANConfig) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		MID_CAN_MaxMb[Ins] = FlexCANConfig.MaxNoMB;
+		FlexCAN_MbLayout_Control(Ins);
+		FlexCAN_IdTable_Control();
+	}
+
+	for(MbIndex = 0U; MbIndex < FLEXCAN_MB_COUNT; MbIndex++)
+	{
+		MID_CAN_TxLatestStats[Ins][MbIndex].Replaced = 0U;
+		MID_CAN_TxLatestStats[Ins][MbIndex].Aborted = 0U;
+	}
 }
 
 void MID_CAN_DeInit(MID_CAN_ModuleIns_e Ins)
 {
+	uint8_t MbIndex = 0U;
+
 	/* Deinit FlexCAN Driver */
 	FlexCAN_DeInit(Ins);
 
 	/* Disable FlexCAN clock */
 	PCC_PeriClockControl(PCC_FlexCAN[Ins], CLOCK_NOSRC_CLK, CLOCK_DIV_DISABLED, DISABLE);
 
-	/* Disable FlexCAN PORT clock */
-	PCC_PeriClockControl(FlexCAN_PORT[Ins], CLOCK_NOSRC_CLK, CLOCK_DIV_DISABLED, DISABLE);
+	/* The PORT clock stays on, other instances and peripherals may share the port */
+	for(MbIndex = 0U; MbIndex < FLEXCAN_MB_COUNT; MbIndex++)
+	{
+		AllMbStatus[Ins][MbIndex] = CAN_MB_INACTIVE;
+	}
+
+	FlexCAN_IdTable_Control();
 }
 
 void MID_CAN_SetCallback(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserConfig)
@@ -132,7 +296,7 @@ void MID_CAN_SetCallback(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserCo
 
 	CallbackID = UserConfig->HandlerType;
 
-	FlexCAN_CallbackRegister(Ins, UserConfig->HandlerFunc, CallbackID);
+	FlexCAN_CallbackRegister(Ins, UserConfig->HandlerFunc, CallbackID, UserConfig->Context);
 }
 
 void MID_CAN_StdRxMbInit(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserConfig)
@@ -146,7 +310,7 @@ void MID_CAN_StdRxMbInit(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserCo
 			.MbType = FlexCAN_MB_RX,
 			.IdType = FlexCAN_STANDARD,
 			.IsRemote = false,
-			.DataLen = 1,
+			.DataLen = UserConfig->DataLen,
 			.MbID = UserConfig->MbID,
 			.IsEnableMbInt = UserConfig->MbInt
 	};
@@ -156,13 +320,47 @@ void MID_CAN_StdRxMbInit(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserCo
 	/* Checks if initialization is successed or not */
 	if(InitCode == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
 	{
-		AllMbStatus[UserConfig->MbIndex] = CAN_MB_ACTIVE;
+		AllMbStatus[Ins][UserConfig->MbIndex] = CAN_MB_ACTIVE;
+		FlexCAN_MbId_Set(Ins, UserConfig->MbIndex, CAN_MB_ID_RX, MB.MbID, MID_CAN_MB_EXACT_MASK, MB.IdType);
 		FlexCAN_NVIC_MbControl(Ins, UserConfig->MbIndex, UserConfig->MbInt);
 	}
 	else
 	{
-		AllMbStatus[UserConfig->MbIndex] = CAN_MB_INACTIVE;
+		AllMbStatus[Ins][UserConfig->MbIndex] = CAN_MB_INACTIVE;
+	}
+
+	FlexCAN_MaxMb_Control(Ins);
+	FlexCAN_IdTable_Control();
+}
+
+bool MID_CAN_RxFilterInit(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e FirstMb, const FlexCAN_RxFilterType *Filters,
+                          uint8_t NoOfFilters, const MID_CAN_UserConfigType *UserConfig)
+{
+	FlexCAN_Driver_ReturnCode_e InitCode = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+	uint8_t MbIndex = 0U;
+
+	if(UserConfig != NULL)
+	{
+		InitCode = FlexCAN_SetRxFilters(Ins, FirstMb, Filters, NoOfFilters, UserConfig->MbInt);
+	}
+
+	/* Checks if initialization is successed or not */
+	if(InitCode == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		for(MbIndex = FirstMb; MbIndex < ((uint8_t)FirstMb + NoOfFilters); MbIndex++)
+		{
+			AllMbStatus[Ins][MbIndex] = CAN_MB_ACTIVE;
+			FlexCAN_MbId_Set(Ins, MbIndex, CAN_MB_ID_RX, Filters[MbIndex - FirstMb].Id, Filters[MbIndex - FirstMb].Mask,
+			                 Filters[MbIndex - FirstMb].IdType);
+			FlexCAN_CallbackRegister(Ins, UserConfig->HandlerFunc, MbIndex, UserConfig->Context);
+			FlexCAN_NVIC_MbControl(Ins, (FlexCAN_MbIndex_e)MbIndex, UserConfig->MbInt);
+		}
+
+		FlexCAN_MaxMb_Control(Ins);
+		FlexCAN_IdTable_Control();
 	}
+
+	return (InitCode == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED);
 }
 
 void MID_CAN_StdTxMbInit(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserConfig)
@@ -176,7 +374,7 @@ void MID_CAN_StdTxMbInit(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserCo
 			.MbType = FlexCAN_MB_TX,
 			.IdType = FlexCAN_STANDARD,
 			.IsRemote = false,
-			.DataLen = 1,
+			.DataLen = UserConfig->DataLen,
 			.MbID = UserConfig->MbID,
 			.IsEnableMbInt = UserConfig->MbInt
 	};
@@ -186,20 +384,163 @@ void MID_CAN_StdTxMbInit(MID_CAN_ModuleIns_e Ins, MID_CAN_UserConfigType *UserCo
 	/* Checks if initialization is successed or not */
 	if(InitCode == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
 	{
-		AllMbStatus[UserConfig->MbIndex] = CAN_MB_ACTIVE;
+		AllMbStatus[Ins][UserConfig->MbIndex] = CAN_MB_ACTIVE;
+		FlexCAN_MbId_Set(Ins, UserConfig->MbIndex, CAN_MB_ID_TX, MB.MbID, MID_CAN_MB_EXACT_MASK, MB.IdType);
 		FlexCAN_NVIC_MbControl(Ins, UserConfig->MbIndex, UserConfig->MbInt);
 	}
 	else
 	{
-		AllMbStatus[UserConfig->MbIndex] = CAN_MB_INACTIVE;
+		AllMbStatus[Ins][UserConfig->MbIndex] = CAN_MB_INACTIVE;
+	}
+
+	FlexCAN_MaxMb_Control(Ins);
+	FlexCAN_IdTable_Control();
+}
+
+bool MID_CAN_MbAlloc(MID_CAN_ModuleIns_e Ins, const MID_CAN_MbRequestType *Request, FlexCAN_MbIndex_e *MbIndex)
+{
+	FlexCAN_Driver_ReturnCode_e InitCode = FLEXCAN_DRIVER_RETURN_CODE_ERROR;
+	FlexCAN_RxFilterType Filter;
+	FlexCAN_MbHeaderType MB = { .EDL = 0, .BRS = 0, .ESI = 0, .MbType = FlexCAN_MB_TX, .IsRemote = false };
+	uint8_t MbCount = FlexCAN_GetMbCount(Ins);
+	uint8_t Index = 0U;
+
+	if(Request == NULL || MbIndex == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		/* Lowest free mailbox, so the used ones stay packed below MAXMB */
+		for(Index = FlexCAN_FirstFreeMb(Ins); Index < MbCount && AllMbStatus[Ins][Index] == CAN_MB_ACTIVE; Index++);
+
+		if(Index >= MbCount)
+		{
+			/* No free mailbox */
+		}
+		else
+		{
+			/* Registered before the interrupt is enabled */
+			FlexCAN_CallbackRegister(Ins, Request->HandlerFunc, Index, Request->Context);
+
+			if(Request->MbType == FlexCAN_MB_RX)
+			{
+				Filter.Id = Request->Id;
+				Filter.Mask = Request->Mask;
+				Filter.IdType = Request->IdType;
+				InitCode = FlexCAN_SetRxFilters(Ins, (FlexCAN_MbIndex_e)Index, &Filter, 1U, (Request->HandlerFunc != NULL));
+			}
+			else
+			{
+				MB.IdType = Request->IdType;
+				MB.DataLen = Request->DataLen;
+				MB.MbID = Request->Id;
+				MB.IsEnableMbInt = (Request->HandlerFunc != NULL);
+				InitCode = FlexCAN_MbInit(Ins, (FlexCAN_MbIndex_e)Index, &MB);
+			}
+		}
+	}
+
+	/* Checks if initialization is successed or not */
+	if(InitCode == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		AllMbStatus[Ins][Index] = CAN_MB_ACTIVE;
+		FlexCAN_MbId_Set(Ins, Index, (Request->MbType == FlexCAN_MB_RX) ? CAN_MB_ID_RX : CAN_MB_ID_TX, Request->Id,
+		                 Request->Mask, Request->IdType);
+		*MbIndex = (FlexCAN_MbIndex_e)Index;
+
+		/* The IRQ line is shared with other mailboxes, a polled one leaves it as it is */
+		if(Request->HandlerFunc != NULL)
+		{
+			FlexCAN_NVIC_MbControl(Ins, (FlexCAN_MbIndex_e)Index, true);
+		}
+
+		FlexCAN_MaxMb_Control(Ins);
+		FlexCAN_IdTable_Control();
+	}
+
+	return (InitCode == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED);
+}
+
+void MID_CAN_MbFree(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex)
+{
+	if(MbIndex > MB31 || AllMbStatus[Ins][MbIndex] != CAN_MB_ACTIVE)
+	{
+		/* Invalid parameters or Mb is inactive */
+	}
+	else
+	{
+		/* The driver masks the MB interrupt while it waits for the acknowledge */
+		(void)FlexCAN_AbortTx(Ins, MbIndex);
+
+		DISABLE_INTERRUPTS();
+		(void)FlexCAN_MbDeInit(Ins, MbIndex);
+		ENABLE_INTERRUPTS();
+
+		FlexCAN_CallbackRegister(Ins, NULL, MbIndex, NULL);
+		AllMbStatus[Ins][MbIndex] = CAN_MB_INACTIVE;
+
+		FlexCAN_MaxMb_Control(Ins);
+		FlexCAN_IdTable_Control();
+	}
+}
+
+uint8_t MID_CAN_GetMaxMb(MID_CAN_ModuleIns_e Ins)
+{
+	return MID_CAN_MaxMb[Ins];
+}
+
+bool MID_CAN_SendId(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType, const uint8_t *Data, uint8_t DataLen)
+{
+	FlexCAN_FrameType Frame = { .Id = Id, .IdType = IdType, .DataLen = DataLen, .Data.Word = { 0U, 0U } };
+	FlexCAN_MbIndex_e MbIndex = MB0;
+	bool IsSent = false;
+	uint8_t Index = 0U;
+
+	if((Data == NULL && DataLen != 0U) || DataLen > FLEXCAN_FRAME_MAX_DATA_LEN)
+	{
+		/* Invalid parameters */
+	}
+	else if(FlexCAN_IdTable_Find(Ins, CAN_MB_ID_TX, Id, IdType, &MbIndex) == false
+	        || FlexCAN_IsTxMbIdle((FlexCAN_Instance_e)Ins, MbIndex) == false)
+	{
+		/* No Tx mailbox for the ID, or its previous frame is still pending */
+	}
+	else
+	{
+		for(Index = 0U; Index < DataLen; Index++)
+		{
+			Frame.Data.Byte[Index] = Data[Index];
+		}
+
+		IsSent = (FlexCAN_TransmitFrame((FlexCAN_Instance_e)Ins, MbIndex, &Frame) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED);
 	}
+
+	return IsSent;
+}
+
+bool MID_CAN_ReadId(MID_CAN_ModuleIns_e Ins, uint32_t Id, FlexCAN_MsgIDType_e IdType, FlexCAN_FrameType *Frame)
+{
+	FlexCAN_MbIndex_e MbIndex = MB0;
+	bool IsRead = false;
+
+	if(FlexCAN_IdTable_Find(Ins, CAN_MB_ID_RX, Id, IdType, &MbIndex) == true)
+	{
+		IsRead = MID_CAN_ReceiveFrame(Ins, MbIndex, Frame);
+	}
+	else
+	{
+		/* No Rx mailbox for the ID */
+	}
+
+	return IsRead;
 }
 
 void MID_CAN_Transmit(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, uint8_t *TxBuffer)
 {
 	CAN_MbStatus_e MbStatus = CAN_MB_INACTIVE;
 
-	MbStatus = AllMbStatus[MbIndex];
+	MbStatus = AllMbStatus[Ins][MbIndex];
 
 	if(MbStatus == CAN_MB_ACTIVE)
 	{
@@ -215,7 +556,7 @@ void MID_CAN_Receive(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, uint8_t
 {
 	CAN_MbStatus_e MbStatus = CAN_MB_INACTIVE;
 
-	MbStatus = AllMbStatus[MbIndex];
+	MbStatus = AllMbStatus[Ins][MbIndex];
 
 	if(MbStatus == CAN_MB_ACTIVE)
 	{
@@ -227,6 +568,194 @@ void MID_CAN_Receive(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, uint8_t
 	}
 }
 
+void MID_CAN_TransmitFrame(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, const FlexCAN_FrameType *Frame)
+{
+	CAN_MbStatus_e MbStatus = CAN_MB_INACTIVE;
+
+	MbStatus = AllMbStatus[Ins][MbIndex];
+
+	if(MbStatus == CAN_MB_ACTIVE)
+	{
+		FlexCAN_TransmitFrame(Ins, MbIndex, Frame);
+	}
+	else
+	{
+		/* Mb is inactive */
+	}
+}
+
+FlexCAN_TxAbort_e MID_CAN_TransmitLatest(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, const FlexCAN_FrameType *Frame)
+{
+	FlexCAN_TxAbort_e Result = FLEXCAN_TX_ABORT_IDLE;
+
+	if(AllMbStatus[Ins][MbIndex] == CAN_MB_ACTIVE)
+	{
+		Result = MID_CAN_AbortTx(Ins, MbIndex);
+
+		/* A message buffer still pending is not overwritten, the new frame is dropped */
+		if(Result != FLEXCAN_TX_ABORT_TIMEOUT)
+		{
+			FlexCAN_TransmitFrame(Ins, MbIndex, Frame);
+		}
+	}
+	else
+	{
+		/* Mb is inactive */
+	}
+
+	return Result;
+}
+
+FlexCAN_TxAbort_e MID_CAN_AbortTx(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex)
+{
+	FlexCAN_TxAbort_e Result = FLEXCAN_TX_ABORT_IDLE;
+
+	if(AllMbStatus[Ins][MbIndex] == CAN_MB_ACTIVE)
+	{
+		/* The driver masks the MB interrupt while it waits, other interrupts keep running */
+		Result = FlexCAN_AbortTx(Ins, MbIndex);
+
+		if(Result == FLEXCAN_TX_ABORT_DONE || Result == FLEXCAN_TX_ABORT_LATE)
+		{
+			DISABLE_INTERRUPTS();
+			MID_CAN_TxLatestStats[Ins][MbIndex].Replaced++;
+			MID_CAN_TxLatestStats[Ins][MbIndex].Aborted += (Result == FLEXCAN_TX_ABORT_DONE) ? 1U : 0U;
+			ENABLE_INTERRUPTS();
+		}
+	}
+	else
+	{
+		/* Mb is inactive */
+	}
+
+	return Result;
+}
+
+void MID_CAN_GetTxLatestStats(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, MID_CAN_TxLatestStatsType *Stats)
+{
+	if(MbIndex > MB31 || Stats == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		DISABLE_INTERRUPTS();
+		*Stats = MID_CAN_TxLatestStats[Ins][MbIndex];
+		ENABLE_INTERRUPTS();
+	}
+}
+
+bool MID_CAN_SetAnswerData(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, const uint8_t *Data, uint8_t DataLen)
+{
+	bool IsSet = false;
+
+	if(AllMbStatus[Ins][MbIndex] == CAN_MB_ACTIVE
+	   && FlexCAN_SetAnswerData(Ins, MbIndex, Data, DataLen) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		IsSet = true;
+	}
+	else
+	{
+		/* Mb is inactive or not a remote answer one */
+	}
+
+	return IsSet;
+}
+
+bool MID_CAN_ReceiveFrame(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, FlexCAN_FrameType *Frame)
+{
+	bool IsRead = false;
+
+	if(AllMbStatus[Ins][MbIndex] == CAN_MB_ACTIVE
+	   && FlexCAN_ReadFrame(Ins, MbIndex, Frame) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		MID_CAN_LatencyRecord(Ins, Frame->Id, Frame->IdType, Frame->TimeStamp, Frame->IsrTimeStamp);
+		IsRead = true;
+	}
+	else
+	{
+		/* Mb is inactive */
+	}
+
+	return IsRead;
+}
+
+void MID_CAN_TransmitFdFrame(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, const FlexCAN_FdFrameType *Frame)
+{
+	CAN_MbStatus_e MbStatus = CAN_MB_INACTIVE;
+
+	MbStatus = AllMbStatus[Ins][MbIndex];
+
+	if(MbStatus == CAN_MB_ACTIVE)
+	{
+		FlexCAN_TransmitFdFrame(Ins, MbIndex, Frame);
+	}
+	else
+	{
+		/* Mb is inactive */
+	}
+}
+
+bool MID_CAN_ReceiveFdFrame(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e MbIndex, FlexCAN_FdFrameType *Frame)
+{
+	bool IsRead = false;
+
+	if(AllMbStatus[Ins][MbIndex] == CAN_MB_ACTIVE
+	   && FlexCAN_ReadFdFrame(Ins, MbIndex, Frame) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		MID_CAN_LatencyRecord(Ins, Frame->Id, Frame->IdType, Frame->TimeStamp, Frame->IsrTimeStamp);
+		IsRead = true;
+	}
+	else
+	{
+		/* Mb is inactive */
+	}
+
+	return IsRead;
+}
+
+bool MID_CAN_RxFifoRead(MID_CAN_ModuleIns_e Ins, FlexCAN_FrameType *Frame)
+{
+	bool IsRead = false;
+
+	if(FlexCAN_RxFifoReadFrame(Ins, Frame) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		MID_CAN_LatencyRecord(Ins, Frame->Id, Frame->IdType, Frame->TimeStamp, Frame->IsrTimeStamp);
+		IsRead = true;
+	}
+	else
+	{
+		/* Ring is empty or Rx FIFO is not configured */
+	}
+
+	return IsRead;
+}
+
+bool MID_CAN_SetRxMode(MID_CAN_ModuleIns_e Ins, const FlexCAN_RxPollConfigType *Config)
+{
+	bool IsSet = false;
+
+	if(FlexCAN_SetRxMode(Ins, Config) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		IsSet = true;
+	}
+	else
+	{
+		/* Invalid receive mode */
+	}
+
+	return IsSet;
+}
+
+uint8_t MID_CAN_RxPoll(MID_CAN_ModuleIns_e Ins)
+{
+	uint8_t Served = 0U;
+
+	Served = FlexCAN_RxPoll(Ins);
+
+	return Served;
+}
+
 uint8_t MID_CAN_GetAckStatus(MID_CAN_ModuleIns_e Ins)
 {
 	uint8_t FlagValue = 0U;
@@ -248,7 +777,7 @@ static void FlexCAN_PORT_Init(MID_CAN_ModuleIns_e Ins, FlexCAN_PinType PortPin)
 
 	/* PORT Initialization for FlexCANx */
 	PORTConfig.muxMode = FlexCAN_MUX[Ins];
-	PCC_PeriClockControl(PCC_PORTE_INDEX, CLOCK_NOSRC_CLK, CLOCK_DIV_DISABLED, ENABLE);
+	PCC_PeriClockControl(PCC_FlexCAN_PORT[Ins], CLOCK_NOSRC_CLK, CLOCK_DIV_DISABLED, ENABLE);
 	PORTPINConfig.userConfig = PORTConfig;
 	PORTPINConfig.pinCode = FlexCAN_PORT[Ins]*32 + PortPin.TxPin;
 	PORT_Driver_InitPin(&PORTPINConfig);
@@ -311,3 +840,197 @@ static void FlexCAN_NVIC_MbControl(MID_CAN_ModuleIns_e Ins, FlexCAN_MbIndex_e Mb
 		NVIC_DisableIRQn(IRQNumber);
 	}
 }
+
+/* Marks the mailboxes of the layout active and enables each of their IRQ lines once */
+static void FlexCAN_MbLayout_Control(MID_CAN_ModuleIns_e Ins)
+{
+	const FlexCAN_MbLayoutType *Layout = MID_CAN_MbLayout[Ins];
+	FlexCAN_MsgIDType_e IdType = FlexCAN_STANDARD;
+	CAN_MbIdDir_e Dir = CAN_MB_ID_NONE;
+	uint32_t IntMask = 0U;
+	uint32_t Code = 0U;
+	uint8_t Index = 0U;
+
+	for(Index = 0U; Index < MID_CAN_NoOfMbLayout[Ins]; Index++)
+	{
+		AllMbStatus[Ins][Layout[Index].MbIndex] = CAN_MB_ACTIVE;
+		IntMask |= (Layout[Index].Callback != NULL) ? (1UL << Layout[Index].MbIndex) : 0U;
+
+		IdType = ((Layout[Index].Cs & FLEXCAN_RAMn_DATA_WORD_0_IDE_MASK) != 0U) ? FlexCAN_EXTENDED : FlexCAN_STANDARD;
+		Code = (Layout[Index].Cs & FLEXCAN_RAMn_DATA_WORD_0_CODE_MASK) >> FLEXCAN_RAMn_DATA_WORD_0_CODE_SHIFT;
+
+		/* Back from the header words: REMOTE has RTR set, ANSWER has a mask */
+		if(Code == Rx_CODE_EMPTY)
+		{
+			Dir = CAN_MB_ID_RX;
+		}
+		else if((Layout[Index].Cs & FLEXCAN_RAMn_DATA_WORD_0_RTR_MASK) == 0U && Layout[Index].RxMask == 0U)
+		{
+			Dir = CAN_MB_ID_TX;
+		}
+		else
+		{
+			Dir = CAN_MB_ID_NONE;
+		}
+
+		if(IdType == FlexCAN_EXTENDED)
+		{
+			FlexCAN_MbId_Set(Ins, Layout[Index].MbIndex, Dir, Layout[Index].Id & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK,
+			                 Layout[Index].RxMask & FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK, IdType);
+		}
+		else
+		{
+			FlexCAN_MbId_Set(Ins, Layout[Index].MbIndex, Dir, (Layout[Index].Id & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT,
+			                 (Layout[Index].RxMask & FLEXCAN_RAMn_DATA_WORD_1_ID_MASK) >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT, IdType);
+		}
+	}
+
+	if((IntMask & 0x0000FFFFUL) != 0U)
+	{
+		FlexCAN_NVIC_MbControl(Ins, MB0, true);
+	}
+
+	if((IntMask & 0xFFFF0000UL) != 0U)
+	{
+		FlexCAN_NVIC_MbControl(Ins, MB16, true);
+	}
+}
+
+/* First mailbox after the Rx FIFO area of the next or current init */
+static uint8_t FlexCAN_FirstFreeMb(MID_CAN_ModuleIns_e Ins)
+{
+	const FlexCAN_RxFifoConfigType *RxFifoConfig = MID_CAN_RxFifoConfig[Ins];
+	uint8_t FirstMb = 0U;
+
+	if(RxFifoConfig != NULL && RxFifoConfig->Mode != FlexCAN_RXFIFO_DISABLE)
+	{
+		FirstMb = (uint8_t)FLEXCAN_RXFIFO_FIRST_FREE_MB(RxFifoConfig->NoOfIdFilters);
+	}
+
+	return FirstMb;
+}
+
+/* MAXMB of the init: the highest layout mailbox or the end of the Rx FIFO area */
+static uint8_t FlexCAN_MaxMb_Init(MID_CAN_ModuleIns_e Ins)
+{
+	const FlexCAN_MbLayoutType *Layout = MID_CAN_MbLayout[Ins];
+	uint8_t FirstMb = FlexCAN_FirstFreeMb(Ins);
+	uint8_t MaxMb = (FirstMb == 0U) ? 0U : (FirstMb - 1U);
+	uint8_t Index = 0U;
+
+	for(Index = 0U; Index < MID_CAN_NoOfMbLayout[Ins]; Index++)
+	{
+		MaxMb = (Layout[Index].MbIndex > MaxMb) ? (uint8_t)Layout[Index].MbIndex : MaxMb;
+	}
+
+	return MaxMb;
+}
+
+/* Moves MAXMB to the highest active mailbox, freeze mode is only entered when it changes */
+static void FlexCAN_MaxMb_Control(MID_CAN_ModuleIns_e Ins)
+{
+	uint8_t FirstMb = FlexCAN_FirstFreeMb(Ins);
+	uint8_t MaxMb = (FirstMb == 0U) ? 0U : (FirstMb - 1U);
+	uint8_t MbIndex = 0U;
+
+	for(MbIndex = FirstMb; MbIndex < FLEXCAN_MB_COUNT; MbIndex++)
+	{
+		MaxMb = (AllMbStatus[Ins][MbIndex] == CAN_MB_ACTIVE) ? MbIndex : MaxMb;
+	}
+
+	if(MaxMb != MID_CAN_MaxMb[Ins] && FlexCAN_SetMaxMb(Ins, MaxMb) == FLEXCAN_DRIVER_RETURN_CODE_SUCCESSED)
+	{
+		MID_CAN_MaxMb[Ins] = MaxMb;
+	}
+}
+
+/* Records the ID of a mailbox, an Rx mailbox only gets one if its mask compares every ID bit */
+static void FlexCAN_MbId_Set(MID_CAN_ModuleIns_e Ins, uint8_t MbIndex, CAN_MbIdDir_e Dir, uint32_t Id,
+                             uint32_t Mask, FlexCAN_MsgIDType_e IdType)
+{
+	uint32_t IdMask = (IdType == FlexCAN_EXTENDED) ? FLEXCAN_RAMn_DATA_WORD_1_ID_EXT_MASK : (FLEXCAN_RAMn_DATA_WORD_1_ID_MASK >> FLEXCAN_RAMn_DATA_WORD_1_ID_SHIFT);
+
+	MID_CAN_MbId[Ins][MbIndex].Key = MID_CAN_IDMAP_KEY(Ins, Id & IdMask, IdType);
+	MID_CAN_MbId[Ins][MbIndex].Dir = (Dir == CAN_MB_ID_RX && (Mask & IdMask) != IdMask) ? CAN_MB_ID_NONE : Dir;
+}
+
+/* Rebuilds the ID lookup of both directions from the active mailboxes, the lowest mailbox wins an ID */
+static void FlexCAN_IdTable_Control(void)
+{
+	uint32_t Keys[MID_CAN_IDMAP_MAX_KEYS];
+	CAN_IdTableType *Table = NULL;
+	uint8_t NoOfKeys = 0U;
+	uint8_t Dir = 0U;
+	uint8_t Ins = 0U;
+	uint8_t MbIndex = 0U;
+	uint8_t Index = 0U;
+
+	for(Dir = 0U; Dir < CAN_MB_ID_DIR_COUNT; Dir++)
+	{
+		/* Spare table, a lookup may be reading the active one */
+		Table = (MID_CAN_IdTableActive[Dir] == &MID_CAN_IdTable[Dir][0]) ? &MID_CAN_IdTable[Dir][1] : &MID_CAN_IdTable[Dir][0];
+		NoOfKeys = 0U;
+
+		for(Ins = 0U; Ins < FLEXCAN_INSTANCE_COUNT; Ins++)
+		{
+			for(MbIndex = 0U; MbIndex < FLEXCAN_MB_COUNT && NoOfKeys < MID_CAN_IDMAP_MAX_KEYS; MbIndex++)
+			{
+				if(AllMbStatus[Ins][MbIndex] == CAN_MB_ACTIVE && MID_CAN_MbId[Ins][MbIndex].Dir == (CAN_MbIdDir_e)Dir)
+				{
+					for(Index = 0U; Index < NoOfKeys && Keys[Index] != MID_CAN_MbId[Ins][MbIndex].Key; Index++);
+
+					if(Index == NoOfKeys)
+					{
+						Keys[NoOfKeys] = MID_CAN_MbId[Ins][MbIndex].Key;
+						Table->MbIndex[NoOfKeys] = MbIndex;
+						NoOfKeys++;
+					}
+				}
+			}
+		}
+
+		/* A failed build leaves a map where every lookup misses */
+		(void)MID_CAN_IdMapBuild(&Table->Map, Keys, NoOfKeys);
+
+		MID_CAN_IdTableActive[Dir] = Table;
+	}
+}
+
+/* Constant time ID to mailbox lookup, safe from interrupt context */
+static bool FlexCAN_IdTable_Find(MID_CAN_ModuleIns_e Ins, CAN_MbIdDir_e Dir, uint32_t Id, FlexCAN_MsgIDType_e IdType,
+                                 FlexCAN_MbIndex_e *MbIndex)
+{
+	const CAN_IdTableType *Table = MID_CAN_IdTableActive[Dir];
+	uint8_t Index = MID_CAN_IDMAP_NONE;
+
+	if(Table != NULL)
+	{
+		Index = MID_CAN_IdMapFind(&Table->Map, MID_CAN_IDMAP_KEY(Ins, Id, IdType));
+	}
+
+	if(Index != MID_CAN_IDMAP_NONE)
+	{
+		*MbIndex = (FlexCAN_MbIndex_e)Table->MbIndex[Index];
+	}
+
+	return (Index != MID_CAN_IDMAP_NONE);
+}
+
+static void FlexCAN_RxFifo_Control(MID_CAN_ModuleIns_e Ins, FlexCAN_RxFifoConfigType *RxFifoConfig)
+{
+	if(RxFifoConfig == NULL || RxFifoConfig->Mode == FlexCAN_RXFIFO_DISABLE)
+	{
+		/* Rx FIFO is not used */
+	}
+	else if(RxFifoConfig->UseDma == true)
+	{
+		/* eDMA drains the FIFO, only the channel interrupt reaches the CPU */
+		PCC_PeriClockControl(PCC_DMAMUX_INDEX, CLOCK_NOSRC_CLK, CLOCK_DIV_DISABLED, ENABLE);
+		NVIC_EnableIRQn((IRQn_Type)(DMA0_IRQn + RxFifoConfig->DmaChannel));
+	}
+	else
+	{
+		/* FIFO flags live in MB5-MB7 */
+		FlexCAN_NVIC_MbControl(Ins, MB5, true);
+	}
+}
@@ -0,0 +1,78 @@
+/*
+ * MIDDLE_Snapshot.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#ifndef INCLUDE_MIDDLE_SNAPSHOT_H_
+#define INCLUDE_MIDDLE_SNAPSHOT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*==================================================================================================
+*                                        DEFINES
+==================================================================================================*/
+
+/* Orders the buffer accesses against the generation, DMB on the Cortex-M4 */
+#define MID_SNAPSHOT_BARRIER()          __sync_synchronize()
+
+/**
+ * @brief Defines a snapshot of a type and its two buffers.
+ *
+ * @param Storage  Storage class of both objects, static or empty.
+ * @param Name     Name of the MID_SnapshotType object.
+ * @param Type     Type of the value shared.
+ */
+#define MID_SNAPSHOT_DEFINE(Storage, Name, Type) \
+    Storage Type Name##_Buffers[2]; \
+    Storage MID_SnapshotType Name = { .Generation = 0U, .Buffers = { &Name##_Buffers[0], &Name##_Buffers[1] }, .Size = sizeof(Type) }
+
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+
+/**
+ * @brief Value shared by one writer with readers of any context, without masking interrupts.
+ *
+ * Double buffer with a generation counter: the writer fills the buffer readers do not use, then
+ * publishes it. The generation is odd while a buffer is filled, so a reader knows when the buffer
+ * it copies may have been written. It retries only then, which takes two publications during the
+ * copy. A reader interrupting the writer copies the other buffer and never waits for it.
+ */
+typedef struct
+{
+    volatile uint32_t            Generation;     /*!< Twice the publications, plus 1 while one is in progress */
+    void                       * Buffers[2];     /*!< Current value in Buffers[(Generation / 2) & 1] */
+    size_t                       Size;           /*!< Size of the value in bytes */
+} MID_SnapshotType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief  Publishes a new value.
+ *
+ * A snapshot has a single writer, this function must not be called from two contexts.
+ *
+ * @param[in,out] Snapshot  Snapshot.
+ * @param[in]     Value     New value, Snapshot->Size bytes, usually a copy kept by the writer.
+ */
+void MID_SnapshotPublish(MID_SnapshotType *Snapshot, const void *Value);
+
+/**
+ * @brief  Copies the current value, never a mix of two publications.
+ *
+ * Can be called from any context, including one that interrupted the writer.
+ *
+ * @param[in]   Snapshot  Snapshot.
+ * @param[out]  Value     Copy, Snapshot->Size bytes.
+ *
+ * @return uint32_t  Number of the publication copied, 0 if nothing was published yet.
+ */
+uint32_t MID_SnapshotRead(const MID_SnapshotType *Snapshot, void *Value);
+
+#endif /* INCLUDE_MIDDLE_SNAPSHOT_H_ */
@@ -0,0 +1,70 @@
+/*
+ * MIDDLE_Snapshot.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: adm
+ */
+
+#include "MIDDLE_Snapshot.h"
+#include <string.h>
+
+/* ----------------------------------------------------------------------------
+   -- Definitions
+   ---------------------------------------------------------------------------- */
+#define SNAPSHOT_CURRENT(Generation)	(((Generation) >> 1U) & 1U)	/*!< Last complete publication */
+
+/* ----------------------------------------------------------------------------
+   -- Global functions
+   ---------------------------------------------------------------------------- */
+void MID_SnapshotPublish(MID_SnapshotType *Snapshot, const void *Value)
+{
+	uint32_t Generation = 0U;
+
+	if(Snapshot == NULL || Value == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		/* Only the writer changes the generation, odd while it writes the buffer readers do not use */
+		Generation = Snapshot->Generation + 1U;
+		Snapshot->Generation = Generation;
+		MID_SNAPSHOT_BARRIER();
+
+		memcpy(Snapshot->Buffers[SNAPSHOT_CURRENT(Generation) ^ 1U], Value, Snapshot->Size);
+
+		/* The buffer is complete before readers are sent to it */
+		MID_SNAPSHOT_BARRIER();
+		Snapshot->Generation = Generation + 1U;
+	}
+}
+
+uint32_t MID_SnapshotRead(const MID_SnapshotType *Snapshot, void *Value)
+{
+	uint32_t Generation = 0U;
+	uint32_t Now = 0U;
+
+	if(Snapshot == NULL || Value == NULL)
+	{
+		/* Invalid parameters */
+	}
+	else
+	{
+		Now = Snapshot->Generation;
+
+		do
+		{
+			Generation = Now;
+			MID_SNAPSHOT_BARRIER();
+
+			memcpy(Value, Snapshot->Buffers[SNAPSHOT_CURRENT(Generation)], Snapshot->Size);
+
+			MID_SNAPSHOT_BARRIER();
+			Now = Snapshot->Generation;
+
+			/* The next write into the copied buffer starts at the second odd generation after it */
+		} while((Now - (Generation | 1U)) >= 2U);
+	}
+
+	return (Generation >> 1U);
+}
@@ -43,6 +43,15 @@ typedef enum
  */
 void MID_UART_Init(void);
 
+/**
+ * @brief Selects the baud rate used by the next MID_UART_Init.
+ *
+ * LPUART1 runs from the 48 MHz FIRC with 16x oversampling, so the baud rate should divide 3 MHz.
+ *
+ * @param[in] baudRate  Baud rate, 115200 until this function is called.
+ */
+void MID_UART_SetBaudRate(Drv_Uart_BaudrateValueType baudRate);
+
 /**
  * @brief Runs the application logic for the UART middleware.
  *
@@ -75,12 +84,15 @@ void MID_UART_ReceiveDataInterrupt(const MID_UART_InstanceType instance, const u
  * @brief Sends data via UART interrupt.
  *
  * This function is called to initiate data transmission via UART interrupt.
+ * The buffer must stay untouched until the transmitter callback.
  *
  * @param[in] instance  The UART instance used for sending data.
  * @param[in] data      Pointer to the buffer containing data to be sent.
  * @param[in] length    The number of bytes to transmit.
+ *
+ * @return bool  true if the transfer started, false if the transmitter is still busy.
  */
-void MID_UART_SendDataInterrupt(const MID_UART_InstanceType instance, uint8_t *data, uint16_t length);
+bool MID_UART_SendDataInterrupt(const MID_UART_InstanceType instance, uint8_t *data, uint16_t length);
 
 #endif /* INC_MIDD_UART_H_ */
 
@@ -61,6 +61,11 @@ void MID_UART_Init(void) {
   MIDD_uartInit();
 }
 
+void MID_UART_SetBaudRate(Drv_Uart_BaudrateValueType baudRate)
+{
+  UserConfig.baudRate = baudRate;
+}
+
 void MID_UART_InstallCallBack(MID_UART_CallBackFunctionType callBackType, DRV_CallBack_LPUART cbFunction)
 {
 	Drv_Uart_InstallCallBack(callBackType, cbFunction);
@@ -71,9 +76,9 @@ void MID_UART_ReceiveDataInterrupt(const MID_UART_InstanceType instance, const u
   Drv_Uart_ReceiveDataInterrupt(instance, rxBuff, rxSize);
 }
 
-void MID_UART_SendDataInterrupt(const MID_UART_InstanceType instance, uint8_t *data, uint16_t length)
+bool MID_UART_SendDataInterrupt(const MID_UART_InstanceType instance, uint8_t *data, uint16_t length)
 {
-  Drv_Uart_SendDataInterrupt(instance, data, length);
+  return (Drv_Uart_SendDataInterrupt(instance, data, length) == DRV_UART_OK);
 }
 
 